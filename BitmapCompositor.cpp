@@ -0,0 +1,312 @@
+#include <string.h>
+#include <algorithm>
+#include "BitmapCompositor.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		BitmapCompositor.cpp -	Draws the terminal view into a back buffer from a GlyphAtlas.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BitmapCompositor(GlyphAtlas & atlas, int columns, int rows)
+--					void resize(int columns, int rows)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					void addDamage(int row, int column, int count)
+--					bool getFrameDamage(CellRect * damage) const
+--					uint64_t hash(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Runs that fall partly outside the buffer are clipped with clipRun, as GDI clips to the window.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint64_t PIXEL_FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t PIXEL_FNV_PRIME = 1099511628211ULL;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BitmapCompositor
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BitmapCompositor(GlyphAtlas & atlas, int columns, int rows)
+--					GlyphAtlas & atlas:		supplies the cell tiles and the cell size; must outlive the compositor
+--					int columns, rows:		size of the view in cells
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+BitmapCompositor::BitmapCompositor(GlyphAtlas & glyphAtlas, int newColumns, int newRows) : atlas(glyphAtlas) {
+	resize(newColumns, newRows);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	resize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void resize(int columns, int rows)
+--					int columns, rows:	new size of the view in cells
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Also picks up the atlas's current cell size. The buffer is cleared to the default background.
+----------------------------------------------------------------------------------------------------------------------*/
+void BitmapCompositor::resize(int newColumns, int newRows) {
+	columns = newColumns < 1 ? 1 : newColumns;
+	rows = newRows < 1 ? 1 : newRows;
+	cellWidth = atlas.getCellWidth();
+	cellHeight = atlas.getCellHeight();
+	pixels.assign((size_t)getWidth() * getHeight(), PIXEL_PALETTE[attributeBackground(ATTR_DEFAULT)]);
+	runTiles.assign(columns, NULL);
+	isInvalid = true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool beginFrame(CellRect * damage)
+--					CellRect * damage:	set to the whole buffer when it needs a full redraw
+--
+-- RETURNS:		bool - true if the buffer is new, resized or invalidated since the last frame
+----------------------------------------------------------------------------------------------------------------------*/
+bool BitmapCompositor::beginFrame(CellRect * damage) {
+	hasFrameDamage = false;
+	if (!isInvalid) {
+		return false;
+	}
+	isInvalid = false;
+	damage->top = 0;
+	damage->left = 0;
+	damage->bottom = rows - 1;
+	damage->right = columns - 1;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	drawRun
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					int row, column:			first cell of the run
+--					const char16_t * glyphs:	count glyphs
+--					int count:					cells in the run
+--					uint8_t attribute:			colours of every cell in the run
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- All the tiles are looked up first and then copied a pixel row at a time across the whole run, so the writes go
+-- along the buffer instead of down it. If a miss flushed the atlas partway through, the tiles found before it are
+-- gone, and the run is redone a cell at a time, copying each tile before the next lookup.
+----------------------------------------------------------------------------------------------------------------------*/
+void BitmapCompositor::drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) {
+	int first = column;
+	int width = getWidth();
+
+	if (!clipRun(row, &column, &count, columns, rows)) {
+		return;
+	}
+	glyphs += column - first;
+
+	uint32_t * origin = &pixels[(size_t)row * cellHeight * width + (size_t)column * cellWidth];
+	size_t rowBytes = (size_t)cellWidth * sizeof(uint32_t);
+	uint64_t flushes = atlas.getFlushes();
+
+	for (int i = 0; i < count; i++) {
+		runTiles[i] = atlas.lookup(glyphs[i], attribute);
+	}
+	if (atlas.getFlushes() == flushes) {
+		for (int y = 0; y < cellHeight; y++) {
+			uint32_t * target = origin + (size_t)y * width;
+			size_t tileOffset = (size_t)y * cellWidth;
+			for (int i = 0; i < count; i++) {
+				memcpy(target + (size_t)i * cellWidth, runTiles[i] + tileOffset, rowBytes);
+			}
+		}
+	}
+	else {
+		for (int i = 0; i < count; i++) {
+			const uint32_t * tile = atlas.lookup(glyphs[i], attribute);
+			uint32_t * target = origin + (size_t)i * cellWidth;
+			for (int y = 0; y < cellHeight; y++) {
+				memcpy(target + (size_t)y * width, tile + (size_t)y * cellWidth, rowBytes);
+			}
+		}
+	}
+	addDamage(row, column, count);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	fillBlank
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void fillBlank(int row, int column, int count, uint8_t attribute)
+--					int row, column:		first cell to fill
+--					int count:				cells to fill
+--					uint8_t attribute:		whose background to fill with
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void BitmapCompositor::fillBlank(int row, int column, int count, uint8_t attribute) {
+	int width = getWidth();
+
+	if (!clipRun(row, &column, &count, columns, rows)) {
+		return;
+	}
+	uint32_t colour = PIXEL_PALETTE[attributeBackground(attribute)];
+	uint32_t * origin = &pixels[(size_t)row * cellHeight * width + (size_t)column * cellWidth];
+	for (int y = 0; y < cellHeight; y++) {
+		std::fill(origin + (size_t)y * width, origin + (size_t)y * width + (size_t)count * cellWidth, colour);
+	}
+	addDamage(row, column, count);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void endFrame(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void BitmapCompositor::endFrame() {
+	frameCount++;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	addDamage
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void addDamage(int row, int column, int count)
+--					int row, column:	first cell drawn
+--					int count:			cells drawn
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void BitmapCompositor::addDamage(int row, int column, int count) {
+	int right = column + count - 1;
+
+	cellCount += count;
+	if (!hasFrameDamage) {
+		frameDamage = { row, column, row, right };
+		hasFrameDamage = true;
+		return;
+	}
+	frameDamage.top = std::min(frameDamage.top, row);
+	frameDamage.bottom = std::max(frameDamage.bottom, row);
+	frameDamage.left = std::min(frameDamage.left, column);
+	frameDamage.right = std::max(frameDamage.right, right);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getFrameDamage
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getFrameDamage(CellRect * damage) const
+--					CellRect * damage:	set to the bounds of every cell drawn since beginFrame
+--
+-- RETURNS:		bool - false if the frame drew nothing
+----------------------------------------------------------------------------------------------------------------------*/
+bool BitmapCompositor::getFrameDamage(CellRect * damage) const {
+	if (hasFrameDamage) {
+		*damage = frameDamage;
+	}
+	return hasFrameDamage;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	hash
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint64_t hash(void) const
+--
+-- RETURNS:		uint64_t - FNV-1a of the buffer size and every pixel
+----------------------------------------------------------------------------------------------------------------------*/
+uint64_t BitmapCompositor::hash() const {
+	uint64_t value = PIXEL_FNV_OFFSET_BASIS;
+	auto mix = [&value](uint32_t word) {
+		for (int shift = 0; shift < 32; shift += 8) {
+			value = (value ^ (word >> shift & 0xFF)) * PIXEL_FNV_PRIME;
+		}
+	};
+
+	mix((uint32_t)getWidth());
+	mix((uint32_t)getHeight());
+	for (uint32_t pixel : pixels) {
+		mix(pixel);
+	}
+	return value;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Renderer.h"
+#include "GlyphAtlas.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		BitmapCompositor.h -	Draws the terminal view into a back buffer from a GlyphAtlas.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void resize(int columns, int rows)
+--					void invalidate(void)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					bool getFrameDamage(CellRect * damage) const
+--					uint64_t hash(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The back buffer is 32-bit 0x00RRGGBB pixels, top row first, getWidth pixels to a row: a top-down 32 bpp DIB, so
+-- GdiRenderer hands it straight to SetDIBitsToDevice. Drawing a cell is a copy of its atlas tile, one memcpy per
+-- pixel row, and a blank run is a fill; nothing here calls the platform.
+--
+-- The cells drawn during a frame are collected into one rectangle that the caller can present when the frame ends.
+-- Like HeadlessRenderer, a new or resized buffer reports itself as damaged on the next frame. The cell size is read
+-- from the atlas on resize, so set it there first.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class BitmapCompositor : public Renderer {
+private:
+	GlyphAtlas & atlas;
+	int columns = 0;
+	int rows = 0;
+	int cellWidth = 0;
+	int cellHeight = 0;
+	std::vector<uint32_t> pixels;
+	std::vector<const uint32_t *> runTiles;	// one run's tiles, looked up before any are copied
+	bool isInvalid = true;
+
+	CellRect frameDamage;
+	bool hasFrameDamage = false;
+	uint64_t frameCount = 0;
+	uint64_t cellCount = 0;
+
+	void addDamage(int row, int column, int count);
+public:
+	BitmapCompositor(GlyphAtlas & atlas, int columns, int rows);
+	BitmapCompositor(const BitmapCompositor &) = delete;
+	BitmapCompositor & operator=(const BitmapCompositor &) = delete;
+
+	void resize(int columns, int rows);
+	void invalidate() { isInvalid = true; };
+	bool getFrameDamage(CellRect * damage) const;
+	uint64_t hash() const;
+
+	int getColumns() const { return columns; };
+	int getRows() const { return rows; };
+	int getWidth() const { return columns * cellWidth; };
+	int getHeight() const { return rows * cellHeight; };
+	const uint32_t * getPixels() const { return pixels.data(); };
+	uint64_t getFrameCount() const { return frameCount; };
+	uint64_t getCellCount() const { return cellCount; };
+
+	bool beginFrame(CellRect * damage) override;
+	void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) override;
+	void fillBlank(int row, int column, int count, uint8_t attribute) override;
+	void endFrame() override;
+};
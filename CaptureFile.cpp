@@ -0,0 +1,78 @@
+#include "CaptureFile.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		CaptureFile.cpp -	A capture mapped into memory for reading in place.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path)
+--					void close(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Mapping moved into MappedFile
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Maps the file with MappedFile
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool open(const std::string & path)
+--					const std::string & path:	the capture, UTF-8
+--
+-- RETURNS:		bool - false if the file cannot be mapped or is not a capture
+--
+-- NOTES:
+-- Closes any file already open first.
+----------------------------------------------------------------------------------------------------------------------*/
+bool CaptureFile::open(const std::string & path) {
+	close();
+	if (!file.open(path)) {
+		return false;
+	}
+	data = file.getData();
+	size = file.getSize();
+	if (size < CAPTURE_HEADER_SIZE || !decodeCaptureHeader(data, size, &header) || header.headerSize > size) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Payload pointers from next are no longer valid afterwards.
+----------------------------------------------------------------------------------------------------------------------*/
+void CaptureFile::close() {
+	file.close();
+	data = nullptr;
+	size = 0;
+	header = CaptureHeader();
+}
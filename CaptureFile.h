@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include "CaptureFormat.h"
+#include "MappedFile.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		CaptureFile.h -	A capture mapped into memory for reading in place.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path)
+--					void close(void)
+--					bool isOpen(void) const
+--					const CaptureHeader & getHeader(void) const
+--					size_t getSize(void) const
+--					size_t begin(void) const
+--					bool next(size_t * offset, CaptureRecord * record, const char ** payload) const
+--					bool isTruncated(size_t offset) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The mapping is a MappedFile
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The whole file is mapped read-only and walked with an offset: begin gives the first record, next decodes the
+-- record there and points payload into the mapping, so records are handed on without a copy. The mapping stays
+-- valid until close. A file cut short mid-record reads as ending at its last whole record.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class CaptureFile {
+private:
+	MappedFile file;
+	const char * data = nullptr;
+	size_t size = 0;
+	CaptureHeader header;
+public:
+	CaptureFile() {};
+	~CaptureFile() { close(); };
+	CaptureFile(const CaptureFile &) = delete;
+	CaptureFile & operator=(const CaptureFile &) = delete;
+
+	bool open(const std::string & path);
+	void close();
+	bool isOpen() const { return data != nullptr; };
+	const CaptureHeader & getHeader() const { return header; };
+	size_t getSize() const { return size; };
+	size_t begin() const { return header.headerSize; };
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	next
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	bool next(size_t * offset, CaptureRecord * record, const char ** payload) const
+	--					size_t * offset:			a record's offset from begin or a previous next; moved past it
+	--					CaptureRecord * record:		filled in with the record's header
+	--					const char ** payload:		set to the record's bytes in the mapping
+	--
+	-- RETURNS:		bool - false at the end of the file or of its last whole record
+	--------------------------------------------------------------------------------------------------------------*/
+	bool next(size_t * offset, CaptureRecord * record, const char ** payload) const {
+		if (*offset > size || size - *offset < CAPTURE_RECORD_SIZE) {
+			return false;
+		}
+		decodeRecordHeader(data + *offset, record);
+		if (size - *offset - CAPTURE_RECORD_SIZE < record->length) {
+			return false;
+		}
+		*payload = data + *offset + CAPTURE_RECORD_SIZE;
+		*offset += CAPTURE_RECORD_SIZE + record->length;
+		return true;
+	}
+
+	// True if next stopped at offset because the record there is incomplete rather than at the end of the file
+	bool isTruncated(size_t offset) const { return offset < size; };
+};
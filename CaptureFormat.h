@@ -0,0 +1,189 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		CaptureFormat.h -	The on-disk layout of a session capture.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void encodeCaptureHeader(char * out, const CaptureHeader & header)
+--					bool decodeCaptureHeader(const char * in, size_t length, CaptureHeader * header)
+--					void encodeRecordHeader(char * out, const CaptureRecord & record)
+--					void decodeRecordHeader(const char * in, CaptureRecord * record)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - CAPTURE_FILE_EXTENSION, which also marks a port name as a capture to replay
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A capture is a CAPTURE_HEADER_SIZE byte file header followed by records, each a CAPTURE_RECORD_SIZE byte header
+-- and its payload, with no padding between them. All fields are little-endian:
+--
+--		file header:	magic "DSPCAP\r\n", u32 version, u32 header size, u64 wall clock at start (ns since the Unix
+--						epoch), char[32] port name (NUL padded)
+--		record:			u64 timestamp (ns since the capture started, monotonic), u32 length | direction << 31,
+--						then length bytes exactly as they crossed the port
+--
+-- A record carries at most CAPTURE_MAX_PAYLOAD bytes; anything longer is written as several records with the same
+-- timestamp. Readers skip header bytes past the size they know, so the header can grow without a new version.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr const char * CAPTURE_FILE_EXTENSION = ".dspcap";
+constexpr char CAPTURE_MAGIC[8] = { 'D', 'S', 'P', 'C', 'A', 'P', '\r', '\n' };
+constexpr uint32_t CAPTURE_VERSION = 1;
+constexpr size_t CAPTURE_PORT_NAME_SIZE = 32;
+constexpr size_t CAPTURE_HEADER_SIZE = 8 + 4 + 4 + 8 + CAPTURE_PORT_NAME_SIZE;
+constexpr size_t CAPTURE_RECORD_SIZE = 8 + 4;
+constexpr uint32_t CAPTURE_LENGTH_MASK = 0x7FFFFFFF;
+constexpr size_t CAPTURE_MAX_PAYLOAD = 1 << 16;
+
+enum class CaptureDirection : uint8_t {
+	Receive = 0,
+	Transmit = 1
+};
+
+struct CaptureHeader {
+	uint32_t version = CAPTURE_VERSION;
+	uint32_t headerSize = CAPTURE_HEADER_SIZE;
+	uint64_t startTime = 0;							// ns since the Unix epoch
+	char portName[CAPTURE_PORT_NAME_SIZE] = {};
+};
+
+struct CaptureRecord {
+	uint64_t timestamp = 0;							// ns since startTime, from a monotonic clock
+	uint32_t length = 0;
+	CaptureDirection direction = CaptureDirection::Receive;
+};
+
+inline void putLittle(char * out, uint64_t value, int size) {
+	for (int i = 0; i < size; i++) {
+		out[i] = (char)(value >> (8 * i));
+	}
+}
+
+inline uint64_t getLittle(const char * in, int size) {
+	uint64_t value = 0;
+
+	for (int i = size - 1; i >= 0; i--) {
+		value = (value << 8) | (uint8_t)in[i];
+	}
+	return value;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	encodeCaptureHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void encodeCaptureHeader(char * out, const CaptureHeader & header)
+--					char * out:						CAPTURE_HEADER_SIZE bytes to fill
+--					const CaptureHeader & header:	the header to write
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+inline void encodeCaptureHeader(char * out, const CaptureHeader & header) {
+	memcpy(out, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+	putLittle(out + 8, CAPTURE_VERSION, 4);
+	putLittle(out + 12, CAPTURE_HEADER_SIZE, 4);
+	putLittle(out + 16, header.startTime, 8);
+	memcpy(out + 24, header.portName, CAPTURE_PORT_NAME_SIZE);
+	out[24 + CAPTURE_PORT_NAME_SIZE - 1] = '\0';
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	decodeCaptureHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool decodeCaptureHeader(const char * in, size_t length, CaptureHeader * header)
+--					const char * in:		the start of the file
+--					size_t length:			bytes available at in; at least CAPTURE_HEADER_SIZE
+--					CaptureHeader * header:	filled in on success
+--
+-- RETURNS:		bool - false if this is not a capture, is truncated or is from a newer version
+--
+-- NOTES:
+-- Records start header->headerSize bytes into the file, which may be past the bytes given here.
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool decodeCaptureHeader(const char * in, size_t length, CaptureHeader * header) {
+	if (length < CAPTURE_HEADER_SIZE || memcmp(in, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+		return false;
+	}
+	header->version = (uint32_t)getLittle(in + 8, 4);
+	header->headerSize = (uint32_t)getLittle(in + 12, 4);
+	if (header->version > CAPTURE_VERSION || header->headerSize < CAPTURE_HEADER_SIZE) {
+		return false;
+	}
+	header->startTime = getLittle(in + 16, 8);
+	memcpy(header->portName, in + 24, CAPTURE_PORT_NAME_SIZE);
+	header->portName[CAPTURE_PORT_NAME_SIZE - 1] = '\0';
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	encodeRecordHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void encodeRecordHeader(char * out, const CaptureRecord & record)
+--					char * out:						CAPTURE_RECORD_SIZE bytes to fill
+--					const CaptureRecord & record:	the record's timestamp, length and direction
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+inline void encodeRecordHeader(char * out, const CaptureRecord & record) {
+	putLittle(out, record.timestamp, 8);
+	putLittle(out + 8, (record.length & CAPTURE_LENGTH_MASK) | ((uint32_t)record.direction << 31), 4);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	decodeRecordHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void decodeRecordHeader(const char * in, CaptureRecord * record)
+--					const char * in:			CAPTURE_RECORD_SIZE bytes of a record header
+--					CaptureRecord * record:		filled in; the payload follows in
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+inline void decodeRecordHeader(const char * in, CaptureRecord * record) {
+	uint32_t word = (uint32_t)getLittle(in + 8, 4);
+
+	record->timestamp = getLittle(in, 8);
+	record->length = word & CAPTURE_LENGTH_MASK;
+	record->direction = (CaptureDirection)(word >> 31);
+}
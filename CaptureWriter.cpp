@@ -0,0 +1,293 @@
+#include <string.h>
+#include <system_error>
+#include "CaptureWriter.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		CaptureWriter.cpp -	Records a session's traffic to a capture file from a background thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path, const std::string & portName)
+--					void close(void)
+--					bool record(CaptureDirection direction, const char * data, size_t length)
+--					bool append(CaptureDirection direction, uint64_t timestamp, const char * data, size_t length)
+--					void run(void)
+--					CaptureStats getStats(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- At most one buffer is with the capture thread at a time, so buffers reach the file in the order they were filled.
+-- The file is unbuffered; every write is a whole buffer straight from its aligned storage.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool open(const std::string & capturePath, const std::string & portName)
+--					const std::string & capturePath:	the file to create; an existing one is replaced
+--					const std::string & portName:		stored in the file header
+--
+-- RETURNS:		bool - false if the file or the capture thread could not be created
+--
+-- NOTES:
+-- Closes any capture in progress first. Timestamps count from this call.
+----------------------------------------------------------------------------------------------------------------------*/
+bool CaptureWriter::open(const std::string & capturePath, const std::string & portName) {
+	CaptureHeader header;
+
+	close();
+	file = fopen(capturePath.c_str(), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	setvbuf(file, NULL, _IONBF, 0);
+
+	if (!storage) {
+		storage.reset(new char[2 * CAPTURE_BUFFER_SIZE + CAPTURE_WRITE_ALIGN]);
+		buffers[0] = (char *)(((uintptr_t)storage.get() + CAPTURE_WRITE_ALIGN - 1) &
+			~(uintptr_t)(CAPTURE_WRITE_ALIGN - 1));
+		buffers[1] = buffers[0] + CAPTURE_BUFFER_SIZE;
+	}
+	header.startTime = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+	strncpy(header.portName, portName.c_str(), CAPTURE_PORT_NAME_SIZE - 1);
+
+	// The file header goes out with the first buffer
+	encodeCaptureHeader(buffers[0], header);
+	fill[0] = CAPTURE_HEADER_SIZE;
+	fill[1] = 0;
+	filling = 0;
+	pending = -1;
+	isStopping = false;
+	stats = CaptureStats();
+	path = capturePath;
+	start = Clock::now();
+
+	try {
+		worker = std::thread(&CaptureWriter::run, this);
+	}
+	catch (const std::system_error &) {
+		fclose(file);
+		file = nullptr;
+		return false;
+	}
+	isOpen.store(true, std::memory_order_release);
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Stops taking records, waits for everything recorded to be written and closes the file. Safe to call when no
+-- capture is open.
+----------------------------------------------------------------------------------------------------------------------*/
+void CaptureWriter::close() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!isOpen.load(std::memory_order_relaxed)) {
+			return;
+		}
+		isOpen.store(false, std::memory_order_relaxed);
+		isStopping = true;
+	}
+	wake.notify_one();
+	worker.join();
+	fclose(file);
+	file = nullptr;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	record
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool record(CaptureDirection direction, const char * data, size_t length)
+--					CaptureDirection direction:	which way the bytes crossed the port
+--					const char * data:			the bytes
+--					size_t length:				bytes in data
+--
+-- RETURNS:		bool - false if nothing is being captured or some of the bytes were dropped
+--
+-- NOTES:
+-- Any thread may call this function. It costs one relaxed load while no capture is open.
+----------------------------------------------------------------------------------------------------------------------*/
+bool CaptureWriter::record(CaptureDirection direction, const char * data, size_t length) {
+	uint64_t timestamp;
+	bool isComplete = true;
+
+	if (!isOpen.load(std::memory_order_acquire)) {
+		return false;
+	}
+	timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (!isOpen.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	do {
+		size_t piece = length < CAPTURE_MAX_PAYLOAD ? length : CAPTURE_MAX_PAYLOAD;
+		isComplete = append(direction, timestamp, data, piece) && isComplete;
+		data += piece;
+		length -= piece;
+	} while (length > 0);
+	return isComplete;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	append
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool append(CaptureDirection direction, uint64_t timestamp, const char * data, size_t length)
+--					CaptureDirection direction:	which way the bytes crossed the port
+--					uint64_t timestamp:			ns since open
+--					const char * data:			the payload
+--					size_t length:				at most CAPTURE_MAX_PAYLOAD bytes
+--
+-- RETURNS:		bool - false if the record was dropped
+--
+-- NOTES:
+-- Called with the lock held. A full buffer is handed to the capture thread; if it still has the other one, the
+-- record is dropped.
+----------------------------------------------------------------------------------------------------------------------*/
+bool CaptureWriter::append(CaptureDirection direction, uint64_t timestamp, const char * data, size_t length) {
+	CaptureRecord record;
+	size_t needed = CAPTURE_RECORD_SIZE + length;
+
+	if (fill[filling] + needed > CAPTURE_BUFFER_SIZE) {
+		if (pending >= 0) {
+			stats.droppedRecords++;
+			stats.droppedBytes += length;
+			return false;
+		}
+		pending = filling;
+		filling ^= 1;
+		fill[filling] = 0;
+		wake.notify_one();
+	}
+	record.timestamp = timestamp;
+	record.length = (uint32_t)length;
+	record.direction = direction;
+	encodeRecordHeader(buffers[filling] + fill[filling], record);
+	memcpy(buffers[filling] + fill[filling] + CAPTURE_RECORD_SIZE, data, length);
+	fill[filling] += needed;
+	stats.records++;
+	stats.bytesCaptured += length;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The capture thread. Writes each buffer handed over, and takes the filling one itself when it has sat for
+-- CAPTURE_FLUSH_INTERVAL or the capture is closing. The lock is not held during the write.
+----------------------------------------------------------------------------------------------------------------------*/
+void CaptureWriter::run() {
+	std::unique_lock<std::mutex> guard(lock);
+
+	for (;;) {
+		if (pending < 0 && !isStopping) {
+			wake.wait_for(guard, CAPTURE_FLUSH_INTERVAL, [this] { return pending >= 0 || isStopping; });
+		}
+		if (pending < 0) {
+			if (fill[filling] == 0) {
+				if (isStopping) {
+					break;
+				}
+				continue;
+			}
+			pending = filling;
+			filling ^= 1;
+			fill[filling] = 0;
+		}
+
+		int index = pending;
+		size_t size = fill[index];
+		guard.unlock();
+		size_t written = fwrite(buffers[index], 1, size, file);
+		guard.lock();
+
+		if (written != size) {
+			stats.writeErrors++;
+		}
+		stats.bytesWritten += written;
+		stats.buffersWritten++;
+		fill[index] = 0;
+		pending = -1;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	CaptureStats getStats(void) const
+--
+-- RETURNS:		CaptureStats - the counts for the capture open now, or the last one closed
+----------------------------------------------------------------------------------------------------------------------*/
+CaptureStats CaptureWriter::getStats() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return stats;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "CaptureFormat.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		CaptureWriter.h -	Records a session's traffic to a capture file from a background thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path, const std::string & portName)
+--					void close(void)
+--					bool record(CaptureDirection direction, const char * data, size_t length)
+--					bool isCapturing(void) const
+--					const std::string & getPath(void) const
+--					CaptureStats getStats(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- record is called on the reader or I/O thread for each received chunk and on the writer thread for each batch
+-- sent. It stamps the chunk, copies it into the filling buffer under a short lock and returns; it never touches the
+-- file. There are two CAPTURE_BUFFER_SIZE buffers, aligned to CAPTURE_WRITE_ALIGN. When the filling one is full it is
+-- handed to the capture thread, which writes it in one call while the other fills. A partly filled buffer is also
+-- handed over after CAPTURE_FLUSH_INTERVAL, so a slow line still reaches the disk promptly. If the disk falls a whole
+-- buffer behind, chunks are dropped and counted rather than making the port wait.
+--
+-- The writer can be opened and closed while the pipeline feeding it runs; record does nothing while it is closed.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t CAPTURE_BUFFER_SIZE = 1 << 20;
+constexpr size_t CAPTURE_WRITE_ALIGN = 4096;
+constexpr std::chrono::milliseconds CAPTURE_FLUSH_INTERVAL{ 250 };
+
+struct CaptureStats {
+	uint64_t records = 0;
+	uint64_t bytesCaptured = 0;		// payload bytes recorded
+	uint64_t bytesWritten = 0;		// file bytes written, headers included
+	uint64_t buffersWritten = 0;
+	uint64_t droppedRecords = 0;
+	uint64_t droppedBytes = 0;
+	uint64_t writeErrors = 0;
+};
+
+class CaptureWriter {
+public:
+	typedef std::chrono::steady_clock Clock;
+private:
+	mutable std::mutex lock;
+	std::condition_variable wake;
+	std::unique_ptr<char[]> storage;
+	char * buffers[2] = {};
+	size_t fill[2] = {};
+	int filling = 0;
+	int pending = -1;					// the buffer handed to the capture thread, or -1
+	bool isStopping = false;
+	std::atomic<bool> isOpen{ false };
+
+	FILE * file = nullptr;
+	std::string path;
+	std::thread worker;
+	Clock::time_point start;
+	CaptureStats stats;
+
+	void run();
+	bool append(CaptureDirection direction, uint64_t timestamp, const char * data, size_t length);
+public:
+	CaptureWriter() {};
+	~CaptureWriter() { close(); };
+	CaptureWriter(const CaptureWriter &) = delete;
+	CaptureWriter & operator=(const CaptureWriter &) = delete;
+
+	bool open(const std::string & capturePath, const std::string & portName);
+	void close();
+	bool record(CaptureDirection direction, const char * data, size_t length);
+	bool isCapturing() const { return isOpen.load(std::memory_order_relaxed); };
+	const std::string & getPath() const { return path; };
+	CaptureStats getStats() const;
+};
@@ -0,0 +1,302 @@
+#define STRICT
+
+#include <windows.h>
+#include "CommReader.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		CommReader.cpp -	An event-driven receive engine that drains the COM port input queue in chunks.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL attach(HANDLE handle, HANDLE cancel)
+--					VOID detach(void)
+--					BOOL read(char * buffer, DWORD capacity, DWORD timeout, LPDWORD bytesRead)
+--					BOOL drainInputQueue(char * buffer, DWORD capacity, LPDWORD bytesRead)
+--					VOID recordLineStatus(LinkTelemetry * telemetry, DWORD errors, const COMSTAT & status)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Line errors are counted instead of being thrown away
+--					Oct 17, 2026 - Waits also end on the port's cancel event
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The previous receive loop issued a one byte ReadFile and polled GetOverlappedResult without waiting, which kept a
+-- core busy even when the line was idle. This engine blocks on the comm event instead and only touches the driver
+-- again once there is data to collect.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	attach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Takes the port's cancel event; creates the wait events only the first time
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL attach(HANDLE handle, HANDLE cancel)
+--					HANDLE handle:	an open, overlapped COM port handle
+--					HANDLE cancel:	a manual-reset event that stops read when set, or NULL for none
+--
+-- RETURNS:		BOOL - false if the events or the port could not be set up
+--
+-- NOTES:
+-- Call this function before the first call to read. The read timeouts are set so that
+-- ReadFile returns immediately with whatever the driver holds, since the wait is done by WaitCommEvent.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL CommReader::attach(HANDLE handle, HANDLE cancel) {
+	COMMTIMEOUTS timeouts = { MAXDWORD, 0, 0, 0, 0 };
+	HANDLE waitEvent = overlapWait.hEvent ? overlapWait.hEvent : CreateEvent(NULL, TRUE, FALSE, NULL);
+	HANDLE readEvent = overlapRead.hEvent ? overlapRead.hEvent : CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	commHandle = handle;
+	cancelEvent = cancel;
+	isWaitPending = false;
+	stats = RxStats();
+
+	overlapWait = {};
+	overlapRead = {};
+	overlapWait.hEvent = waitEvent;
+	overlapRead.hEvent = readEvent;
+	if (!overlapWait.hEvent || !overlapRead.hEvent) {
+		detach();
+		return false;
+	}
+
+	if (!SetCommTimeouts(commHandle, &timeouts) || !SetCommMask(commHandle, EV_RXCHAR | EV_ERR)) {
+		detach();
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	detach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Keeps the wait events for the next attach
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID detach(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function once the reading thread has stopped reading. Clearing the event mask completes any
+-- WaitCommEvent that is still pending so its OVERLAPPED can be reused; one cancelled with CancelIoEx has already
+-- completed.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID CommReader::detach() {
+	DWORD unused;
+
+	if (isWaitPending) {
+		SetCommMask(commHandle, 0);
+		if (WaitForSingleObject(overlapWait.hEvent, RX_WAIT_TIMEOUT) == WAIT_OBJECT_0) {
+			GetOverlappedResult(commHandle, &overlapWait, &unused, FALSE);
+		}
+		isWaitPending = false;
+	}
+	commHandle = INVALID_HANDLE_VALUE;
+	cancelEvent = NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	~CommReader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	~CommReader(void)
+--
+-- NOTES:
+-- Detaches if still attached, then releases the wait events.
+----------------------------------------------------------------------------------------------------------------------*/
+CommReader::~CommReader() {
+	if (commHandle != INVALID_HANDLE_VALUE) {
+		detach();
+	}
+	if (overlapWait.hEvent) {
+		CloseHandle(overlapWait.hEvent);
+	}
+	if (overlapRead.hEvent) {
+		CloseHandle(overlapRead.hEvent);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	read
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Returns false as soon as the cancel event is set
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL read(char * buffer, DWORD capacity, DWORD timeout, LPDWORD bytesRead)
+--					char * buffer:		the buffer that receives the chunk
+--					DWORD capacity:		size of the buffer in bytes
+--					DWORD timeout:		ms to wait for data before giving up
+--					LPDWORD bytesRead:	set to the number of bytes placed in the buffer, 0 on timeout
+--
+-- RETURNS:		BOOL - false if the port failed or was cancelled, and reading should stop
+--
+-- NOTES:
+-- Call this function in the read loop. It returns as soon as at least one byte is available, carrying every byte
+-- the driver had queued up to the buffer capacity. A WaitCommEvent that times out is left pending and picked up by
+-- the next call rather than being reissued.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL CommReader::read(char * buffer, DWORD capacity, DWORD timeout, LPDWORD bytesRead) {
+	HANDLE waits[2] = { overlapWait.hEvent, cancelEvent };
+	DWORD unused, waited;
+
+	*bytesRead = 0;
+
+	// Bytes may have arrived after the last drain without raising a new event
+	if (!isWaitPending) {
+		if (!drainInputQueue(buffer, capacity, bytesRead)) {
+			return false;
+		}
+		if (*bytesRead) {
+			return true;
+		}
+
+		commEvent = 0;
+		ResetEvent(overlapWait.hEvent);
+		stats.waitCalls++;
+		if (WaitCommEvent(commHandle, &commEvent, &overlapWait)) {
+			return drainInputQueue(buffer, capacity, bytesRead);
+		}
+		if (GetLastError() != ERROR_IO_PENDING) {
+			return false;
+		}
+		isWaitPending = true;
+	}
+
+	waited = WaitForMultipleObjects(cancelEvent ? 2 : 1, waits, FALSE, timeout);
+	if (waited == WAIT_OBJECT_0 + 1) {
+		return false;
+	}
+	if (waited != WAIT_OBJECT_0) {
+		return true;
+	}
+	isWaitPending = false;
+	if (!GetOverlappedResult(commHandle, &overlapWait, &unused, FALSE)) {
+		return false;
+	}
+	return drainInputQueue(buffer, capacity, bytesRead);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	drainInputQueue
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Records the line errors and queue depth ClearCommError reports
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL drainInputQueue(char * buffer, DWORD capacity, LPDWORD bytesRead)
+--					char * buffer:		the buffer that receives the chunk
+--					DWORD capacity:		size of the buffer in bytes
+--					LPDWORD bytesRead:	set to the number of bytes placed in the buffer
+--
+-- RETURNS:		BOOL - false if the driver could not be queried or read
+--
+-- NOTES:
+-- Call this function to collect everything reported in COMSTAT.cbInQue with one ReadFile. ClearCommError also
+-- releases the port if a line error has suspended it.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL CommReader::drainInputQueue(char * buffer, DWORD capacity, LPDWORD bytesRead) {
+	COMSTAT cs;
+	DWORD errors, toRead;
+
+	*bytesRead = 0;
+	stats.errorCalls++;
+	if (!ClearCommError(commHandle, &errors, &cs)) {
+		return false;
+	}
+	recordLineStatus(telemetry, errors, cs);
+	if (cs.cbInQue == 0) {
+		return true;
+	}
+
+	toRead = cs.cbInQue < capacity ? cs.cbInQue : capacity;
+	ResetEvent(overlapRead.hEvent);
+	stats.readCalls++;
+	if (!ReadFile(commHandle, buffer, toRead, bytesRead, &overlapRead)) {
+		if (GetLastError() != ERROR_IO_PENDING ||
+			!GetOverlappedResult(commHandle, &overlapRead, bytesRead, TRUE)) {
+			return false;
+		}
+	}
+	stats.bytesReceived += *bytesRead;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	recordLineStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID recordLineStatus(LinkTelemetry * telemetry, DWORD errors, const COMSTAT & status)
+--					LinkTelemetry * telemetry:	where to count them, or NULL to drop them
+--					DWORD errors:				the error mask from ClearCommError
+--					const COMSTAT & status:		the queue depths from the same call
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function after every ClearCommError on the port, since each call clears the errors it reports. A bit
+-- in the mask stands for at least one error of its kind since the last call, so it is counted once.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID CommReader::recordLineStatus(LinkTelemetry * telemetry, DWORD errors, const COMSTAT & status) {
+	if (telemetry == NULL) {
+		return;
+	}
+	if (errors != 0) {
+		if (errors & CE_OVERRUN) {
+			telemetry->countLineError(LineError::Overrun);
+		}
+		if (errors & CE_RXOVER) {
+			telemetry->countLineError(LineError::InputOverflow);
+		}
+		if (errors & CE_FRAME) {
+			telemetry->countLineError(LineError::Framing);
+		}
+		if (errors & CE_RXPARITY) {
+			telemetry->countLineError(LineError::Parity);
+		}
+		if (errors & CE_BREAK) {
+			telemetry->countLineError(LineError::Break);
+		}
+	}
+	telemetry->noteInputQueue(status.cbInQue);
+	telemetry->noteOutputQueue(status.cbOutQue);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <windows.h>
+#include "LinkTelemetry.h"
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		CommReader.h -	An event-driven receive engine that drains the COM port input queue in chunks.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL attach(HANDLE handle, HANDLE cancel)
+--					VOID detach(void)
+--					BOOL read(char * buffer, DWORD capacity, DWORD timeout, LPDWORD bytesRead)
+--					const RxStats & getStats(void) const
+--					VOID setTelemetry(LinkTelemetry * telemetry)
+--					VOID recordLineStatus(LinkTelemetry * telemetry, DWORD errors, const COMSTAT & status)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - RX_WAIT_TIMEOUT moved to SerialTransport.h
+--					Oct 17, 2026 - Line errors and input queue depths go to the port's LinkTelemetry
+--					Oct 17, 2026 - A cancel event ends a wait at once; the wait events are kept across attaches
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The reader sleeps in WaitCommEvent until the driver reports EV_RXCHAR, then reads everything the driver has queued
+-- (COMSTAT.cbInQue) with a single ReadFile call. The port must be opened with FILE_FLAG_OVERLAPPED. Only one thread
+-- may call read.
+--
+-- Given a cancel event, read also wakes when it is signalled and reports the port as stopped, so a disconnect does
+-- not wait out the read timeout. The two OVERLAPPED events are created by the first attach and kept until the
+-- reader is destroyed, so reattaching to a reopened port creates nothing.
+--
+-- The error mask and COMSTAT from each ClearCommError are recorded in the LinkTelemetry, when one is set, by
+-- recordLineStatus, which Win32Transport also uses for its own ClearCommError calls.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct RxStats {
+	ULONGLONG waitCalls = 0;		// WaitCommEvent calls issued
+	ULONGLONG readCalls = 0;		// ReadFile calls issued
+	ULONGLONG errorCalls = 0;		// ClearCommError calls issued
+	ULONGLONG bytesReceived = 0;
+};
+
+class CommReader {
+private:
+	HANDLE commHandle = INVALID_HANDLE_VALUE;
+	OVERLAPPED overlapWait = {};
+	OVERLAPPED overlapRead = {};
+	HANDLE cancelEvent = NULL;			// not owned
+	DWORD commEvent = 0;
+	BOOL isWaitPending = false;
+	RxStats stats;
+	LinkTelemetry * telemetry = nullptr;
+
+	BOOL drainInputQueue(char * buffer, DWORD capacity, LPDWORD bytesRead);
+public:
+	CommReader() {};
+	~CommReader();
+	CommReader(const CommReader &) = delete;
+	CommReader & operator=(const CommReader &) = delete;
+
+	BOOL attach(HANDLE handle, HANDLE cancel = NULL);
+	VOID detach();
+	BOOL read(char * buffer, DWORD capacity, DWORD timeout, LPDWORD bytesRead);
+	const RxStats & getStats() const { return stats; };
+	VOID setTelemetry(LinkTelemetry * portTelemetry) { telemetry = portTelemetry; };
+
+	static VOID recordLineStatus(LinkTelemetry * telemetry, DWORD errors, const COMSTAT & status);
+};
@@ -0,0 +1,143 @@
+#include "Crc.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Crc.cpp -	The CRC-16 and CRC-32 checks used by the file transfer protocols.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					uint16_t crc16(const char * data, size_t length, uint16_t crc)
+--					uint32_t crc32(const char * data, size_t length, uint32_t crc)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Table k holds the CRC of a byte followed by k zero bytes, so eight bytes fold into the CRC with eight independent
+-- lookups instead of eight dependent ones. Bytes are loaded one at a time, so the result does not depend on the
+-- machine's byte order.
+----------------------------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+struct Crc16Tables {
+	uint16_t table[8][256];
+
+	Crc16Tables() {
+		for (int i = 0; i < 256; i++) {
+			uint16_t crc = (uint16_t)(i << 8);
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (uint16_t)(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+			}
+			table[0][i] = crc;
+		}
+		for (int k = 1; k < 8; k++) {
+			for (int i = 0; i < 256; i++) {
+				uint16_t previous = table[k - 1][i];
+				table[k][i] = (uint16_t)((previous << 8) ^ table[0][previous >> 8]);
+			}
+		}
+	}
+};
+
+struct Crc32Tables {
+	uint32_t table[8][256];
+
+	Crc32Tables() {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+			}
+			table[0][i] = crc;
+		}
+		for (int k = 1; k < 8; k++) {
+			for (int i = 0; i < 256; i++) {
+				uint32_t previous = table[k - 1][i];
+				table[k][i] = (previous >> 8) ^ table[0][previous & 0xFF];
+			}
+		}
+	}
+};
+
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	crc16
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint16_t crc16(const char * data, size_t length, uint16_t crc)
+--					const char * data:	the bytes to check
+--					size_t length:		bytes in data
+--					uint16_t crc:		the CRC of the bytes before data, or 0
+--
+-- RETURNS:		uint16_t - the CRC-16/XMODEM of everything so far
+----------------------------------------------------------------------------------------------------------------------*/
+uint16_t crc16(const char * data, size_t length, uint16_t crc) {
+	static const Crc16Tables tables;
+	const uint8_t * bytes = (const uint8_t *)data;
+	const uint16_t (*t)[256] = tables.table;
+
+	while (length >= 8) {
+		uint16_t high = (uint16_t)(bytes[0] ^ (crc >> 8));
+		uint16_t low = (uint16_t)(bytes[1] ^ (crc & 0xFF));
+		crc = (uint16_t)(t[7][high] ^ t[6][low] ^ t[5][bytes[2]] ^ t[4][bytes[3]] ^
+			t[3][bytes[4]] ^ t[2][bytes[5]] ^ t[1][bytes[6]] ^ t[0][bytes[7]]);
+		bytes += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = (uint16_t)((crc << 8) ^ t[0][(crc >> 8) ^ *bytes++]);
+	}
+	return crc;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	crc32
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint32_t crc32(const char * data, size_t length, uint32_t crc)
+--					const char * data:	the bytes to check
+--					size_t length:		bytes in data
+--					uint32_t crc:		the CRC of the bytes before data, or 0
+--
+-- RETURNS:		uint32_t - the CRC-32 of everything so far
+----------------------------------------------------------------------------------------------------------------------*/
+uint32_t crc32(const char * data, size_t length, uint32_t crc) {
+	static const Crc32Tables tables;
+	const uint8_t * bytes = (const uint8_t *)data;
+	const uint32_t (*t)[256] = tables.table;
+
+	crc = ~crc;
+	while (length >= 8) {
+		uint32_t one = crc ^ (bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24);
+		crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+			t[3][bytes[4]] ^ t[2][bytes[5]] ^ t[1][bytes[6]] ^ t[0][bytes[7]];
+		bytes += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *bytes++) & 0xFF];
+	}
+	return ~crc;
+}
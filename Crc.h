@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Crc.h -	The CRC-16 and CRC-32 checks used by the file transfer protocols.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					uint16_t crc16(const char * data, size_t length, uint16_t crc)
+--					uint32_t crc32(const char * data, size_t length, uint32_t crc)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- crc16 is CRC-16/XMODEM (polynomial 0x1021, no reflection, starting at 0), used by XMODEM, YMODEM and ZMODEM's
+-- 16-bit frames. crc32 is the IEEE 802.3 CRC that ZMODEM, zlib and Ethernet use; like zlib's it takes and returns
+-- the finished value, so a CRC can be carried across calls by passing the previous result, starting from 0.
+--
+-- Both are computed eight bytes at a time from eight 256-entry tables (slicing-by-8), built once on first use. The
+-- CRC32 instruction of SSE4.2 and ARMv8 computes CRC-32C, a different polynomial, so it cannot stand in for either.
+----------------------------------------------------------------------------------------------------------------------*/
+
+uint16_t crc16(const char * data, size_t length, uint16_t crc = 0);
+uint32_t crc32(const char * data, size_t length, uint32_t crc = 0);
@@ -1,10 +1,12 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include <windows.h>
+#include <commctrl.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include "DisplayService.h"
-#include "WINDOW.h"
+
+#pragma comment(lib, "comctl32.lib")
 
 /*------------------------------------------------------------------------------------------------------------------
 -- SOURCE FILE:		DisplayService.cpp -	A service class that handles display events from the application.
@@ -13,12 +15,33 @@
 --
 -- FUNCTIONS:
 --					VOID displayMessageBox(const char * content)
---					VOID drawInput(char input)
+--					VOID beginReceive(int pane, size_t backlog)
+--					BOOL drawInput(int pane, const char * input, DWORD length)
+--					VOID endReceive(int pane, BOOL isCutShort)
+--					VOID showPane(int pane)
+--					VOID present(void)
+--					VOID paint(void)
+--					VOID resize(void)
+--					VOID scrollView(int lines)
+--					VOID handleScroll(WPARAM wParam)
+--					VOID showStatus(LPCWSTR text)
+--					VOID hideStatus(void)
+--					TerminalPane & getPane(int pane)
+--					VOID loadMetrics(void)
+--					VOID invalidateDirty(void)
+--					VOID updateScrollBar(void)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Draws received chunks with one device context
+--					Oct 17, 2026 - Keeps a screen model and repaints only dirty cells from WM_PAINT
+--					Oct 17, 2026 - Keeps a scrollback history that can be viewed with the scroll bar or wheel
+--					Oct 17, 2026 - Paints through a GdiRenderer; the paint logic itself is renderView in Renderer.cpp
+--					Oct 17, 2026 - Received text goes through a TerminalEmulator
+--					Oct 17, 2026 - Received data is presented in FramePacer frames
+--					Oct 17, 2026 - Keeps a TerminalPane per port session and shows one at a time
+--					Oct 17, 2026 - Shows a status bar on request, shrinking the grid to fit above it
 --
 -- DESIGNER:		Henry Ho
 --
@@ -29,43 +52,411 @@
 -- such as dialogs, message boxes, and drawing.
 ----------------------------------------------------------------------------------------------------------------------*/
 
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginReceive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Takes the pane the batch is for
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID beginReceive(int pane, size_t backlog)
+--					int pane:		the session's pane
+--					size_t backlog:	received bytes waiting to be drawn
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before a batch of drawInput calls; the pacer picks smooth or jump scrolling for the batch.
+-- A hidden pane's batch is only timed.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::beginReceive(int pane, size_t backlog) {
+	if (pane == activePane) {
+		pacer.beginFrame(backlog, FramePacer::Clock::now());
+	}
+	else {
+		hiddenStart = FramePacer::Clock::now();
+	}
+}
+
 /*------------------------------------------------------------------------------------------------------------------
 -- FUNCTION:	drawInput
 --
 -- DATE:		Sept 28, 2019
 --
+-- REVISIONS:	Oct 17, 2026 - Draws a whole chunk with one device context and one metrics lookup
+--				Oct 17, 2026 - Updates the screen model and invalidates the changed cells instead of drawing
+--				Oct 17, 2026 - Holds a scrolled-back view in place while new output arrives
+--				Oct 17, 2026 - Interprets control characters and escape sequences through the TerminalEmulator
+--				Oct 17, 2026 - Presents the chunk at once in smooth mode; reports when the frame budget is spent
+--				Oct 17, 2026 - Takes the pane to draw on; a hidden pane only has its model updated
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL drawInput(int pane, const char * input, DWORD length)
+--					int pane:			the session's pane
+--					const char * input:	the input to draw on the screen
+--					DWORD length:		number of characters in input
+--
+-- RETURNS:		BOOL - false once the frame budget is spent and the rest should wait for the next batch
+--
+-- NOTES:
+-- Call this function from the window thread, between beginReceive and endReceive, to put received characters on the
+-- screen. In smooth mode they are presented before it returns; in jump mode they appear when the batch ends. A
+-- sequence split across two calls is completed by the second.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL DisplayService::drawInput(int pane, const char * input, DWORD length) {
+	TerminalPane & target = getPane(pane);
+	uint64_t scrolled;
+
+	loadMetrics();
+	target.terminal.receive(input, length);
+
+	// Keep a scrolled-back view on the same lines while new output pushes history up beneath it
+	scrolled = target.screen.getScrollCount() - target.seenScrollCount;
+	target.seenScrollCount += scrolled;
+	if (target.viewOffset > 0) {
+		target.viewOffset = target.viewOffset + scrolled < target.history.size() ?
+			target.viewOffset + (size_t)scrolled : target.history.size();
+	}
+	if (pane != activePane) {
+		return FramePacer::Clock::now() - hiddenStart < FRAME_BUDGET;
+	}
+	invalidateDirty();
+	if (pacer.chunkApplied()) {
+		present();
+	}
+	return !pacer.isBudgetSpent(FramePacer::Clock::now());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endReceive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Takes the pane the batch was for
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID endReceive(int pane, BOOL isCutShort)
+--					int pane:			the session's pane
+--					BOOL isCutShort:	true if drawing stopped at the frame budget with data still waiting
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function after a batch of drawInput calls. Presents whatever the batch drew and has not yet shown.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::endReceive(int pane, BOOL isCutShort) {
+	if (pane == activePane && pacer.endFrame(isCutShort != FALSE)) {
+		present();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	showPane
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID showPane(int pane)
+--					int pane:	the session's pane
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to switch the window to another session. The whole window is repainted from the pane's model,
+-- which has kept up with its port while hidden.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::showPane(int pane) {
+	getPane(pane);
+	if (pane == activePane) {
+		return;
+	}
+	activePane = pane;
+	InvalidateRect(*windowHandle, NULL, TRUE);
+	updateScrollBar();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	present
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID present(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Paints the invalidated cells now, through WM_PAINT, instead of when the message queue next runs dry.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::present() {
+	UpdateWindow(*windowHandle);
+	pacer.presented(FramePacer::Clock::now());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	paint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Draws history lines while the view is scrolled back
+--				Oct 17, 2026 - Draws through the GdiRenderer with renderView
+--				Oct 17, 2026 - Draws the shown pane
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID paint(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function for WM_PAINT. Cells inside the update region are marked dirty so uncovered areas are redrawn,
+-- then each dirty run is drawn with one ExtTextOut that also fills its background.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::paint() {
+	TerminalPane & pane = *panes[activePane];
+
+	renderView(renderer, pane.screen, pane.history, pane.viewOffset);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	resize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Resizes every pane
+--				Oct 17, 2026 - Moves the status bar and leaves room for it
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID resize(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function for WM_SIZE. The grid is resized to the number of whole cells that fit the client area above
+-- the status bar, if one is shown.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::resize() {
+	RECT client;
+	RECT bar;
+
+	if (statusBar != NULL) {
+		// The bar places itself along the bottom of its parent
+		SendMessage(statusBar, WM_SIZE, 0, 0);
+	}
+	if (!renderer.getHasMetrics()) {
+		return;
+	}
+	GetClientRect(*windowHandle, &client);
+	if (statusBar != NULL && GetWindowRect(statusBar, &bar)) {
+		client.bottom = client.bottom > bar.bottom - bar.top ? client.bottom - (bar.bottom - bar.top) : 0;
+	}
+	for (std::unique_ptr<TerminalPane> & pane : panes) {
+		pane->screen.resize(client.right / renderer.getCellWidth(), client.bottom / renderer.getCellHeight());
+	}
+	InvalidateRect(*windowHandle, NULL, TRUE);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scrollView
+--
+-- DATE:		Oct 17, 2026
+--
 -- REVISIONS:	(N/A)
 --
 -- DESIGNER:	Henry Ho
 --
 -- PROGRAMMER:	Henry Ho
 --
--- INTERFACE:	VOID drawInput(char input)
---					char input:	the input to draw on the screen
+-- INTERFACE:	VOID scrollView(int lines)
+--					int lines:	lines to move back into history; negative moves toward the live screen
 --
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to draw a character in the screen
+-- Call this function for the mouse wheel and scroll bar. The view stops at the oldest line kept and at the live
+-- screen.
 ----------------------------------------------------------------------------------------------------------------------*/
-VOID DisplayService::drawInput(char input) {
-	HDC deviceContext = GetDC(*windowHandle);// get device context	
-	TEXTMETRIC textMetric;
-	char str[255];
-	GetTextMetrics(deviceContext, &textMetric);
-	sprintf(str, "%c", input); // convert char to str
-	TextOut(deviceContext, textMetric.tmMaxCharWidth * xCoord, yCoord, (LPCWSTR) str, strlen(str)); // output character
+VOID DisplayService::scrollView(int lines) {
+	TerminalPane & pane = *panes[activePane];
+	size_t newOffset;
 
-	// Resets cursor
-	if ((xCoord + 1) * textMetric.tmMaxCharWidth >= WINDOW_WIDTH) {
-		yCoord = yCoord + textMetric.tmHeight + textMetric.tmExternalLeading;
-		xCoord = 0;
+	if (lines < 0) {
+		newOffset = (size_t)-lines < pane.viewOffset ? pane.viewOffset + lines : 0;
 	}
 	else {
-		xCoord++; // increment the screen x-coordinate
+		newOffset = pane.viewOffset + lines < pane.history.size() ? pane.viewOffset + lines : pane.history.size();
+	}
+	if (newOffset == pane.viewOffset) {
+		return;
 	}
+	pane.viewOffset = newOffset;
+	InvalidateRect(*windowHandle, NULL, FALSE);
+	updateScrollBar();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	handleScroll
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID handleScroll(WPARAM wParam)
+--					WPARAM wParam:	the WM_VSCROLL parameter
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function for WM_VSCROLL. The thumb position is read with SIF_TRACKPOS since the 16 bit position in
+-- wParam cannot address a long history.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::handleScroll(WPARAM wParam) {
+	TerminalPane & pane = *panes[activePane];
+	SCROLLINFO info;
+
+	switch (LOWORD(wParam)) {
+	case SB_LINEUP:
+		scrollView(1);
+		break;
+	case SB_LINEDOWN:
+		scrollView(-1);
+		break;
+	case SB_PAGEUP:
+		scrollView(pane.screen.getRows());
+		break;
+	case SB_PAGEDOWN:
+		scrollView(-pane.screen.getRows());
+		break;
+	case SB_TOP:
+		scrollView((int)pane.history.size());
+		break;
+	case SB_BOTTOM:
+		scrollView(-(int)pane.viewOffset);
+		break;
+	case SB_THUMBTRACK:
+	case SB_THUMBPOSITION:
+		info.cbSize = sizeof(SCROLLINFO);
+		info.fMask = SIF_TRACKPOS;
+		GetScrollInfo(*windowHandle, SB_VERT, &info);
+		scrollView((int)pane.history.size() - info.nTrackPos - (int)pane.viewOffset);
+		break;
+	default:
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getPane
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TerminalPane & getPane(int pane)
+--					int pane:	index of the pane, from 0
+--
+-- RETURNS:		TerminalPane & - the pane, created at the window's grid size if it is new
+----------------------------------------------------------------------------------------------------------------------*/
+TerminalPane & DisplayService::getPane(int pane) {
+	while ((int)panes.size() <= pane) {
+		panes.emplace_back(new TerminalPane());
+		panes.back()->screen.resize(panes[0]->screen.getColumns(), panes[0]->screen.getRows());
+	}
+	return *panes[pane];
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	loadMetrics
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID loadMetrics(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Measures the fixed-pitch font the first time it is needed and sizes the grid to the window. Every later call
+-- returns immediately, so there is no GetTextMetrics call per character or per paint.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::loadMetrics() {
+	if (renderer.loadMetrics()) {
+		resize();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	invalidateDirty
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Invalidates the whole view when scrolled back over live rows
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID invalidateDirty(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Adds the bounding rectangle of the dirty cells to the window's update region without erasing it. While the view
+-- is scrolled back the live rows sit lower in the window, so the whole window is invalidated if any are visible.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::invalidateDirty() {
+	TerminalPane & pane = *panes[activePane];
+	CellRect area;
 
-	ReleaseDC(*windowHandle, deviceContext); // Release device context
+	updateScrollBar();
+	if (!pane.screen.getDirtyBounds(&area.top, &area.left, &area.bottom, &area.right)) {
+		return;
+	}
+	if (pane.viewOffset > 0) {
+		if (pane.viewOffset < (size_t)pane.screen.getRows()) {
+			renderer.invalidateCells(NULL);
+		}
+		return;
+	}
+	renderer.invalidateCells(&area);
 }
 
 /*------------------------------------------------------------------------------------------------------------------
@@ -88,4 +479,98 @@ VOID DisplayService::drawInput(char input) {
 ----------------------------------------------------------------------------------------------------------------------*/
 HWND * DisplayService::getWindowHandle() {
 	return windowHandle;
-}
\ No newline at end of file
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	updateScrollBar
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID updateScrollBar(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The scroll range covers the history followed by the live screen, one unit per line.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::updateScrollBar() {
+	TerminalPane & pane = *panes[activePane];
+	SCROLLINFO info;
+
+	info.cbSize = sizeof(SCROLLINFO);
+	info.fMask = SIF_RANGE | SIF_PAGE | SIF_POS | SIF_DISABLENOSCROLL;
+	info.nMin = 0;
+	info.nMax = (int)pane.history.size() + pane.screen.getRows() - 1;
+	info.nPage = (UINT)pane.screen.getRows();
+	info.nPos = (int)(pane.history.size() - pane.viewOffset);
+	SetScrollInfo(*windowHandle, SB_VERT, &info, TRUE);
+}
+
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	showStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID showStatus(LPCWSTR text)
+--					LPCWSTR text:	the line to show
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to show a line of text along the bottom of the window, replacing the line shown before. The
+-- status bar is created the first time, and the grid is resized to make room for it.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::showStatus(LPCWSTR text) {
+	if (statusBar == NULL) {
+		INITCOMMONCONTROLSEX controls = { sizeof(controls), ICC_BAR_CLASSES };
+
+		InitCommonControlsEx(&controls);
+		statusBar = CreateWindowEx(0, STATUSCLASSNAME, NULL, WS_CHILD | WS_VISIBLE, 0, 0, 0, 0,
+			*windowHandle, NULL, (HINSTANCE)GetWindowLongPtr(*windowHandle, GWLP_HINSTANCE), NULL);
+		if (statusBar == NULL) {
+			return;
+		}
+		resize();
+	}
+	SendMessage(statusBar, SB_SETTEXT, 0, (LPARAM)text);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	hideStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID hideStatus(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to remove the status bar and give its rows back to the grid.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID DisplayService::hideStatus() {
+	if (statusBar == NULL) {
+		return;
+	}
+	DestroyWindow(statusBar);
+	statusBar = NULL;
+	resize();
+}
@@ -1,8 +1,16 @@
 #pragma once
 
 #include <windows.h>
+#include <commctrl.h>
 #include <stdlib.h>
+#include <memory>
+#include <vector>
 #include "utils.h"
+#include "ScreenModel.h"
+#include "Scrollback.h"
+#include "GdiRenderer.h"
+#include "TerminalEmulator.h"
+#include "FramePacer.h"
 
 /*------------------------------------------------------------------------------------------------------------------
 -- HEADER FILE:		DisplayService.h -	A service class that handles display events from the application.
@@ -11,12 +19,30 @@
 --
 -- FUNCTIONS:
 --					VOID displayMessageBox(const char * content)
---					VOID drawInput(char input)
+--					VOID beginReceive(int pane, size_t backlog)
+--					BOOL drawInput(int pane, const char * input, DWORD length)
+--					VOID endReceive(int pane, BOOL isCutShort)
+--					VOID showPane(int pane)
+--					VOID present(void)
+--					VOID paint(void)
+--					VOID resize(void)
+--					VOID scrollView(int lines)
+--					VOID handleScroll(WPARAM wParam)
+--					VOID showStatus(LPCWSTR text)
+--					VOID hideStatus(void)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Draws received chunks with one device context
+--					Oct 17, 2026 - Keeps a screen model and repaints only dirty cells from WM_PAINT
+--					Oct 17, 2026 - Keeps a scrollback history that can be viewed with the scroll bar or wheel
+--					Oct 17, 2026 - Paints through a GdiRenderer
+--					Oct 17, 2026 - Interprets VT100/ANSI escape sequences in received text
+--					Oct 17, 2026 - Decodes received text as UTF-8; message boxes no longer leak their text
+--					Oct 17, 2026 - Paces presents with a FramePacer, jump scrolling when output outruns the screen
+--					Oct 17, 2026 - One TerminalPane per port session; only the shown pane is drawn
+--					Oct 17, 2026 - Can show a status bar under the terminal
 --
 -- DESIGNER:		Henry Ho
 --
@@ -25,19 +51,64 @@
 -- NOTES:
 -- This service class can be used to display any visual out put in the application. It should be used for events
 -- such as dialogs, message boxes, and drawing.
+--
+-- Received text is run through a TerminalEmulator into a ScreenModel and the changed area is invalidated; the
+-- actual drawing happens in paint, called for WM_PAINT, so the screen survives being covered and resized. Rows
+-- scrolled off the top go into a bounded Scrollback; while the view is scrolled back the window shows history lines
+-- above the live screen.
+-- Drawing goes through renderView and a GdiRenderer, so the same frames can be drawn off screen by a HeadlessRenderer.
+-- Each drain of received data is a FramePacer frame: chunks are presented as they arrive while the screen keeps up,
+-- and only the end of each frame is presented once it falls behind. Presents are synchronous (UpdateWindow) because
+-- a busy stream keeps posting WM_RX_DATA, and posted messages would otherwise starve WM_PAINT.
+--
+-- Each port session has its own TerminalPane: screen, scrollback, emulator state and view position. Every pane
+-- keeps taking its port's output, but only the shown one is invalidated and paced; a hidden pane's batch is simply
+-- cut off at FRAME_BUDGET. Switching panes repaints the whole window.
+--
+-- The status bar is a common control child window, created when first shown and destroyed when hidden. The grid
+-- loses the rows it covers, and the main window clips its children so painting the grid leaves the bar alone.
 ----------------------------------------------------------------------------------------------------------------------*/
+constexpr size_t SCROLLBACK_MAX_LINES = 100000;
+constexpr size_t SCROLLBACK_MAX_BYTES = 32 * 1024 * 1024;
+constexpr int WHEEL_SCROLL_LINES = 3;
+constexpr size_t MESSAGE_BOX_MAX = 256;		// characters, including the terminator
+
+struct TerminalPane {
+	ScreenModel screen{ 80, 24 };
+	Scrollback history{ SCROLLBACK_MAX_LINES, SCROLLBACK_MAX_BYTES };
+	TerminalEmulator terminal{ screen };
+
+	// Lines the view is scrolled back from the live screen, 0 when following new output
+	size_t viewOffset = 0;
+	uint64_t seenScrollCount = 0;
+
+	TerminalPane() { screen.setScrollback(&history); };
+	TerminalPane(const TerminalPane &) = delete;
+	TerminalPane & operator=(const TerminalPane &) = delete;
+};
+
 class DisplayService {
 private:
-	int xCoord = 0;
-	int yCoord = 0;
 	HWND * windowHandle;
+	std::vector<std::unique_ptr<TerminalPane>> panes;	// created as sessions first use them
+	int activePane = 0;
+	FramePacer::TimePoint hiddenStart;					// when the current batch for a hidden pane began
+	HWND statusBar = NULL;								// NULL while no status is shown
+
+	GdiRenderer renderer;
+	FramePacer pacer;
+
+	TerminalPane & getPane(int pane);
+	VOID loadMetrics();
+	VOID invalidateDirty();
+	VOID updateScrollBar();
 public:
 	/*------------------------------------------------------------------------------------------------------------------
 	-- FUNCTION:	displayMessageBox
 	--
 	-- DATE:		Sept 28, 2019
 	--
-	-- REVISIONS:	(N/A)
+	-- REVISIONS:	Oct 17, 2026 - Converts into a stack buffer; the converted text used to be leaked
 	--
 	-- DESIGNER:	Henry Ho
 	--
@@ -52,7 +123,8 @@ public:
 	-- Call this function to display a message box in the application.
 	----------------------------------------------------------------------------------------------------------------------*/
 	static void displayMessageBox(const char * content) {
-		MessageBox(NULL, utils::strToLPCWSTR(content), TEXT(""), MB_OK);
+		wchar_t text[MESSAGE_BOX_MAX];
+		MessageBox(NULL, utils::strToLPCWSTR(content, text, MESSAGE_BOX_MAX), TEXT(""), MB_OK);
 	}
 
 	/*------------------------------------------------------------------------------------------------------------------
@@ -77,7 +149,23 @@ public:
 	static void displayMessageBox(LPCWSTR content) {
 		MessageBox(NULL, content, TEXT(""), MB_OK);
 	}
-	DisplayService(HWND * hwnd) : windowHandle(hwnd) {};
-	VOID drawInput(char input);
+	DisplayService(HWND * hwnd) : windowHandle(hwnd), renderer(hwnd) {
+		panes.emplace_back(new TerminalPane());
+	};
+	DisplayService(const DisplayService &) = delete;
+	DisplayService & operator=(const DisplayService &) = delete;
+	VOID beginReceive(int pane, size_t backlog);
+	BOOL drawInput(int pane, const char * input, DWORD length);
+	VOID endReceive(int pane, BOOL isCutShort);
+	VOID showPane(int pane);
+	int getActivePane() const { return activePane; };
+	VOID present();
+	VOID paint();
+	VOID resize();
+	VOID scrollView(int lines);
+	VOID handleScroll(WPARAM wParam);
+	VOID showStatus(LPCWSTR text);
+	VOID hideStatus();
 	HWND * getWindowHandle();
+	const PacerStats & getPacerStats() const { return pacer.getStats(); };
 };
\ No newline at end of file
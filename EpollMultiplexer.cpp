@@ -0,0 +1,246 @@
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "EpollMultiplexer.h"
+#include "PosixTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		EpollMultiplexer.cpp -	PortMultiplexer that waits on every port with one epoll set on Linux.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool openQueue(void)
+--					void closeQueue(void)
+--					std::unique_ptr<Port> attach(SerialTransport * transport)
+--					bool detach(Port * port)
+--					int wait(Port ** ready, int capacity, uint32_t timeout)
+--					void wake(void)
+--					std::unique_ptr<PortMultiplexer> createPortMultiplexer(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The eventfd is registered with a null data pointer, which is how wait tells it from a port.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openQueue
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openQueue(void)
+--
+-- RETURNS:		bool - false if the epoll set or the eventfd could not be created
+----------------------------------------------------------------------------------------------------------------------*/
+bool EpollMultiplexer::openQueue() {
+	struct epoll_event event = {};
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	event.events = EPOLLIN;
+	event.data.ptr = nullptr;
+	if (epollFd < 0 || wakeFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) != 0) {
+		closeQueue();
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeQueue
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void closeQueue(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void EpollMultiplexer::closeQueue() {
+	if (epollFd >= 0) {
+		::close(epollFd);
+		epollFd = -1;
+	}
+	if (wakeFd >= 0) {
+		::close(wakeFd);
+		wakeFd = -1;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	attach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<Port> attach(SerialTransport * transport)
+--					SerialTransport * transport:	an open PosixTransport
+--
+-- RETURNS:		std::unique_ptr<Port> - the port in the epoll set, or nullptr for another kind of transport
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortMultiplexer::Port> EpollMultiplexer::attach(SerialTransport * transport) {
+	PosixTransport * posix = dynamic_cast<PosixTransport *>(transport);
+	std::unique_ptr<EpollPort> port;
+	struct epoll_event event = {};
+
+	if (posix == nullptr || posix->getDescriptor() < 0) {
+		return nullptr;
+	}
+	port.reset(new EpollPort());
+	port->descriptor = posix->getDescriptor();
+	event.events = EPOLLIN;
+	event.data.ptr = port.get();
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, port->descriptor, &event) != 0) {
+		return nullptr;
+	}
+	return std::unique_ptr<Port>(port.release());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	detach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool detach(Port * port)
+--					Port * port:	a port from attach
+--
+-- RETURNS:		bool - always true; leaving the epoll set takes effect at once
+----------------------------------------------------------------------------------------------------------------------*/
+bool EpollMultiplexer::detach(Port * port) {
+	EpollPort * epollPort = static_cast<EpollPort *>(port);
+
+	if (epollPort->descriptor >= 0) {
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, epollPort->descriptor, NULL);
+		epollPort->descriptor = -1;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wait
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int wait(Port ** ready, int capacity, uint32_t timeout)
+--					Port ** ready:		filled with the ports that were read or failed
+--					int capacity:		entries in ready
+--					uint32_t timeout:	ms to wait, or WAIT_FOREVER
+--
+-- RETURNS:		int - ports put in ready
+--
+-- NOTES:
+-- A ready port is read through its transport with no timeout. A read that finds nothing after all is not reported.
+----------------------------------------------------------------------------------------------------------------------*/
+int EpollMultiplexer::wait(Port ** ready, int capacity, uint32_t timeout) {
+	struct epoll_event events[MULTIPLEXER_BATCH];
+	uint64_t wakes;
+	int count = 0;
+	int signalled;
+
+	signalled = epoll_wait(epollFd, events, capacity < MULTIPLEXER_BATCH ? capacity : MULTIPLEXER_BATCH,
+		timeout == WAIT_FOREVER ? -1 : (int)timeout);
+	for (int i = 0; i < signalled; i++) {
+		Port * port = static_cast<Port *>(events[i].data.ptr);
+
+		if (port == nullptr) {
+			if (::read(wakeFd, &wakes, sizeof(wakes)) < 0) {
+				// Another pass already drained the counter
+			}
+			continue;
+		}
+		if (port->state != PortState::Active) {
+			continue;
+		}
+		if (!port->transport->read(port->buffer, RX_CHUNK_SIZE, 0, &port->length)) {
+			port->state = PortState::Failed;
+		}
+		else if (port->length == 0) {
+			continue;
+		}
+		ready[count++] = port;
+	}
+	return count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wake
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void wake(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Safe from any thread. Wakes the current wait, or makes the next one return at once.
+----------------------------------------------------------------------------------------------------------------------*/
+void EpollMultiplexer::wake() {
+	uint64_t one = 1;
+
+	if (wakeFd >= 0 && ::write(wakeFd, &one, sizeof(one)) < 0) {
+		// The counter is already non-zero, so the wait wakes regardless
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createPortMultiplexer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<PortMultiplexer> createPortMultiplexer(void)
+--
+-- RETURNS:		std::unique_ptr<PortMultiplexer> - the multiplexer for this platform
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortMultiplexer> createPortMultiplexer() {
+	return std::unique_ptr<PortMultiplexer>(new EpollMultiplexer());
+}
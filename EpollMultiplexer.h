@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include "PortMultiplexer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		EpollMultiplexer.h -	PortMultiplexer that waits on every port with one epoll set on Linux.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool openQueue(void)
+--					void closeQueue(void)
+--					std::unique_ptr<Port> attach(SerialTransport * transport)
+--					bool detach(Port * port)
+--					int wait(Port ** ready, int capacity, uint32_t timeout)
+--					void rearm(Port * port)
+--					void wake(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Each PosixTransport's descriptor is added level-triggered for EPOLLIN, alongside an eventfd that wake signals.
+-- epoll reports readiness rather than completions, so wait does the read itself: one read of up to RX_CHUNK_SIZE
+-- per ready port per pass, which keeps a flooded port from starving the rest. Anything left is reported again by
+-- the next epoll_wait.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class EpollMultiplexer : public PortMultiplexer {
+private:
+	struct EpollPort : public Port {
+		int descriptor = -1;
+	};
+
+	int epollFd = -1;
+	int wakeFd = -1;
+protected:
+	bool openQueue() override;
+	void closeQueue() override;
+	std::unique_ptr<Port> attach(SerialTransport * transport) override;
+	bool detach(Port * port) override;
+	int wait(Port ** ready, int capacity, uint32_t timeout) override;
+	void rearm(Port *) override {};
+	void wake() override;
+public:
+	EpollMultiplexer() {};
+	~EpollMultiplexer() { stop(); };
+};
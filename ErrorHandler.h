@@ -15,7 +15,12 @@
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Reports ERROR_SESSION_LIMIT
+--					Oct 17, 2026 - Reports ERROR_CAPTURE_OPEN
+--					Oct 17, 2026 - Reports ERROR_TRANSFER_START
+--					Oct 17, 2026 - Reports ERROR_TELEMETRY_SAVE
+--					Oct 17, 2026 - Reports ERROR_BRIDGE_START
+--					Oct 17, 2026 - ERROR_RD_THREAD no longer falls through to the unknown error
 --
 -- DESIGNER:		Henry Ho
 --
@@ -32,7 +37,12 @@ struct ErrorHandler {
 	--
 	-- DATE:		Sept 28, 2019
 	--
-	-- REVISIONS:	(N/A)
+	-- REVISIONS:	Oct 17, 2026 - ERROR_SESSION_LIMIT
+	--				Oct 17, 2026 - ERROR_CAPTURE_OPEN
+	--				Oct 17, 2026 - ERROR_TRANSFER_START
+	--				Oct 17, 2026 - ERROR_TELEMETRY_SAVE
+	--				Oct 17, 2026 - ERROR_BRIDGE_START
+	--				Oct 17, 2026 - break after ERROR_RD_THREAD
 	--
 	-- DESIGNER:	Henry Ho
 	--
@@ -61,8 +71,24 @@ struct ErrorHandler {
 		case ERROR_PORT_PROP:
 			DisplayService::displayMessageBox("Error getting COM properties");
 			break;
+		case ERROR_SESSION_LIMIT:
+			DisplayService::displayMessageBox("Too many ports open");
+			break;
+		case ERROR_CAPTURE_OPEN:
+			DisplayService::displayMessageBox("Error creating capture file");
+			break;
+		case ERROR_TRANSFER_START:
+			DisplayService::displayMessageBox("Error starting file transfer");
+			break;
+		case ERROR_TELEMETRY_SAVE:
+			DisplayService::displayMessageBox("Error saving telemetry");
+			break;
+		case ERROR_BRIDGE_START:
+			DisplayService::displayMessageBox("Error serving port over TCP");
+			break;
 		case ERROR_RD_THREAD:
 			DisplayService::displayMessageBox("Error creating read thread");
+			break;
 		default:
 			DisplayService::displayMessageBox("Unknown error detected.");
 			break;
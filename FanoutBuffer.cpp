@@ -0,0 +1,275 @@
+#include <string.h>
+#include "FanoutBuffer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		FanoutBuffer.cpp -	One copy of a byte stream, read by many cursors at their own pace.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void append(const char * data, size_t length)
+--					void attach(FanoutCursor * cursor)
+--					void detach(FanoutCursor * cursor)
+--					size_t peek(FanoutCursor * cursor, const char ** data)
+--					FanoutBlock * takeBlock(void)
+--					void release(FanoutBlock * block)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A block's length and next are stored with release by the writer and loaded with acquire by the reader, so the
+-- bytes and the position they describe are in place first.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	FanoutBuffer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	FanoutBuffer(void)
+--
+-- NOTES:
+-- Starts the chain with one empty block, held as the tail.
+----------------------------------------------------------------------------------------------------------------------*/
+FanoutBuffer::FanoutBuffer() {
+	tail = takeBlock();
+	tail->references.store(1);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	~FanoutBuffer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	~FanoutBuffer(void)
+--
+-- NOTES:
+-- Every cursor must have been detached, which leaves only the tail alive.
+----------------------------------------------------------------------------------------------------------------------*/
+FanoutBuffer::~FanoutBuffer() {
+	release(tail);
+	for (FanoutBlock * block : freeBlocks) {
+		delete block;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	append
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void append(const char * data, size_t length)
+--					const char * data:	bytes to add to the stream
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Called on the writer thread only. Copies into the tail, chaining a new block each time it fills. A block taken
+-- from the free list costs a lock; one that has to be allocated also costs a new.
+----------------------------------------------------------------------------------------------------------------------*/
+void FanoutBuffer::append(const char * data, size_t length) {
+	while (length > 0) {
+		size_t filled = tail->length.load(std::memory_order_relaxed);
+
+		if (filled == FANOUT_BLOCK_SIZE) {
+			FanoutBlock * block = takeBlock();
+			FanoutBlock * full = tail;
+
+			// One reference as the tail and one from the link
+			block->position = full->position + FANOUT_BLOCK_SIZE;
+			block->references.store(2, std::memory_order_relaxed);
+			full->next.store(block, std::memory_order_release);
+			tail = block;
+			release(full);
+			filled = 0;
+		}
+		size_t slice = FANOUT_BLOCK_SIZE - filled < length ? FANOUT_BLOCK_SIZE - filled : length;
+
+		memcpy(tail->data + filled, data, slice);
+		tail->length.store(filled + slice, std::memory_order_release);
+		written.fetch_add(slice, std::memory_order_release);
+		data += slice;
+		length -= slice;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	attach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void attach(FanoutCursor * cursor)
+--					FanoutCursor * cursor:	a detached cursor; set to the end of the stream
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function on the reader thread, never while append runs.
+----------------------------------------------------------------------------------------------------------------------*/
+void FanoutBuffer::attach(FanoutCursor * cursor) {
+	tail->references.fetch_add(1, std::memory_order_relaxed);
+	cursor->block = tail;
+	cursor->offset = tail->length.load(std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	detach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void detach(FanoutCursor * cursor)
+--					FanoutCursor * cursor:	an attached cursor; left detached
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function on the reader thread. Any blocks only the cursor was keeping alive are freed.
+----------------------------------------------------------------------------------------------------------------------*/
+void FanoutBuffer::detach(FanoutCursor * cursor) {
+	if (cursor->block != nullptr) {
+		release(cursor->block);
+		cursor->block = nullptr;
+		cursor->offset = 0;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	peek
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t peek(FanoutCursor * cursor, const char ** data)
+--					FanoutCursor * cursor:	an attached cursor
+--					const char ** data:		set to the next unread byte
+--
+-- RETURNS:		size_t - unread bytes at data, all in one block; 0 if the cursor has caught up
+--
+-- NOTES:
+-- Call this function on the reader thread. A cursor at the end of a full block moves into the next one here, taking
+-- a reference on it before letting go of the old one. The bytes stay valid until the cursor moves again.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t FanoutBuffer::peek(FanoutCursor * cursor, const char ** data) {
+	FanoutBlock * block = cursor->block;
+
+	if (cursor->offset == FANOUT_BLOCK_SIZE) {
+		FanoutBlock * next = block->next.load(std::memory_order_acquire);
+
+		if (next == nullptr) {
+			return 0;
+		}
+		next->references.fetch_add(1, std::memory_order_relaxed);
+		cursor->block = next;
+		cursor->offset = 0;
+		release(block);
+		block = next;
+	}
+	*data = block->data + cursor->offset;
+	return block->length.load(std::memory_order_acquire) - cursor->offset;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	takeBlock
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	FanoutBlock * takeBlock(void)
+--
+-- RETURNS:		FanoutBlock * - an empty block with no references and no next
+----------------------------------------------------------------------------------------------------------------------*/
+FanoutBlock * FanoutBuffer::takeBlock() {
+	{
+		std::lock_guard<std::mutex> guard(freeLock);
+
+		if (!freeBlocks.empty()) {
+			FanoutBlock * block = freeBlocks.back();
+			freeBlocks.pop_back();
+			return block;
+		}
+	}
+	blocksAllocated.fetch_add(1, std::memory_order_relaxed);
+	return new FanoutBlock();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	release
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void release(FanoutBlock * block)
+--					FanoutBlock * block:	a block to drop one reference on
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Called on either thread. A block whose last reference goes is put on the free list and drops its link to the
+-- next, which may free that one in turn. Only the tail has no next, and the tail always holds its own reference.
+----------------------------------------------------------------------------------------------------------------------*/
+void FanoutBuffer::release(FanoutBlock * block) {
+	while (block != nullptr && block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		FanoutBlock * next = block->next.load(std::memory_order_acquire);
+
+		block->length.store(0, std::memory_order_relaxed);
+		block->next.store(nullptr, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> guard(freeLock);
+			freeBlocks.push_back(block);
+		}
+		block = next;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		FanoutBuffer.h -	One copy of a byte stream, read by many cursors at their own pace.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void append(const char * data, size_t length)
+--					void attach(FanoutCursor * cursor)
+--					void detach(FanoutCursor * cursor)
+--					size_t peek(FanoutCursor * cursor, const char ** data)
+--					void consume(FanoutCursor * cursor, size_t length)
+--					uint64_t getWritten(void) const
+--					uint64_t getBlocksAllocated(void) const
+--					FanoutBlock * takeBlock(void)
+--					void release(FanoutBlock * block)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The stream is a chain of FANOUT_BLOCK_SIZE blocks that one writer appends to. Each reader keeps a FanoutCursor,
+-- a place in the chain, and sends straight out of the block it points at, so the bytes are stored once however many
+-- readers there are. A cursor is attached at the end of the stream, so a reader only sees what arrives after it.
+--
+-- Blocks are reference counted. A block holds one reference for each cursor in it, one while it is the writer's
+-- tail, and one from the block before it while that block is alive. When the count reaches zero, the block is behind
+-- every cursor, and it goes back to a free list with its hold on the next block dropped. The writer therefore never
+-- waits for a reader: a reader that falls behind only keeps more blocks alive. Bounding how far behind it may fall is
+-- up to the owner.
+--
+-- There is one writer thread and one reader thread, which moves every cursor. append and attach must not run at the
+-- same time, since attach takes a reference on the tail the writer may be letting go of; the owner serializes the
+-- two. Everything else may run alongside append.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t FANOUT_BLOCK_SIZE = 64 * 1024;
+
+struct FanoutBlock {
+	std::atomic<uint32_t> references{ 0 };
+	std::atomic<size_t> length{ 0 };				// bytes written; set with release once they are in data
+	std::atomic<FanoutBlock *> next{ nullptr };
+	uint64_t position = 0;						// stream offset of data[0]
+	char data[FANOUT_BLOCK_SIZE];
+};
+
+struct FanoutCursor {
+	FanoutBlock * block = nullptr;
+	size_t offset = 0;
+
+	uint64_t position() const { return block->position + offset; };
+};
+
+class FanoutBuffer {
+private:
+	FanoutBlock * tail;
+	std::atomic<uint64_t> written{ 0 };
+	std::mutex freeLock;						// guards freeBlocks; taken once per block, not per append
+	std::vector<FanoutBlock *> freeBlocks;
+	std::atomic<uint64_t> blocksAllocated{ 0 };
+
+	FanoutBlock * takeBlock();
+	void release(FanoutBlock * block);
+public:
+	FanoutBuffer();
+	~FanoutBuffer();
+	FanoutBuffer(const FanoutBuffer &) = delete;
+	FanoutBuffer & operator=(const FanoutBuffer &) = delete;
+
+	void append(const char * data, size_t length);
+	void attach(FanoutCursor * cursor);
+	void detach(FanoutCursor * cursor);
+	size_t peek(FanoutCursor * cursor, const char ** data);
+	void consume(FanoutCursor * cursor, size_t length) { cursor->offset += length; };
+	uint64_t getWritten() const { return written.load(std::memory_order_acquire); };
+	uint64_t getBlocksAllocated() const { return blocksAllocated.load(std::memory_order_relaxed); };
+};
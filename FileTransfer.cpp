@@ -0,0 +1,487 @@
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <string.h>
+#include "FileTransfer.h"
+#include "XmodemTransfer.h"
+#include "ZmodemTransfer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		FileTransfer.cpp -	The byte stream, statistics and file handling the transfer protocols share.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int readByte(uint32_t timeout)
+--					void unreadByte(void)
+--					bool write(const char * data, size_t length)
+--					void sendAbort(void)
+--					void beginFile(const std::string & name, uint64_t size, uint64_t offset)
+--					void setProgress(uint64_t offset)
+--					void countRetry(void)
+--					void finish(TransferStatus status)
+--					TransferStats getStats(void) const
+--					std::string baseName(const std::string & path)
+--					FILE * openReceived(const std::string & directory, const std::string & name,
+--						uint64_t resumeLimit, uint64_t * existing)
+--					double linkEfficiency(const TransferStats & stats, const PortSettings & settings)
+--					const char * protocolName(TransferProtocol protocol)
+--					std::unique_ptr<FileTransfer> createFileTransfer(TransferProtocol protocol,
+--						TransferChannel * channel, const TransferOptions & options)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+----------------------------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+constexpr char CAN = 0x18;
+constexpr char BS = 0x08;
+constexpr int ABORT_LENGTH = 8;		// CANs, then as many backspaces to erase them if a shell was listening
+
+#ifdef _WIN32
+FILE * openUtf8(const std::string & path, const wchar_t * mode) {
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+	std::wstring widePath(length > 0 ? length : 1, L'\0');
+
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+	return _wfopen(widePath.c_str(), mode);
+}
+#endif
+
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readByte
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readByte(uint32_t timeout)
+--					uint32_t timeout:	ms to wait for a byte, 0 to take one only if it has already arrived
+--
+-- RETURNS:		int - the byte, 0 to 255, TIMED_OUT, or LINK_FAILED if the link failed or the transfer was
+--				cancelled
+--
+-- NOTES:
+-- Reads a chunk from the channel at a time and hands it out a byte at a time. The wait is cut into slices of
+-- RX_WAIT_TIMEOUT so that cancel is noticed promptly.
+----------------------------------------------------------------------------------------------------------------------*/
+int FileTransfer::readByte(uint32_t timeout) {
+	if (inputHead < inputCount) {
+		return (uint8_t)input[inputHead++];
+	}
+	Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout);
+
+	for (;;) {
+		if (isCancelled()) {
+			return LINK_FAILED;
+		}
+		Clock::time_point now = Clock::now();
+		uint32_t wait = 0;
+		size_t received = 0;
+
+		if (deadline > now) {
+			long long remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+			wait = remaining < RX_WAIT_TIMEOUT ? (uint32_t)remaining : RX_WAIT_TIMEOUT;
+		}
+		if (!channel->receive(input, sizeof(input), wait, &received)) {
+			return LINK_FAILED;
+		}
+		if (received > 0) {
+			std::lock_guard<std::mutex> guard(statsLock);
+			stats.wireBytesReceived += received;
+			inputHead = 1;
+			inputCount = received;
+			return (uint8_t)input[0];
+		}
+		if (Clock::now() >= deadline) {
+			return TIMED_OUT;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	unreadByte
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void unreadByte(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Puts back the byte the last readByte returned, for a parser that read one byte too far. Only one byte can be
+-- put back, and only straight after a readByte that returned a byte.
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::unreadByte() {
+	if (inputHead > 0) {
+		inputHead--;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	write
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool write(const char * data, size_t length)
+--					const char * data:	bytes for the far end
+--					size_t length:		bytes in data
+--
+-- RETURNS:		bool - false if the link failed or the transfer was cancelled
+----------------------------------------------------------------------------------------------------------------------*/
+bool FileTransfer::write(const char * data, size_t length) {
+	if (isCancelled() || !channel->send(data, length)) {
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(statsLock);
+	stats.wireBytesSent += length;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendAbort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void sendAbort(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Sends the cancel sequence that XMODEM, YMODEM and ZMODEM receivers and senders all stop on, even when the transfer
+-- has been cancelled locally.
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::sendAbort() {
+	char sequence[ABORT_LENGTH * 2];
+
+	memset(sequence, CAN, ABORT_LENGTH);
+	memset(sequence + ABORT_LENGTH, BS, ABORT_LENGTH);
+	channel->send(sequence, sizeof(sequence));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void beginFile(const std::string & name, uint64_t size, uint64_t offset)
+--					const std::string & name:	the file's name as sent
+--					uint64_t size:				its length, or 0 if the protocol does not say
+--					uint64_t offset:			where its data starts, past what a resumed transfer already has
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Starts the clock for the file's data.
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::beginFile(const std::string & name, uint64_t size, uint64_t offset) {
+	std::lock_guard<std::mutex> guard(statsLock);
+	stats.fileName = name;
+	stats.fileSize = size;
+	stats.startOffset = offset;
+	stats.offset = offset;
+	dataStart = Clock::now();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setProgress
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setProgress(uint64_t offset)
+--					uint64_t offset:	file bytes acknowledged or written so far
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::setProgress(uint64_t offset) {
+	std::lock_guard<std::mutex> guard(statsLock);
+	stats.offset = offset;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	countRetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void countRetry(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::countRetry() {
+	std::lock_guard<std::mutex> guard(statsLock);
+	stats.retries++;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	finish
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void finish(TransferStatus status)
+--					TransferStatus status:	how the transfer ended
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Stops the clock. A transfer cancelled here reports Cancelled whatever the protocol ran into on the way out.
+----------------------------------------------------------------------------------------------------------------------*/
+void FileTransfer::finish(TransferStatus status) {
+	std::lock_guard<std::mutex> guard(statsLock);
+	stats.status = isCancelled() && status != TransferStatus::Complete ? TransferStatus::Cancelled : status;
+	if (dataStart != Clock::time_point()) {
+		stats.seconds = std::chrono::duration<double>(Clock::now() - dataStart).count();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStats getStats(void) const
+--
+-- RETURNS:		TransferStats - a copy, safe to take from any thread; seconds runs on while the transfer does
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStats FileTransfer::getStats() const {
+	std::lock_guard<std::mutex> guard(statsLock);
+	TransferStats copy = stats;
+
+	if (copy.status == TransferStatus::Running && dataStart != Clock::time_point()) {
+		copy.seconds = std::chrono::duration<double>(Clock::now() - dataStart).count();
+	}
+	return copy;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	baseName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::string baseName(const std::string & path)
+--					const std::string & path:	a path with / or \ separators
+--
+-- RETURNS:		std::string - the last component, or empty if that is empty, . or ..
+--
+-- NOTES:
+-- Used on both ends: the sender sends no directories, and the receiver never lets a name it was sent leave the
+-- directory it was given.
+----------------------------------------------------------------------------------------------------------------------*/
+std::string FileTransfer::baseName(const std::string & path) {
+	size_t slash = path.find_last_of("/\\:");
+	std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+	if (name == "." || name == "..") {
+		return std::string();
+	}
+	return name;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openReceived
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	FILE * openReceived(const std::string & directory, const std::string & name, uint64_t resumeLimit,
+--					uint64_t * existing)
+--					const std::string & directory:	where to put the file, UTF-8; empty for the current directory
+--					const std::string & name:		its name, already passed through baseName
+--					uint64_t resumeLimit:			keep an existing file up to this long, or 0 to start afresh
+--					uint64_t * existing:			set to the length kept, with the file positioned at its end
+--
+-- RETURNS:		FILE * - the open file, or nullptr if it cannot be created
+--
+-- NOTES:
+-- An existing file longer than resumeLimit is not a partial copy of the one coming and is overwritten.
+----------------------------------------------------------------------------------------------------------------------*/
+FILE * FileTransfer::openReceived(const std::string & directory, const std::string & name, uint64_t resumeLimit,
+	uint64_t * existing) {
+	std::string path = directory.empty() ? name : directory + "/" + name;
+	FILE * file = nullptr;
+
+	*existing = 0;
+	if (resumeLimit > 0) {
+#ifdef _WIN32
+		file = openUtf8(path, L"r+b");
+		if (file != nullptr && _fseeki64(file, 0, SEEK_END) == 0) {
+			long long length = _ftelli64(file);
+#else
+		file = fopen(path.c_str(), "r+b");
+		if (file != nullptr && fseeko(file, 0, SEEK_END) == 0) {
+			long long length = (long long)ftello(file);
+#endif
+			if (length >= 0 && (uint64_t)length <= resumeLimit) {
+				*existing = (uint64_t)length;
+				return file;
+			}
+		}
+		if (file != nullptr) {
+			fclose(file);
+		}
+	}
+#ifdef _WIN32
+	return openUtf8(path, L"wb");
+#else
+	return fopen(path.c_str(), "wb");
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	linkEfficiency
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double linkEfficiency(const TransferStats & stats, const PortSettings & settings)
+--					const TransferStats & stats:	a transfer's statistics
+--					const PortSettings & settings:	the line it ran over
+--
+-- RETURNS:		double - file bytes per second achieved over the most the line can carry, 0 if unknown
+--
+-- NOTES:
+-- The most the line can carry is the baud rate over the bits in a frame: start bit, data bits, parity bit and stop
+-- bits. Bytes a resumed transfer did not have to send are not counted.
+----------------------------------------------------------------------------------------------------------------------*/
+double linkEfficiency(const TransferStats & stats, const PortSettings & settings) {
+	double frameBits = 1.0 + settings.dataBits + (settings.parity != ParityMode::None ? 1 : 0) + settings.stopBits;
+	double lineRate = settings.baudRate / frameBits;
+
+	if (stats.seconds <= 0 || lineRate <= 0) {
+		return 0;
+	}
+	return (stats.offset - stats.startOffset) / stats.seconds / lineRate;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	protocolName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const char * protocolName(TransferProtocol protocol)
+--					TransferProtocol protocol:	a protocol
+--
+-- RETURNS:		const char * - its usual name
+----------------------------------------------------------------------------------------------------------------------*/
+const char * protocolName(TransferProtocol protocol) {
+	switch (protocol) {
+	case TransferProtocol::Xmodem:
+		return "XMODEM";
+	case TransferProtocol::Xmodem1k:
+		return "XMODEM-1K";
+	case TransferProtocol::Ymodem:
+		return "YMODEM";
+	case TransferProtocol::Zmodem:
+	default:
+		return "ZMODEM";
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createFileTransfer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<FileTransfer> createFileTransfer(TransferProtocol protocol, TransferChannel * channel,
+--					const TransferOptions & options)
+--					TransferProtocol protocol:		the protocol to speak
+--					TransferChannel * channel:		the link to the far end, which must outlive the transfer
+--					const TransferOptions & options:	windowing, resume and timeouts
+--
+-- RETURNS:		std::unique_ptr<FileTransfer> - a transfer ready for one send or receive
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<FileTransfer> createFileTransfer(TransferProtocol protocol, TransferChannel * channel,
+	const TransferOptions & options) {
+	if (protocol == TransferProtocol::Zmodem) {
+		return std::unique_ptr<FileTransfer>(new ZmodemTransfer(channel, options));
+	}
+	return std::unique_ptr<FileTransfer>(new XmodemTransfer(protocol, channel, options));
+}
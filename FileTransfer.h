@@ -0,0 +1,162 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		FileTransfer.h -	Sends and receives files over a port with XMODEM, YMODEM or ZMODEM.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const std::string & path)
+--					bool receive(const std::string & directory)
+--					void cancel(void)
+--					bool isCancelled(void) const
+--					TransferStats getStats(void) const
+--					int readByte(uint32_t timeout)
+--					void unreadByte(void)
+--					bool write(const char * data, size_t length)
+--					void sendAbort(void)
+--					void beginFile(const std::string & name, uint64_t size, uint64_t offset)
+--					void setProgress(uint64_t offset)
+--					void countRetry(void)
+--					void finish(TransferStatus status)
+--					std::string baseName(const std::string & path)
+--					FILE * openReceived(const std::string & directory, const std::string & name,
+--						uint64_t resumeLimit, uint64_t * existing)
+--					double linkEfficiency(const TransferStats & stats, const PortSettings & settings)
+--					const char * protocolName(TransferProtocol protocol)
+--					std::unique_ptr<FileTransfer> createFileTransfer(TransferProtocol protocol,
+--						TransferChannel * channel, const TransferOptions & options)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A transfer runs on a thread of its own and talks to the far end through a TransferChannel: SerialCommController
+-- routes its pipeline through one while a transfer runs, and TransportChannel drives a bare SerialTransport. send
+-- and receive block until the transfer ends and can be cancelled from any thread, which sends the CAN sequence
+-- every one of these protocols understands. Files are sent from a MappedFile; received files are written to the
+-- directory given, under the name the sender gave with any directories stripped.
+--
+-- ZMODEM (ZmodemTransfer) streams: data goes out in subpackets without waiting for acknowledgements, and the
+-- receiver only speaks up to ask for a resend from a position, so a clean link runs at line rate. A nonzero window
+-- makes the sender ask for an acknowledgement every quarter window and stop when a whole window is outstanding. A
+-- receiver that finds a shorter file of the same name resumes from its end. XMODEM and YMODEM (XmodemTransfer)
+-- wait for each block to be acknowledged, and cannot resume.
+----------------------------------------------------------------------------------------------------------------------*/
+
+enum class TransferProtocol : uint8_t {
+	Xmodem,			// 128-byte blocks, CRC-16, or an additive checksum if the receiver asks for it
+	Xmodem1k,		// 1024-byte blocks, CRC-16
+	Ymodem,			// XMODEM-1K with a header block giving the name and size
+	Zmodem
+};
+
+enum class TransferStatus : uint8_t {
+	Running,
+	Complete,
+	Skipped,		// the receiver already had the whole file
+	Cancelled,		// by either end
+	Failed
+};
+
+constexpr uint32_t TRANSFER_TIMEOUT = 10000;		// ms without a reply before a frame is repeated
+constexpr int TRANSFER_RETRIES = 10;				// repeats in a row before the transfer fails
+constexpr size_t ZMODEM_SUBPACKET_SIZE = 1024;
+
+struct TransferOptions {
+	bool allowResume = true;
+	size_t window = 0;								// ZMODEM: bytes that may be unacknowledged, 0 for no limit
+	size_t subpacketSize = ZMODEM_SUBPACKET_SIZE;
+	uint32_t timeout = TRANSFER_TIMEOUT;
+	int retries = TRANSFER_RETRIES;
+	std::string receiveName = "received.bin";		// XMODEM sends no name
+};
+
+struct TransferStats {
+	std::string fileName;
+	TransferStatus status = TransferStatus::Running;
+	uint64_t fileSize = 0;
+	uint64_t startOffset = 0;		// where a resumed transfer picked up
+	uint64_t offset = 0;			// file bytes sent and acknowledged, or received and written
+	uint64_t wireBytesSent = 0;
+	uint64_t wireBytesReceived = 0;
+	uint64_t retries = 0;			// frames repeated or resend requests, either way
+	double seconds = 0;				// from the start of the file's data to the end of the transfer
+};
+
+class TransferChannel {
+public:
+	virtual ~TransferChannel() {};
+
+	// Queues every byte, waiting for room; returns false if the link failed
+	virtual bool send(const char * data, size_t length) = 0;
+	// Waits up to timeout ms; returns false if the link failed. 0 bytes means timed out.
+	virtual bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived) = 0;
+};
+
+class FileTransfer {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	// read results that are not bytes or frame types
+	static constexpr int TIMED_OUT = -1;
+	static constexpr int LINK_FAILED = -2;		// the link failed or the transfer was cancelled here
+	static constexpr int FRAME_ERROR = -3;		// a bad check, bad framing or too much noise
+	static constexpr int PEER_CANCELLED = -4;	// the far end sent the CAN sequence
+private:
+	char input[RX_CHUNK_SIZE];
+	size_t inputHead = 0;
+	size_t inputCount = 0;
+	Clock::time_point dataStart;
+	mutable std::mutex statsLock;
+	TransferStats stats;
+	std::atomic<bool> cancelled{ false };
+protected:
+	TransferChannel * channel;
+	TransferOptions options;
+
+	int readByte(uint32_t timeout);
+	void unreadByte();
+	bool write(const char * data, size_t length);
+	void sendAbort();
+	void beginFile(const std::string & name, uint64_t size, uint64_t offset);
+	void setProgress(uint64_t offset);
+	void countRetry();
+	void finish(TransferStatus status);
+	static std::string baseName(const std::string & path);
+	static FILE * openReceived(const std::string & directory, const std::string & name, uint64_t resumeLimit,
+		uint64_t * existing);
+public:
+	FileTransfer(TransferChannel * link, const TransferOptions & transferOptions) :
+		channel(link), options(transferOptions) {};
+	virtual ~FileTransfer() {};
+	FileTransfer(const FileTransfer &) = delete;
+	FileTransfer & operator=(const FileTransfer &) = delete;
+
+	virtual bool send(const std::string & path) = 0;
+	virtual bool receive(const std::string & directory) = 0;
+	void cancel() { cancelled.store(true); };
+	bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); };
+	TransferStats getStats() const;
+};
+
+double linkEfficiency(const TransferStats & stats, const PortSettings & settings);
+const char * protocolName(TransferProtocol protocol);
+std::unique_ptr<FileTransfer> createFileTransfer(TransferProtocol protocol, TransferChannel * channel,
+	const TransferOptions & options);
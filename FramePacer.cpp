@@ -0,0 +1,130 @@
+#include "FramePacer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		FramePacer.cpp -	Decides which received chunks are presented and when to jump scroll.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void beginFrame(size_t backlog, TimePoint now)
+--					bool endFrame(bool isCutShort)
+--					void presented(TimePoint now)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void beginFrame(size_t backlog, TimePoint now)
+--					size_t backlog:		bytes waiting to be applied
+--					TimePoint now:		the current time
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before draining. The mode for the whole frame is chosen here: jump mode is entered as soon as
+-- the backlog or the last lag is too large, but only left after JUMP_EXIT_FRAMES quiet frames.
+----------------------------------------------------------------------------------------------------------------------*/
+void FramePacer::beginFrame(size_t backlog, TimePoint now) {
+	frameStart = now;
+	hiddenChunks = 0;
+	stats.frames++;
+	stats.lastBacklog = backlog;
+	if (backlog > stats.maxBacklog) {
+		stats.maxBacklog = backlog;
+	}
+	if (!isAdaptive) {
+		return;
+	}
+
+	if (mode == ScrollMode::Smooth) {
+		if (backlog >= JUMP_ENTER_BACKLOG || stats.lastLagMs >= (double)JUMP_ENTER_LAG.count()) {
+			mode = ScrollMode::Jump;
+			quietFrames = 0;
+			stats.jumpEntries++;
+		}
+	}
+	else if (backlog <= JUMP_EXIT_BACKLOG) {
+		if (++quietFrames >= JUMP_EXIT_FRAMES) {
+			mode = ScrollMode::Smooth;
+		}
+	}
+	else {
+		quietFrames = 0;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool endFrame(bool isCutShort)
+--					bool isCutShort:	true if the drain stopped at FRAME_BUDGET with data still waiting
+--
+-- RETURNS:		bool - true if the caller should present the final state now
+--
+-- NOTES:
+-- In jump mode every chunk of the frame but the last one presented is counted as skipped.
+----------------------------------------------------------------------------------------------------------------------*/
+bool FramePacer::endFrame(bool isCutShort) {
+	if (isCutShort) {
+		stats.budgetYields++;
+	}
+	if (!hasUnpresented) {
+		return false;
+	}
+	stats.framesSkipped += hiddenChunks - 1;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	presented
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void presented(TimePoint now)
+--					TimePoint now:	the current time, after the present
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void FramePacer::presented(TimePoint now) {
+	double lagMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+
+	hasUnpresented = false;
+	hiddenChunks = 0;
+	stats.framesPresented++;
+	stats.lastLagMs = lagMs;
+	stats.totalLagMs += lagMs;
+	if (lagMs > stats.maxLagMs) {
+		stats.maxLagMs = lagMs;
+	}
+}
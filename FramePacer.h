@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		FramePacer.h -	Decides which received chunks are presented and when to fall back to jump scroll.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void setAdaptive(bool isAdaptive)
+--					void beginFrame(size_t backlog, TimePoint now)
+--					bool chunkApplied(void)
+--					bool isBudgetSpent(TimePoint now) const
+--					bool endFrame(bool isCutShort)
+--					void presented(TimePoint now)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A drain of the receive ring is one pacer frame. In smooth mode every chunk applied to the screen model is presented
+-- as it is applied, so output scrolls line by line. When the backlog waiting in the ring at the start of a frame, or
+-- the lag of the last present, passes a threshold the pacer switches to jump mode: chunks are applied without being
+-- shown and only the final state of the frame is presented. A frame in either mode stops after FRAME_BUDGET so the
+-- window keeps answering input; the rest is picked up by the next frame. The pacer goes back to smooth mode once the
+-- backlog has stayed small for JUMP_EXIT_FRAMES frames in a row, so a burst does not flip it back and forth.
+--
+-- Render lag is the time from the start of the frame that found data waiting to the present that showed it.
+-- The pacer only counts and decides; the caller applies and presents. Nothing here calls the platform.
+----------------------------------------------------------------------------------------------------------------------*/
+constexpr size_t JUMP_ENTER_BACKLOG = 32 * 1024;		// bytes waiting at the start of a frame
+constexpr size_t JUMP_EXIT_BACKLOG = 4 * 1024;
+constexpr int JUMP_EXIT_FRAMES = 4;
+constexpr std::chrono::milliseconds JUMP_ENTER_LAG{ 100 };
+constexpr std::chrono::milliseconds FRAME_BUDGET{ 16 };
+
+enum class ScrollMode : uint8_t {
+	Smooth,
+	Jump
+};
+
+struct PacerStats {
+	uint64_t frames = 0;				// drains started
+	uint64_t framesPresented = 0;
+	uint64_t framesSkipped = 0;			// chunks applied in jump mode and never shown on their own
+	uint64_t jumpEntries = 0;
+	uint64_t budgetYields = 0;			// frames cut short by FRAME_BUDGET
+	size_t lastBacklog = 0;
+	size_t maxBacklog = 0;
+	double lastLagMs = 0.0;
+	double maxLagMs = 0.0;
+	double totalLagMs = 0.0;			// over framesPresented
+};
+
+class FramePacer {
+public:
+	typedef std::chrono::steady_clock Clock;
+	typedef Clock::time_point TimePoint;
+private:
+	ScrollMode mode = ScrollMode::Smooth;
+	bool isAdaptive = true;
+	int quietFrames = 0;
+
+	TimePoint frameStart;
+	bool hasUnpresented = false;
+	uint64_t hiddenChunks = 0;			// applied this frame since the last present
+	PacerStats stats;
+public:
+	FramePacer() {};
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	setAdaptive
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	void setAdaptive(bool isAdaptive)
+	--					bool isAdaptive:	false keeps the pacer in smooth mode whatever the backlog
+	--
+	-- RETURNS:		void
+	--------------------------------------------------------------------------------------------------------------*/
+	void setAdaptive(bool adaptive) {
+		isAdaptive = adaptive;
+		if (!adaptive) {
+			mode = ScrollMode::Smooth;
+		}
+	}
+
+	void beginFrame(size_t backlog, TimePoint now);
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	chunkApplied
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	bool chunkApplied(void)
+	--
+	-- RETURNS:		bool - true if the caller should present the chunk now
+	--
+	-- NOTES:
+	-- Call this function after each chunk reaches the screen model.
+	--------------------------------------------------------------------------------------------------------------*/
+	bool chunkApplied() {
+		hasUnpresented = true;
+		hiddenChunks++;
+		return mode == ScrollMode::Smooth;
+	}
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	isBudgetSpent
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	bool isBudgetSpent(TimePoint now) const
+	--					TimePoint now:	the current time
+	--
+	-- RETURNS:		bool - true once the frame has run for FRAME_BUDGET
+	--------------------------------------------------------------------------------------------------------------*/
+	bool isBudgetSpent(TimePoint now) const { return now - frameStart >= FRAME_BUDGET; };
+
+	bool endFrame(bool isCutShort);
+	void presented(TimePoint now);
+
+	ScrollMode getMode() const { return mode; };
+	const PacerStats & getStats() const { return stats; };
+};
@@ -0,0 +1,141 @@
+#include <windows.h>
+#include <string.h>
+#include "GdiGlyphRasterizer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		GdiGlyphRasterizer.cpp -	Rasterizes glyph atlas tiles with a GDI font.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL setFont(HFONT font, int cellWidth, int cellHeight)
+--					void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--					VOID release(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- GDI may batch drawing calls, so GdiFlush runs before the DIB's memory is read.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setFont
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL setFont(HFONT font, int cellWidth, int cellHeight)
+--					HFONT font:					font to draw with; the caller keeps ownership
+--					int cellWidth, cellHeight:	cell size in pixels
+--
+-- RETURNS:		BOOL - false if the memory context or DIB section could not be created
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL GdiGlyphRasterizer::setFont(HFONT font, int cellWidth, int cellHeight) {
+	BITMAPINFO bitmapInfo = {};
+
+	release();
+	bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bitmapInfo.bmiHeader.biWidth = cellWidth;
+	bitmapInfo.bmiHeader.biHeight = -cellHeight;
+	bitmapInfo.bmiHeader.biPlanes = 1;
+	bitmapInfo.bmiHeader.biBitCount = 32;
+	bitmapInfo.bmiHeader.biCompression = BI_RGB;
+
+	memoryContext = CreateCompatibleDC(NULL);
+	if (memoryContext == NULL) {
+		return false;
+	}
+	bitmap = CreateDIBSection(memoryContext, &bitmapInfo, DIB_RGB_COLORS, (void **)&bits, NULL, 0);
+	if (bitmap == NULL) {
+		release();
+		return false;
+	}
+	previousBitmap = SelectObject(memoryContext, bitmap);
+	SelectObject(memoryContext, font);
+	SetTextColor(memoryContext, RGB(255, 255, 255));
+	SetBkMode(memoryContext, TRANSPARENT);
+	width = cellWidth;
+	height = cellHeight;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	rasterize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--					char16_t glyph:			the character to draw
+--					uint8_t * coverage:		width * height bytes, all 0 on entry
+--					int width, height:		cell size in pixels; the same as given to setFont
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Leaves coverage empty if setFont has not succeeded or the sizes disagree.
+----------------------------------------------------------------------------------------------------------------------*/
+void GdiGlyphRasterizer::rasterize(char16_t glyph, uint8_t * coverage, int cellWidth, int cellHeight) {
+	WCHAR text = (WCHAR)glyph;
+	size_t area = (size_t)width * height;
+
+	if (bits == NULL || cellWidth != width || cellHeight != height) {
+		return;
+	}
+	memset(bits, 0, area * sizeof(uint32_t));
+	TextOutW(memoryContext, 0, 0, &text, 1);
+	GdiFlush();
+	for (size_t i = 0; i < area; i++) {
+		coverage[i] = (uint8_t)(bits[i] >> 8);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	release
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID release(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+VOID GdiGlyphRasterizer::release() {
+	if (memoryContext != NULL && previousBitmap != NULL) {
+		SelectObject(memoryContext, previousBitmap);
+	}
+	if (bitmap != NULL) {
+		DeleteObject(bitmap);
+	}
+	if (memoryContext != NULL) {
+		DeleteDC(memoryContext);
+	}
+	memoryContext = NULL;
+	bitmap = NULL;
+	previousBitmap = NULL;
+	bits = NULL;
+	width = 0;
+	height = 0;
+}
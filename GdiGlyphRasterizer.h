@@ -0,0 +1,48 @@
+#pragma once
+
+#include <windows.h>
+#include <stdint.h>
+#include "GlyphAtlas.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		GdiGlyphRasterizer.h -	Rasterizes glyph atlas tiles with a GDI font.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL setFont(HFONT font, int cellWidth, int cellHeight)
+--					void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Each glyph is drawn white on black into a one-cell DIB section with TextOutW, and its green channel is read back
+-- as coverage. This is the only GDI text call left on the paint path, and it only runs on an atlas miss.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class GdiGlyphRasterizer : public GlyphRasterizer {
+private:
+	HDC memoryContext = NULL;
+	HBITMAP bitmap = NULL;
+	HGDIOBJ previousBitmap = NULL;
+	uint32_t * bits = NULL;
+	int width = 0;
+	int height = 0;
+
+	VOID release();
+public:
+	GdiGlyphRasterizer() {};
+	GdiGlyphRasterizer(const GdiGlyphRasterizer &) = delete;
+	GdiGlyphRasterizer & operator=(const GdiGlyphRasterizer &) = delete;
+	~GdiGlyphRasterizer() { release(); };
+
+	BOOL setFont(HFONT font, int cellWidth, int cellHeight);
+	void rasterize(char16_t glyph, uint8_t * coverage, int width, int height) override;
+};
@@ -0,0 +1,260 @@
+#include <windows.h>
+#include "GdiRenderer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		GdiRenderer.cpp -	Draws the terminal view into a window with GDI.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL loadMetrics(void)
+--					VOID invalidateCells(const CellRect * area)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					VOID present(const RECT & area)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Composes frames from a glyph atlas and presents them with one blit
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Moved out of DisplayService so the window is just one of the places the view can be drawn. The palette moved to
+-- GlyphAtlas along with the drawing itself.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	loadMetrics
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL loadMetrics(void)
+--
+-- RETURNS:		BOOL - true only on the call that read the metrics
+--
+-- NOTES:
+-- Selects the stock fixed font once and caches its cell size, and sizes the glyph atlas to match. Later calls return
+-- at once.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL GdiRenderer::loadMetrics() {
+	HDC metricsContext;
+	TEXTMETRIC textMetric;
+
+	if (hasMetrics) {
+		return false;
+	}
+	font = (HFONT)GetStockObject(SYSTEM_FIXED_FONT);
+	metricsContext = GetDC(*windowHandle);
+	SelectObject(metricsContext, font);
+	GetTextMetrics(metricsContext, &textMetric);
+	ReleaseDC(*windowHandle, metricsContext);
+
+	cellWidth = textMetric.tmAveCharWidth;
+	cellHeight = textMetric.tmHeight + textMetric.tmExternalLeading;
+	hasMetrics = true;
+
+	rasterizer.setFont(font, cellWidth, cellHeight);
+	atlas.setCellSize(cellWidth, cellHeight);
+	bitmapInfo = {};
+	bitmapInfo.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+	bitmapInfo.bmiHeader.biPlanes = 1;
+	bitmapInfo.bmiHeader.biBitCount = 32;
+	bitmapInfo.bmiHeader.biCompression = BI_RGB;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	invalidateCells
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID invalidateCells(const CellRect * area)
+--					const CellRect * area:	cells to repaint, or NULL for the whole window
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Queues a WM_PAINT for the pixels under the cells without erasing them first.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID GdiRenderer::invalidateCells(const CellRect * area) {
+	RECT pixels;
+
+	if (area == NULL) {
+		InvalidateRect(*windowHandle, NULL, FALSE);
+		return;
+	}
+	pixels.left = area->left * cellWidth;
+	pixels.top = area->top * cellHeight;
+	pixels.right = (area->right + 1) * cellWidth;
+	pixels.bottom = (area->bottom + 1) * cellHeight;
+	InvalidateRect(*windowHandle, &pixels, FALSE);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool beginFrame(CellRect * damage)
+--					CellRect * damage:	set to the cells under the update rectangle
+--
+-- RETURNS:		bool - always true; Windows only sends WM_PAINT when something needs drawing
+--
+-- NOTES:
+-- The back buffer is resized to cover the client area first. A resized buffer is blank, so then the damage is all
+-- of it, not just the update rectangle.
+----------------------------------------------------------------------------------------------------------------------*/
+bool GdiRenderer::beginFrame(CellRect * damage) {
+	RECT client;
+	CellRect lost;
+
+	loadMetrics();
+	deviceContext = BeginPaint(*windowHandle, &paintStruct);
+
+	GetClientRect(*windowHandle, &client);
+	int columns = (client.right + cellWidth - 1) / cellWidth;
+	int rows = (client.bottom + cellHeight - 1) / cellHeight;
+	if (columns != compositor.getColumns() || rows != compositor.getRows()
+		|| compositor.getWidth() != compositor.getColumns() * cellWidth) {
+		compositor.resize(columns, rows);
+	}
+
+	damage->top = paintStruct.rcPaint.top / cellHeight;
+	damage->bottom = (paintStruct.rcPaint.bottom - 1) / cellHeight;
+	damage->left = paintStruct.rcPaint.left / cellWidth;
+	damage->right = (paintStruct.rcPaint.right - 1) / cellWidth;
+	if (compositor.beginFrame(&lost)) {
+		*damage = lost;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	drawRun
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					int row, column:			first cell of the run
+--					const char16_t * glyphs:	count glyphs
+--					int count:					cells in the run
+--					uint8_t attribute:			colours of every cell in the run
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void GdiRenderer::drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) {
+	compositor.drawRun(row, column, glyphs, count, attribute);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	fillBlank
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void fillBlank(int row, int column, int count, uint8_t attribute)
+--					int row, column:		first cell to fill
+--					int count:				cells to fill
+--					uint8_t attribute:		whose background to fill with
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void GdiRenderer::fillBlank(int row, int column, int count, uint8_t attribute) {
+	compositor.fillBlank(row, column, count, attribute);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void endFrame(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Presents the update rectangle, which covers every cell drawn this frame: renderView only draws the damage and the
+-- cells DisplayService invalidated.
+----------------------------------------------------------------------------------------------------------------------*/
+void GdiRenderer::endFrame() {
+	compositor.endFrame();
+	present(paintStruct.rcPaint);
+	EndPaint(*windowHandle, &paintStruct);
+	deviceContext = NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	present
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID present(const RECT & area)
+--					const RECT & area:	client pixels to copy from the back buffer
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The band of rows is passed as its own top-down DIB starting at its first row, which sidesteps SetDIBitsToDevice's
+-- bottom-up source coordinates.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID GdiRenderer::present(const RECT & area) {
+	int left = area.left < 0 ? 0 : area.left;
+	int top = area.top < 0 ? 0 : area.top;
+	int right = area.right < compositor.getWidth() ? area.right : compositor.getWidth();
+	int bottom = area.bottom < compositor.getHeight() ? area.bottom : compositor.getHeight();
+
+	if (left >= right || top >= bottom) {
+		return;
+	}
+	bitmapInfo.bmiHeader.biWidth = compositor.getWidth();
+	bitmapInfo.bmiHeader.biHeight = -(bottom - top);
+	SetDIBitsToDevice(deviceContext, left, top, right - left, bottom - top, left, 0, 0, bottom - top,
+		compositor.getPixels() + (size_t)top * compositor.getWidth(), &bitmapInfo, DIB_RGB_COLORS);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <windows.h>
+#include "Renderer.h"
+#include "GlyphAtlas.h"
+#include "BitmapCompositor.h"
+#include "GdiGlyphRasterizer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		GdiRenderer.h -	Draws the terminal view into a window with GDI.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					BOOL loadMetrics(void)
+--					VOID invalidateCells(const CellRect * area)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					VOID present(const RECT & area)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Composes frames from a glyph atlas and presents them with one blit
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A frame is one WM_PAINT: beginFrame calls BeginPaint and reports the update rectangle as damage, and endFrame
+-- calls EndPaint. Only call beginFrame from the window's paint handler.
+--
+-- Runs are not drawn with text calls. Each cell is copied from a GlyphAtlas into a BitmapCompositor's back buffer,
+-- which covers the client area, and endFrame presents the update rectangle from it with one SetDIBitsToDevice. A
+-- glyph is only rasterized by GDI the first time it appears in a colour; getAtlas gives its hit-rate counters.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class GdiRenderer : public Renderer {
+private:
+	HWND * windowHandle;
+	PAINTSTRUCT paintStruct;
+	HDC deviceContext = NULL;
+
+	// Cached once; the stock fixed font never changes while the program runs
+	HFONT font = NULL;
+	int cellWidth = 0;
+	int cellHeight = 0;
+	BOOL hasMetrics = false;
+
+	GdiGlyphRasterizer rasterizer;
+	GlyphAtlas atlas;
+	BitmapCompositor compositor;
+	BITMAPINFO bitmapInfo;
+
+	VOID present(const RECT & area);
+public:
+	GdiRenderer(HWND * hwnd) : windowHandle(hwnd), atlas(rasterizer), compositor(atlas, 1, 1) {};
+	GdiRenderer(const GdiRenderer &) = delete;
+	GdiRenderer & operator=(const GdiRenderer &) = delete;
+
+	BOOL loadMetrics();
+	VOID invalidateCells(const CellRect * area);
+	BOOL getHasMetrics() const { return hasMetrics; };
+	int getCellWidth() const { return cellWidth; };
+	int getCellHeight() const { return cellHeight; };
+	const GlyphAtlas & getAtlas() const { return atlas; };
+
+	bool beginFrame(CellRect * damage) override;
+	void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) override;
+	void fillBlank(int row, int column, int count, uint8_t attribute) override;
+	void endFrame() override;
+};
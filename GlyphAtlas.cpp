@@ -0,0 +1,256 @@
+#include <string.h>
+#include "GlyphAtlas.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		GlyphAtlas.cpp -	A cache of rasterized cells, one per glyph and attribute.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					GlyphAtlas(GlyphRasterizer & rasterizer, size_t capacity)
+--					void setCellSize(int width, int height)
+--					const uint32_t * insert(uint32_t key, size_t entry)
+--					void clear(void)
+--					double getHitRate(void) const
+--					void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--					uint32_t blendPixel(uint32_t background, uint32_t foreground, uint8_t alpha)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The table has twice as many entries as there are tiles, rounded up to a power of two, so probes stay short even
+-- when the atlas is full. Entries are never removed one at a time, which is what lets linear probing stop at the
+-- first empty entry.
+----------------------------------------------------------------------------------------------------------------------*/
+
+const uint32_t PIXEL_PALETTE[16] = {
+	0x000000, 0xAA0000, 0x00AA00, 0xAA5500,
+	0x0000AA, 0xAA00AA, 0x00AAAA, 0xFFFFFF,
+	0x555555, 0xFF5555, 0x55FF55, 0xFFFF55,
+	0x5555FF, 0xFF55FF, 0x55FFFF, 0xFFFFFF
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	blendPixel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint32_t blendPixel(uint32_t background, uint32_t foreground, uint8_t alpha)
+--					uint32_t background:	0x00RRGGBB
+--					uint32_t foreground:	0x00RRGGBB
+--					uint8_t alpha:			foreground coverage, 0-255
+--
+-- RETURNS:		uint32_t - the mixed colour, 0x00RRGGBB
+----------------------------------------------------------------------------------------------------------------------*/
+static uint32_t blendPixel(uint32_t background, uint32_t foreground, uint8_t alpha) {
+	uint32_t pixel = 0;
+
+	for (int shift = 0; shift < 24; shift += 8) {
+		uint32_t back = background >> shift & 0xFF;
+		uint32_t fore = foreground >> shift & 0xFF;
+		pixel |= ((back * (255 - alpha) + fore * alpha + 127) / 255) << shift;
+	}
+	return pixel;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	rasterize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--					char16_t glyph:			the character to draw
+--					uint8_t * coverage:		width * height bytes, all 0 on entry
+--					int width, height:		cell size in pixels
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- PatternRasterizer: a space is left empty; anything else lights some of a 3 by 5 grid of blocks inside a one pixel
+-- margin, chosen by hashing the code point. Different characters nearly always look different, which is all a
+-- benchmark or a pixel hash needs.
+----------------------------------------------------------------------------------------------------------------------*/
+void PatternRasterizer::rasterize(char16_t glyph, uint8_t * coverage, int width, int height) {
+	uint32_t blocks = ((uint32_t)glyph * 2654435761u) >> 17;
+	int innerWidth = width - 2;
+	int innerHeight = height - 2;
+
+	if (glyph == u' ' || innerWidth < 3 || innerHeight < 5) {
+		return;
+	}
+	for (int y = 0; y < innerHeight; y++) {
+		int blockRow = y * 5 / innerHeight;
+		for (int x = 0; x < innerWidth; x++) {
+			int blockColumn = x * 3 / innerWidth;
+			if (blocks >> (blockRow * 3 + blockColumn) & 1) {
+				coverage[(size_t)(y + 1) * width + x + 1] = 255;
+			}
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	GlyphAtlas
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	GlyphAtlas(GlyphRasterizer & rasterizer, size_t capacity)
+--					GlyphRasterizer & rasterizer:	draws tiles on a miss; must outlive the atlas
+--					size_t capacity:				tiles kept before the atlas is flushed
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+GlyphAtlas::GlyphAtlas(GlyphRasterizer & glyphRasterizer, size_t tileCapacity)
+	: rasterizer(glyphRasterizer), capacity(tileCapacity < 1 ? 1 : tileCapacity) {
+	size_t entries = 2;
+	int bits = 1;
+
+	while (entries < capacity * 2) {
+		entries <<= 1;
+		bits++;
+	}
+	tableShift = 32 - bits;
+	keys.assign(entries, 0);
+	tileIndexes.assign(entries, 0);
+	setCellSize(1, 1);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setCellSize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setCellSize(int width, int height)
+--					int width, height:	cell size in pixels
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Drops every tile. The tile memory is allocated here, once, so lookups never allocate.
+----------------------------------------------------------------------------------------------------------------------*/
+void GlyphAtlas::setCellSize(int width, int height) {
+	cellWidth = width < 1 ? 1 : width;
+	cellHeight = height < 1 ? 1 : height;
+	pixels.assign(capacity * cellWidth * cellHeight, 0);
+	coverage.assign((size_t)cellWidth * cellHeight, 0);
+	clear();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	clear
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void clear(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void GlyphAtlas::clear() {
+	memset(keys.data(), 0, keys.size() * sizeof(uint32_t));
+	tileCount = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	insert
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint32_t * insert(uint32_t key, size_t entry)
+--					uint32_t key:	glyph and attribute, as lookup builds it
+--					size_t entry:	the empty table entry where the probe for key ended
+--
+-- RETURNS:		const uint32_t * - the new tile's pixels
+--
+-- NOTES:
+-- The miss path of lookup: rasterizes the glyph and colours it with the attribute's palette entries.
+----------------------------------------------------------------------------------------------------------------------*/
+const uint32_t * GlyphAtlas::insert(uint32_t key, size_t entry) {
+	char16_t glyph = (char16_t)(key >> 8);
+	uint8_t attribute = (uint8_t)key;
+	uint32_t foreground = PIXEL_PALETTE[attribute & 0x0F];
+	uint32_t background = PIXEL_PALETTE[attribute >> 4];
+	size_t area = (size_t)cellWidth * cellHeight;
+
+	misses++;
+	if (tileCount == capacity) {
+		clear();
+		flushes++;
+		entry = probeStart(key);
+	}
+
+	memset(coverage.data(), 0, area);
+	rasterizer.rasterize(glyph, coverage.data(), cellWidth, cellHeight);
+
+	uint32_t * tile = &pixels[tileCount * area];
+	for (size_t i = 0; i < area; i++) {
+		uint8_t alpha = coverage[i];
+		tile[i] = alpha == 0 ? background : alpha == 255 ? foreground : blendPixel(background, foreground, alpha);
+	}
+
+	keys[entry] = key;
+	tileIndexes[entry] = (uint32_t)tileCount++;
+	return tile;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getHitRate
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double getHitRate(void) const
+--
+-- RETURNS:		double - hits over lookups since the counters were last reset, or 0 before any lookup
+----------------------------------------------------------------------------------------------------------------------*/
+double GlyphAtlas::getHitRate() const {
+	uint64_t lookups = hits + misses;
+	return lookups == 0 ? 0.0 : (double)hits / lookups;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		GlyphAtlas.h -	A cache of rasterized cells, one per glyph and attribute.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void setCellSize(int width, int height)
+--					const uint32_t * lookup(char16_t glyph, uint8_t attribute)
+--					void resetCounters(void)
+--					double getHitRate(void) const
+--					void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Each tile is one cell, already coloured: 32-bit 0x00RRGGBB pixels, row by row, the layout of a 32 bpp DIB. A
+-- glyph is rasterized the first time it is seen in an attribute and only copied after that, so a screen of output
+-- costs one font rasterization per distinct character and colour instead of one text call per run.
+--
+-- Tiles are found through an open-addressed table keyed by glyph and attribute. The atlas has a fixed number of
+-- tiles; when it fills, every tile is dropped at once and the cache refills from what is on screen. A terminal shows
+-- a few hundred distinct cells at most, so with the default size this only happens on unusual output.
+--
+-- A GlyphRasterizer supplies the shapes as 8-bit coverage. GdiGlyphRasterizer draws with the window's font;
+-- PatternRasterizer draws a fixed pattern per code point so the atlas and compositor run with no font at all.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t GLYPH_ATLAS_CAPACITY = 4096;	// tiles
+
+// Palette indexed by the attribute nibbles as 0x00RRGGBB; entries 0-7 follow the ANSI colour order, 8-15 are bright
+extern const uint32_t PIXEL_PALETTE[16];
+
+class GlyphRasterizer {
+public:
+	virtual ~GlyphRasterizer() {};
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	rasterize
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	void rasterize(char16_t glyph, uint8_t * coverage, int width, int height)
+	--					char16_t glyph:			the character to draw
+	--					uint8_t * coverage:		width * height bytes, all 0 on entry; 255 is fully foreground
+	--					int width, height:		cell size in pixels
+	--
+	-- RETURNS:		void
+	--------------------------------------------------------------------------------------------------------------*/
+	virtual void rasterize(char16_t glyph, uint8_t * coverage, int width, int height) = 0;
+};
+
+class PatternRasterizer : public GlyphRasterizer {
+public:
+	void rasterize(char16_t glyph, uint8_t * coverage, int width, int height) override;
+};
+
+class GlyphAtlas {
+private:
+	GlyphRasterizer & rasterizer;
+	int cellWidth = 0;
+	int cellHeight = 0;
+	size_t capacity;
+	size_t tileCount = 0;
+	int tableShift;
+
+	std::vector<uint32_t> keys;			// 0 when the entry is empty
+	std::vector<uint32_t> tileIndexes;
+	std::vector<uint32_t> pixels;		// capacity tiles of cellWidth * cellHeight
+	std::vector<uint8_t> coverage;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t flushes = 0;
+
+	static constexpr uint32_t KEY_USED = 0x80000000;
+
+	size_t probeStart(uint32_t key) const { return (size_t)((key * 2654435761u) >> tableShift); };
+	const uint32_t * insert(uint32_t key, size_t entry);
+	void clear();
+public:
+	GlyphAtlas(GlyphRasterizer & rasterizer, size_t capacity = GLYPH_ATLAS_CAPACITY);
+	GlyphAtlas(const GlyphAtlas &) = delete;
+	GlyphAtlas & operator=(const GlyphAtlas &) = delete;
+
+	void setCellSize(int width, int height);
+	void resetCounters() { hits = 0; misses = 0; flushes = 0; };
+	double getHitRate() const;
+
+	int getCellWidth() const { return cellWidth; };
+	int getCellHeight() const { return cellHeight; };
+	size_t getTileCount() const { return tileCount; };
+	uint64_t getHits() const { return hits; };
+	uint64_t getMisses() const { return misses; };
+	uint64_t getFlushes() const { return flushes; };
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	lookup
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	const uint32_t * lookup(char16_t glyph, uint8_t attribute)
+	--					char16_t glyph:			the character in the cell
+	--					uint8_t attribute:		its colours
+	--
+	-- RETURNS:		const uint32_t * - the cell's pixels, cellWidth per row; valid until the next lookup that misses
+	--
+	-- NOTES:
+	-- Call setCellSize first. A miss rasterizes the tile; a hit is a hash and usually one compare.
+	--------------------------------------------------------------------------------------------------------------*/
+	const uint32_t * lookup(char16_t glyph, uint8_t attribute) {
+		uint32_t key = KEY_USED | (uint32_t)glyph << 8 | attribute;
+		size_t mask = keys.size() - 1;
+		size_t entry = probeStart(key);
+
+		while (keys[entry] != 0) {
+			if (keys[entry] == key) {
+				hits++;
+				return &pixels[(size_t)tileIndexes[entry] * cellWidth * cellHeight];
+			}
+			entry = (entry + 1) & mask;
+		}
+		return insert(key, entry);
+	}
+};
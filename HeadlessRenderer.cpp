@@ -0,0 +1,274 @@
+#include <string.h>
+#include "HeadlessRenderer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		HeadlessRenderer.cpp -	Draws the terminal view into an in-memory text grid.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void resize(int columns, int rows)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					uint64_t hash(void) const
+--					std::string dumpText(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Runs that fall partly outside the grid are clipped with clipRun, as GDI clips to the window.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	HeadlessRenderer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	HeadlessRenderer(int columns, int rows)
+--					int columns:	cells per row
+--					int rows:		rows in the grid
+----------------------------------------------------------------------------------------------------------------------*/
+HeadlessRenderer::HeadlessRenderer(int columns, int rows) : columns(0), rows(0) {
+	resize(columns, rows);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	resize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void resize(int newColumns, int newRows)
+--					int newColumns:		cells per row, at least 1
+--					int newRows:		rows in the grid, at least 1
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The grid is cleared to blanks and the whole of it is damaged on the next frame.
+----------------------------------------------------------------------------------------------------------------------*/
+void HeadlessRenderer::resize(int newColumns, int newRows) {
+	columns = newColumns < 1 ? 1 : newColumns;
+	rows = newRows < 1 ? 1 : newRows;
+	glyphs.assign((size_t)columns * rows, BLANK_GLYPH);
+	attributes.assign((size_t)columns * rows, ATTR_DEFAULT);
+	isInvalid = true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	beginFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool beginFrame(CellRect * damage)
+--					CellRect * damage:	set to the whole grid if it was invalidated
+--
+-- RETURNS:		bool - true if the grid was invalidated since the last frame
+----------------------------------------------------------------------------------------------------------------------*/
+bool HeadlessRenderer::beginFrame(CellRect * damage) {
+	if (!isInvalid) {
+		return false;
+	}
+	isInvalid = false;
+	damage->top = 0;
+	damage->left = 0;
+	damage->bottom = rows - 1;
+	damage->right = columns - 1;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	drawRun
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void drawRun(int row, int column, const char16_t * runGlyphs, int count, uint8_t attribute)
+--					int row, column:			first cell of the run
+--					const char16_t * runGlyphs:	count glyphs
+--					int count:					cells in the run
+--					uint8_t attribute:			colours of every cell in the run
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void HeadlessRenderer::drawRun(int row, int column, const char16_t * runGlyphs, int count, uint8_t attribute) {
+	int first = column;
+
+	if (!clipRun(row, &column, &count, columns, rows)) {
+		return;
+	}
+	size_t cell = (size_t)row * columns + column;
+	memcpy(&glyphs[cell], runGlyphs + (column - first), (size_t)count * sizeof(char16_t));
+	memset(&attributes[cell], attribute, (size_t)count);
+	runCount++;
+	cellCount += count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	fillBlank
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void fillBlank(int row, int column, int count, uint8_t attribute)
+--					int row, column:		first cell to fill
+--					int count:				cells to fill
+--					uint8_t attribute:		attribute the blanks take
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void HeadlessRenderer::fillBlank(int row, int column, int count, uint8_t attribute) {
+	if (!clipRun(row, &column, &count, columns, rows)) {
+		return;
+	}
+	size_t cell = (size_t)row * columns + column;
+	for (int i = 0; i < count; i++) {
+		glyphs[cell + i] = BLANK_GLYPH;
+	}
+	memset(&attributes[cell], attribute, (size_t)count);
+	runCount++;
+	cellCount += count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void endFrame(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void HeadlessRenderer::endFrame() {
+	frameCount++;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	hash
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint64_t hash(void) const
+--
+-- RETURNS:		uint64_t - FNV-1a of the grid size, then every cell's glyph (low byte first) and attribute
+--
+-- NOTES:
+-- The value depends only on what is shown, never on how many frames or runs it took to draw it.
+----------------------------------------------------------------------------------------------------------------------*/
+uint64_t HeadlessRenderer::hash() const {
+	uint64_t value = FNV_OFFSET_BASIS;
+	auto mix = [&value](uint8_t byte) {
+		value = (value ^ byte) * FNV_PRIME;
+	};
+
+	mix((uint8_t)columns);
+	mix((uint8_t)(columns >> 8));
+	mix((uint8_t)rows);
+	mix((uint8_t)(rows >> 8));
+	for (size_t cell = 0; cell < glyphs.size(); cell++) {
+		mix((uint8_t)glyphs[cell]);
+		mix((uint8_t)(glyphs[cell] >> 8));
+		mix(attributes[cell]);
+	}
+	return value;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	dumpText
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::string dumpText(void) const
+--
+-- RETURNS:		std::string - one UTF-8 line per row, each ending in '\n', trailing blanks removed
+--
+-- NOTES:
+-- Attributes are left out so a golden file stays readable; compare hash as well to catch colour changes.
+----------------------------------------------------------------------------------------------------------------------*/
+std::string HeadlessRenderer::dumpText() const {
+	std::string text;
+
+	text.reserve((size_t)(columns + 1) * rows);
+	for (int row = 0; row < rows; row++) {
+		const char16_t * line = &glyphs[(size_t)row * columns];
+		int length = columns;
+
+		while (length > 0 && line[length - 1] == BLANK_GLYPH) {
+			length--;
+		}
+		for (int column = 0; column < length; column++) {
+			char16_t glyph = line[column];
+			if (glyph < 0x80) {
+				text += (char)glyph;
+			}
+			else if (glyph < 0x800) {
+				text += (char)(0xC0 | (glyph >> 6));
+				text += (char)(0x80 | (glyph & 0x3F));
+			}
+			else {
+				text += (char)(0xE0 | (glyph >> 12));
+				text += (char)(0x80 | ((glyph >> 6) & 0x3F));
+				text += (char)(0x80 | (glyph & 0x3F));
+			}
+		}
+		text += '\n';
+	}
+	return text;
+}
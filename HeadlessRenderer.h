@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Renderer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		HeadlessRenderer.h -	Draws the terminal view into an in-memory text grid.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void resize(int columns, int rows)
+--					void invalidate(void)
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					uint64_t hash(void) const
+--					std::string dumpText(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The grid holds what a window would show after each frame: one glyph and one attribute per cell, laid out like
+-- ScreenModel's. Drawing a run is a copy into it, so the renderer keeps up with anything the model can produce and
+-- the cost measured in a benchmark is the paint path's own. It needs no window and no thread of its own.
+--
+-- For golden-screen tests, hash gives a 64-bit FNV-1a of every glyph and attribute and dumpText gives the glyphs as
+-- UTF-8 lines with trailing blanks trimmed. Like a window that was just uncovered, a new or resized grid reports
+-- itself as damaged on the next frame; call invalidate after changing the view offset for the same reason.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class HeadlessRenderer : public Renderer {
+private:
+	int columns;
+	int rows;
+	std::vector<char16_t> glyphs;
+	std::vector<uint8_t> attributes;
+	bool isInvalid = true;
+
+	uint64_t frameCount = 0;
+	uint64_t runCount = 0;
+	uint64_t cellCount = 0;
+public:
+	HeadlessRenderer(int columns, int rows);
+
+	void resize(int columns, int rows);
+	void invalidate() { isInvalid = true; };
+	uint64_t hash() const;
+	std::string dumpText() const;
+
+	int getColumns() const { return columns; };
+	int getRows() const { return rows; };
+	char16_t getGlyph(int row, int column) const { return glyphs[(size_t)row * columns + column]; };
+	uint8_t getAttribute(int row, int column) const { return attributes[(size_t)row * columns + column]; };
+	uint64_t getFrameCount() const { return frameCount; };
+	uint64_t getRunCount() const { return runCount; };
+	uint64_t getCellCount() const { return cellCount; };
+
+	bool beginFrame(CellRect * damage) override;
+	void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) override;
+	void fillBlank(int row, int column, int count, uint8_t attribute) override;
+	void endFrame() override;
+};
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include "IocpMultiplexer.h"
+#include "Win32Transport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		IocpMultiplexer.cpp -	PortMultiplexer that waits on every port with one I/O completion port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool openQueue(void)
+--					void closeQueue(void)
+--					std::unique_ptr<Port> attach(SerialTransport * transport)
+--					bool detach(Port * port)
+--					int wait(Port ** ready, int capacity, uint32_t timeout)
+--					void rearm(Port * port)
+--					void wake(void)
+--					bool issueRead(IocpPort * port)
+--					std::unique_ptr<PortMultiplexer> createPortMultiplexer(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This file is built on Windows only; EpollMultiplexer.cpp provides createPortMultiplexer elsewhere. Wake packets
+-- are posted with no OVERLAPPED, which is how wait tells them from a read.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openQueue
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openQueue(void)
+--
+-- RETURNS:		bool - false if the completion port could not be created
+----------------------------------------------------------------------------------------------------------------------*/
+bool IocpMultiplexer::openQueue() {
+	completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+	return completionPort != NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeQueue
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void closeQueue(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void IocpMultiplexer::closeQueue() {
+	if (completionPort != NULL) {
+		CloseHandle(completionPort);
+		completionPort = NULL;
+	}
+	attached.clear();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	attach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<Port> attach(SerialTransport * transport)
+--					SerialTransport * transport:	an open Win32Transport
+--
+-- RETURNS:		std::unique_ptr<Port> - the port with its first read pending, or nullptr if it could not be attached
+--
+-- NOTES:
+-- With ReadIntervalTimeout and ReadTotalTimeoutMultiplier both MAXDWORD, a read returns as soon as one byte is in
+-- the driver queue, with everything queued up to the buffer size, and only waits out the constant when idle.
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortMultiplexer::Port> IocpMultiplexer::attach(SerialTransport * transport) {
+	Win32Transport * win32 = dynamic_cast<Win32Transport *>(transport);
+	COMMTIMEOUTS timeouts = { MAXDWORD, MAXDWORD, IOCP_READ_TIMEOUT, 0, 0 };
+	std::unique_ptr<IocpPort> port;
+
+	if (win32 == nullptr || win32->getHandle() == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	port.reset(new IocpPort());
+	port->handle = win32->getHandle();
+	if (!SetCommTimeouts(port->handle, &timeouts)
+		|| CreateIoCompletionPort(port->handle, completionPort, 0, 0) == NULL) {
+		return nullptr;
+	}
+	if (!issueRead(port.get())) {
+		return nullptr;
+	}
+	attached.push_back(port.get());
+	return std::unique_ptr<Port>(port.release());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	detach
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool detach(Port * port)
+--					Port * port:	a port from attach
+--
+-- RETURNS:		bool - true if no read was pending; false if the cancelled read has still to come back
+--
+-- NOTES:
+-- The buffer and OVERLAPPED belong to the driver until the cancelled read completes, so the port is only freed once
+-- wait has seen that completion and handed the port back as Closed.
+----------------------------------------------------------------------------------------------------------------------*/
+bool IocpMultiplexer::detach(Port * port) {
+	IocpPort * iocpPort = static_cast<IocpPort *>(port);
+
+	if (iocpPort->isReadPending) {
+		// If the read has just completed there is nothing to cancel, but its packet is queued all the same
+		CancelIoEx(iocpPort->handle, &iocpPort->overlap);
+		return false;
+	}
+	attached.erase(std::remove(attached.begin(), attached.end(), iocpPort), attached.end());
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wait
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int wait(Port ** ready, int capacity, uint32_t timeout)
+--					Port ** ready:		filled with the ports whose read completed, failed or was cancelled
+--					int capacity:		entries in ready
+--					uint32_t timeout:	ms to wait, or WAIT_FOREVER
+--
+-- RETURNS:		int - ports put in ready
+--
+-- NOTES:
+-- Up to MULTIPLEXER_BATCH completions are taken per call. An idle read that timed out with nothing is reissued here
+-- and not reported.
+----------------------------------------------------------------------------------------------------------------------*/
+int IocpMultiplexer::wait(Port ** ready, int capacity, uint32_t timeout) {
+	OVERLAPPED_ENTRY entries[MULTIPLEXER_BATCH];
+	ULONG removed = 0;
+	DWORD transferred;
+	int count = 0;
+
+	if (!GetQueuedCompletionStatusEx(completionPort, entries,
+		(ULONG)(capacity < MULTIPLEXER_BATCH ? capacity : MULTIPLEXER_BATCH), &removed,
+		timeout == WAIT_FOREVER ? INFINITE : timeout, FALSE)) {
+		return 0;
+	}
+	for (ULONG i = 0; i < removed; i++) {
+		IocpPort * port = nullptr;
+
+		if (entries[i].lpOverlapped == NULL) {
+			continue;
+		}
+		for (IocpPort * candidate : attached) {
+			if (&candidate->overlap == entries[i].lpOverlapped) {
+				port = candidate;
+				break;
+			}
+		}
+		if (port == nullptr) {
+			continue;
+		}
+		port->isReadPending = false;
+
+		if (port->state == PortState::Closing) {
+			port->state = PortState::Closed;
+			attached.erase(std::remove(attached.begin(), attached.end(), port), attached.end());
+		}
+		else if (!GetOverlappedResult(port->handle, &port->overlap, &transferred, FALSE)) {
+			port->state = PortState::Failed;
+		}
+		else if (transferred == 0) {
+			if (!issueRead(port)) {
+				port->state = PortState::Failed;
+				ready[count++] = port;
+			}
+			continue;
+		}
+		else {
+			port->length = transferred;
+		}
+		ready[count++] = port;
+	}
+	return count;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	rearm
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void rearm(Port * port)
+--					Port * port:	a port whose read has been delivered
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void IocpMultiplexer::rearm(Port * port) {
+	if (!issueRead(static_cast<IocpPort *>(port))) {
+		port->state = PortState::Failed;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wake
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void wake(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Safe from any thread.
+----------------------------------------------------------------------------------------------------------------------*/
+void IocpMultiplexer::wake() {
+	if (completionPort != NULL) {
+		PostQueuedCompletionStatus(completionPort, 0, 0, NULL);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	issueRead
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool issueRead(IocpPort * port)
+--					IocpPort * port:	a port with no read pending
+--
+-- RETURNS:		bool - false if the read could not be issued
+--
+-- NOTES:
+-- A read that completes at once still queues a completion packet, so it is handled by wait like any other.
+----------------------------------------------------------------------------------------------------------------------*/
+bool IocpMultiplexer::issueRead(IocpPort * port) {
+	port->overlap = {};
+	if (!ReadFile(port->handle, port->buffer, RX_CHUNK_SIZE, NULL, &port->overlap)
+		&& GetLastError() != ERROR_IO_PENDING) {
+		return false;
+	}
+	port->isReadPending = true;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createPortMultiplexer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<PortMultiplexer> createPortMultiplexer(void)
+--
+-- RETURNS:		std::unique_ptr<PortMultiplexer> - the multiplexer for this platform
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortMultiplexer> createPortMultiplexer() {
+	return std::unique_ptr<PortMultiplexer>(new IocpMultiplexer());
+}
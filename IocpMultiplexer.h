@@ -0,0 +1,64 @@
+#pragma once
+
+#include <windows.h>
+#include <memory>
+#include <vector>
+#include "PortMultiplexer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		IocpMultiplexer.h -	PortMultiplexer that waits on every port with one I/O completion port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool openQueue(void)
+--					void closeQueue(void)
+--					std::unique_ptr<Port> attach(SerialTransport * transport)
+--					bool detach(Port * port)
+--					int wait(Port ** ready, int capacity, uint32_t timeout)
+--					void rearm(Port * port)
+--					void wake(void)
+--					bool issueRead(IocpPort * port)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Each Win32Transport's handle is associated with the completion port and always has one overlapped ReadFile of up
+-- to RX_CHUNK_SIZE pending. The port's COMMTIMEOUTS are changed so that read completes as soon as any byte arrives,
+-- or with nothing after IOCP_READ_TIMEOUT, when it is simply issued again. A handle can only be associated once, so
+-- a transport can be attached once per open; CommReader is not used while it is.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr DWORD IOCP_READ_TIMEOUT = 60000;		// ms an idle read waits before it is reissued
+
+class IocpMultiplexer : public PortMultiplexer {
+private:
+	struct IocpPort : public Port {
+		HANDLE handle = INVALID_HANDLE_VALUE;
+		OVERLAPPED overlap = {};
+		bool isReadPending = false;
+	};
+
+	HANDLE completionPort = NULL;
+	std::vector<IocpPort *> attached;		// to tell our reads from other completions on the same handles
+
+	bool issueRead(IocpPort * port);
+protected:
+	bool openQueue() override;
+	void closeQueue() override;
+	std::unique_ptr<Port> attach(SerialTransport * transport) override;
+	bool detach(Port * port) override;
+	int wait(Port ** ready, int capacity, uint32_t timeout) override;
+	void rearm(Port * port) override;
+	void wake() override;
+public:
+	IocpMultiplexer() {};
+	~IocpMultiplexer() { stop(); };
+};
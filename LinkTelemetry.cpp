@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include "LinkTelemetry.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		LinkTelemetry.cpp -	Per-port counters, UART error accounting and receive-to-paint latency.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void countPaint(int64_t arrival)
+--					void reset(void)
+--					TelemetrySnapshot snapshot(void) const
+--					void formatStatus(const TelemetrySnapshot & snapshot, char * text, size_t capacity)
+--					void writeJson(FILE * out, const char * portName, const TelemetrySnapshot & snapshot)
+--					double percentile(double fraction) const
+--					int latencyBucket(uint64_t microseconds)
+--					double bucketLimit(int bucket)
+--					const char * scaleBytes(uint64_t bytes, double * scaled)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A snapshot reads each counter once, relaxed, so it is consistent per counter but not across them: bytes_received
+-- may already include a chunk whose read is not yet counted. That is fine for a status line and for monitoring.
+----------------------------------------------------------------------------------------------------------------------*/
+
+static const char * const LINE_ERROR_NAMES[LINE_ERROR_KINDS] = { "overrun", "input_overflow", "framing", "parity",
+	"break" };
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	latencyBucket
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int latencyBucket(uint64_t microseconds)
+--					uint64_t microseconds:	a latency
+--
+-- RETURNS:		int - the bucket it is counted in, the number of bits needed to hold it capped at the last bucket
+----------------------------------------------------------------------------------------------------------------------*/
+static int latencyBucket(uint64_t microseconds) {
+	int bucket = 0;
+
+	while (microseconds != 0 && bucket < LATENCY_BUCKETS - 1) {
+		microseconds >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	bucketLimit
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double bucketLimit(int bucket)
+--					int bucket:	a latency bucket
+--
+-- RETURNS:		double - the microseconds every latency in the bucket is below; the last bucket has no limit
+----------------------------------------------------------------------------------------------------------------------*/
+static double bucketLimit(int bucket) {
+	return (double)((uint64_t)1 << bucket);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scaleBytes
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const char * scaleBytes(uint64_t bytes, double * scaled)
+--					uint64_t bytes:		a byte count
+--					double * scaled:	set to the count in the unit returned
+--
+-- RETURNS:		const char * - "B", "KB", "MB" or "GB"
+----------------------------------------------------------------------------------------------------------------------*/
+static const char * scaleBytes(uint64_t bytes, double * scaled) {
+	static const char * const UNITS[] = { "B", "KB", "MB", "GB" };
+	int unit = 0;
+
+	*scaled = (double)bytes;
+	while (*scaled >= 1000 && unit < 3) {
+		*scaled /= 1000;
+		unit++;
+	}
+	return UNITS[unit];
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	percentile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double percentile(double fraction) const
+--					double fraction:	0.5 for the median, 0.99 for the 99th percentile
+--
+-- RETURNS:		double - microseconds the given fraction of paints came in under, 0 with no samples
+--
+-- NOTES:
+-- The answer is the upper limit of the bucket the percentile falls in, so it can be up to twice the true value; it
+-- is never more than the slowest paint.
+----------------------------------------------------------------------------------------------------------------------*/
+double TelemetrySnapshot::percentile(double fraction) const {
+	uint64_t total = 0;
+	uint64_t wanted;
+
+	for (int i = 0; i < LATENCY_BUCKETS; i++) {
+		total += paintLatency[i];
+	}
+	if (total == 0) {
+		return 0;
+	}
+	wanted = (uint64_t)(fraction * total);
+	wanted = wanted < total ? wanted + 1 : total;
+	for (int i = 0; i < LATENCY_BUCKETS - 1; i++) {
+		if (wanted <= paintLatency[i]) {
+			return bucketLimit(i) < paintMaxUs ? bucketLimit(i) : paintMaxUs;
+		}
+		wanted -= paintLatency[i];
+	}
+	return paintMaxUs;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	countPaint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void countPaint(int64_t arrival)
+--					int64_t arrival:	the mark taken with takeArrival before drawing the batch; 0 is ignored
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function on the window thread once the batch has been presented.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinkTelemetry::countPaint(int64_t arrival) {
+	int64_t elapsed;
+
+	if (arrival == 0) {
+		return;
+	}
+	elapsed = now() - arrival;
+	if (elapsed < 0) {
+		elapsed = 0;
+	}
+	add(paint.buckets[latencyBucket((uint64_t)elapsed / 1000)], 1);
+	add(paint.samples, 1);
+	if ((uint64_t)elapsed > paint.maxNs.load(std::memory_order_relaxed)) {
+		paint.maxNs.store((uint64_t)elapsed, std::memory_order_relaxed);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	reset
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void reset(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function while none of the writer threads is running, such as before a port is started.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinkTelemetry::reset() {
+	receive.bytes.store(0, std::memory_order_relaxed);
+	receive.calls.store(0, std::memory_order_relaxed);
+	receive.firstArrival.store(0, std::memory_order_relaxed);
+	transmit.bytes.store(0, std::memory_order_relaxed);
+	transmit.calls.store(0, std::memory_order_relaxed);
+	for (std::atomic<uint64_t> & errors : line.errors) {
+		errors.store(0, std::memory_order_relaxed);
+	}
+	line.inputQueueHigh.store(0, std::memory_order_relaxed);
+	line.outputQueueHigh.store(0, std::memory_order_relaxed);
+	for (std::atomic<uint64_t> & bucket : paint.buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	paint.samples.store(0, std::memory_order_relaxed);
+	paint.maxNs.store(0, std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	snapshot
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TelemetrySnapshot snapshot(void) const
+--
+-- RETURNS:		TelemetrySnapshot - every counter as it stands; safe to call from any thread
+----------------------------------------------------------------------------------------------------------------------*/
+TelemetrySnapshot LinkTelemetry::snapshot() const {
+	TelemetrySnapshot result;
+
+	result.bytesReceived = receive.bytes.load(std::memory_order_relaxed);
+	result.readCalls = receive.calls.load(std::memory_order_relaxed);
+	result.bytesSent = transmit.bytes.load(std::memory_order_relaxed);
+	result.writeCalls = transmit.calls.load(std::memory_order_relaxed);
+	for (int i = 0; i < LINE_ERROR_KINDS; i++) {
+		result.lineErrors[i] = line.errors[i].load(std::memory_order_relaxed);
+	}
+	result.inputQueueHigh = line.inputQueueHigh.load(std::memory_order_relaxed);
+	result.outputQueueHigh = line.outputQueueHigh.load(std::memory_order_relaxed);
+	for (int i = 0; i < LATENCY_BUCKETS; i++) {
+		result.paintLatency[i] = paint.buckets[i].load(std::memory_order_relaxed);
+	}
+	result.paintSamples = paint.samples.load(std::memory_order_relaxed);
+	result.paintMaxUs = paint.maxNs.load(std::memory_order_relaxed) / 1000.0;
+	return result;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	formatStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void formatStatus(const TelemetrySnapshot & snapshot, char * text, size_t capacity)
+--					const TelemetrySnapshot & snapshot:	the counters to describe
+--					char * text:						set to one line for the status area
+--					size_t capacity:					size of text, including the terminator
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void LinkTelemetry::formatStatus(const TelemetrySnapshot & snapshot, char * text, size_t capacity) {
+	double received, sent;
+	const char * receivedUnit = scaleBytes(snapshot.bytesReceived, &received);
+	const char * sentUnit = scaleBytes(snapshot.bytesSent, &sent);
+
+	snprintf(text, capacity,
+		"RX %.1f %s in %llu reads   TX %.1f %s in %llu writes   Errors: overrun %llu, overflow %llu, framing %llu, "
+		"parity %llu, break %llu   Queue peak: in %llu, out %llu   Paint: p50 %.2f ms, p99 %.2f ms, max %.2f ms",
+		received, receivedUnit, (unsigned long long)snapshot.readCalls, sent, sentUnit,
+		(unsigned long long)snapshot.writeCalls,
+		(unsigned long long)snapshot.lineErrors[(int)LineError::Overrun],
+		(unsigned long long)snapshot.lineErrors[(int)LineError::InputOverflow],
+		(unsigned long long)snapshot.lineErrors[(int)LineError::Framing],
+		(unsigned long long)snapshot.lineErrors[(int)LineError::Parity],
+		(unsigned long long)snapshot.lineErrors[(int)LineError::Break],
+		(unsigned long long)snapshot.inputQueueHigh, (unsigned long long)snapshot.outputQueueHigh,
+		snapshot.percentile(0.50) / 1000, snapshot.percentile(0.99) / 1000, snapshot.paintMaxUs / 1000);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	writeJson
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void writeJson(FILE * out, const char * portName, const TelemetrySnapshot & snapshot)
+--					FILE * out:							where the object goes
+--					const char * portName:				UTF-8 name of the port, or NULL to leave it out
+--					const TelemetrySnapshot & snapshot:	the counters to write
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Writes one JSON object on one line, without a trailing newline, so the caller can put it in an array or under a
+-- key. Only latency buckets with samples are listed; "le" is the bucket's limit in microseconds, null for the last.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinkTelemetry::writeJson(FILE * out, const char * portName, const TelemetrySnapshot & snapshot) {
+	bool isFirst = true;
+
+	fprintf(out, "{ ");
+	if (portName != NULL) {
+		fprintf(out, "\"port\": \"");
+		for (const char * c = portName; *c; c++) {
+			if (*c == '"' || *c == '\\') {
+				fprintf(out, "\\%c", *c);
+			}
+			else if ((unsigned char)*c < 0x20) {
+				fprintf(out, "\\u%04x", (unsigned char)*c);
+			}
+			else {
+				fputc(*c, out);
+			}
+		}
+		fprintf(out, "\", ");
+	}
+	fprintf(out, "\"bytes_received\": %llu, \"bytes_sent\": %llu, \"read_calls\": %llu, \"write_calls\": %llu, ",
+		(unsigned long long)snapshot.bytesReceived, (unsigned long long)snapshot.bytesSent,
+		(unsigned long long)snapshot.readCalls, (unsigned long long)snapshot.writeCalls);
+	fprintf(out, "\"line_errors\": { ");
+	for (int i = 0; i < LINE_ERROR_KINDS; i++) {
+		fprintf(out, "\"%s\": %llu%s", LINE_ERROR_NAMES[i], (unsigned long long)snapshot.lineErrors[i],
+			i + 1 < LINE_ERROR_KINDS ? ", " : " }, ");
+	}
+	fprintf(out, "\"input_queue_high\": %llu, \"output_queue_high\": %llu, ",
+		(unsigned long long)snapshot.inputQueueHigh, (unsigned long long)snapshot.outputQueueHigh);
+	fprintf(out, "\"paint_latency_us\": { \"samples\": %llu, \"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+		"\"max\": %.1f, \"buckets\": [", (unsigned long long)snapshot.paintSamples, snapshot.percentile(0.50),
+		snapshot.percentile(0.90), snapshot.percentile(0.99), snapshot.paintMaxUs);
+	for (int i = 0; i < LATENCY_BUCKETS; i++) {
+		if (snapshot.paintLatency[i] == 0) {
+			continue;
+		}
+		if (i + 1 < LATENCY_BUCKETS) {
+			fprintf(out, "%s{ \"le\": %.0f, \"count\": %llu }", isFirst ? " " : ", ", bucketLimit(i),
+				(unsigned long long)snapshot.paintLatency[i]);
+		}
+		else {
+			fprintf(out, "%s{ \"le\": null, \"count\": %llu }", isFirst ? " " : ", ",
+				(unsigned long long)snapshot.paintLatency[i]);
+		}
+		isFirst = false;
+	}
+	fprintf(out, "%s] } }", isFirst ? "" : " ");
+}
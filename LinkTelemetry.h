@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include "RingBuffer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		LinkTelemetry.h -	Per-port counters, UART error accounting and receive-to-paint latency.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void countRead(size_t length)
+--					void countWrite(size_t length)
+--					void countLineError(LineError kind, uint64_t count)
+--					void noteInputQueue(size_t depth)
+--					void noteOutputQueue(size_t depth)
+--					void markArrival(void)
+--					int64_t takeArrival(void)
+--					void countPaint(int64_t arrival)
+--					void reset(void)
+--					TelemetrySnapshot snapshot(void) const
+--					int64_t now(void)
+--					void formatStatus(const TelemetrySnapshot & snapshot, char * text, size_t capacity)
+--					void writeJson(FILE * out, const char * portName, const TelemetrySnapshot & snapshot)
+--					double percentile(double fraction) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - countLineError takes a count, for drivers that report running totals
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Every counter has one writer thread, and the counters are grouped by that thread onto cache lines of their own:
+-- the receive side (the reader thread or the multiplexer's I/O thread), the transmit side (the writer thread) and
+-- the paint side (the window thread). A single writer updates a counter with a relaxed load and store, which costs
+-- no more than a plain increment, and any thread can read it at any time. Line errors and driver queue depths are
+-- the exception: they are seen by whichever thread polls the driver, so they take a relaxed fetch_add or
+-- compare-exchange, and only when something changes.
+--
+-- Latency runs from the arrival of the first byte of a batch to the present that shows it. It goes into power of
+-- two buckets: bucket 0 holds anything under a microsecond and bucket i from 2^(i-1) up to 2^i microseconds, with
+-- the last bucket also taking everything slower.
+----------------------------------------------------------------------------------------------------------------------*/
+
+enum class LineError { Overrun, InputOverflow, Framing, Parity, Break };
+
+constexpr int LINE_ERROR_KINDS = 5;
+constexpr int LATENCY_BUCKETS = 24;		// the last starts at 2^22 us, about 4 s
+
+struct TelemetrySnapshot {
+	uint64_t bytesReceived = 0;
+	uint64_t bytesSent = 0;
+	uint64_t readCalls = 0;					// reads that delivered data
+	uint64_t writeCalls = 0;
+	uint64_t lineErrors[LINE_ERROR_KINDS] = {};
+	uint64_t inputQueueHigh = 0;			// most bytes seen waiting in the driver's input queue
+	uint64_t outputQueueHigh = 0;			// most bytes seen waiting to leave the port
+	uint64_t paintLatency[LATENCY_BUCKETS] = {};
+	uint64_t paintSamples = 0;
+	double paintMaxUs = 0;
+
+	double percentile(double fraction) const;
+};
+
+class LinkTelemetry {
+private:
+	struct alignas(CACHE_LINE_SIZE) ReceiveCounters {
+		std::atomic<uint64_t> bytes{ 0 };
+		std::atomic<uint64_t> calls{ 0 };
+		std::atomic<int64_t> firstArrival{ 0 };		// steady clock ns of the oldest undrained chunk, 0 for none
+	};
+	struct alignas(CACHE_LINE_SIZE) TransmitCounters {
+		std::atomic<uint64_t> bytes{ 0 };
+		std::atomic<uint64_t> calls{ 0 };
+	};
+	struct alignas(CACHE_LINE_SIZE) LineCounters {
+		std::atomic<uint64_t> errors[LINE_ERROR_KINDS] = {};
+		std::atomic<uint64_t> inputQueueHigh{ 0 };
+		std::atomic<uint64_t> outputQueueHigh{ 0 };
+	};
+	struct alignas(CACHE_LINE_SIZE) PaintCounters {
+		std::atomic<uint64_t> buckets[LATENCY_BUCKETS] = {};
+		std::atomic<uint64_t> samples{ 0 };
+		std::atomic<uint64_t> maxNs{ 0 };
+	};
+
+	ReceiveCounters receive;
+	TransmitCounters transmit;
+	LineCounters line;
+	PaintCounters paint;
+
+	// Only for counters with a single writer
+	static void add(std::atomic<uint64_t> & counter, uint64_t amount) {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	};
+	static void raise(std::atomic<uint64_t> & highWater, uint64_t value) {
+		uint64_t seen = highWater.load(std::memory_order_relaxed);
+		while (value > seen && !highWater.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {
+		}
+	};
+public:
+	LinkTelemetry() {};
+	LinkTelemetry(const LinkTelemetry &) = delete;
+	LinkTelemetry & operator=(const LinkTelemetry &) = delete;
+
+	// Receive side
+	void countRead(size_t length) {
+		add(receive.calls, 1);
+		add(receive.bytes, length);
+	};
+	// Call before the chunk is queued, so the consumer never sees data without a mark
+	void markArrival() {
+		if (receive.firstArrival.load(std::memory_order_relaxed) == 0) {
+			receive.firstArrival.store(now(), std::memory_order_relaxed);
+		}
+	};
+
+	// Transmit side
+	void countWrite(size_t length) {
+		add(transmit.calls, 1);
+		add(transmit.bytes, length);
+	};
+
+	// Any thread that polls the port
+	void countLineError(LineError kind, uint64_t count = 1) {
+		line.errors[(int)kind].fetch_add(count, std::memory_order_relaxed);
+	};
+	void noteInputQueue(size_t depth) { raise(line.inputQueueHigh, depth); };
+	void noteOutputQueue(size_t depth) { raise(line.outputQueueHigh, depth); };
+
+	// Paint side; call takeArrival before draining so later chunks are timed by the next paint
+	int64_t takeArrival() { return receive.firstArrival.exchange(0, std::memory_order_relaxed); };
+	void countPaint(int64_t arrival);
+
+	void reset();
+	TelemetrySnapshot snapshot() const;
+
+	static int64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	};
+	static void formatStatus(const TelemetrySnapshot & snapshot, char * text, size_t capacity);
+	static void writeJson(FILE * out, const char * portName, const TelemetrySnapshot & snapshot);
+};
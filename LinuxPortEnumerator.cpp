@@ -0,0 +1,305 @@
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include "LinuxPortEnumerator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		LinuxPortEnumerator.cpp -	PortEnumerator that lists ttys from sysfs and watches /dev with inotify.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void scan(std::vector<std::string> * ports)
+--					bool openWatch(void)
+--					void closeWatch(void)
+--					void watch(void)
+--					void wake(void)
+--					bool isSerialDevice(const std::string & name)
+--					void catchUp(void)
+--					std::unique_ptr<PortEnumerator> createPortEnumerator(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This file is built on Linux only; Win32PortEnumerator.cpp provides createPortEnumerator on Windows.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr const char * TTY_CLASS_PATH = "/sys/class/tty/";
+constexpr const char * DEVICE_PATH = "/dev/";
+constexpr size_t INOTIFY_BUFFER_SIZE = 4096;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scan
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void scan(std::vector<std::string> * ports)
+--					std::vector<std::string> * ports:	the /dev path of each port found is appended
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Only sysfs is read; no port is opened.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinuxPortEnumerator::scan(std::vector<std::string> * ports) {
+	DIR * ttys = opendir(TTY_CLASS_PATH);
+	struct dirent * entry;
+
+	if (ttys == NULL) {
+		return;
+	}
+	while ((entry = readdir(ttys)) != NULL) {
+		if (entry->d_name[0] != '.' && isSerialDevice(entry->d_name)) {
+			ports->push_back(std::string(DEVICE_PATH) + entry->d_name);
+		}
+	}
+	closedir(ttys);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openWatch
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openWatch(void)
+--
+-- RETURNS:		bool - false if the inotify watch or the eventfd could not be set up
+----------------------------------------------------------------------------------------------------------------------*/
+bool LinuxPortEnumerator::openWatch() {
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (inotifyFd < 0 || wakeFd < 0 ||
+		inotify_add_watch(inotifyFd, DEVICE_PATH, IN_CREATE | IN_DELETE | IN_MOVED_TO | IN_MOVED_FROM) < 0) {
+		closeWatch();
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeWatch
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void closeWatch(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void LinuxPortEnumerator::closeWatch() {
+	if (inotifyFd >= 0) {
+		::close(inotifyFd);
+		inotifyFd = -1;
+	}
+	if (wakeFd >= 0) {
+		::close(wakeFd);
+		wakeFd = -1;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	watch
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void watch(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Sleeps in poll until /dev changes or wake is called. A node created or moved in is added if sysfs says it is a
+-- port; one deleted or moved out is removed, which does nothing unless it was listed.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinuxPortEnumerator::watch() {
+	alignas(struct inotify_event) char buffer[INOTIFY_BUFFER_SIZE];
+	struct pollfd waits[2] = { { inotifyFd, POLLIN, 0 }, { wakeFd, POLLIN, 0 } };
+
+	while (isRunning.load()) {
+		if (poll(waits, 2, -1) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return;
+		}
+		if (waits[1].revents != 0) {
+			uint64_t count;
+			ssize_t ignored = ::read(wakeFd, &count, sizeof(count));
+			(void)ignored;
+			continue;
+		}
+
+		ssize_t length = ::read(inotifyFd, buffer, sizeof(buffer));
+		if (length <= 0) {
+			continue;
+		}
+		for (char * next = buffer; next < buffer + length; ) {
+			struct inotify_event * event = (struct inotify_event *)next;
+
+			next += sizeof(struct inotify_event) + event->len;
+			if (event->mask & IN_Q_OVERFLOW) {
+				catchUp();
+			}
+			else if (event->len == 0 || (event->mask & IN_ISDIR)) {
+				continue;
+			}
+			else if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+				if (isSerialDevice(event->name)) {
+					addPort(std::string(DEVICE_PATH) + event->name);
+				}
+			}
+			else {
+				removePort(std::string(DEVICE_PATH) + event->name);
+			}
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wake
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void wake(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void LinuxPortEnumerator::wake() {
+	uint64_t one = 1;
+
+	if (wakeFd >= 0) {
+		ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+		(void)ignored;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isSerialDevice
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isSerialDevice(const std::string & name)
+--					const std::string & name:	a tty's name, such as ttyUSB0
+--
+-- RETURNS:		bool - true if the tty is backed by a device that is present and has a node in /dev
+----------------------------------------------------------------------------------------------------------------------*/
+bool LinuxPortEnumerator::isSerialDevice(const std::string & name) {
+	std::string classPath = std::string(TTY_CLASS_PATH) + name;
+	struct stat info;
+	FILE * typeFile;
+	int type = -1;
+
+	if (stat((classPath + "/device").c_str(), &info) != 0 ||
+		stat((std::string(DEVICE_PATH) + name).c_str(), &info) != 0 || !S_ISCHR(info.st_mode)) {
+		return false;
+	}
+	// Only serial core ports have a type, and a slot with no UART behind it reports 0
+	if ((typeFile = fopen((classPath + "/type").c_str(), "r")) != NULL) {
+		if (fscanf(typeFile, "%d", &type) != 1) {
+			type = -1;
+		}
+		fclose(typeFile);
+	}
+	return type != 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	catchUp
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void catchUp(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when inotify has dropped events. sysfs is scanned again and the cache brought in line with it
+-- through addPort and removePort, so only the ports that differ are changed.
+----------------------------------------------------------------------------------------------------------------------*/
+void LinuxPortEnumerator::catchUp() {
+	std::vector<std::string> present;
+	std::vector<std::string> listed = getPorts();
+
+	scan(&present);
+	for (const std::string & port : listed) {
+		if (std::find(present.begin(), present.end(), port) == present.end()) {
+			removePort(port);
+		}
+	}
+	for (const std::string & port : present) {
+		addPort(port);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createPortEnumerator
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<PortEnumerator> createPortEnumerator(void)
+--
+-- RETURNS:		std::unique_ptr<PortEnumerator> - an enumerator that has not been started
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortEnumerator> createPortEnumerator() {
+	return std::unique_ptr<PortEnumerator>(new LinuxPortEnumerator());
+}
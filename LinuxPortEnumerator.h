@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PortEnumerator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		LinuxPortEnumerator.h -	PortEnumerator that lists ttys from sysfs and watches /dev with inotify.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void scan(std::vector<std::string> * ports)
+--					bool openWatch(void)
+--					void closeWatch(void)
+--					void watch(void)
+--					void wake(void)
+--					bool isSerialDevice(const std::string & name)
+--					void catchUp(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A port is a tty in /sys/class/tty backed by a device, which leaves out virtual consoles and ptys, and whose node
+-- is in /dev. Ports are listed by their /dev path, which PosixTransport opens as it is. The serial core registers
+-- every UART slot its driver was built for, such as ttyS0 to ttyS31, whether or not hardware is there; a slot
+-- with no UART reports type 0 and is left out.
+--
+-- The watch is an inotify on /dev for nodes created and deleted, the way udev makes and removes them when a USB
+-- adapter is plugged in or pulled. Each event is checked against sysfs and passed to addPort or removePort, so the
+-- cache is updated one port at a time. Only if the inotify queue overflows, and events are lost, is sysfs scanned
+-- again to catch up. An eventfd wakes the watch for stop.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class LinuxPortEnumerator : public PortEnumerator {
+private:
+	int inotifyFd = -1;
+	int wakeFd = -1;
+
+	static bool isSerialDevice(const std::string & name);
+	void catchUp();
+protected:
+	void scan(std::vector<std::string> * ports) override;
+	bool openWatch() override;
+	void closeWatch() override;
+	void watch() override;
+	void wake() override;
+public:
+	LinuxPortEnumerator() {};
+	~LinuxPortEnumerator() { stop(); };
+};
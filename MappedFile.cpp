@@ -0,0 +1,141 @@
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MappedFile.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		MappedFile.cpp -	A whole file mapped read-only into memory.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path)
+--					void close(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Only the mapping differs between platforms: CreateFileMapping and MapViewOfFile on Windows, mmap elsewhere. Both
+-- are asked for sequential read-ahead, since every user reads front to back.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool open(const std::string & path)
+--					const std::string & path:	the file, UTF-8
+--
+-- RETURNS:		bool - false if the file cannot be opened or mapped
+--
+-- NOTES:
+-- Closes any file already open first.
+----------------------------------------------------------------------------------------------------------------------*/
+bool MappedFile::open(const std::string & path) {
+	close();
+#ifdef _WIN32
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, NULL, 0);
+	std::wstring widePath(length > 0 ? length : 1, L'\0');
+	LARGE_INTEGER fileSize;
+
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+	file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize)) {
+		close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+	if (size > 0) {
+		mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		data = mapping != NULL ? (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (data == nullptr) {
+			close();
+			return false;
+		}
+	}
+#else
+	int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	struct stat status;
+
+	if (descriptor < 0) {
+		return false;
+	}
+	if (fstat(descriptor, &status) != 0) {
+		::close(descriptor);
+		return false;
+	}
+	size = (size_t)status.st_size;
+	if (size > 0) {
+		void * view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (view == MAP_FAILED) {
+			::close(descriptor);
+			size = 0;
+			return false;
+		}
+		madvise(view, size, MADV_SEQUENTIAL);
+		data = (const char *)view;
+	}
+	::close(descriptor);
+#endif
+	isMapped = true;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Pointers into the file are no longer valid afterwards.
+----------------------------------------------------------------------------------------------------------------------*/
+void MappedFile::close() {
+#ifdef _WIN32
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+	if (mapping != NULL) {
+		CloseHandle(mapping);
+		mapping = NULL;
+	}
+	if (file != INVALID_HANDLE_VALUE) {
+		CloseHandle(file);
+		file = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (data != nullptr) {
+		munmap((void *)data, size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	isMapped = false;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		MappedFile.h -	A whole file mapped read-only into memory.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const std::string & path)
+--					void close(void)
+--					bool isOpen(void) const
+--					const char * getData(void) const
+--					size_t getSize(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Files are read through the mapping in place: captures by CaptureFile and files sent by a FileTransfer. The view
+-- stays valid until close. An empty file opens with no mapping and a size of 0.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class MappedFile {
+private:
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = NULL;
+#endif
+	const char * data = nullptr;
+	size_t size = 0;
+	bool isMapped = false;
+public:
+	MappedFile() {};
+	~MappedFile() { close(); };
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+
+	bool open(const std::string & path);
+	void close();
+	bool isOpen() const { return isMapped; };
+	const char * getData() const { return data; };
+	size_t getSize() const { return size; };
+};
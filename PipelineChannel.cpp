@@ -0,0 +1,201 @@
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include "PipelineChannel.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PipelineChannel.cpp -	A TransferChannel over a port's SerialPipeline.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const char * data, size_t length)
+--					bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived)
+--					void deliver(const char * data, size_t length)
+--					void open(void)
+--					void close(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- send and receive are called on the transfer's thread, deliver on the window thread. close wakes a transfer
+-- waiting in either, so the controller can join the transfer's thread without waiting out a timeout.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	send
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool send(const char * data, size_t length)
+--					const char * data:	the bytes to send
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		bool - false if the pipeline stopped or the channel was closed before every byte was queued
+--
+-- NOTES:
+-- Queues as much as fits under TRANSFER_QUEUE_LIMIT and waits a millisecond at a time for the writer to make room
+-- for the rest.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PipelineChannel::send(const char * data, size_t length) {
+	while (length > 0) {
+		size_t depth;
+		size_t accepted = 0;
+
+		if (!pipeline->isActive()) {
+			return false;
+		}
+		depth = pipeline->getTransmitQueue().getQueueDepth();
+		if (depth < TRANSFER_QUEUE_LIMIT) {
+			accepted = pipeline->send(data, std::min(length, TRANSFER_QUEUE_LIMIT - depth));
+			data += accepted;
+			length -= accepted;
+		}
+
+		std::unique_lock<std::mutex> guard(lock);
+		if (!isOpen) {
+			return false;
+		}
+		if (length > 0 && accepted == 0) {
+			arrived.wait_for(guard, std::chrono::milliseconds(1), [this]() { return !isOpen; });
+		}
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived)
+--					char * buffer:				where to copy received bytes
+--					size_t capacity:			size of buffer
+--					uint32_t timeout:			ms to wait for the first byte
+--					size_t * bytesReceived:		set to the number of bytes copied, 0 if the wait timed out
+--
+-- RETURNS:		bool - false if the channel was closed or the pipeline stopped
+----------------------------------------------------------------------------------------------------------------------*/
+bool PipelineChannel::receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived) {
+	std::unique_lock<std::mutex> guard(lock);
+	size_t length;
+
+	*bytesReceived = 0;
+	if (!arrived.wait_for(guard, std::chrono::milliseconds(timeout),
+		[this]() { return pendingHead < pending.size() || !isOpen; })) {
+		return pipeline->isActive();
+	}
+	if (pendingHead == pending.size()) {
+		return false;
+	}
+	length = std::min(capacity, pending.size() - pendingHead);
+	memcpy(buffer, pending.data() + pendingHead, length);
+	pendingHead += length;
+	if (pendingHead == pending.size()) {
+		pending.clear();
+		pendingHead = 0;
+	}
+	*bytesReceived = length;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	deliver
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void deliver(const char * data, size_t length)
+--					const char * data:	bytes drained from the pipeline's ring
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from the thread draining the pipeline. Bytes delivered while the channel is closed are
+-- dropped.
+----------------------------------------------------------------------------------------------------------------------*/
+void PipelineChannel::deliver(const char * data, size_t length) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	if (!isOpen) {
+		return;
+	}
+	pending.insert(pending.end(), data, data + length);
+	arrived.notify_one();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void open(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before starting a transfer on the channel. Anything left from an earlier transfer is dropped.
+----------------------------------------------------------------------------------------------------------------------*/
+void PipelineChannel::open() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	pending.clear();
+	pendingHead = 0;
+	isOpen = true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Fails any send or receive in progress and every later one until the channel is opened again.
+----------------------------------------------------------------------------------------------------------------------*/
+void PipelineChannel::close() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	isOpen = false;
+	arrived.notify_all();
+}
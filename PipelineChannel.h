@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "FileTransfer.h"
+#include "SerialPipeline.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		PipelineChannel.h -	A TransferChannel over a port's SerialPipeline.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const char * data, size_t length)
+--					bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived)
+--					void deliver(const char * data, size_t length)
+--					void open(void)
+--					void close(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Lets a transfer share a port with the terminal. Sends go into the pipeline's TransmitQueue, but no further than
+-- TRANSFER_QUEUE_LIMIT ahead of the writer: the queue drops what does not fit, and a transfer that ran a whole
+-- megabyte ahead would leave its ZRPOS answers stuck behind it. Received data still lands in the pipeline's ring
+-- and is drained on the window thread as always; while a transfer runs the controller hands it to deliver instead
+-- of the display, and the transfer's thread picks it up with receive.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t TRANSFER_QUEUE_LIMIT = 16 * 1024;	// bytes a transfer may have waiting for the writer
+
+class PipelineChannel : public TransferChannel {
+private:
+	SerialPipeline * pipeline;
+	std::mutex lock;
+	std::condition_variable arrived;
+	std::vector<char> pending;		// delivered, not yet received
+	size_t pendingHead = 0;
+	bool isOpen = false;
+public:
+	explicit PipelineChannel(SerialPipeline * port) : pipeline(port) {};
+	PipelineChannel(const PipelineChannel &) = delete;
+	PipelineChannel & operator=(const PipelineChannel &) = delete;
+
+	bool send(const char * data, size_t length) override;
+	bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived) override;
+	void deliver(const char * data, size_t length);
+	void open();
+	void close();
+};
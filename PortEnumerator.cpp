@@ -0,0 +1,406 @@
+#include <ctype.h>
+#include <algorithm>
+#include <system_error>
+#include "PortEnumerator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PortEnumerator.cpp -	Finds the serial ports on the machine and keeps the list current.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(ChangeFunction change)
+--					void stop(void)
+--					bool isReady(void) const
+--					std::vector<std::string> getPorts(void) const
+--					uint64_t getVersion(void) const
+--					void addPort(const std::string & name)
+--					void removePort(const std::string & name)
+--					bool comparePorts(const std::string & first, const std::string & second)
+--					void run(void)
+--					void publish(std::vector<std::string> * scanned)
+--					bool applyChange(bool isAdded, const std::string & name)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The cache, the held changes and the version are only touched under lock. The change function is called after the
+-- lock is released, so it may call getPorts.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	start
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool start(ChangeFunction change)
+--					ChangeFunction change:	called after each change to the cache; may be empty
+--
+-- RETURNS:		bool - false if already started, or if the thread could not be created
+--
+-- NOTES:
+-- Returns before the first scan has run. If the thread cannot be created the ports are scanned here instead, so the
+-- cache is still filled, but nothing watches for changes.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortEnumerator::start(ChangeFunction change) {
+	if (isRunning.load()) {
+		return false;
+	}
+	onChange = change;
+	isRunning.store(true);
+	isWatching = openWatch();
+
+	try {
+		worker = std::thread(&PortEnumerator::run, this);
+	}
+	catch (const std::system_error &) {
+		std::vector<std::string> scanned;
+
+		isRunning.store(false);
+		if (isWatching) {
+			closeWatch();
+			isWatching = false;
+		}
+		scan(&scanned);
+		publish(&scanned);
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void stop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Waits for a first scan still running to finish. The cache keeps its last contents.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortEnumerator::stop() {
+	if (!isRunning.exchange(false)) {
+		return;
+	}
+	wake();
+	worker.join();
+	if (isWatching) {
+		closeWatch();
+		isWatching = false;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isReady
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isReady(void) const
+--
+-- RETURNS:		bool - true once the first scan has filled the cache
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortEnumerator::isReady() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return isScanned;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getPorts
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::vector<std::string> getPorts(void) const
+--
+-- RETURNS:		std::vector<std::string> - the ports listed now, in natural order; empty before the first scan
+----------------------------------------------------------------------------------------------------------------------*/
+std::vector<std::string> PortEnumerator::getPorts() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return ports;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getVersion
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint64_t getVersion(void) const
+--
+-- RETURNS:		uint64_t - a count raised by every change to the cache, 0 before the first scan
+----------------------------------------------------------------------------------------------------------------------*/
+uint64_t PortEnumerator::getVersion() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return version;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	addPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void addPort(const std::string & name)
+--					const std::string & name:	a port that has arrived, in the form SerialTransport opens
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when the platform reports a new port. A port already listed is left alone.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortEnumerator::addPort(const std::string & name) {
+	bool isChanged;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		if (!isScanned) {
+			pending.push_back(std::make_pair(true, name));
+			return;
+		}
+		isChanged = applyChange(true, name);
+		version += isChanged ? 1 : 0;
+	}
+	if (isChanged && onChange) {
+		onChange();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	removePort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void removePort(const std::string & name)
+--					const std::string & name:	a port that has gone
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when the platform reports a port removed. A port not listed is ignored.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortEnumerator::removePort(const std::string & name) {
+	bool isChanged;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		if (!isScanned) {
+			pending.push_back(std::make_pair(false, name));
+			return;
+		}
+		isChanged = applyChange(false, name);
+		version += isChanged ? 1 : 0;
+	}
+	if (isChanged && onChange) {
+		onChange();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	comparePorts
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool comparePorts(const std::string & first, const std::string & second)
+--					const std::string & first:	a port name
+--					const std::string & second:	another port name
+--
+-- RETURNS:		bool - true if first sorts before second
+--
+-- NOTES:
+-- Runs of digits compare by value, so COM9 comes before COM10 and ttyUSB2 before ttyUSB10. Names that only differ
+-- in leading zeros fall back to plain comparison, which keeps the order strict.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortEnumerator::comparePorts(const std::string & first, const std::string & second) {
+	size_t i = 0, j = 0;
+
+	while (i < first.size() && j < second.size()) {
+		if (isdigit((unsigned char)first[i]) && isdigit((unsigned char)second[j])) {
+			size_t endFirst, endSecond;
+
+			while (i < first.size() && first[i] == '0') {
+				i++;
+			}
+			while (j < second.size() && second[j] == '0') {
+				j++;
+			}
+			for (endFirst = i; endFirst < first.size() && isdigit((unsigned char)first[endFirst]); endFirst++);
+			for (endSecond = j; endSecond < second.size() && isdigit((unsigned char)second[endSecond]); endSecond++);
+			if (endFirst - i != endSecond - j) {
+				return endFirst - i < endSecond - j;
+			}
+			int order = first.compare(i, endFirst - i, second, j, endSecond - j);
+			if (order != 0) {
+				return order < 0;
+			}
+			i = endFirst;
+			j = endSecond;
+		}
+		else if (first[i] != second[j]) {
+			return (unsigned char)first[i] < (unsigned char)second[j];
+		}
+		else {
+			i++;
+			j++;
+		}
+	}
+	if (i == first.size() && j == second.size()) {
+		return first < second;
+	}
+	return i == first.size();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The enumerator's thread: one scan, then the watch until stop. A platform with no watch of its own returns from
+-- watch at once and the thread ends; the cache then only changes through addPort and removePort from outside.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortEnumerator::run() {
+	std::vector<std::string> scanned;
+
+	scan(&scanned);
+	publish(&scanned);
+	if (isWatching) {
+		watch();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	publish
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void publish(std::vector<std::string> * scanned)
+--					std::vector<std::string> * scanned:	the first scan's ports, in any order; emptied by this call
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Makes the scan the cache, then applies the changes held while it ran.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortEnumerator::publish(std::vector<std::string> * scanned) {
+	std::sort(scanned->begin(), scanned->end(), comparePorts);
+	scanned->erase(std::unique(scanned->begin(), scanned->end()), scanned->end());
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		ports.swap(*scanned);
+		for (std::pair<bool, std::string> & change : pending) {
+			applyChange(change.first, change.second);
+		}
+		pending.clear();
+		isScanned = true;
+		version++;
+	}
+	if (onChange) {
+		onChange();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	applyChange
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool applyChange(bool isAdded, const std::string & name)
+--					bool isAdded:				true to list the port, false to drop it
+--					const std::string & name:	the port
+--
+-- RETURNS:		bool - false if the cache already had the port listed, or already did not
+--
+-- NOTES:
+-- Call this function with lock held. The port is inserted at its sorted place rather than the cache resorted.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortEnumerator::applyChange(bool isAdded, const std::string & name) {
+	std::vector<std::string>::iterator place = std::lower_bound(ports.begin(), ports.end(), name, comparePorts);
+	bool isListed = place != ports.end() && *place == name;
+
+	if (isAdded && !isListed) {
+		ports.insert(place, name);
+		return true;
+	}
+	if (!isAdded && isListed) {
+		ports.erase(place);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		PortEnumerator.h -	Finds the serial ports on the machine and keeps the list current.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(ChangeFunction change)
+--					void stop(void)
+--					bool isReady(void) const
+--					std::vector<std::string> getPorts(void) const
+--					uint64_t getVersion(void) const
+--					void addPort(const std::string & name)
+--					void removePort(const std::string & name)
+--					bool comparePorts(const std::string & first, const std::string & second)
+--					void scan(std::vector<std::string> * ports)
+--					bool openWatch(void)
+--					void closeWatch(void)
+--					void watch(void)
+--					void wake(void)
+--					std::unique_ptr<PortEnumerator> createPortEnumerator(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- start returns at once. A thread of the enumerator's own lists the ports once, into a cache kept in natural order
+-- (COM2 before COM10), and then, where the platform can, watches for ports arriving and leaving. After the first
+-- scan the cache only changes one port at a time through addPort and removePort, called from the watch or, where
+-- the platform announces devices to a window instead, from that window's thread. Nothing is scanned again.
+--
+-- The change function is called after every change to the cache, including the first scan, on whichever thread
+-- made it and without the lock held; it should only post a message. getPorts returns a copy, so a caller can build
+-- a menu from it while the cache moves on, and getVersion tells it whether it has to.
+--
+-- Changes made while the first scan runs are held and applied after it in order. Adding a port already listed and
+-- removing one that is not are ignored, so a watch opened before the scan can report what the scan already saw.
+--
+-- createPortEnumerator returns the platform's implementation: Win32PortEnumerator on Windows, LinuxPortEnumerator
+-- elsewhere. Each calls stop from its destructor, while its watch can still be woken.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class PortEnumerator {
+public:
+	typedef std::function<void()> ChangeFunction;
+private:
+	mutable std::mutex lock;
+	std::vector<std::string> ports;					// sorted with comparePorts
+	std::vector<std::pair<bool, std::string>> pending;	// added (true) or removed while the first scan runs
+	bool isScanned = false;
+	bool isWatching = false;
+	uint64_t version = 0;
+	ChangeFunction onChange;
+	std::thread worker;
+
+	void run();
+	void publish(std::vector<std::string> * scanned);
+	bool applyChange(bool isAdded, const std::string & name);
+protected:
+	std::atomic<bool> isRunning{ false };
+
+	// List every port present now; called once, on the enumerator's thread
+	virtual void scan(std::vector<std::string> * ports) = 0;
+	// Set up the arrival and removal watch before the scan so nothing between the two is missed
+	virtual bool openWatch() { return true; };
+	virtual void closeWatch() {};
+	// Report arrivals and removals through addPort and removePort until isRunning is cleared
+	virtual void watch() {};
+	// Make watch return promptly once isRunning is cleared
+	virtual void wake() {};
+public:
+	PortEnumerator() {};
+	virtual ~PortEnumerator() {};
+	PortEnumerator(const PortEnumerator &) = delete;
+	PortEnumerator & operator=(const PortEnumerator &) = delete;
+
+	bool start(ChangeFunction change);
+	void stop();
+	bool isReady() const;
+	std::vector<std::string> getPorts() const;
+	uint64_t getVersion() const;
+	void addPort(const std::string & name);
+	void removePort(const std::string & name);
+
+	static bool comparePorts(const std::string & first, const std::string & second);
+};
+
+std::unique_ptr<PortEnumerator> createPortEnumerator();
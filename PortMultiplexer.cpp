@@ -0,0 +1,558 @@
+#include <system_error>
+#include <utility>
+#include "PortMultiplexer.h"
+#include "SimulatedTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PortMultiplexer.cpp -	Services the receive side of many ports from one I/O thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(void)
+--					void stop(void)
+--					bool add(SerialTransport * transport, ReceiveFunction receive)
+--					void remove(SerialTransport * transport)
+--					size_t getPortCount(void) const
+--					MultiplexerStats getStats(void) const
+--					bool submit(Command * command)
+--					void run(void)
+--					void runCommands(void)
+--					bool addPort(SerialTransport * transport, ReceiveFunction receive)
+--					bool removePort(SerialTransport * transport)
+--					void releaseClosed(void)
+--					uint32_t serviceSimulated(void)
+--					void deliver(Port * port)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The port table is only touched by the I/O thread while it runs. Other threads queue an add or remove under
+-- commandLock, wake the thread and wait for the command to be marked done.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	start
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool start(void)
+--
+-- RETURNS:		bool - false if already running, or the wait queue or the thread could not be created
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortMultiplexer::start() {
+	if (isRunning.load() || !openQueue()) {
+		return false;
+	}
+	isRunning.store(true);
+
+	try {
+		worker = std::thread(&PortMultiplexer::run, this);
+	}
+	catch (const std::system_error &) {
+		isRunning.store(false);
+		closeQueue();
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void stop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Ports still added are detached, and any add or remove left waiting is released, before the queue is closed.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::stop() {
+	Port * ready[MULTIPLEXER_BATCH];
+
+	if (!isRunning.exchange(false)) {
+		return;
+	}
+	wake();
+	worker.join();
+
+	for (std::unique_ptr<Port> & port : ports) {
+		if (port->simulated != nullptr) {
+			port->simulated->setArrivalNotify(nullptr);
+			port->state = PortState::Closed;
+		}
+		else if (port->state == PortState::Active) {
+			port->state = detach(port.get()) ? PortState::Closed : PortState::Closing;
+		}
+		else if (port->state == PortState::Failed) {
+			port->state = PortState::Closed;
+		}
+	}
+	// A detach that completes later is handed back by the wait; give the platform a moment to return them
+	for (int attempt = 0; attempt < 10; attempt++) {
+		releaseClosed();
+		if (ports.empty()) {
+			break;
+		}
+		wait(ready, MULTIPLEXER_BATCH, RX_WAIT_TIMEOUT / 10);
+	}
+	ports.clear();
+	closeQueue();
+
+	std::lock_guard<std::mutex> guard(commandLock);
+	for (Command * command : commands) {
+		command->isDone = true;
+	}
+	for (std::pair<Port *, Command *> & removal : removals) {
+		removal.second->isDone = true;
+	}
+	commands.clear();
+	removals.clear();
+	portCount = 0;
+	commandDone.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	add
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool add(SerialTransport * transport, ReceiveFunction receive)
+--					SerialTransport * transport:	an open port, not already added; must stay open until removed
+--					ReceiveFunction receive:		called on the I/O thread with each read
+--
+-- RETURNS:		bool - false if the multiplexer is not running or cannot service this kind of transport
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortMultiplexer::add(SerialTransport * transport, ReceiveFunction receive) {
+	Command command = { CommandKind::Add, transport, receive, false, false };
+	return submit(&command);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	remove
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void remove(SerialTransport * transport)
+--					SerialTransport * transport:	a port given to add
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Returns once the port's read has been cancelled and its receive function will not be called again.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::remove(SerialTransport * transport) {
+	Command command = { CommandKind::Remove, transport, nullptr, false, false };
+	submit(&command);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getPortCount
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t getPortCount(void) const
+--
+-- RETURNS:		size_t - ports added and not yet removed
+----------------------------------------------------------------------------------------------------------------------*/
+size_t PortMultiplexer::getPortCount() const {
+	std::lock_guard<std::mutex> guard(commandLock);
+	return portCount;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	MultiplexerStats getStats(void) const
+--
+-- RETURNS:		MultiplexerStats - the counters since the multiplexer was created
+----------------------------------------------------------------------------------------------------------------------*/
+MultiplexerStats PortMultiplexer::getStats() const {
+	MultiplexerStats stats;
+
+	stats.wakeups = wakeups.load(std::memory_order_relaxed);
+	stats.reads = reads.load(std::memory_order_relaxed);
+	stats.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+	stats.failedPorts = failedPorts.load(std::memory_order_relaxed);
+	return stats;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	submit
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool submit(Command * command)
+--					Command * command:	the add or remove to run on the I/O thread
+--
+-- RETURNS:		bool - whether the I/O thread accepted the command
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortMultiplexer::submit(Command * command) {
+	std::unique_lock<std::mutex> guard(commandLock);
+
+	if (!isRunning.load()) {
+		return false;
+	}
+	commands.push_back(command);
+	wake();
+	commandDone.wait(guard, [command] { return command->isDone; });
+	return command->isAccepted;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The I/O thread. Each pass runs queued commands, reads the simulated ports that are due, then sleeps until a read
+-- completes, the next simulated port is due or another thread wakes it.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::run() {
+	Port * ready[MULTIPLEXER_BATCH];
+	uint32_t timeout;
+	int count;
+
+	while (isRunning.load(std::memory_order_relaxed)) {
+		runCommands();
+		timeout = serviceSimulated();
+		count = wait(ready, MULTIPLEXER_BATCH, timeout);
+		wakeups.fetch_add(1, std::memory_order_relaxed);
+
+		for (int i = 0; i < count; i++) {
+			Port * port = ready[i];
+
+			if (port->state == PortState::Active) {
+				deliver(port);
+				rearm(port);
+			}
+			// rearm marks the port Failed if the next read could not be issued
+			if (port->state == PortState::Failed) {
+				failedPorts.fetch_add(1, std::memory_order_relaxed);
+				detach(port);
+			}
+		}
+		releaseClosed();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runCommands
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void runCommands(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- A remove whose port is still Closing stays in removals until releaseClosed finds the port Closed.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::runCommands() {
+	std::lock_guard<std::mutex> guard(commandLock);
+
+	if (commands.empty()) {
+		return;
+	}
+	for (Command * command : commands) {
+		if (command->kind == CommandKind::Add) {
+			command->isAccepted = addPort(command->transport, command->receive);
+			portCount += command->isAccepted ? 1 : 0;
+			command->isDone = true;
+		}
+		else if (removePort(command->transport)) {
+			command->isDone = true;
+		}
+		else {
+			for (std::unique_ptr<Port> & port : ports) {
+				if (port->transport == command->transport && port->state == PortState::Closing) {
+					removals.push_back(std::make_pair(port.get(), command));
+				}
+			}
+		}
+	}
+	commands.clear();
+	commandDone.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	addPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool addPort(SerialTransport * transport, ReceiveFunction receive)
+--					SerialTransport * transport:	the port to service
+--					ReceiveFunction receive:		where its reads go
+--
+-- RETURNS:		bool - false if the port is already added or cannot be serviced
+--
+-- NOTES:
+-- Simulated ports are timed here; anything else goes to the platform half.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortMultiplexer::addPort(SerialTransport * transport, ReceiveFunction receive) {
+	SimulatedTransport * simulated = dynamic_cast<SimulatedTransport *>(transport);
+	std::unique_ptr<Port> port;
+
+	for (std::unique_ptr<Port> & existing : ports) {
+		if (existing->transport == transport && existing->state != PortState::Closing) {
+			return false;
+		}
+	}
+	if (transport == nullptr || !transport->isOpen()) {
+		return false;
+	}
+	if (simulated != nullptr) {
+		port.reset(new Port());
+		port->simulated = simulated;
+		simulated->setArrivalNotify([this]() { wake(); });
+	}
+	else if ((port = attach(transport)) == nullptr) {
+		return false;
+	}
+	port->transport = transport;
+	port->receive = receive;
+	ports.push_back(std::move(port));
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	removePort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool removePort(SerialTransport * transport)
+--					SerialTransport * transport:	the port to stop servicing
+--
+-- RETURNS:		bool - true if the port is gone, or was never added; false if it is Closing
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortMultiplexer::removePort(SerialTransport * transport) {
+	for (size_t i = 0; i < ports.size(); i++) {
+		Port * port = ports[i].get();
+
+		if (port->transport != transport || port->state == PortState::Closing) {
+			continue;
+		}
+		portCount--;
+		if (port->simulated != nullptr) {
+			port->simulated->setArrivalNotify(nullptr);
+		}
+		else if (port->state == PortState::Active && !detach(port)) {
+			port->state = PortState::Closing;
+			return false;
+		}
+		ports.erase(ports.begin() + i);
+		return true;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	releaseClosed
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void releaseClosed(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Frees the ports the platform has handed back as Closed and completes the removes waiting on them.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::releaseClosed() {
+	bool isReleased = false;
+
+	for (size_t i = 0; i < ports.size();) {
+		if (ports[i]->state != PortState::Closed) {
+			i++;
+			continue;
+		}
+		{
+			std::lock_guard<std::mutex> guard(commandLock);
+			for (size_t j = 0; j < removals.size(); j++) {
+				if (removals[j].first == ports[i].get()) {
+					removals[j].second->isDone = true;
+					removals.erase(removals.begin() + j);
+					isReleased = true;
+					break;
+				}
+			}
+		}
+		ports.erase(ports.begin() + i);
+	}
+	if (isReleased) {
+		std::lock_guard<std::mutex> guard(commandLock);
+		commandDone.notify_all();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	serviceSimulated
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint32_t serviceSimulated(void)
+--
+-- RETURNS:		uint32_t - ms until the next simulated port is due, or WAIT_FOREVER if none is expecting data
+--
+-- NOTES:
+-- A port's deadline is set from the first byte due on its line and cleared by the read, so a port that was idle is
+-- picked up on the next pass after its line wakes the thread.
+----------------------------------------------------------------------------------------------------------------------*/
+uint32_t PortMultiplexer::serviceSimulated() {
+	Clock::time_point now = Clock::now();
+	Clock::time_point next = Clock::time_point::max();
+	Clock::time_point due;
+
+	for (std::unique_ptr<Port> & entry : ports) {
+		Port * port = entry.get();
+
+		if (port->simulated == nullptr || port->state != PortState::Active) {
+			continue;
+		}
+		if (port->hasDeadline && port->deadline <= now) {
+			port->hasDeadline = false;
+			if (!port->transport->read(port->buffer, RX_CHUNK_SIZE, 0, &port->length)) {
+				port->state = PortState::Failed;
+				failedPorts.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			deliver(port);
+		}
+		if (!port->hasDeadline && port->simulated->getNextArrival(&due)) {
+			port->deadline = due + SIMULATED_RX_LATENCY;
+			port->hasDeadline = true;
+		}
+		if (port->hasDeadline && port->deadline < next) {
+			next = port->deadline;
+		}
+	}
+
+	if (next == Clock::time_point::max()) {
+		return WAIT_FOREVER;
+	}
+	if (next <= now) {
+		return 0;
+	}
+	// Round up so the wait does not end just short of the deadline and spin
+	return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+		next - now + std::chrono::milliseconds(1) - Clock::duration(1)).count();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	deliver
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void deliver(Port * port)
+--					Port * port:	a port with port->length bytes read into its buffer
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void PortMultiplexer::deliver(Port * port) {
+	if (port->length == 0) {
+		return;
+	}
+	reads.fetch_add(1, std::memory_order_relaxed);
+	bytesReceived.fetch_add(port->length, std::memory_order_relaxed);
+	port->receive(port->buffer, port->length);
+	port->length = 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		PortMultiplexer.h -	Services the receive side of many ports from one I/O thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(void)
+--					void stop(void)
+--					bool add(SerialTransport * transport, ReceiveFunction receive)
+--					void remove(SerialTransport * transport)
+--					size_t getPortCount(void) const
+--					MultiplexerStats getStats(void) const
+--					std::unique_ptr<PortMultiplexer> createPortMultiplexer(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Instead of a reader thread per port, every added port is read by one thread that sleeps until any of them has
+-- data: an I/O completion port on Windows (IocpMultiplexer), epoll elsewhere (EpollMultiplexer). Each read of up to
+-- RX_CHUNK_SIZE bytes is handed to the port's receive function on that thread, which is where SerialPipeline pushes
+-- it into its ring. Ports are added and removed from any thread; the change is made on the I/O thread and the call
+-- returns once it has taken effect, so after remove the receive function is never called again. A port whose read
+-- fails is dropped from the wait set and stays quiet until it is removed.
+--
+-- A SimulatedTransport has no handle to wait on. The I/O thread reads it SIMULATED_RX_LATENCY after the first byte
+-- on its line is due, so the bytes arriving in between are collected in one read, much as a UART's receive timeout
+-- batches them; the port wakes the thread when its line goes from idle to busy.
+--
+-- The platform half provides the wait: attach and detach a port, wait for reads to complete, and wake the wait early.
+-- Its destructor must call stop, since the base destructor runs after the platform half is gone. add and remove wait
+-- for the I/O thread, so never call them from a receive function.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class SimulatedTransport;
+
+constexpr int MULTIPLEXER_BATCH = 64;		// completions taken per wait
+constexpr std::chrono::microseconds SIMULATED_RX_LATENCY{ 1000 };
+
+struct MultiplexerStats {
+	uint64_t wakeups = 0;			// times the I/O thread came out of its wait
+	uint64_t reads = 0;				// reads that delivered data
+	uint64_t bytesReceived = 0;
+	uint64_t failedPorts = 0;		// ports dropped after a read failed
+};
+
+class PortMultiplexer {
+public:
+	typedef std::chrono::steady_clock Clock;
+	// Called on the I/O thread with each read
+	typedef std::function<void(const char * data, size_t length)> ReceiveFunction;
+
+	enum class PortState : uint8_t {
+		Active,			// a read is pending or the port is waited on
+		Failed,			// a read failed; nothing more is read
+		Closing,		// detached, waiting for the platform to give the port back
+		Closed
+	};
+
+	struct Port {
+		SerialTransport * transport = nullptr;
+		SimulatedTransport * simulated = nullptr;	// set when the port is timed rather than waited on
+		ReceiveFunction receive;
+		PortState state = PortState::Active;
+		Clock::time_point deadline;					// simulated ports: when to read next
+		bool hasDeadline = false;
+		size_t length = 0;							// bytes in buffer after a completed read
+		char buffer[RX_CHUNK_SIZE];
+
+		virtual ~Port() {};
+	};
+private:
+	enum class CommandKind : uint8_t { Add, Remove };
+
+	struct Command {
+		CommandKind kind;
+		SerialTransport * transport;
+		ReceiveFunction receive;
+		bool isDone;
+		bool isAccepted;
+	};
+
+	std::thread worker;
+	std::atomic<bool> isRunning{ false };
+	std::vector<std::unique_ptr<Port>> ports;		// owned by the I/O thread while it runs
+
+	mutable std::mutex commandLock;
+	std::condition_variable commandDone;
+	std::vector<Command *> commands;
+	std::vector<std::pair<Port *, Command *>> removals;	// Closing ports and the remove waiting for each
+	size_t portCount = 0;
+
+	std::atomic<uint64_t> wakeups{ 0 };
+	std::atomic<uint64_t> reads{ 0 };
+	std::atomic<uint64_t> bytesReceived{ 0 };
+	std::atomic<uint64_t> failedPorts{ 0 };
+
+	void run();
+	void runCommands();
+	bool addPort(SerialTransport * transport, ReceiveFunction receive);
+	bool removePort(SerialTransport * transport);
+	void releaseClosed();
+	uint32_t serviceSimulated();
+	void deliver(Port * port);
+	bool submit(Command * command);
+protected:
+	// The platform half; everything but wake is called on the I/O thread, or by start and stop while it is not running
+	virtual bool openQueue() = 0;
+	virtual void closeQueue() = 0;
+	// Returns a port that will be waited on, with its first read pending, or nullptr if the transport cannot be
+	virtual std::unique_ptr<Port> attach(SerialTransport * transport) = 0;
+	// Stops waiting on the port; returns false if it is Closing and a later wait will hand it back as Closed
+	virtual bool detach(Port * port) = 0;
+	// Waits up to timeout ms (WAIT_FOREVER for no limit); fills ready with ports whose read completed, failed or closed
+	virtual int wait(Port ** ready, int capacity, uint32_t timeout) = 0;
+	// Issues the next read after a completed one has been delivered; marks the port Failed if it cannot
+	virtual void rearm(Port * port) = 0;
+	virtual void wake() = 0;
+public:
+	static constexpr uint32_t WAIT_FOREVER = 0xFFFFFFFF;
+
+	PortMultiplexer() {};
+	virtual ~PortMultiplexer() {};
+	PortMultiplexer(const PortMultiplexer &) = delete;
+	PortMultiplexer & operator=(const PortMultiplexer &) = delete;
+
+	bool start();
+	void stop();
+	bool add(SerialTransport * transport, ReceiveFunction receive);
+	void remove(SerialTransport * transport);
+	bool isActive() const { return isRunning.load(std::memory_order_relaxed); };
+	size_t getPortCount() const;
+	MultiplexerStats getStats() const;
+};
+
+std::unique_ptr<PortMultiplexer> createPortMultiplexer();
@@ -0,0 +1,166 @@
+#include "PortWorker.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PortWorker.cpp -	A long-lived thread that runs one port job per connection.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(Job work)
+--					void stop(void)
+--					void run(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Every state change is made under the lock and announced on the one condition variable, which both the thread and
+-- a caller waiting in stop watch.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	~PortWorker
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	~PortWorker(void)
+--
+-- NOTES:
+-- Tells the parked thread to exit and joins it. A job still running is waited for, so its owner must have made it
+-- return first, as it would for stop.
+----------------------------------------------------------------------------------------------------------------------*/
+PortWorker::~PortWorker() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		state = WorkerState::Exiting;
+	}
+	changed.notify_all();
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	start
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool start(Job work)
+--					Job work:	run once on the worker thread; returns when the connection is over
+--
+-- RETURNS:		bool - false if a job is still running
+--
+-- NOTES:
+-- Hands the job to the parked thread, creating the thread the first time. Throws std::system_error, with the
+-- worker left Idle, if the thread cannot be created.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PortWorker::start(Job work) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		if (state != WorkerState::Idle) {
+			return false;
+		}
+		job = work;
+		state = WorkerState::Running;
+		if (!thread.joinable()) {
+			try {
+				thread = std::thread(&PortWorker::run, this);
+			}
+			catch (...) {
+				job = nullptr;
+				state = WorkerState::Idle;
+				throw;
+			}
+			threadStarts.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	changed.notify_all();
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void stop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function once the job has been told to return. It waits until it has, leaving the thread parked for
+-- the next start. Returns at once if the job already ended on its own.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortWorker::stop() {
+	std::unique_lock<std::mutex> guard(lock);
+
+	if (state == WorkerState::Running) {
+		state = WorkerState::Stopping;
+	}
+	changed.wait(guard, [this] { return state == WorkerState::Idle || state == WorkerState::Exiting; });
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The worker thread. It waits for a job, runs it without the lock held, and goes back to Idle, until told to exit.
+----------------------------------------------------------------------------------------------------------------------*/
+void PortWorker::run() {
+	std::unique_lock<std::mutex> guard(lock);
+
+	for (;;) {
+		// A job stopped before the thread picked it up still runs, and returns at once
+		changed.wait(guard, [this] { return state == WorkerState::Exiting || (state != WorkerState::Idle && job); });
+		if (state == WorkerState::Exiting) {
+			return;
+		}
+		Job work = std::move(job);
+		job = nullptr;
+		guard.unlock();
+		work();
+		jobCount.fetch_add(1, std::memory_order_relaxed);
+		guard.lock();
+		if (state != WorkerState::Exiting) {
+			state = WorkerState::Idle;
+		}
+		changed.notify_all();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		PortWorker.h -	A long-lived thread that runs one port job per connection.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(Job work)
+--					void stop(void)
+--					WorkerState getState(void) const
+--					uint64_t getThreadStarts(void) const
+--					uint64_t getJobCount(void) const
+--					void run(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The thread is created by the first start and then kept, parked on a condition variable, until the worker is
+-- destroyed; later connections hand it a new job instead of creating a thread. Its state only moves along:
+--
+--		Idle -> Running			start, which creates the thread the first time
+--		Running -> Stopping		stop, once the owner has told the job to finish
+--		Running -> Idle			the job returns on its own, for instance when the port fails
+--		Stopping -> Idle		the job returns after stop
+--		Idle -> Exiting			the destructor, which then joins the thread
+--
+-- stop does not end the job itself. The owner first makes it return, for instance by cancelling the transport it is
+-- blocked in, then calls stop, which waits until the thread is back to Idle. A job therefore never outlives the
+-- connection it was started for, and there is never more than one running on a worker.
+----------------------------------------------------------------------------------------------------------------------*/
+
+enum class WorkerState { Idle, Running, Stopping, Exiting };
+
+class PortWorker {
+public:
+	typedef std::function<void()> Job;
+private:
+	mutable std::mutex lock;
+	std::condition_variable changed;
+	std::thread thread;
+	WorkerState state = WorkerState::Idle;
+	Job job;
+	std::atomic<uint64_t> threadStarts{ 0 };
+	std::atomic<uint64_t> jobCount{ 0 };
+
+	void run();
+public:
+	PortWorker() {};
+	~PortWorker();
+	PortWorker(const PortWorker &) = delete;
+	PortWorker & operator=(const PortWorker &) = delete;
+
+	bool start(Job work);
+	void stop();
+	WorkerState getState() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return state;
+	};
+	uint64_t getThreadStarts() const { return threadStarts.load(std::memory_order_relaxed); };
+	uint64_t getJobCount() const { return jobCount.load(std::memory_order_relaxed); };
+};
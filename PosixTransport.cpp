@@ -0,0 +1,611 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#include "PosixTransport.h"
+#include "error_codes.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PosixTransport.cpp -	SerialTransport for a tty or pseudo-terminal on Linux.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int adopt(int fd, const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					void recordLineStatus(void)
+--					bool openPtyPair(int * master, std::string * slaveName)
+--					speed_t speedFor(uint32_t baudRate)
+--					std::unique_ptr<SerialTransport> createSerialTransport(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Flow control status and receive pausing
+--					Oct 17, 2026 - Line errors and input queue depth are recorded in the LinkTelemetry
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This file is built on Linux only; Win32Transport.cpp provides createSerialTransport on Windows. The reader owns
+-- the epoll set; the writer waits with poll so the two threads never modify the same registration.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	speedFor
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	speed_t speedFor(uint32_t baudRate)
+--					uint32_t baudRate:	bits per second
+--
+-- RETURNS:		speed_t - the termios constant, B0 if the rate is not a standard one
+----------------------------------------------------------------------------------------------------------------------*/
+static speed_t speedFor(uint32_t baudRate) {
+	static const struct {
+		uint32_t rate;
+		speed_t speed;
+	} speeds[] = {
+		{ 110, B110 }, { 300, B300 }, { 600, B600 }, { 1200, B1200 }, { 2400, B2400 }, { 4800, B4800 },
+		{ 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 }, { 115200, B115200 },
+		{ 230400, B230400 }, { 460800, B460800 }, { 921600, B921600 },
+	};
+
+	for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+		if (speeds[i].rate == baudRate) {
+			return speeds[i].speed;
+		}
+	}
+	return B0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int open(const std::string & name)
+--					const std::string & name:	path of the device, such as "/dev/ttyUSB0" or a pty slave
+--
+-- RETURNS:		int - 0 on success, otherwise an error code from error_codes.h
+----------------------------------------------------------------------------------------------------------------------*/
+int PosixTransport::open(const std::string & name) {
+	int fd;
+
+	close();
+	fd = ::open(name.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (fd < 0) {
+		return ERROR_OPEN_PORT;
+	}
+	return adopt(fd, name);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	adopt
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Asks the new driver again for what it can report
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int adopt(int fd, const std::string & name)
+--					int fd:						an open tty descriptor; the transport closes it
+--					const std::string & name:	name used for the port
+--
+-- RETURNS:		int - 0 on success, otherwise an error code from error_codes.h
+--
+-- NOTES:
+-- Call this function to drive a descriptor that was opened elsewhere, such as the master side of a pty pair.
+----------------------------------------------------------------------------------------------------------------------*/
+int PosixTransport::adopt(int fd, const std::string & name) {
+	struct termios tio;
+	struct epoll_event event = {};
+
+	close();
+	portFd = fd;
+	portName = name;
+	hasLineCounts = false;
+	canCountLine = true;
+	canQueryInput = true;
+
+	if (tcgetattr(portFd, &tio) != 0) {
+		close();
+		return ERROR_PORT_PROP;
+	}
+	cfmakeraw(&tio);
+	tio.c_cflag |= CLOCAL | CREAD;
+	// With VMIN 0 an empty tty reads 0 even when non-blocking; VMIN 1 makes it report EAGAIN instead
+	tio.c_cc[VMIN] = 1;
+	tio.c_cc[VTIME] = 0;
+	if (tcsetattr(portFd, TCSANOW, &tio) != 0 ||
+		fcntl(portFd, F_SETFL, fcntl(portFd, F_GETFL) | O_NONBLOCK) != 0) {
+		close();
+		return ERROR_PORT_CONFIG;
+	}
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	cancelFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (epollFd < 0 || cancelFd < 0) {
+		close();
+		return ERROR_OPEN_PORT;
+	}
+	event.events = EPOLLIN;
+	event.data.fd = portFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, portFd, &event);
+	event.data.fd = cancelFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, cancelFd, &event);
+
+	tcflush(portFd, TCIOFLUSH);
+	isCancelled.store(false);
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	configure
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Keeps the settings for setReceivePaused
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int configure(const PortSettings & settings)
+--					const PortSettings & settings:	line settings to apply
+--
+-- RETURNS:		int - 0 on success, otherwise an error code from error_codes.h
+----------------------------------------------------------------------------------------------------------------------*/
+int PosixTransport::configure(const PortSettings & settings) {
+	struct termios tio;
+	speed_t speed = speedFor(settings.baudRate);
+
+	if (speed == B0 || tcgetattr(portFd, &tio) != 0) {
+		return ERROR_PORT_CONFIG;
+	}
+	cfsetispeed(&tio, speed);
+	cfsetospeed(&tio, speed);
+
+	tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+	switch (settings.dataBits) {
+	case 5:
+		tio.c_cflag |= CS5;
+		break;
+	case 6:
+		tio.c_cflag |= CS6;
+		break;
+	case 7:
+		tio.c_cflag |= CS7;
+		break;
+	default:
+		tio.c_cflag |= CS8;
+		break;
+	}
+	if (settings.parity != ParityMode::None) {
+		tio.c_cflag |= PARENB | (settings.parity == ParityMode::Odd ? PARODD : 0);
+	}
+	if (settings.stopBits == 2) {
+		tio.c_cflag |= CSTOPB;
+	}
+	if (settings.rtsCts) {
+		tio.c_cflag |= CRTSCTS;
+	}
+	tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+	if (settings.xonXoff) {
+		tio.c_iflag |= IXON | IXOFF;
+	}
+
+	if (tcsetattr(portFd, TCSANOW, &tio) != 0) {
+		return ERROR_PORT_CONFIG;
+	}
+	portSettings = settings;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function once the reader and writer have stopped using the port.
+----------------------------------------------------------------------------------------------------------------------*/
+void PosixTransport::close() {
+	if (portFd >= 0) {
+		::close(portFd);
+		portFd = -1;
+	}
+	if (epollFd >= 0) {
+		::close(epollFd);
+		epollFd = -1;
+	}
+	if (cancelFd >= 0) {
+		::close(cancelFd);
+		cancelFd = -1;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	read
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Records the line status when it wakes or returns data
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					char * buffer:		the buffer that receives the chunk
+--					size_t capacity:	size of the buffer in bytes
+--					uint32_t timeout:	ms to wait for data
+--					size_t * bytesRead:	set to the number of bytes placed in the buffer, 0 on timeout
+--
+-- RETURNS:		bool - false if the port failed, hung up or was cancelled
+--
+-- NOTES:
+-- Bytes already queued are read without waiting. A pty master whose slave has been closed reads EIO, which ends
+-- the session like a lost port would.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PosixTransport::read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) {
+	struct epoll_event events[2];
+	ssize_t received;
+	int ready;
+
+	*bytesRead = 0;
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (isCancelled.load(std::memory_order_relaxed)) {
+			return false;
+		}
+		received = ::read(portFd, buffer, capacity);
+		if (received > 0) {
+			*bytesRead = (size_t)received;
+			recordLineStatus();
+			return true;
+		}
+		if (received == 0 || (errno != EAGAIN && errno != EINTR)) {
+			return false;
+		}
+		if (attempt > 0) {
+			// Woken with nothing to read, which a break or a line error alone can do
+			recordLineStatus();
+			break;
+		}
+
+		ready = epoll_wait(epollFd, events, 2, (int)timeout);
+		if (ready < 0) {
+			return errno == EINTR;
+		}
+		for (int i = 0; i < ready; i++) {
+			if (events[i].data.fd == portFd && (events[i].events & (EPOLLERR | EPOLLHUP)) &&
+				!(events[i].events & EPOLLIN)) {
+				return false;
+			}
+		}
+		if (ready == 0) {
+			return true;
+		}
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	write
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool write(const char * data, size_t length)
+--					const char * data:	the bytes to write
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		bool - false if the write failed or was cancelled
+--
+-- NOTES:
+-- When the tty's output queue is full the writer waits for room in slices, so cancel is not held up by a line that
+-- flow control has stopped.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PosixTransport::write(const char * data, size_t length) {
+	struct pollfd fds[2];
+	ssize_t written;
+	size_t total = 0;
+
+	fds[0].fd = portFd;
+	fds[0].events = POLLOUT;
+	fds[1].fd = cancelFd;
+	fds[1].events = POLLIN;
+
+	while (total < length) {
+		if (isCancelled.load(std::memory_order_relaxed)) {
+			return false;
+		}
+		written = ::write(portFd, data + total, length - total);
+		if (written > 0) {
+			total += (size_t)written;
+			continue;
+		}
+		if (written < 0 && errno != EAGAIN && errno != EINTR) {
+			return false;
+		}
+		if (poll(fds, 2, (int)TX_WAIT_TIMEOUT) < 0 && errno != EINTR) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cancel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void cancel(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The eventfd is left signalled so every later wait also returns at once, until the port is opened again.
+----------------------------------------------------------------------------------------------------------------------*/
+void PosixTransport::cancel() {
+	uint64_t one = 1;
+
+	isCancelled.store(true);
+	if (cancelFd >= 0 && ::write(cancelFd, &one, sizeof(one)) < 0) {
+		// Already signalled enough times to overflow the counter; the waits wake regardless
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getFlowStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getFlowStatus(FlowStatus * status)
+--					FlowStatus * status:	set to the output queue, and to the state of CTS under RTS/CTS
+--
+-- RETURNS:		bool - false if the output queue cannot be read
+--
+-- NOTES:
+-- isXoffHeld is never set; see the notes in PosixTransport.h. A port without modem lines reports CTS as not held.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PosixTransport::getFlowStatus(FlowStatus * status) {
+	int queued, lines;
+
+	if (ioctl(portFd, TIOCOUTQ, &queued) != 0) {
+		return false;
+	}
+	status->outputQueued = queued > 0 ? (size_t)queued : 0;
+	status->isCtsHeld = portSettings.rtsCts && ioctl(portFd, TIOCMGET, &lines) == 0 && !(lines & TIOCM_CTS);
+	status->isXoffHeld = false;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setReceivePaused
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool setReceivePaused(bool paused)
+--					bool paused:	true to ask the far end to stop sending, false to let it resume
+--
+-- RETURNS:		bool - false if neither kind of flow control is set or the port refused
+--
+-- NOTES:
+-- Drops or raises RTS, and has the tty send STOP or START ahead of anything queued, as the settings call for.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PosixTransport::setReceivePaused(bool paused) {
+	int rts = TIOCM_RTS;
+	bool isSignalled = false;
+
+	if (portSettings.rtsCts) {
+		isSignalled = ioctl(portFd, paused ? TIOCMBIC : TIOCMBIS, &rts) == 0;
+	}
+	if (portSettings.xonXoff) {
+		isSignalled = tcflow(portFd, paused ? TCIOFF : TCION) == 0 || isSignalled;
+	}
+	return isSignalled;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setTelemetry(LinkTelemetry * telemetry)
+--					LinkTelemetry * telemetry:	where to record line errors and input queue depth, or nullptr to stop
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function while the reader is stopped. Errors the driver counted before now are not recorded.
+----------------------------------------------------------------------------------------------------------------------*/
+void PosixTransport::setTelemetry(LinkTelemetry * portTelemetry) {
+	telemetry = portTelemetry;
+	hasLineCounts = false;
+	recordLineStatus();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	recordLineStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void recordLineStatus(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Called on the reader thread. TIOCGICOUNT gives running totals since the driver loaded, so only the change since
+-- the last reading is counted; the first reading just sets where to count from.
+----------------------------------------------------------------------------------------------------------------------*/
+void PosixTransport::recordLineStatus() {
+	if (telemetry == nullptr || portFd < 0) {
+		return;
+	}
+	if (canCountLine) {
+		struct serial_icounter_struct counts = {};
+
+		if (ioctl(portFd, TIOCGICOUNT, &counts) == 0) {
+			uint32_t totals[LINE_ERROR_KINDS];
+
+			totals[(int)LineError::Overrun] = (uint32_t)counts.overrun;
+			totals[(int)LineError::InputOverflow] = (uint32_t)counts.buf_overrun;
+			totals[(int)LineError::Framing] = (uint32_t)counts.frame;
+			totals[(int)LineError::Parity] = (uint32_t)counts.parity;
+			totals[(int)LineError::Break] = (uint32_t)counts.brk;
+			for (int kind = 0; kind < LINE_ERROR_KINDS; kind++) {
+				if (hasLineCounts && totals[kind] != lineCounts[kind]) {
+					telemetry->countLineError((LineError)kind, (uint32_t)(totals[kind] - lineCounts[kind]));
+				}
+				lineCounts[kind] = totals[kind];
+			}
+			hasLineCounts = true;
+		}
+		else if (errno == EINVAL || errno == ENOTTY) {
+			canCountLine = false;
+		}
+	}
+	if (canQueryInput) {
+		int queued;
+
+		if (ioctl(portFd, TIOCINQ, &queued) == 0) {
+			telemetry->noteInputQueue(queued > 0 ? (size_t)queued : 0);
+		}
+		else if (errno == EINVAL || errno == ENOTTY) {
+			canQueryInput = false;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openPtyPair
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openPtyPair(int * master, std::string * slaveName)
+--					int * master:				set to the master descriptor
+--					std::string * slaveName:	set to the path of the slave device
+--
+-- RETURNS:		bool - false if no pty could be allocated
+--
+-- NOTES:
+-- The pair behaves like two ports joined by a null-modem cable, with no line rate. Pass the master to adopt and
+-- open the slave by name, or hand the slave name to another program.
+----------------------------------------------------------------------------------------------------------------------*/
+bool PosixTransport::openPtyPair(int * master, std::string * slaveName) {
+	char name[128];
+	int fd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+
+	if (fd < 0) {
+		return false;
+	}
+	if (grantpt(fd) != 0 || unlockpt(fd) != 0 || ptsname_r(fd, name, sizeof(name)) != 0) {
+		::close(fd);
+		return false;
+	}
+	*master = fd;
+	*slaveName = name;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createSerialTransport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<SerialTransport> createSerialTransport(void)
+--
+-- RETURNS:		std::unique_ptr<SerialTransport> - a closed transport for this platform
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<SerialTransport> createSerialTransport() {
+	return std::unique_ptr<SerialTransport>(new PosixTransport());
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "LinkTelemetry.h"
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		PosixTransport.h -	SerialTransport for a tty or pseudo-terminal on Linux.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int adopt(int fd, const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					int getDescriptor(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					void recordLineStatus(void)
+--					bool openPtyPair(int * master, std::string * slaveName)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Reports the output queue and CTS, and pauses the far end on request
+--					Oct 17, 2026 - Records line errors and input queue depth in the port's LinkTelemetry
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The descriptor is put in raw mode and made non-blocking. The reader sleeps in epoll_wait on the descriptor and on
+-- an eventfd that cancel signals, then drains everything the tty holds up to the buffer size. A pty pair from
+-- openPtyPair gives a loopback for testing without hardware: adopt the master here and open the slave by name.
+--
+-- Linux does not say whether an XOFF from the far end is holding output, so under XON/XOFF a held line only shows
+-- as an output queue that does not drain. A pty has no modem lines, so RTS/CTS does nothing on one.
+--
+-- With a LinkTelemetry set, each read that wakes or returns data asks the driver for its line error totals with
+-- TIOCGICOUNT and adds what has changed since the last ask, and records the input queue from TIOCINQ. A driver that
+-- answers either with EINVAL or ENOTTY, as a pty does, is not asked for that one again.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class PosixTransport : public SerialTransport {
+private:
+	int portFd = -1;
+	int epollFd = -1;
+	int cancelFd = -1;
+	std::string portName;
+	std::atomic<bool> isCancelled{ false };
+	PortSettings portSettings;
+	LinkTelemetry * telemetry = nullptr;
+	uint32_t lineCounts[LINE_ERROR_KINDS] = {};	// the driver's totals at the last ask
+	bool hasLineCounts = false;					// lineCounts holds a first reading to count from
+	bool canCountLine = true;
+	bool canQueryInput = true;
+
+	void recordLineStatus();
+public:
+	PosixTransport() {};
+	~PosixTransport() { close(); };
+	PosixTransport(const PosixTransport &) = delete;
+	PosixTransport & operator=(const PosixTransport &) = delete;
+
+	int open(const std::string & name) override;
+	int adopt(int fd, const std::string & name);
+	int configure(const PortSettings & settings) override;
+	void close() override;
+	bool isOpen() const override { return portFd >= 0; };
+	int getDescriptor() const { return portFd; };
+	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) override;
+	bool write(const char * data, size_t length) override;
+	void cancel() override;
+	bool getFlowStatus(FlowStatus * status) override;
+	bool setReceivePaused(bool paused) override;
+	void setTelemetry(LinkTelemetry * portTelemetry) override;
+
+	static bool openPtyPair(int * master, std::string * slaveName);
+};
@@ -0,0 +1,165 @@
+#include "Renderer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Renderer.cpp -	Walks the visible part of the model into a Renderer.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void renderView(Renderer & renderer, ScreenModel & screen, const Scrollback & history,
+--						size_t viewOffset)
+--					void renderRow(Renderer & renderer, int row, const char16_t * glyphs, const uint8_t * attributes,
+--						int length, int left, int right)
+--					void renderHistory(Renderer & renderer, const ScreenModel & screen, const Scrollback & history,
+--						size_t viewOffset, const CellRect & area)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This is the paint logic that used to live in DisplayService, with the device context replaced by a Renderer.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	renderRow
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void renderRow(Renderer & renderer, int row, const char16_t * glyphs, const uint8_t * attributes,
+--					int length, int left, int right)
+--					Renderer & renderer:			the backend to draw with
+--					int row:						view row to draw in
+--					const char16_t * glyphs:		the line's glyphs
+--					const uint8_t * attributes:		the line's attributes
+--					int length:						cells stored for the line; cells past it are blank
+--					int left, right:				inclusive column range to draw
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Draws one run per attribute change and fills the rest of the range with the default background.
+----------------------------------------------------------------------------------------------------------------------*/
+static void renderRow(Renderer & renderer, int row, const char16_t * glyphs, const uint8_t * attributes,
+	int length, int left, int right) {
+	int column = left, start;
+
+	while (column <= right && column < length) {
+		start = column;
+		while (column <= right && column < length && attributes[column] == attributes[start]) {
+			column++;
+		}
+		renderer.drawRun(row, start, glyphs + start, column - start, attributes[start]);
+	}
+	if (column <= right) {
+		renderer.fillBlank(row, column, right - column + 1, ATTR_DEFAULT);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	renderHistory
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void renderHistory(Renderer & renderer, const ScreenModel & screen, const Scrollback & history,
+--					size_t viewOffset, const CellRect & area)
+--					Renderer & renderer:			the backend to draw with
+--					const ScreenModel & screen:		the live screen
+--					const Scrollback & history:		lines scrolled off the screen
+--					size_t viewOffset:				lines the view is scrolled back
+--					const CellRect & area:			cells to draw
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Draws the scrolled-back view. View rows map to history lines first and then to the live screen rows below them.
+----------------------------------------------------------------------------------------------------------------------*/
+static void renderHistory(Renderer & renderer, const ScreenModel & screen, const Scrollback & history,
+	size_t viewOffset, const CellRect & area) {
+	ScrollbackLineView line;
+	int top = area.top < 0 ? 0 : area.top;
+	int left = area.left < 0 ? 0 : area.left;
+	int bottom = area.bottom < screen.getRows() ? area.bottom : screen.getRows() - 1;
+	int right = area.right < screen.getColumns() ? area.right : screen.getColumns() - 1;
+	size_t firstLine = history.size() - viewOffset;
+
+	for (int row = top; row <= bottom; row++) {
+		size_t lineIndex = firstLine + row;
+		if (history.getLine(lineIndex, &line)) {
+			renderRow(renderer, row, line.glyphs, line.attributes, (int)line.length, left, right);
+		}
+		else {
+			int screenRow = (int)(lineIndex - history.size());
+			renderRow(renderer, row, screen.rowGlyphs(screenRow), screen.rowAttributes(screenRow),
+				screen.getColumns(), left, right);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	renderView
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void renderView(Renderer & renderer, ScreenModel & screen, const Scrollback & history,
+--					size_t viewOffset)
+--					Renderer & renderer:			the backend to draw with
+--					ScreenModel & screen:			the live screen; its dirty cells are cleared
+--					const Scrollback & history:		lines scrolled off the screen
+--					size_t viewOffset:				lines the view is scrolled back, 0 when following new output;
+--													clamped to the history kept
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Draws one frame. Following the live screen, the backend's damage is marked dirty in the model and every dirty run
+-- is drawn once. Scrolled back, only the damage is drawn, since the model's dirty cells are not where they show.
+----------------------------------------------------------------------------------------------------------------------*/
+void renderView(Renderer & renderer, ScreenModel & screen, const Scrollback & history, size_t viewOffset) {
+	CellRect damage;
+	bool isDamaged = renderer.beginFrame(&damage);
+
+	if (viewOffset > history.size()) {
+		viewOffset = history.size();
+	}
+	if (viewOffset > 0) {
+		if (isDamaged) {
+			renderHistory(renderer, screen, history, viewOffset, damage);
+		}
+		renderer.endFrame();
+		return;
+	}
+
+	if (isDamaged) {
+		for (int row = damage.top; row <= damage.bottom; row++) {
+			screen.markDirty(row, damage.left, damage.right - damage.left + 1);
+		}
+	}
+	screen.forEachDirtyRun([&renderer](int row, int column, const char16_t * text, int count, uint8_t attribute) {
+		renderer.drawRun(row, column, text, count, attribute);
+	});
+	renderer.endFrame();
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ScreenModel.h"
+#include "Scrollback.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Renderer.h -	The drawing backend behind the terminal view.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool beginFrame(CellRect * damage)
+--					void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute)
+--					void fillBlank(int row, int column, int count, uint8_t attribute)
+--					void endFrame(void)
+--					bool clipRun(int row, int * column, int * count, int columns, int rows)
+--					void renderView(Renderer & renderer, ScreenModel & screen, const Scrollback & history,
+--						size_t viewOffset)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - clipRun shared by the in-memory backends
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A renderer only ever sees cells: runs of glyphs sharing one attribute, and blank runs. Deciding what to draw is
+-- renderView's job, so every backend shows exactly the same thing for the same model. GdiRenderer draws into the
+-- window from WM_PAINT; HeadlessRenderer copies the runs into an in-memory grid so benchmarks and golden-screen
+-- comparisons can run the real paint path anywhere, with no window and no platform dependencies.
+----------------------------------------------------------------------------------------------------------------------*/
+
+// An inclusive range of cells
+struct CellRect {
+	int top;
+	int left;
+	int bottom;
+	int right;
+};
+
+class Renderer {
+public:
+	virtual ~Renderer() {};
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	beginFrame
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	bool beginFrame(CellRect * damage)
+	--					CellRect * damage:	set to the cells the backend lost and needs redrawn
+	--
+	-- RETURNS:		bool - true if damage was set, false if only the model's dirty cells need drawing
+	--
+	-- NOTES:
+	-- Every beginFrame is matched by one endFrame. The damage may reach past the model's edges.
+	--------------------------------------------------------------------------------------------------------------*/
+	virtual bool beginFrame(CellRect * damage) = 0;
+	virtual void drawRun(int row, int column, const char16_t * glyphs, int count, uint8_t attribute) = 0;
+	virtual void fillBlank(int row, int column, int count, uint8_t attribute) = 0;
+	virtual void endFrame() = 0;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	clipRun
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool clipRun(int row, int * column, int * count, int columns, int rows)
+--					int row:			row of the run
+--					int * column:		first cell of the run; moved right past any cells left of the grid
+--					int * count:		cells in the run; shortened to the cells inside the grid
+--					int columns, rows:	size of the grid
+--
+-- RETURNS:		bool - false if nothing of the run is inside the grid
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool clipRun(int row, int * column, int * count, int columns, int rows) {
+	if (row < 0 || row >= rows) {
+		return false;
+	}
+	if (*column < 0) {
+		*count += *column;
+		*column = 0;
+	}
+	if (*column + *count > columns) {
+		*count = columns - *column;
+	}
+	return *count > 0;
+}
+
+void renderView(Renderer & renderer, ScreenModel & screen, const Scrollback & history, size_t viewOffset);
@@ -0,0 +1,383 @@
+#include <string.h>
+#include "ReplayTransport.h"
+#include "error_codes.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ReplayTransport.cpp -	A port that plays back the received side of a capture.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & path)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					void setSpeed(double speed)
+--					bool isFinished(void) const
+--					uint64_t getBytesReplayed(void) const
+--					bool isReplayPort(const std::string & name)
+--					void loadNext(void)
+--					Clock::time_point dueTime(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The one copy made is the read into the caller's buffer, the same copy a driver read makes; records are otherwise
+-- read in place from the mapping.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int open(const std::string & path)
+--					const std::string & path:	the capture to play back
+--
+-- RETURNS:		int - 0 on success, or ERROR_OPEN_PORT if the file is not a readable capture
+--
+-- NOTES:
+-- Playback starts now: the first record is due at its own timestamp from this call.
+----------------------------------------------------------------------------------------------------------------------*/
+int ReplayTransport::open(const std::string & path) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	if (!capture.open(path)) {
+		isPortOpen = false;
+		return ERROR_OPEN_PORT;
+	}
+	nextOffset = capture.begin();
+	payload = nullptr;
+	bytesReplayed = 0;
+	loadNext();
+	start = Clock::now();
+	isCancelled = false;
+	isPortOpen = true;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	configure
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int configure(const PortSettings & settings)
+--					const PortSettings & settings:	ignored; the capture already holds the line's timing
+--
+-- RETURNS:		int - 0
+----------------------------------------------------------------------------------------------------------------------*/
+int ReplayTransport::configure(const PortSettings & settings) {
+	(void)settings;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function only once the reader has stopped, since it unmaps the file reads copy from.
+----------------------------------------------------------------------------------------------------------------------*/
+void ReplayTransport::close() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	isPortOpen = false;
+	payload = nullptr;
+	capture.close();
+	wake.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isOpen
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isOpen(void) const
+--
+-- RETURNS:		bool - true between a successful open and close
+----------------------------------------------------------------------------------------------------------------------*/
+bool ReplayTransport::isOpen() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return isPortOpen;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	read
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					char * buffer:		where to put the bytes
+--					size_t capacity:	size of buffer
+--					uint32_t timeout:	ms to wait for a record to come due
+--					size_t * bytesRead:	bytes put in buffer; 0 if nothing came due in time
+--
+-- RETURNS:		bool - false if the port is closed or cancelled
+--
+-- NOTES:
+-- A record larger than the buffer is split over reads; the rest of it is already due for the next one.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ReplayTransport::read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) {
+	std::unique_lock<std::mutex> guard(lock);
+	Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout);
+	Clock::time_point now;
+	size_t count = 0;
+
+	*bytesRead = 0;
+	for (;;) {
+		if (!isPortOpen || isCancelled) {
+			return false;
+		}
+		now = Clock::now();
+		while (payload != nullptr && count < capacity && (consumed > 0 || speed <= 0 || dueTime() <= now)) {
+			size_t length = current.length - consumed < capacity - count ? current.length - consumed : capacity - count;
+			memcpy(buffer + count, payload + consumed, length);
+			count += length;
+			consumed += length;
+			if (consumed == current.length) {
+				loadNext();
+			}
+		}
+		if (count > 0) {
+			bytesReplayed += count;
+			*bytesRead = count;
+			return true;
+		}
+		if (now >= deadline) {
+			return true;
+		}
+		wake.wait_until(guard, payload != nullptr && dueTime() < deadline ? dueTime() : deadline);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	write
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool write(const char * data, size_t length)
+--					const char * data:	the bytes to write
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		bool - false if the port is closed or cancelled
+--
+-- NOTES:
+-- The bytes are discarded at once.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ReplayTransport::write(const char * data, size_t length) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	(void)data;
+	(void)length;
+	return isPortOpen && !isCancelled;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cancel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void cancel(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void ReplayTransport::cancel() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	isCancelled = true;
+	wake.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setSpeed
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setSpeed(double replaySpeed)
+--					double replaySpeed:	1 for the captured timing, 2 for twice as fast and so on; 0 for no waits
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Takes effect from the next open.
+----------------------------------------------------------------------------------------------------------------------*/
+void ReplayTransport::setSpeed(double replaySpeed) {
+	std::lock_guard<std::mutex> guard(lock);
+	speed = replaySpeed;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isFinished
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isFinished(void) const
+--
+-- RETURNS:		bool - true once every received record has been read
+----------------------------------------------------------------------------------------------------------------------*/
+bool ReplayTransport::isFinished() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return isPortOpen && payload == nullptr;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getBytesReplayed
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint64_t getBytesReplayed(void) const
+--
+-- RETURNS:		uint64_t - bytes read since open
+----------------------------------------------------------------------------------------------------------------------*/
+uint64_t ReplayTransport::getBytesReplayed() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return bytesReplayed;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isReplayPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isReplayPort(const std::string & name)
+--					const std::string & name:	a port name
+--
+-- RETURNS:		bool - true if the name is a capture file, which opens a ReplayTransport
+----------------------------------------------------------------------------------------------------------------------*/
+bool ReplayTransport::isReplayPort(const std::string & name) {
+	size_t extension = strlen(CAPTURE_FILE_EXTENSION);
+	return name.size() > extension && name.compare(name.size() - extension, extension, CAPTURE_FILE_EXTENSION) == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	loadNext
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void loadNext(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Moves to the next received record, skipping transmitted and empty ones; payload is nullptr if there is none.
+-- Called with the lock held.
+----------------------------------------------------------------------------------------------------------------------*/
+void ReplayTransport::loadNext() {
+	consumed = 0;
+	while (capture.next(&nextOffset, &current, &payload)) {
+		if (current.direction == CaptureDirection::Receive && current.length > 0) {
+			return;
+		}
+	}
+	payload = nullptr;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	dueTime
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	Clock::time_point dueTime(void) const
+--
+-- RETURNS:		Clock::time_point - when the current record arrives at this speed
+----------------------------------------------------------------------------------------------------------------------*/
+ReplayTransport::Clock::time_point ReplayTransport::dueTime() const {
+	if (speed <= 0) {
+		return start;
+	}
+	return start + std::chrono::duration_cast<Clock::duration>(
+		std::chrono::nanoseconds((long long)(current.timestamp / speed)));
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include "CaptureFile.h"
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		ReplayTransport.h -	A port that plays back the received side of a capture.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & path)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					void setSpeed(double speed)
+--					bool isFinished(void) const
+--					uint64_t getBytesReplayed(void) const
+--					bool isReplayPort(const std::string & name)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Opening a capture file as a port maps it with CaptureFile, and reads then return its received records as they
+-- come due: at the times they were captured, counted from open and divided by the speed, or as fast as they are read
+-- at a speed of 0. A read collects every record due, up to the buffer, as a driver read collects whatever is
+-- queued. Transmitted records are skipped and writes are accepted and discarded, since there is no device to hear
+-- them. Once the capture is played out the port stays open and idle.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class ReplayTransport : public SerialTransport {
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	mutable std::mutex lock;
+	std::condition_variable wake;
+	bool isPortOpen = false;
+	bool isCancelled = false;
+	CaptureFile capture;
+	double speed = 1;
+
+	size_t nextOffset = 0;			// the record after the current one
+	CaptureRecord current;
+	const char * payload = nullptr;	// the current record's bytes, or nullptr once played out
+	size_t consumed = 0;			// bytes of the current record already read
+	Clock::time_point start;
+	uint64_t bytesReplayed = 0;
+
+	void loadNext();
+	Clock::time_point dueTime() const;
+public:
+	ReplayTransport(double replaySpeed = 1) : speed(replaySpeed) {};
+	~ReplayTransport() { close(); };
+
+	int open(const std::string & path) override;
+	int configure(const PortSettings & settings) override;
+	void close() override;
+	bool isOpen() const override;
+	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) override;
+	bool write(const char * data, size_t length) override;
+	void cancel() override;
+
+	void setSpeed(double replaySpeed);
+	bool isFinished() const;
+	uint64_t getBytesReplayed() const;
+	static bool isReplayPort(const std::string & name);
+};
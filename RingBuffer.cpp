@@ -0,0 +1,234 @@
+#include <string.h>
+#include "RingBuffer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		RingBuffer.cpp -	A bounded lock-free byte queue for one producer thread and one consumer thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					size_t push(const char * data, size_t length)
+--					size_t pop(char * buffer, size_t capacity)
+--					size_t peek(const char ** data)
+--					void consume(size_t length)
+--					size_t size(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Positions increase without wrapping and are masked on access, so head == tail means empty and
+-- tail - head == capacity means full. The producer publishes with a release store of tail after copying, and the
+-- consumer publishes with a release store of head after reading, so neither side sees bytes before they are written.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	RingBuffer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	RingBuffer(size_t minimumCapacity)
+--					size_t minimumCapacity:	bytes the queue must hold; rounded up to a power of two
+--
+-- NOTES:
+-- Allocates the storage once. Nothing is allocated after construction.
+----------------------------------------------------------------------------------------------------------------------*/
+RingBuffer::RingBuffer(size_t minimumCapacity) :
+	head(0), cachedTail(0), tail(0), cachedHead(0), overflowBytes(0), overflowEvents(0) {
+	size_t capacity = 1;
+	while (capacity < minimumCapacity) {
+		capacity <<= 1;
+	}
+	storage = new char[capacity];
+	mask = capacity - 1;
+}
+
+RingBuffer::~RingBuffer() {
+	delete[] storage;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	push
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t push(const char * data, size_t length)
+--					const char * data:	bytes to append
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		size_t - bytes appended; the rest were dropped
+--
+-- NOTES:
+-- Call this function from the producer thread only. The copy is split in two when it wraps past the end of the
+-- storage.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t RingBuffer::push(const char * data, size_t length) {
+	size_t currentTail = tail.load(std::memory_order_relaxed);
+	size_t freeSpace = capacity() - (currentTail - cachedHead);
+	size_t offset, firstPart;
+
+	if (freeSpace < length) {
+		cachedHead = head.load(std::memory_order_acquire);
+		freeSpace = capacity() - (currentTail - cachedHead);
+	}
+	if (freeSpace < length) {
+		overflowBytes.fetch_add(length - freeSpace, std::memory_order_relaxed);
+		overflowEvents.fetch_add(1, std::memory_order_relaxed);
+		length = freeSpace;
+	}
+	if (length == 0) {
+		return 0;
+	}
+
+	offset = currentTail & mask;
+	firstPart = capacity() - offset;
+	if (firstPart >= length) {
+		memcpy(storage + offset, data, length);
+	}
+	else {
+		memcpy(storage + offset, data, firstPart);
+		memcpy(storage, data + firstPart, length - firstPart);
+	}
+	tail.store(currentTail + length, std::memory_order_release);
+	return length;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	pop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t pop(char * buffer, size_t capacity)
+--					char * buffer:		destination for the bytes
+--					size_t capacity:	size of buffer in bytes
+--
+-- RETURNS:		size_t - bytes copied out of the queue
+--
+-- NOTES:
+-- Call this function from the consumer thread only.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t RingBuffer::pop(char * buffer, size_t capacity) {
+	size_t copied = 0, available;
+	const char * data;
+
+	// At most two contiguous pieces when the readable region wraps
+	while (copied < capacity && (available = peek(&data)) > 0) {
+		if (available > capacity - copied) {
+			available = capacity - copied;
+		}
+		memcpy(buffer + copied, data, available);
+		consume(available);
+		copied += available;
+	}
+	return copied;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	peek
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t peek(const char ** data)
+--					const char ** data:	set to the first readable byte
+--
+-- RETURNS:		size_t - number of contiguous readable bytes at data
+--
+-- NOTES:
+-- Call this function from the consumer thread to read in place without copying. The bytes stay valid until they
+-- are released with consume. When the readable region wraps, only the part up to the end of the storage is
+-- returned; call peek again after consuming it.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t RingBuffer::peek(const char ** data) {
+	size_t currentHead = head.load(std::memory_order_relaxed);
+	size_t available = cachedTail - currentHead;
+	size_t offset, contiguous;
+
+	if (available == 0) {
+		cachedTail = tail.load(std::memory_order_acquire);
+		available = cachedTail - currentHead;
+		if (available == 0) {
+			return 0;
+		}
+	}
+
+	offset = currentHead & mask;
+	contiguous = capacity() - offset;
+	*data = storage + offset;
+	return available < contiguous ? available : contiguous;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	consume
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void consume(size_t length)
+--					size_t length:	bytes to release; at most what the last peek returned
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from the consumer thread to hand space back to the producer.
+----------------------------------------------------------------------------------------------------------------------*/
+void RingBuffer::consume(size_t length) {
+	head.store(head.load(std::memory_order_relaxed) + length, std::memory_order_release);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	size
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t size(void) const
+--
+-- RETURNS:		size_t - bytes queued
+--
+-- NOTES:
+-- Safe to call from any thread; the answer may be stale by the time it is used.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t RingBuffer::size() const {
+	size_t currentHead = head.load(std::memory_order_acquire);
+	return tail.load(std::memory_order_acquire) - currentHead;
+}
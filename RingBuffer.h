@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		RingBuffer.h -	A bounded lock-free byte queue for one producer thread and one consumer thread.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					size_t push(const char * data, size_t length)
+--					size_t pop(char * buffer, size_t capacity)
+--					size_t peek(const char ** data)
+--					void consume(size_t length)
+--					size_t size(void) const
+--					size_t capacity(void) const
+--					uint64_t getOverflowBytes(void) const
+--					uint64_t getOverflowEvents(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The capacity is rounded up to a power of two so positions wrap with a mask. The head (consumer) and tail
+-- (producer) positions sit on separate cache lines, and each side keeps a private copy of the other side's position
+-- so it only reads the shared one when its copy says the queue looks full or empty. push never blocks: bytes that do
+-- not fit are dropped and counted.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+class RingBuffer {
+private:
+	// Read by both sides, written once by the constructor
+	char * storage;
+	size_t mask;
+
+	// Consumer side
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;
+	size_t cachedTail;
+
+	// Producer side
+	alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;
+	size_t cachedHead;
+	std::atomic<uint64_t> overflowBytes;
+	std::atomic<uint64_t> overflowEvents;
+public:
+	RingBuffer(size_t minimumCapacity);
+	~RingBuffer();
+	RingBuffer(const RingBuffer &) = delete;
+	RingBuffer & operator=(const RingBuffer &) = delete;
+
+	size_t push(const char * data, size_t length);
+	size_t pop(char * buffer, size_t capacity);
+	size_t peek(const char ** data);
+	void consume(size_t length);
+	size_t size() const;
+	size_t capacity() const { return mask + 1; };
+	uint64_t getOverflowBytes() const { return overflowBytes.load(std::memory_order_relaxed); };
+	uint64_t getOverflowEvents() const { return overflowEvents.load(std::memory_order_relaxed); };
+};
@@ -0,0 +1,512 @@
+#include <string.h>
+#include "ScreenModel.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ScreenModel.cpp -	The character grid behind the terminal window.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void resize(int columns, int rows)
+--					void putText(const char * text, size_t length)
+--					void putGlyphs(const char16_t * text, size_t length)
+--					void lineFeed(void)
+--					void carriageReturn(void)
+--					void setCursor(int x, int y)
+--					void eraseCells(int row, int firstColumn, int count)
+--					void scrollUp(void)
+--					void markDirty(int row, int firstColumn, int count)
+--					void markAllDirty(void)
+--					bool getDirtyBounds(int * top, int * left, int * bottom, int * right) const
+--					void clearDirty(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Rows scrolled off the top are kept in a Scrollback
+--					Oct 17, 2026 - Cursor positioning and erasing for the escape sequence interpreter
+--					Oct 17, 2026 - putGlyphs for text decoded from UTF-8
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Wrapping is deferred like a VT100: writing the last column leaves the cursor past the edge, and the wrap happens
+-- when the next character arrives. This keeps a full-width line from scrolling the screen early.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	ScreenModel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	ScreenModel(int columns, int rows)
+--					int columns:	cells per row
+--					int rows:		rows on the screen
+--
+-- NOTES:
+-- Creates a blank screen with every cell dirty so the first paint draws the background.
+----------------------------------------------------------------------------------------------------------------------*/
+ScreenModel::ScreenModel(int columns, int rows) : columns(0), rows(0), wordsPerRow(0) {
+	resize(columns, rows);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	resize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void resize(int newColumns, int newRows)
+--					int newColumns:	cells per row
+--					int newRows:	rows on the screen
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when the window size changes. The overlapping part of the old screen is kept, shifted up if
+-- needed so the cursor row stays visible.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::resize(int newColumns, int newRows) {
+	std::vector<char16_t> newGlyphs;
+	std::vector<uint8_t> newAttributes;
+	int firstRow, keptRows, keptColumns;
+
+	if (newColumns < 1) {
+		newColumns = 1;
+	}
+	if (newRows < 1) {
+		newRows = 1;
+	}
+
+	newGlyphs.assign((size_t)newColumns * newRows, BLANK_GLYPH);
+	newAttributes.assign((size_t)newColumns * newRows, ATTR_DEFAULT);
+
+	firstRow = cursorY + 1 > newRows ? cursorY + 1 - newRows : 0;
+	keptRows = rows - firstRow < newRows ? rows - firstRow : newRows;
+	keptColumns = columns < newColumns ? columns : newColumns;
+	for (int row = 0; row < keptRows; row++) {
+		memcpy(&newGlyphs[(size_t)row * newColumns], &glyphs[(size_t)(row + firstRow) * columns],
+			keptColumns * sizeof(char16_t));
+		memcpy(&newAttributes[(size_t)row * newColumns], &attributes[(size_t)(row + firstRow) * columns],
+			keptColumns);
+	}
+
+	glyphs.swap(newGlyphs);
+	attributes.swap(newAttributes);
+	columns = newColumns;
+	rows = newRows;
+	wordsPerRow = (columns + 63) / 64;
+	dirtyBits.assign((size_t)wordsPerRow * rows, 0);
+	dirtyTop = rows;
+	dirtyLeft = columns;
+	dirtyBottom = -1;
+	dirtyRight = -1;
+
+	cursorY -= firstRow;
+	if (cursorX > columns) {
+		cursorX = columns;
+	}
+	markAllDirty();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	putText
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void putText(const char * text, size_t length)
+--					const char * text:	characters to place at the cursor
+--					size_t length:		number of characters in text
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function with printable text. Each byte becomes one cell with the current attribute. The text is copied
+-- a row segment at a time, so the cost per byte is a store and the dirty marking is per segment.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::putText(const char * text, size_t length) {
+	while (length > 0) {
+		if (cursorX >= columns) {
+			carriageReturn();
+			lineFeed();
+		}
+
+		size_t room = (size_t)(columns - cursorX);
+		size_t count = length < room ? length : room;
+		size_t offset = (size_t)cursorY * columns + cursorX;
+		char16_t * cellGlyphs = &glyphs[offset];
+
+		for (size_t i = 0; i < count; i++) {
+			cellGlyphs[i] = (unsigned char)text[i];
+		}
+		memset(&attributes[offset], currentAttribute, count);
+		markDirty(cursorY, cursorX, (int)count);
+
+		cursorX += (int)count;
+		text += count;
+		length -= count;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	putGlyphs
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void putGlyphs(const char16_t * text, size_t length)
+--					const char16_t * text:	decoded UTF-16 units to place at the cursor
+--					size_t length:			number of units in text
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The same as putText for text that has already been decoded: each unit becomes one cell, a row segment at a time.
+-- A surrogate pair takes two cells.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::putGlyphs(const char16_t * text, size_t length) {
+	while (length > 0) {
+		if (cursorX >= columns) {
+			carriageReturn();
+			lineFeed();
+		}
+
+		size_t room = (size_t)(columns - cursorX);
+		size_t count = length < room ? length : room;
+		size_t offset = (size_t)cursorY * columns + cursorX;
+
+		memcpy(&glyphs[offset], text, count * sizeof(char16_t));
+		memset(&attributes[offset], currentAttribute, count);
+		markDirty(cursorY, cursorX, (int)count);
+
+		cursorX += (int)count;
+		text += count;
+		length -= count;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	lineFeed
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void lineFeed(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to move the cursor down a row, scrolling the screen when it is on the last row.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::lineFeed() {
+	if (cursorY + 1 < rows) {
+		cursorY++;
+	}
+	else {
+		scrollUp();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	carriageReturn
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void carriageReturn(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to move the cursor to the first column.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::carriageReturn() {
+	cursorX = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setCursor
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setCursor(int x, int y)
+--					int x:	column, 0 based
+--					int y:	row, 0 based
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The position is clamped to the screen. Moving the cursor cancels a pending wrap.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::setCursor(int x, int y) {
+	cursorX = x < 0 ? 0 : (x >= columns ? columns - 1 : x);
+	cursorY = y < 0 ? 0 : (y >= rows ? rows - 1 : y);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	eraseCells
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void eraseCells(int row, int firstColumn, int count)
+--					int row:			row containing the cells
+--					int firstColumn:	first column to erase
+--					int count:			number of cells to erase
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Blanks the cells with the current attribute, as scrolling does, and marks them dirty. The range is clipped to the
+-- screen.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::eraseCells(int row, int firstColumn, int count) {
+	if (row < 0 || row >= rows) {
+		return;
+	}
+	if (firstColumn < 0) {
+		count += firstColumn;
+		firstColumn = 0;
+	}
+	if (firstColumn + count > columns) {
+		count = columns - firstColumn;
+	}
+	if (count <= 0) {
+		return;
+	}
+
+	size_t offset = (size_t)row * columns + firstColumn;
+	for (int i = 0; i < count; i++) {
+		glyphs[offset + i] = BLANK_GLYPH;
+	}
+	memset(&attributes[offset], currentAttribute, (size_t)count);
+	markDirty(row, firstColumn, count);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scrollUp
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Appends the departing row to the scrollback
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void scrollUp(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Moves every row up by one and blanks the last row. Every visible cell has moved, so the whole screen is dirty.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::scrollUp() {
+	size_t rowCells = (size_t)columns;
+	size_t movedCells = rowCells * (rows - 1);
+
+	if (history != NULL) {
+		history->append(rowGlyphs(0), rowAttributes(0), rowCells);
+	}
+	scrollCount++;
+
+	memmove(glyphs.data(), glyphs.data() + rowCells, movedCells * sizeof(char16_t));
+	memmove(attributes.data(), attributes.data() + rowCells, movedCells);
+	for (size_t i = movedCells; i < movedCells + rowCells; i++) {
+		glyphs[i] = BLANK_GLYPH;
+	}
+	memset(&attributes[movedCells], currentAttribute, rowCells);
+	markAllDirty();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	markDirty
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void markDirty(int row, int firstColumn, int count)
+--					int row:			row containing the cells
+--					int firstColumn:	first changed column
+--					int count:			number of changed cells
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when cells change, or when the window needs them redrawn after being uncovered.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::markDirty(int row, int firstColumn, int count) {
+	uint64_t * bits;
+	int column, lastColumn;
+
+	if (row < 0 || row >= rows || count <= 0) {
+		return;
+	}
+	if (firstColumn < 0) {
+		count += firstColumn;
+		firstColumn = 0;
+	}
+	if (firstColumn + count > columns) {
+		count = columns - firstColumn;
+	}
+	if (count <= 0) {
+		return;
+	}
+
+	bits = &dirtyBits[(size_t)row * wordsPerRow];
+	column = firstColumn;
+	lastColumn = firstColumn + count;
+	while (column < lastColumn) {
+		int shift = column & 63;
+		int span = 64 - shift < lastColumn - column ? 64 - shift : lastColumn - column;
+		uint64_t mask = span == 64 ? ~0ULL : ((1ULL << span) - 1) << shift;
+		bits[column >> 6] |= mask;
+		column += span;
+	}
+
+	if (row < dirtyTop) {
+		dirtyTop = row;
+	}
+	if (row > dirtyBottom) {
+		dirtyBottom = row;
+	}
+	if (firstColumn < dirtyLeft) {
+		dirtyLeft = firstColumn;
+	}
+	if (lastColumn - 1 > dirtyRight) {
+		dirtyRight = lastColumn - 1;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	markAllDirty
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void markAllDirty(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function when the whole screen must be redrawn.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::markAllDirty() {
+	for (int row = 0; row < rows; row++) {
+		markDirty(row, 0, columns);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getDirtyBounds
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getDirtyBounds(int * top, int * left, int * bottom, int * right) const
+--					int * top, left, bottom, right:	set to the inclusive cell bounds of the dirty area
+--
+-- RETURNS:		bool - false if nothing is dirty
+--
+-- NOTES:
+-- Call this function to find the window area that needs to be invalidated.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ScreenModel::getDirtyBounds(int * top, int * left, int * bottom, int * right) const {
+	if (dirtyTop > dirtyBottom) {
+		return false;
+	}
+	*top = dirtyTop;
+	*left = dirtyLeft;
+	*bottom = dirtyBottom;
+	*right = dirtyRight;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	clearDirty
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void clearDirty(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Clears the bitmap rows inside the dirty bounds and resets the bounds to empty.
+----------------------------------------------------------------------------------------------------------------------*/
+void ScreenModel::clearDirty() {
+	if (dirtyTop <= dirtyBottom) {
+		memset(&dirtyBits[(size_t)dirtyTop * wordsPerRow], 0,
+			(size_t)(dirtyBottom - dirtyTop + 1) * wordsPerRow * sizeof(uint64_t));
+	}
+	dirtyTop = rows;
+	dirtyLeft = columns;
+	dirtyBottom = -1;
+	dirtyRight = -1;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Scrollback.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		ScreenModel.h -	The character grid behind the terminal window.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void resize(int columns, int rows)
+--					void putText(const char * text, size_t length)
+--					void putGlyphs(const char16_t * text, size_t length)
+--					void lineFeed(void)
+--					void carriageReturn(void)
+--					void setCursor(int x, int y)
+--					void eraseCells(int row, int firstColumn, int count)
+--					void markDirty(int row, int firstColumn, int count)
+--					void markAllDirty(void)
+--					bool getDirtyBounds(int * top, int * left, int * bottom, int * right) const
+--					void forEachDirtyRun(Visitor visit)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Rows scrolled off the top are kept in a Scrollback
+--					Oct 17, 2026 - Cursor positioning and erasing for the escape sequence interpreter
+--					Oct 17, 2026 - putGlyphs for text decoded from UTF-8
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Glyphs and attributes are kept in two contiguous row-major arrays so a row scan touches one cache line per 32
+-- glyphs. Each row has a bitmap with one bit per column that is set when the cell changes; the renderer walks the set
+-- bits and draws each run of dirty cells that share an attribute with a single call, then clears the bits. The model
+-- does no drawing itself and has no platform dependencies.
+----------------------------------------------------------------------------------------------------------------------*/
+
+// Attribute byte: low nibble is the foreground palette index, high nibble the background palette index
+constexpr uint8_t COLOR_BLACK = 0;
+constexpr uint8_t COLOR_WHITE = 7;
+constexpr uint8_t ATTR_DEFAULT = (COLOR_WHITE << 4) | COLOR_BLACK;
+constexpr char16_t BLANK_GLYPH = u' ';
+
+inline uint8_t makeAttribute(uint8_t foreground, uint8_t background) {
+	return (uint8_t)((background << 4) | (foreground & 0x0F));
+}
+inline uint8_t attributeForeground(uint8_t attribute) { return attribute & 0x0F; }
+inline uint8_t attributeBackground(uint8_t attribute) { return attribute >> 4; }
+
+inline int countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (int)index;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+class ScreenModel {
+private:
+	int columns;
+	int rows;
+	int wordsPerRow;
+	int cursorX = 0;
+	int cursorY = 0;
+	uint8_t currentAttribute = ATTR_DEFAULT;
+	Scrollback * history = NULL;
+	uint64_t scrollCount = 0;
+
+	std::vector<char16_t> glyphs;
+	std::vector<uint8_t> attributes;
+	std::vector<uint64_t> dirtyBits;
+
+	// Bounding box of everything dirty, in cells; dirtyTop > dirtyBottom when clean
+	int dirtyTop = 0, dirtyLeft = 0, dirtyBottom = -1, dirtyRight = -1;
+
+	void scrollUp();
+	void clearDirty();
+public:
+	ScreenModel(int columns, int rows);
+
+	void resize(int columns, int rows);
+	void putText(const char * text, size_t length);
+	void putGlyphs(const char16_t * text, size_t length);
+	void lineFeed();
+	void carriageReturn();
+	void setCursor(int x, int y);
+	void eraseCells(int row, int firstColumn, int count);
+	void markDirty(int row, int firstColumn, int count);
+	void markAllDirty();
+	bool getDirtyBounds(int * top, int * left, int * bottom, int * right) const;
+
+	int getColumns() const { return columns; };
+	int getRows() const { return rows; };
+	int getCursorX() const { return cursorX; };
+	int getCursorY() const { return cursorY; };
+	uint8_t getAttribute() const { return currentAttribute; };
+	void setAttribute(uint8_t attribute) { currentAttribute = attribute; };
+	void setScrollback(Scrollback * lines) { history = lines; };
+	uint64_t getScrollCount() const { return scrollCount; };
+	const char16_t * rowGlyphs(int row) const { return &glyphs[(size_t)row * columns]; };
+	const uint8_t * rowAttributes(int row) const { return &attributes[(size_t)row * columns]; };
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	forEachDirtyRun
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	void forEachDirtyRun(Visitor visit)
+	--					Visitor visit:	called as visit(row, column, const char16_t * glyphs, int count, attribute)
+	--
+	-- RETURNS:		void
+	--
+	-- NOTES:
+	-- Call this function from the paint handler. Each maximal run of dirty cells in a row that share an attribute is
+	-- reported once, then every dirty bit is cleared.
+	--------------------------------------------------------------------------------------------------------------*/
+	template <typename Visitor>
+	void forEachDirtyRun(Visitor visit) {
+		for (int row = dirtyTop; row <= dirtyBottom; row++) {
+			uint64_t * bits = &dirtyBits[(size_t)row * wordsPerRow];
+			const char16_t * rowText = rowGlyphs(row);
+			const uint8_t * rowAttr = rowAttributes(row);
+			int column = 0;
+
+			while (column < columns) {
+				int word = column >> 6;
+				uint64_t pending = bits[word] >> (column & 63);
+
+				// Skip to the next set bit, a whole clean word at a time
+				if (pending == 0) {
+					column = (word + 1) << 6;
+					continue;
+				}
+				column += countTrailingZeros(pending);
+				if (column >= columns) {
+					break;
+				}
+
+				int start = column;
+				uint8_t attribute = rowAttr[start];
+				while (column < columns && (bits[column >> 6] >> (column & 63) & 1) && rowAttr[column] == attribute) {
+					column++;
+				}
+				visit(row, start, rowText + start, column - start, attribute);
+			}
+		}
+		clearDirty();
+	}
+};
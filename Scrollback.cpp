@@ -0,0 +1,223 @@
+#include <string.h>
+#include "Scrollback.h"
+#include "ScreenModel.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Scrollback.cpp -	Bounded history of lines that have scrolled off the top of the screen.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void append(const char16_t * glyphs, const uint8_t * attributes, size_t length)
+--					bool getLine(size_t index, ScrollbackLineView * line) const
+--					size_t footprint(void) const
+--					void clear(void)
+--					void dropOldest(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A chunk holds its glyphs first and its attributes after them, chunkCells of each. A line never spans two chunks;
+-- the unused tail of a chunk is the price of that, at most one line per chunk.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	Scrollback
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	Scrollback(size_t maxLines, size_t maxBytes, size_t chunkBytes)
+--					size_t maxLines:	most lines kept
+--					size_t maxBytes:	most bytes of line text kept; rounded down to whole chunks, at least two
+--					size_t chunkBytes:	size of one arena chunk
+--
+-- NOTES:
+-- The line ring is allocated here; text chunks are allocated as the history first grows into them.
+----------------------------------------------------------------------------------------------------------------------*/
+Scrollback::Scrollback(size_t maxLines, size_t maxBytes, size_t chunkBytes) {
+	size_t chunkCount = maxBytes / chunkBytes;
+
+	if (chunkCount < 2) {
+		chunkCount = 2;
+	}
+	if (maxLines < 1) {
+		maxLines = 1;
+	}
+	chunkCells = chunkBytes / (sizeof(char16_t) + sizeof(uint8_t));
+	chunks.resize(chunkCount);
+	lines.resize(maxLines);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	append
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void append(const char16_t * glyphs, const uint8_t * attributes, size_t length)
+--					const char16_t * glyphs:		the line's glyphs
+--					const uint8_t * attributes:		one attribute per glyph
+--					size_t length:					number of cells in the line
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function with each row leaving the top of the screen. Trailing blank cells are not stored. When a
+-- budget is exceeded the oldest lines are dropped.
+----------------------------------------------------------------------------------------------------------------------*/
+void Scrollback::append(const char16_t * glyphs, const uint8_t * attributes, size_t length) {
+	LineRecord * record;
+
+	while (length > 0 && glyphs[length - 1] == u' ' && attributes[length - 1] == ATTR_DEFAULT) {
+		length--;
+	}
+	if (length > chunkCells) {
+		length = chunkCells;
+	}
+
+	// Move to the next chunk in the ring, evicting the lines that still live there
+	if (writeOffset + length > chunkCells) {
+		writeChunk = (writeChunk + 1) % chunks.size();
+		writeOffset = 0;
+		while (lineCount > 0 && lines[firstLine].chunk == writeChunk) {
+			dropOldest();
+		}
+	}
+	if (!chunks[writeChunk]) {
+		chunks[writeChunk].reset(new char[chunkCells * (sizeof(char16_t) + sizeof(uint8_t))]);
+	}
+	if (lineCount == lines.size()) {
+		dropOldest();
+	}
+
+	record = &lines[(firstLine + lineCount) % lines.size()];
+	record->chunk = (uint32_t)writeChunk;
+	record->offset = (uint32_t)writeOffset;
+	record->length = (uint32_t)length;
+	memcpy(chunkGlyphs(writeChunk) + writeOffset, glyphs, length * sizeof(char16_t));
+	memcpy(chunkAttributes(writeChunk) + writeOffset, attributes, length);
+	writeOffset += length;
+	lineCount++;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getLine
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getLine(size_t index, ScrollbackLineView * line) const
+--					size_t index:				0 is the oldest line kept, size() - 1 the newest
+--					ScrollbackLineView * line:	set to point at the stored line
+--
+-- RETURNS:		bool - false if index is out of range
+--
+-- NOTES:
+-- The view points into the arena and stays valid until the next append.
+----------------------------------------------------------------------------------------------------------------------*/
+bool Scrollback::getLine(size_t index, ScrollbackLineView * line) const {
+	const LineRecord * record;
+
+	if (index >= lineCount) {
+		return false;
+	}
+	record = &lines[(firstLine + index) % lines.size()];
+	line->glyphs = chunkGlyphs(record->chunk) + record->offset;
+	line->attributes = chunkAttributes(record->chunk) + record->offset;
+	line->length = record->length;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	footprint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t footprint(void) const
+--
+-- RETURNS:		size_t - bytes currently allocated for line records and text chunks
+----------------------------------------------------------------------------------------------------------------------*/
+size_t Scrollback::footprint() const {
+	size_t bytes = lines.capacity() * sizeof(LineRecord) + chunks.capacity() * sizeof(chunks[0]);
+
+	for (size_t i = 0; i < chunks.size(); i++) {
+		if (chunks[i]) {
+			bytes += chunkCells * (sizeof(char16_t) + sizeof(uint8_t));
+		}
+	}
+	return bytes;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	clear
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void clear(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Forgets every line. Allocated chunks are kept for reuse.
+----------------------------------------------------------------------------------------------------------------------*/
+void Scrollback::clear() {
+	firstLine = 0;
+	lineCount = 0;
+	writeChunk = 0;
+	writeOffset = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	dropOldest
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void dropOldest(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void Scrollback::dropOldest() {
+	firstLine = (firstLine + 1) % lines.size();
+	lineCount--;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Scrollback.h -	Bounded history of lines that have scrolled off the top of the screen.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void append(const char16_t * glyphs, const uint8_t * attributes, size_t length)
+--					bool getLine(size_t index, ScrollbackLineView * line) const
+--					size_t size(void) const
+--					size_t footprint(void) const
+--					void clear(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Line text lives in fixed-size arena chunks that are reused in a ring: when the writer moves into a chunk that
+-- still holds old lines, those lines (always the oldest ones) are dropped and the chunk is overwritten. Line records
+-- are kept in a second ring sized to the line budget, so both append and lookup by index are constant time and no
+-- memory is allocated per line. Chunks are only allocated the first time the ring reaches them.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t SCROLLBACK_CHUNK_BYTES = 64 * 1024;
+
+struct ScrollbackLineView {
+	const char16_t * glyphs;
+	const uint8_t * attributes;
+	size_t length;
+};
+
+class Scrollback {
+private:
+	struct LineRecord {
+		uint32_t chunk;
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	size_t chunkCells;
+	std::vector<std::unique_ptr<char[]>> chunks;
+	size_t writeChunk = 0;
+	size_t writeOffset = 0;
+
+	std::vector<LineRecord> lines;
+	size_t firstLine = 0;
+	size_t lineCount = 0;
+
+	char16_t * chunkGlyphs(size_t chunk) const { return (char16_t *)chunks[chunk].get(); };
+	uint8_t * chunkAttributes(size_t chunk) const {
+		return (uint8_t *)(chunks[chunk].get() + chunkCells * sizeof(char16_t));
+	};
+	void dropOldest();
+public:
+	Scrollback(size_t maxLines, size_t maxBytes, size_t chunkBytes = SCROLLBACK_CHUNK_BYTES);
+	Scrollback(const Scrollback &) = delete;
+	Scrollback & operator=(const Scrollback &) = delete;
+
+	void append(const char16_t * glyphs, const uint8_t * attributes, size_t length);
+	bool getLine(size_t index, ScrollbackLineView * line) const;
+	size_t size() const { return lineCount; };
+	size_t footprint() const;
+	void clear();
+};
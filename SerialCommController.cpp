@@ -5,8 +5,15 @@
 
 #include <windows.h>
 #include <iostream>
+#include <system_error>
+#include <string.h>
+#include <time.h>
 #include "ErrorHandler.h"
 #include "SerialCommController.h"
+#include "messages.h"
+#include "ReplayTransport.h"
+#include "SimulatedTransport.h"
+#include "Win32Transport.h"
 
 /*------------------------------------------------------------------------------------------------------------------
 -- SOURCE FILE:		SerialCommController.cpp -	A controller class that controls all operations in the physical
@@ -15,20 +22,45 @@
 -- PROGRAM:			DumbSerialPortEmulator
 --
 -- FUNCTIONS:
---					VOID drawToWindow(char input)
---					DWORD handleRead(LPVOID input)
+--					BOOL drawToWindow(const char * input, DWORD length)
+--					VOID drainReceived(void)
 --					VOID handleWrite(WPARAM * input)
+--					VOID handlePaste(const char * text, size_t length)
 --					VOID closePort(void)
 --					LPCWSTR getComPortName(void) const
+--					BOOL isConnected(void) const
+--					BOOL startCapture(void)
+--					VOID stopCapture(void)
+--					BOOL startBridge(void)
+--					VOID stopBridge(void)
+--					BOOL startTransfer(TransferProtocol protocol, LPCWSTR path, BOOL isSending)
+--					VOID cancelTransfer(void)
+--					VOID finishTransfer(void)
+--					VOID describeTelemetry(char * text, size_t capacity)
+--					VOID writeTelemetry(FILE * out)
 --					VOID handleParam(UINT Msg, WPARAM* wParam)
 --					VOID initializeConnection(void)
 --					VOID resetCommConfig(void)
 --					VOID setComPort(LPCWSTR commPortName)
+--					std::string toPortName(LPCWSTR portName)
+--					std::string toFileName(const std::string & portName)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Receive path reads whole chunks through CommReader
+--					Oct 17, 2026 - Received data is handed to the window thread through a ring buffer
+--					Oct 17, 2026 - Writes go through a TransmitQueue with its own writer thread
+--					Oct 17, 2026 - Port I/O goes through a SerialTransport and the shared SerialPipeline
+--					Oct 17, 2026 - Can open a SimulatedTransport instead of a COM port
+--					Oct 17, 2026 - Drains in frame-budgeted batches paced by the DisplayService
+--					Oct 17, 2026 - Draws into its own pane and receives through the shared PortMultiplexer
+--					Oct 17, 2026 - Records the session to a capture file on request
+--					Oct 17, 2026 - Sends and receives files on a transfer thread while the port stays open
+--					Oct 17, 2026 - Times each drain from arrival to paint and reports the port's telemetry
+--					Oct 17, 2026 - Reconnecting reuses the transport and the pipeline's parked threads
+--					Oct 17, 2026 - Serves the session to local TCP clients on request
+--					Oct 17, 2026 - Capture file names are made from the port's base name
 --
 -- DESIGNER:		Henry Ho
 --
@@ -45,7 +77,12 @@
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Stops the writer thread before closing the handle
+--				Oct 17, 2026 - Stops the pipeline threads before closing the transport
+--				Oct 17, 2026 - Ends any capture in progress
+--				Oct 17, 2026 - Cancels any transfer in progress and waits for its thread
+--				Oct 17, 2026 - The pipeline's threads are parked for the next connect rather than ended
+--				Oct 17, 2026 - Stops serving the port over TCP
 --
 -- DESIGNER:	Henry Ho
 --
@@ -56,11 +93,22 @@
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to close the communication handle.
+-- Call this function to close the communication handle. A transfer cut off here is not reported. The pipeline has
+-- stopped reading and writing before the transport is closed, so a quick reconnect cannot race the old loops. The
+-- bridge is closed first so no client can send to the port once the pipeline stops.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SerialCommController::closePort() {
+	if (transfer) {
+		transfer->cancel();
+		transferChannel.close();
+		transferThread.join();
+		transfer.reset();
+	}
 	if (isComActive) {
-		CloseHandle(commHandle);
+		bridge.close();
+		pipeline.stop();
+		transport->close();
+		capture.close();
 	}
 	isComActive = false;
 }
@@ -70,22 +118,79 @@ VOID SerialCommController::closePort() {
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Takes a whole received chunk instead of a single character
+--				Oct 17, 2026 - Returns whether the frame budget allows another chunk
+--				Oct 17, 2026 - Draws into this session's pane
 --
 -- DESIGNER:	Henry Ho
 --
 -- PROGRAMMER:	Henry Ho
 --
--- INTERFACE:	VOID drawToWindow(char input)
---					char input:	the input to draw on the screen
+-- INTERFACE:	BOOL drawToWindow(const char * input, DWORD length)
+--					const char * input:	the received characters to draw on the screen
+--					DWORD length:		number of characters in input
+--
+-- RETURNS:		BOOL - false once the frame budget is spent
+--
+-- NOTES:
+-- Call this function from the window thread to draw a received chunk on the screen
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL SerialCommController::drawToWindow(const char * input, DWORD length) {
+	return displayService->drawInput(pane, input, length);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	drainReceived
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Drains through SerialPipeline
+--				Oct 17, 2026 - Stops at the display's frame budget; the rest is drawn on the next WM_RX_DATA
+--				Oct 17, 2026 - Drains into this session's pane
+--				Oct 17, 2026 - Hands everything to the transfer channel while a transfer runs
+--				Oct 17, 2026 - Counts the time from arrival to paint
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID drainReceived(void)
 --
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to draw a character in the screen
+-- Call this function from the window thread when WM_RX_DATA arrives. Queued data is drawn in place from the ring, a
+-- chunk at a time, as one display frame. The frame ends when the ring is empty or its time budget is spent; in the
+-- second case the pipeline posts another WM_RX_DATA, so input and other messages get a turn before the rest is drawn.
+-- While a transfer runs nothing is drawn; the whole ring goes to the transfer's thread.
+--
+-- A paint is counted once a drain reaches the end of the ring on the shown pane, timed from the arrival of the
+-- oldest byte it drew. Nothing is counted for a hidden pane or a transfer, since nothing is painted.
 ----------------------------------------------------------------------------------------------------------------------*/
-VOID SerialCommController::drawToWindow(char input) {
-	displayService->drawInput(input);
+VOID SerialCommController::drainReceived() {
+	LinkTelemetry & telemetry = pipeline.getTelemetry();
+	int64_t arrival = telemetry.takeArrival();
+	bool isDrained;
+
+	if (transfer) {
+		pipeline.drain([this](const char * data, size_t length) { transferChannel.deliver(data, length); });
+		paintPendingSince = 0;
+		return;
+	}
+	if (paintPendingSince == 0) {
+		paintPendingSince = arrival;
+	}
+	displayService->beginReceive(pane, pipeline.getReceiveRing().size());
+	isDrained = pipeline.drainUntil([this](const char * data, size_t length) {
+		return drawToWindow(data, (DWORD)length) != FALSE;
+	});
+	displayService->endReceive(pane, !isDrained);
+	if (isDrained) {
+		if (displayService->getActivePane() == pane) {
+			telemetry.countPaint(paintPendingSince);
+		}
+		paintPendingSince = 0;
+	}
 }
 
 /*------------------------------------------------------------------------------------------------------------------
@@ -93,7 +198,7 @@ VOID SerialCommController::drawToWindow(char input) {
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Keys are not sent while a transfer runs
 --
 -- DESIGNER:	Henry Ho
 --
@@ -110,7 +215,9 @@ VOID SerialCommController::drawToWindow(char input) {
 -- returns true.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SerialCommController::handleParam(WPARAM* wParam) {
-	handleWrite(wParam);
+	if (!transfer) {
+		handleWrite(wParam);
+	}
 }
 
 /*------------------------------------------------------------------------------------------------------------------
@@ -118,7 +225,7 @@ VOID SerialCommController::handleParam(WPARAM* wParam) {
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Queues the character for the writer thread instead of writing it here
 --
 -- DESIGNER:	Henry Ho
 --
@@ -130,17 +237,17 @@ VOID SerialCommController::handleParam(WPARAM* wParam) {
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to send a character over the communication port.
+-- Call this function to send a character over the communication port. It returns without waiting for the port.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SerialCommController::handleWrite(WPARAM* input) {
-	DWORD bytesWritten;
-	WriteFile(commHandle, input, 1, &bytesWritten, &OVERLAPPED());
+	char character = (char)*input;
+	pipeline.send(&character, 1);
 }
 
 /*------------------------------------------------------------------------------------------------------------------
--- FUNCTION:	handleRead
+-- FUNCTION:	handlePaste
 --
--- DATE:		Sept 28, 2019
+-- DATE:		Oct 17, 2026
 --
 -- REVISIONS:	(N/A)
 --
@@ -148,58 +255,136 @@ VOID SerialCommController::handleWrite(WPARAM* input) {
 --
 -- PROGRAMMER:	Henry Ho
 --
--- INTERFACE:	DWORD handleRead(LPVOID input)
---					LPVOID input:	the input for this function. It is not used in this method.
+-- INTERFACE:	VOID handlePaste(const char * text, size_t length)
+--					const char * text:	the text to send
+--					size_t length:		number of bytes in text
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to send a block of text such as a clipboard paste. It returns without waiting for the port.
+-- Nothing is sent while a transfer runs.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::handlePaste(const char * text, size_t length) {
+	if (!transfer) {
+		pipeline.send(text, length);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	initializeConnection
+--
+-- DATE:		Sept 28, 2019
+--
+-- REVISIONS:	Oct 17, 2026 - Sizes the driver queues and starts the writer thread
+--				Oct 17, 2026 - Opens the port through SerialTransport and starts SerialPipeline
+--				Oct 17, 2026 - Port names starting with SIM open a SimulatedTransport
+--				Oct 17, 2026 - Receives through the shared PortMultiplexer; WM_RX_DATA carries the pane
+--				Oct 17, 2026 - Gives the pipeline this session's CaptureWriter
+--				Oct 17, 2026 - Capture file names open a ReplayTransport, read by a thread of its own
+--				Oct 17, 2026 - Keeps the transport from the last connection to the same port
+--				Oct 17, 2026 - Gives the pipeline this session's TcpBridge
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL initializeConnection(LPCWSTR portName)
+--					LPCWSTR portName: Name of port to open
 --
--- RETURNS:		DWORD
+-- RETURNS:		BOOL - false if the port could not be opened
 --
 -- NOTES:
--- This should be called inside a separate thread because of the while-loop inside this function. The ReadFile
--- method uses an overlap structure, which requires event and timeout handling. 
+-- Call this function to open the communication port. The writer thread is started here and the port added to the
+-- multiplexer, or given a reader thread if there is none; received data is announced to the window with WM_RX_DATA,
+-- whose wParam is this session's pane.
 --
--- Note that there are missing error handling statements in this method.
+-- A reconnect reopens the transport it used last time, keeping its events and buffers, and the pipeline hands its
+-- loops to the threads parked by the last closePort; only a first connect creates them.
 ----------------------------------------------------------------------------------------------------------------------*/
-DWORD SerialCommController::handleRead(LPVOID input) {
-	COMSTAT cs;
-	DWORD bytesReceived, endTime, lastError;
-	char inputBuffer[1];
-	OVERLAPPED overlapRead;
-
-	// Set overlap structure
-	overlapRead.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
-	overlapRead.Offset = 0;
-	overlapRead.OffsetHigh = 0;
-
-	while (isComActive) {
-		if (!ReadFile(commHandle, inputBuffer, 1, &bytesReceived, &overlapRead)) {
-			bytesReceived = 0;
-			if ((lastError = GetLastError()) == ERROR_IO_PENDING && 
-				GetOverlappedResult(commHandle, &overlapRead, &bytesReceived, FALSE) &&
-				bytesReceived) {
-					drawToWindow(*inputBuffer);
-			}
-			else {
-				ClearCommError(commHandle, &lastError, &cs);
-				lastError = 0;
-			}
+BOOL SerialCommController::initializeConnection(LPCWSTR portName) {
+	HWND window = *displayService->getWindowHandle();
+	WPARAM target = (WPARAM)pane;
+	std::string name;
+	int error;
+
+	commPortName = portName;
+	name = toPortName(portName);
+	if (name != transportName) {
+		if (SimulatedTransport::isSimulatedPort(name)) {
+			transport.reset(new SimulatedTransport());
 		}
-		else {
-			if (bytesReceived) {
-				drawToWindow(*inputBuffer);
-			}
+		else if (ReplayTransport::isReplayPort(name)) {
+			transport.reset(new ReplayTransport());
 		}
-		if (overlapRead.hEvent) {
-			ResetEvent(overlapRead.hEvent);
+		else {
+			transport = createSerialTransport();
 		}
+		transportName = name;
 	}
-	PurgeComm(commHandle, PURGE_RXCLEAR);
-	return 0;
+	if ((error = transport->open(name)) != 0 ||
+		(error = transport->configure(portSettings)) != 0) {
+		transport->close();
+		ErrorHandler::handleError(error);
+		return false;
+	}
+	pipeline.setCapture(&capture);
+	pipeline.setBridge(&bridge);
+	// The multiplexer can only wait on COM ports and simulated ports
+	if (!pipeline.start(transport.get(), [window, target]() { PostMessage(window, WM_RX_DATA, target, 0); },
+		ReplayTransport::isReplayPort(name) ? nullptr : multiplexer)) {
+		transport->close();
+		ErrorHandler::handleError(ERROR_RD_THREAD);
+		return false;
+	}
+
+	LPCWSTR message = TEXT("Connecting to ");
+	DisplayService::displayMessageBox((std::wstring(message) + commPortName).c_str());
+	isComActive = true;
+	return true;
 }
 
 /*------------------------------------------------------------------------------------------------------------------
--- FUNCTION:	initializeConnection
+-- FUNCTION:	startCapture
 --
--- DATE:		Sept 28, 2019
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Names the file after the port's base name, so a replay session can capture
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL startCapture(void)
+--
+-- RETURNS:		BOOL - false if the port is not open or the file could not be created
+--
+-- NOTES:
+-- Call this function to start recording the open port. The capture is written to the working directory as
+-- capture-<port>-<date>-<time>.dspcap, and CaptureDump turns it into text. <port> comes from toFileName, since a
+-- replay session's port name is a whole path.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL SerialCommController::startCapture() {
+	std::string name = toPortName(commPortName.c_str());
+	char stamp[32];
+	time_t now = time(NULL);
+
+	if (!isComActive) {
+		return false;
+	}
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", localtime(&now));
+	if (!capture.open("capture-" + toFileName(name) + "-" + stamp + CAPTURE_FILE_EXTENSION, name)) {
+		ErrorHandler::handleError(ERROR_CAPTURE_OPEN);
+		return false;
+	}
+	DisplayService::displayMessageBox(("Capturing to " + capture.getPath()).c_str());
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stopCapture
+--
+-- DATE:		Oct 17, 2026
 --
 -- REVISIONS:	(N/A)
 --
@@ -207,36 +392,230 @@ DWORD SerialCommController::handleRead(LPVOID input) {
 --
 -- PROGRAMMER:	Henry Ho
 --
--- INTERFACE:	VOID initializeConnection(LPCWSTR portName)
---					LPCWSTR portName: Name of port to open
+-- INTERFACE:	VOID stopCapture(void)
 --
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to open the communication port.
+-- Call this function to finish the capture in progress, if any. Waits for the file to be written and reports what
+-- was recorded, including anything dropped because the disk fell behind.
 ----------------------------------------------------------------------------------------------------------------------*/
-VOID SerialCommController::initializeConnection(LPCWSTR portName) {
-	commPortName = portName;
-	// Sets up com port/
-	if ((commHandle = CreateFile(commPortName, GENERIC_READ | GENERIC_WRITE, 0,
-		NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL))
-		== INVALID_HANDLE_VALUE)
-	{
-		ErrorHandler::handleError(ERROR_OPEN_PORT);
+VOID SerialCommController::stopCapture() {
+	CaptureStats stats;
+	char summary[256];
+
+	if (!capture.isCapturing()) {
 		return;
 	}
+	capture.close();
+	stats = capture.getStats();
+	snprintf(summary, sizeof(summary), "Captured %llu chunks (%llu bytes) to %s\n"
+		"%llu chunks dropped, %llu write errors",
+		(unsigned long long)stats.records, (unsigned long long)stats.bytesCaptured, capture.getPath().c_str(),
+		(unsigned long long)stats.droppedRecords, (unsigned long long)stats.writeErrors);
+	DisplayService::displayMessageBox(summary);
+}
 
-	if (!GetCommProperties(commHandle, &commProp)) {
-		ErrorHandler::handleError(ERROR_PORT_PROP);
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	startBridge
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL startBridge(void)
+--
+-- RETURNS:		BOOL - false if the port is not open or the TCP port could not be bound
+--
+-- NOTES:
+-- Call this function to serve the open port to local TCP clients. A client that falls BRIDGE_LAG_LIMIT bytes
+-- behind skips ahead to the newest data rather than holding anything up.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL SerialCommController::startBridge() {
+	BridgeSettings settings;
+	char message[128];
+
+	if (!isComActive) {
+		return false;
+	}
+	settings.port = (uint16_t)(BRIDGE_BASE_PORT + pane);
+	settings.policy = BacklogPolicy::Drop;
+	if (!bridge.open(settings, [this](const char * data, size_t length) { pipeline.send(data, length); })) {
+		ErrorHandler::handleError(ERROR_BRIDGE_START);
+		return false;
+	}
+	snprintf(message, sizeof(message), "Serving %s on 127.0.0.1:%u", toPortName(commPortName.c_str()).c_str(),
+		(unsigned)bridge.getPort());
+	DisplayService::displayMessageBox(message);
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stopBridge
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID stopBridge(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to stop serving, if the port is being served. Every client is disconnected, and what they were
+-- sent is reported, along with how often a client fell too far behind.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::stopBridge() {
+	BridgeStats stats;
+	char summary[256];
+
+	if (!bridge.isServing()) {
 		return;
-	};
+	}
+	bridge.close();
+	stats = bridge.getStats();
+	snprintf(summary, sizeof(summary), "Served %llu clients, %llu bytes sent in all\n"
+		"Clients fell behind %llu times and skipped %llu bytes", (unsigned long long)stats.accepted,
+		(unsigned long long)stats.bytesSent, (unsigned long long)stats.drops, (unsigned long long)stats.droppedBytes);
+	DisplayService::displayMessageBox(summary);
+}
 
-	SetCommState(commHandle, &commConfig.dcb);
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	startTransfer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BOOL startTransfer(TransferProtocol protocol, LPCWSTR path, BOOL isSending)
+--					TransferProtocol protocol:	the protocol to speak
+--					LPCWSTR path:				the file to send, or the directory to receive into; empty for the
+--												working directory
+--					BOOL isSending:				true to send the file, false to receive
+--
+-- RETURNS:		BOOL - false if the port is not open, a transfer is already running or its thread could not start
+--
+-- NOTES:
+-- Call this function to start a transfer on the open port. It returns once the transfer's thread is running;
+-- WM_TRANSFER_DONE arrives when it ends, and finishTransfer reports how it went.
+----------------------------------------------------------------------------------------------------------------------*/
+BOOL SerialCommController::startTransfer(TransferProtocol protocol, LPCWSTR path, BOOL isSending) {
+	HWND window = *displayService->getWindowHandle();
+	WPARAM target = (WPARAM)pane;
+	std::string name = toPortName(path);
 
-	SetupComm(commHandle, sizeof(OUTPUT_BUFFER), sizeof(OUTPUT_BUFFER));
-	LPCWSTR message = TEXT("Connecting to ");
-	DisplayService::displayMessageBox((std::wstring(message) + commPortName).c_str());
-	isComActive = true;
+	if (!isComActive || transfer) {
+		ErrorHandler::handleError(ERROR_TRANSFER_START);
+		return false;
+	}
+	transfer = createFileTransfer(protocol, &transferChannel, TransferOptions());
+	transferProtocol = protocol;
+	isSendingFile = isSending;
+	isTransferDone.store(false);
+	transferChannel.open();
+	try {
+		transferThread = std::thread([this, name, isSending, window, target]() {
+			if (isSending) {
+				transfer->send(name);
+			}
+			else {
+				transfer->receive(name);
+			}
+			isTransferDone.store(true);
+			PostMessage(window, WM_TRANSFER_DONE, target, 0);
+		});
+	}
+	catch (const std::system_error &) {
+		transferChannel.close();
+		transfer.reset();
+		ErrorHandler::handleError(ERROR_TRANSFER_START);
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cancelTransfer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID cancelTransfer(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to stop the transfer in progress, if any. The far end is sent the CAN sequence; the transfer
+-- is reported as cancelled when its WM_TRANSFER_DONE arrives.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::cancelTransfer() {
+	if (transfer) {
+		transfer->cancel();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	finishTransfer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID finishTransfer(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from the window thread when WM_TRANSFER_DONE arrives. Joins the transfer's thread, hands the
+-- port back to the terminal and reports the result, the rate and how close it came to the line's rate. Does nothing
+-- if the transfer was already ended by closePort, including when a later transfer has started since.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::finishTransfer() {
+	static const char * const STATUS_NAMES[] = { "running", "complete", "skipped, the receiver has it already",
+		"cancelled", "failed" };
+	TransferStats stats;
+	char summary[512];
+	double rate;
+
+	if (!transfer || !isTransferDone.load()) {
+		return;
+	}
+	transferThread.join();
+	transferChannel.close();
+	stats = transfer->getStats();
+	transfer.reset();
+
+	rate = stats.seconds > 0 ? (stats.offset - stats.startOffset) / stats.seconds : 0;
+	snprintf(summary, sizeof(summary),
+		"%s %s %s: %s\n%llu of %llu bytes, resumed from %llu\n%.1f s at %.0f bytes/s, %.0f%% of the line rate\n"
+		"%llu retries",
+		protocolName(transferProtocol), isSendingFile ? "send of" : "receive of",
+		stats.fileName.empty() ? "file" : stats.fileName.c_str(), STATUS_NAMES[(int)stats.status],
+		(unsigned long long)stats.offset, (unsigned long long)stats.fileSize,
+		(unsigned long long)stats.startOffset, stats.seconds, rate, 100 * linkEfficiency(stats, portSettings),
+		(unsigned long long)stats.retries);
+	DisplayService::displayMessageBox(summary);
 }
 
 /*------------------------------------------------------------------------------------------------------------------
@@ -244,7 +623,7 @@ VOID SerialCommController::initializeConnection(LPCWSTR portName) {
 --
 -- DATE:		Sept 30, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Keeps the chosen settings as PortSettings and applies them through the transport
 --
 -- DESIGNER:	Henry Ho
 --
@@ -256,19 +635,130 @@ VOID SerialCommController::initializeConnection(LPCWSTR portName) {
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function to set the port configurations
+-- Call this function to set the port configurations. The dialog starts from the driver's defaults for the port;
+-- the result is applied now if the port is open and on every later connect.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SerialCommController::setCommConfig(LPCWSTR portName) {
-	GetCommConfig(
-		commHandle,
-		&commConfig,
-		(LPDWORD)&commConfig.dwSize
-	);
+	DWORD size = sizeof(COMMCONFIG);
+
+	GetDefaultCommConfig(portName, &commConfig, &size);
+	Win32Transport::toDcb(portSettings, &commConfig.dcb);
 	if (!CommConfigDialog(portName, *displayService->getWindowHandle(), &commConfig)) {
 		ErrorHandler::handleError(ERROR_PORT_CONFIG);
 		return;
 	}
-	SetCommState(commHandle, &commConfig.dcb);
+	portSettings = Win32Transport::fromDcb(commConfig.dcb);
+	if (transport->isOpen()) {
+		transport->configure(portSettings);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toPortName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::string toPortName(LPCWSTR portName)
+--					LPCWSTR portName:	name of the port as shown in the menu
+--
+-- RETURNS:		std::string - the name in the form SerialTransport takes
+----------------------------------------------------------------------------------------------------------------------*/
+std::string SerialCommController::toPortName(LPCWSTR portName) {
+	int size = WideCharToMultiByte(CP_UTF8, 0, portName, -1, NULL, 0, NULL, NULL);
+	std::string name(size > 0 ? size - 1 : 0, '\0');
+
+	if (size > 1) {
+		WideCharToMultiByte(CP_UTF8, 0, portName, -1, &name[0], size, NULL, NULL);
+	}
+	return name;
 }
 
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toFileName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::string toFileName(const std::string & portName)
+--					const std::string & portName:	name of the port in the form SerialTransport takes
+--
+-- RETURNS:		std::string - something to put in a file name: the base name of the port without its extension,
+--				with anything a file name cannot hold replaced by '_'
+--
+-- NOTES:
+-- Turns \\.\COM10 into COM10 and C:\logs\run.dspcap into run.
+----------------------------------------------------------------------------------------------------------------------*/
+std::string SerialCommController::toFileName(const std::string & portName) {
+	size_t slash = portName.find_last_of("\\/");
+	std::string name = slash == std::string::npos ? portName : portName.substr(slash + 1);
+	size_t dot = name.find_last_of('.');
 
+	if (dot != std::string::npos && dot > 0) {
+		name.erase(dot);
+	}
+	for (char & c : name) {
+		if ((unsigned char)c < 0x20 || strchr("<>:\"/\\|?*", c) != NULL) {
+			c = '_';
+		}
+	}
+	return name.empty() ? "port" : name;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	describeTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID describeTelemetry(char * text, size_t capacity)
+--					char * text:		set to one line describing the port's telemetry
+--					size_t capacity:	size of text, including the terminator
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from the window thread, for the status area. The counters are those of the current or last
+-- connection; they are reset when the port is next connected.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::describeTelemetry(char * text, size_t capacity) {
+	LinkTelemetry::formatStatus(pipeline.sampleTelemetry(), text, capacity);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	writeTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID writeTelemetry(FILE * out)
+--					FILE * out:	where the JSON object goes
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from the window thread. Writes the port's telemetry as one JSON object named by the port.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SerialCommController::writeTelemetry(FILE * out) {
+	LinkTelemetry::writeJson(out, toPortName(commPortName.c_str()).c_str(), pipeline.sampleTelemetry());
+}
@@ -6,6 +6,17 @@
 #include "error_codes.h"
 #include "ErrorHandler.h"
 #include "DisplayService.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include "CaptureWriter.h"
+#include "FileTransfer.h"
+#include "PipelineChannel.h"
+#include "PortMultiplexer.h"
+#include "SerialPipeline.h"
+#include "SerialTransport.h"
+#include "TcpBridge.h"
 
 /*------------------------------------------------------------------------------------------------------------------
 -- HEADER FILE:		SerialCommController.h -	A controller class that controls all operations in the physical
@@ -14,20 +25,46 @@
 -- PROGRAM:			DumbSerialPortEmulator
 --
 -- FUNCTIONS:
---					VOID drawToWindow(char input)
---					DWORD handleRead(LPVOID input)
+--					BOOL drawToWindow(const char * input, DWORD length)
+--					VOID drainReceived(void)
 --					VOID handleWrite(WPARAM * input)
+--					VOID handlePaste(const char * text, size_t length)
 --					VOID closePort(void)
 --					LPCWSTR getComPortName(void) const
+--					BOOL isConnected(void) const
+--					BOOL startCapture(void)
+--					VOID stopCapture(void)
+--					BOOL isCapturing(void) const
+--					BOOL startBridge(void)
+--					VOID stopBridge(void)
+--					BOOL isServing(void) const
+--					BOOL startTransfer(TransferProtocol protocol, LPCWSTR path, BOOL isSending)
+--					VOID cancelTransfer(void)
+--					VOID finishTransfer(void)
+--					BOOL isTransferring(void) const
+--					VOID describeTelemetry(char * text, size_t capacity)
+--					VOID writeTelemetry(FILE * out)
 --					VOID handleParam(UINT Msg, WPARAM* wParam)
 --					VOID initializeConnection(void)
 --					VOID resetCommConfig(void)
 --					VOID setComPort(LPCWSTR commPortName)
+--					std::string toPortName(LPCWSTR portName)
+--					std::string toFileName(const std::string & portName)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Receive path reads whole chunks through CommReader
+--					Oct 17, 2026 - Received data is handed to the window thread through a ring buffer
+--					Oct 17, 2026 - Writes go through a TransmitQueue with its own writer thread
+--					Oct 17, 2026 - Port I/O goes through a SerialTransport and the shared SerialPipeline
+--					Oct 17, 2026 - Can open a SimulatedTransport instead of a COM port
+--					Oct 17, 2026 - One controller per port session, receiving through the shared PortMultiplexer
+--					Oct 17, 2026 - Can record the session's traffic to a capture file
+--					Oct 17, 2026 - Can send or receive a file with XMODEM, YMODEM or ZMODEM
+--					Oct 17, 2026 - Times receive-to-paint and reports the port's LinkTelemetry
+--					Oct 17, 2026 - Keeps its transport and pipeline threads from one connection to the next
+--					Oct 17, 2026 - Can serve the session's received data to local TCP clients
 --
 -- DESIGNER:		Henry Ho
 --
@@ -37,35 +74,83 @@
 -- This controller class should be instantiated at the application session level in order to control physical layer
 -- functions. This controller class can open ports, close open ports, reset COM port configurations, and handle
 -- messages in connection mode.
+--
+-- SessionService keeps one controller per port. Each draws into its own DisplayService pane and tags its WM_RX_DATA
+-- with that pane, so the window thread knows which controller to drain.
+--
+-- A capture records both directions of the open port to a file until it is stopped or the port closes. The
+-- CaptureWriter is declared before the pipeline so it outlives the threads that record to it.
+--
+-- The TcpBridge serves the open port on 127.0.0.1, port BRIDGE_BASE_PORT plus the pane, until it is stopped or the
+-- port closes. Every client gets what the port receives, and what a client sends goes to the port as if typed. It is
+-- declared before the pipeline for the same reason as the capture.
+--
+-- A file transfer runs on a thread of its own, talking through a PipelineChannel: while it runs, drained data goes to
+-- the channel instead of the pane, and keystrokes are not sent. The thread posts WM_TRANSFER_DONE, with the pane, when
+-- the transfer ends.
+--
+-- Each drain takes the pipeline's arrival mark and counts a paint once the batch has been drawn to the end on the
+-- shown pane. A batch cut off at the frame budget keeps its mark for the drain that finishes it.
 ----------------------------------------------------------------------------------------------------------------------*/
 class SerialCommController {
 private:
-	char OUTPUT_BUFFER[1] = { 0 };
-	
+	std::unique_ptr<SerialTransport> transport = createSerialTransport();
+	std::string transportName;		// the port transport was made for, empty until the first connect
+	CaptureWriter capture;
+	TcpBridge bridge;
+	SerialPipeline pipeline;
+	PipelineChannel transferChannel{ &pipeline };
+	std::unique_ptr<FileTransfer> transfer;
+	std::thread transferThread;
+	std::atomic<bool> isTransferDone{ false };	// set by the transfer's thread just before WM_TRANSFER_DONE
+	TransferProtocol transferProtocol = TransferProtocol::Zmodem;
+	BOOL isSendingFile = false;
+	PortSettings portSettings;
+	int64_t paintPendingSince = 0;	// arrival mark of the oldest data drawn but not yet counted as painted
+
 	COMMCONFIG commConfig;
-	HANDLE commHandle;
-	COMMPROP commProp;
-	LPCWSTR commPortName;
+	std::wstring commPortName;
 
 	DisplayService * displayService;
+	PortMultiplexer * multiplexer = nullptr;
+	int pane = 0;
 	BOOL isComActive = false;
-	VOID drawToWindow(char input);
-	DWORD handleRead(LPVOID input);
+	BOOL drawToWindow(const char * input, DWORD length);
 	VOID handleWrite(WPARAM * input);
+	static std::string toPortName(LPCWSTR portName);
+	static std::string toFileName(const std::string & portName);
 
 public:
-	static DWORD WINAPI readFunc(LPVOID param) {
-		return ((SerialCommController*)param)->handleRead(0);
-	};
-	
 	SerialCommController() {};
-	SerialCommController(DisplayService * disp) : displayService(disp) {
+	SerialCommController(DisplayService * disp, LPCWSTR portName = TEXT("COM1"), int displayPane = 0,
+		PortMultiplexer * sharedReader = nullptr) : displayService(disp), multiplexer(sharedReader), pane(displayPane) {
 		commConfig.dwSize = sizeof(COMMCONFIG);
 		commConfig.wVersion = 0x100;
-		commPortName = TEXT("COM1");
+		commPortName = portName;
 	};
+	SerialCommController(const SerialCommController &) = delete;
+	SerialCommController & operator=(const SerialCommController &) = delete;
+	~SerialCommController() { closePort(); };
 	VOID closePort();
+	VOID drainReceived();
+	const RingBuffer & getReceiveRing() const { return pipeline.getReceiveRing(); };
+	const TransmitQueue & getTransmitQueue() const { return pipeline.getTransmitQueue(); };
 	VOID handleParam(WPARAM* wParam); 
-	VOID initializeConnection(LPCWSTR portName);
+	VOID handlePaste(const char * text, size_t length);
+	BOOL initializeConnection(LPCWSTR portName);
 	VOID setCommConfig(LPCWSTR portName);
+	LPCWSTR getComPortName() const { return commPortName.c_str(); };
+	BOOL isConnected() const { return isComActive; };
+	BOOL startCapture();
+	VOID stopCapture();
+	BOOL isCapturing() const { return capture.isCapturing(); };
+	BOOL startBridge();
+	VOID stopBridge();
+	BOOL isServing() const { return bridge.isServing(); };
+	BOOL startTransfer(TransferProtocol protocol, LPCWSTR path, BOOL isSending);
+	VOID cancelTransfer();
+	VOID finishTransfer();
+	BOOL isTransferring() const { return transfer != nullptr; };
+	VOID describeTelemetry(char * text, size_t capacity);
+	VOID writeTelemetry(FILE * out);
 };
\ No newline at end of file
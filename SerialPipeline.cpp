@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <system_error>
+#include "PortMultiplexer.h"
+#include "SerialPipeline.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		SerialPipeline.cpp -	The chunked receive and transmit stages shared by every platform.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(SerialTransport * port, NotifyFunction notify, PortMultiplexer * multiplexer)
+--					void stop(void)
+--					void receiveLoop(void)
+--					void deliver(const char * data, size_t length)
+--					bool transmit(const char * data, size_t length)
+--					bool waitForLine(FlowStatus * status)
+--					void pauseReceive(void)
+--					void resumeReceive(void)
+--					FlowStats getFlowStats(void) const
+--					TelemetrySnapshot sampleTelemetry(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Receive through a shared PortMultiplexer when one is given
+--					Oct 17, 2026 - Flow control on both sides of the pipeline
+--					Oct 17, 2026 - Reads, writes and queue depths are counted in the LinkTelemetry
+--					Oct 17, 2026 - The reader runs on a PortWorker that is parked between connections
+--					Oct 17, 2026 - Received chunks are published to a TcpBridge when one is set
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Both worker loops have returned, or the port has been removed from the multiplexer, by the time stop returns, so
+-- the transport may be closed at once. The threads themselves stay parked for the next start.
+--
+-- Pause times are taken from the steady clock in nanoseconds and stored as 0 when there is no pause, so
+-- getFlowStats can add a pause still in progress without a lock.
+----------------------------------------------------------------------------------------------------------------------*/
+
+static int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	start
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Optional multiplexer in place of the reader thread
+--				Oct 17, 2026 - Sent batches are recorded to the capture
+--				Oct 17, 2026 - The writer paces itself with transmit
+--				Oct 17, 2026 - Resets the telemetry and hands it to the transport
+--				Oct 17, 2026 - Hands the receive loop to the parked reader rather than a new thread
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool start(SerialTransport * port, NotifyFunction notifyFunction, PortMultiplexer * multiplexer)
+--					SerialTransport * port:			an open transport
+--					NotifyFunction notifyFunction:	tells the consumer there is data to drain
+--					PortMultiplexer * multiplexer:	a running multiplexer to receive through, or nullptr for a
+--													reader thread of its own
+--
+-- RETURNS:		bool - false if the pipeline is already running, a thread could not be created or the multiplexer
+--				cannot service the port
+----------------------------------------------------------------------------------------------------------------------*/
+bool SerialPipeline::start(SerialTransport * port, NotifyFunction notifyFunction, PortMultiplexer * multiplexer) {
+	if (isRunning.load() || port == nullptr || !port->isOpen()) {
+		return false;
+	}
+	transport = port;
+	sharedReader = multiplexer;
+	notify = notifyFunction;
+	isDrainPending.store(false);
+	isReceivePaused.store(false);
+	receivePauseStart.store(0);
+	transmitPauseStart.store(0);
+	receivePauses.store(0);
+	receivePausedNs.store(0);
+	transmitPauses.store(0);
+	transmitPausedNs.store(0);
+	telemetry.reset();
+	transport->setTelemetry(&telemetry);
+	isRunning.store(true);
+
+	try {
+		transmitQueue.start([this](const char * data, size_t length) {
+			return transmit(data, length);
+		});
+		if (sharedReader == nullptr) {
+			reader.start([this] { receiveLoop(); });
+		}
+	}
+	catch (const std::system_error &) {
+		isRunning.store(false);
+		transmitQueue.stop();
+		transport->setTelemetry(nullptr);
+		return false;
+	}
+	if (sharedReader != nullptr && !sharedReader->add(port, [this](const char * data, size_t length) {
+		deliver(data, length);
+	})) {
+		isRunning.store(false);
+		transmitQueue.stop();
+		sharedReader = nullptr;
+		transport->setTelemetry(nullptr);
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Remove the port from the multiplexer
+--				Oct 17, 2026 - Release a paused far end
+--				Oct 17, 2026 - Takes the telemetry back from the transport
+--				Oct 17, 2026 - Waits for the loops to return and leaves their threads parked
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void stop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Cancels the transport so a blocked read or write returns, then waits for both loops. Bytes still in the ring stay
+-- there for a final drain. A multiplexed port is removed first, which cancels its pending read and returns once the
+-- I/O thread will not deliver to this pipeline again. A far end still paused is released, since nothing will drain
+-- the ring to do it, and the time it spent paused is counted.
+----------------------------------------------------------------------------------------------------------------------*/
+void SerialPipeline::stop() {
+	if (!isRunning.exchange(false)) {
+		return;
+	}
+	if (sharedReader != nullptr) {
+		sharedReader->remove(transport);
+		sharedReader = nullptr;
+	}
+	transport->cancel();
+	transmitQueue.stop();
+	reader.stop();
+	if (isReceivePaused.load()) {
+		resumeReceive();
+	}
+	transport->setTelemetry(nullptr);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveLoop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Runs on the reader PortWorker, once per connection
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void receiveLoop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The reader loop, run on the reader PortWorker. Each chunk is copied into the ring and the consumer is notified
+-- once per batch: a new notify is only sent once the consumer has started draining the previous one. Bytes that do
+-- not fit are dropped and counted by the ring rather than stalling the reader. The loop ends when the transport
+-- fails or is cancelled, and the thread parks until the next start.
+----------------------------------------------------------------------------------------------------------------------*/
+void SerialPipeline::receiveLoop() {
+	size_t bytesReceived;
+
+	while (isRunning.load(std::memory_order_relaxed)) {
+		if (!transport->read(rxBuffer, RX_CHUNK_SIZE, RX_WAIT_TIMEOUT, &bytesReceived)) {
+			break;
+		}
+		if (bytesReceived == 0) {
+			continue;
+		}
+		deliver(rxBuffer, bytesReceived);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	deliver
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Received chunks are recorded to the capture
+--				Oct 17, 2026 - Pause the far end once the ring reaches receiveHigh
+--				Oct 17, 2026 - Counts the read and marks the arrival for the paint latency
+--				Oct 17, 2026 - Received chunks are published to the bridge
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void deliver(const char * data, size_t length)
+--					const char * data:	a chunk read from the port
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The producer side of the ring, called on the reader thread or the multiplexer's I/O thread.
+----------------------------------------------------------------------------------------------------------------------*/
+void SerialPipeline::deliver(const char * data, size_t length) {
+	if (capture != nullptr) {
+		capture->record(CaptureDirection::Receive, data, length);
+	}
+	if (bridge != nullptr) {
+		bridge->publish(data, length);
+	}
+	telemetry.markArrival();
+	rxRing.push(data, length);
+	telemetry.countRead(length);
+	if (!isReceivePaused.load() && rxRing.size() >= flowLimits.receiveHigh) {
+		pauseReceive();
+	}
+	if (!isDrainPending.exchange(true, std::memory_order_acq_rel)) {
+		notify();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	transmit
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool transmit(const char * data, size_t length)
+--					const char * data:	a batch taken from the TransmitQueue
+--					size_t length:		bytes in data
+--
+-- RETURNS:		bool - false if a write failed or the pipeline stopped before every byte was written
+--
+-- NOTES:
+-- The TransmitQueue's write function, called on the writer thread. Each slice handed to the transport tops the
+-- port's output queue up to transmitHigh and no further; when the port is full or held, waitForLine waits for room.
+-- A transport that cannot report its queue gets the whole batch at once, as before.
+----------------------------------------------------------------------------------------------------------------------*/
+bool SerialPipeline::transmit(const char * data, size_t length) {
+	while (length > 0) {
+		FlowStatus status;
+		size_t slice = length;
+
+		if (transport->getFlowStatus(&status)) {
+			telemetry.noteOutputQueue(status.outputQueued);
+			if (status.isCtsHeld || status.isXoffHeld || status.outputQueued >= flowLimits.transmitHigh) {
+				if (!waitForLine(&status)) {
+					return false;
+				}
+			}
+			slice = std::min(length, flowLimits.transmitHigh - std::min(status.outputQueued, flowLimits.transmitHigh));
+		}
+		if (capture != nullptr) {
+			capture->record(CaptureDirection::Transmit, data, slice);
+		}
+		if (!transport->write(data, slice)) {
+			return false;
+		}
+		telemetry.countWrite(slice);
+		data += slice;
+		length -= slice;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	waitForLine
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool waitForLine(FlowStatus * status)
+--					FlowStatus * status:	the port's last status, updated while waiting
+--
+-- RETURNS:		bool - false if the pipeline stopped or the port could no longer report its status
+--
+-- NOTES:
+-- Polls the port every TX_FLOW_POLL ms until it is released and its output queue is down to transmitLow. Only the
+-- time the far end actually holds the line counts as a transmit pause; waiting on a port that is merely full is the
+-- line's own pace.
+----------------------------------------------------------------------------------------------------------------------*/
+bool SerialPipeline::waitForLine(FlowStatus * status) {
+	bool isHeld = false;
+	bool isReady = false;
+
+	while (isRunning.load(std::memory_order_relaxed) && !transmitQueue.isStopping()) {
+		bool isHolding = status->isCtsHeld || status->isXoffHeld;
+
+		if (isHolding && !isHeld) {
+			transmitPauses.fetch_add(1, std::memory_order_relaxed);
+			transmitPauseStart.store(nowNs());
+		}
+		else if (!isHolding && isHeld) {
+			transmitPausedNs.fetch_add(nowNs() - transmitPauseStart.exchange(0), std::memory_order_relaxed);
+		}
+		isHeld = isHolding;
+		if (!isHolding && status->outputQueued <= flowLimits.transmitLow) {
+			isReady = true;
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(TX_FLOW_POLL));
+		if (!transport->getFlowStatus(status)) {
+			break;
+		}
+	}
+	if (isHeld) {
+		transmitPausedNs.fetch_add(nowNs() - transmitPauseStart.exchange(0), std::memory_order_relaxed);
+	}
+	return isReady;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	pauseReceive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void pauseReceive(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Called by the producer once the ring reaches receiveHigh. The fill is checked again under flowLock, since the
+-- consumer may have drained it in the meantime. The pause only counts if the transport could assert it; without
+-- flow control the ring overflows and counts the loss as before.
+----------------------------------------------------------------------------------------------------------------------*/
+void SerialPipeline::pauseReceive() {
+	std::lock_guard<std::mutex> guard(flowLock);
+
+	if (isReceivePaused.load() || rxRing.size() < flowLimits.receiveHigh) {
+		return;
+	}
+	if (!transport->setReceivePaused(true)) {
+		return;
+	}
+	receivePauses.fetch_add(1, std::memory_order_relaxed);
+	receivePauseStart.store(nowNs());
+	isReceivePaused.store(true);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	resumeReceive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void resumeReceive(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Called by the consumer once the ring is down to receiveLow, and by stop. Releases the far end and adds the time
+-- it spent paused.
+----------------------------------------------------------------------------------------------------------------------*/
+void SerialPipeline::resumeReceive() {
+	std::lock_guard<std::mutex> guard(flowLock);
+
+	if (!isReceivePaused.load()) {
+		return;
+	}
+	transport->setReceivePaused(false);
+	isReceivePaused.store(false);
+	receivePausedNs.fetch_add(nowNs() - receivePauseStart.exchange(0), std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getFlowStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	FlowStats getFlowStats(void) const
+--
+-- RETURNS:		FlowStats - pause counts and times in both directions, including any pause still in progress
+--
+-- NOTES:
+-- Safe to call from any thread while the pipeline runs.
+----------------------------------------------------------------------------------------------------------------------*/
+FlowStats SerialPipeline::getFlowStats() const {
+	FlowStats stats;
+	int64_t now = nowNs();
+	int64_t receiveStart = receivePauseStart.load();
+	int64_t transmitStart = transmitPauseStart.load();
+	uint64_t receiveNs = receivePausedNs.load(std::memory_order_relaxed);
+	uint64_t transmitNs = transmitPausedNs.load(std::memory_order_relaxed);
+
+	if (receiveStart != 0) {
+		receiveNs += now - receiveStart;
+	}
+	if (transmitStart != 0) {
+		transmitNs += now - transmitStart;
+	}
+	stats.receivePauses = receivePauses.load(std::memory_order_relaxed);
+	stats.receivePausedSeconds = receiveNs / 1e9;
+	stats.transmitPauses = transmitPauses.load(std::memory_order_relaxed);
+	stats.transmitPausedSeconds = transmitNs / 1e9;
+	stats.isReceivePaused = receiveStart != 0;
+	stats.isTransmitPaused = transmitStart != 0;
+	return stats;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sampleTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TelemetrySnapshot sampleTelemetry(void)
+--
+-- RETURNS:		TelemetrySnapshot - the port's counters
+--
+-- NOTES:
+-- Call this function from the thread that starts and stops the pipeline. While it runs the port is polled first,
+-- so line errors are collected even when nothing is being sent and the reads go through a multiplexer that never
+-- asks the driver for them.
+----------------------------------------------------------------------------------------------------------------------*/
+TelemetrySnapshot SerialPipeline::sampleTelemetry() {
+	FlowStatus status;
+
+	if (isRunning.load() && transport->getFlowStatus(&status)) {
+		telemetry.noteOutputQueue(status.outputQueued);
+	}
+	return telemetry.snapshot();
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "CaptureWriter.h"
+#include "LinkTelemetry.h"
+#include "PortWorker.h"
+#include "RingBuffer.h"
+#include "SerialTransport.h"
+#include "TcpBridge.h"
+#include "TransmitQueue.h"
+
+class PortMultiplexer;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		SerialPipeline.h -	The chunked receive and transmit stages shared by every platform.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(SerialTransport * port, NotifyFunction notify, PortMultiplexer * multiplexer)
+--					void stop(void)
+--					void setCapture(CaptureWriter * writer)
+--					void setBridge(TcpBridge * server)
+--					void setFlowLimits(const FlowLimits & limits)
+--					size_t send(const char * data, size_t length)
+--					void drain(Visit visit)
+--					bool drainUntil(Visit visit)
+--					bool isActive(void) const
+--					const RingBuffer & getReceiveRing(void) const
+--					const TransmitQueue & getTransmitQueue(void) const
+--					FlowStats getFlowStats(void) const
+--					LinkTelemetry & getTelemetry(void)
+--					TelemetrySnapshot sampleTelemetry(void)
+--					uint64_t getThreadStarts(void) const
+--					bool transmit(const char * data, size_t length)
+--					bool waitForLine(FlowStatus * status)
+--					void checkReceiveResume(void)
+--					void pauseReceive(void)
+--					void resumeReceive(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - drainUntil lets the consumer stop partway and pick up the rest later
+--					Oct 17, 2026 - The receive side can be serviced by a shared PortMultiplexer
+--					Oct 17, 2026 - Received chunks and sent batches can be recorded to a CaptureWriter
+--					Oct 17, 2026 - Transmit pacing and receive pausing under RTS/CTS or XON/XOFF flow control
+--					Oct 17, 2026 - Counts the port's traffic in a LinkTelemetry
+--					Oct 17, 2026 - The reader and writer are PortWorkers kept across connections
+--					Oct 17, 2026 - Received chunks can be published to a TcpBridge
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A reader thread pulls whole chunks from the transport into an SPSC ring and calls notify once per batch; the
+-- consumer later drains the ring in place. Outgoing bytes go through a TransmitQueue whose writer thread hands each
+-- coalesced batch to the transport. The pipeline does not own the transport: open it before start and close it
+-- after stop.
+--
+-- Both threads are PortWorkers, created by the first start and parked by stop, so a pipeline reconnected again and
+-- again keeps the same two threads, its ring and its transmit buffers. stop cancels the transport and waits for
+-- both loops to return, so no read or write of the old connection can still be running when it is closed.
+--
+-- Given a running PortMultiplexer, start adds the port to it instead of starting a reader thread, so many pipelines
+-- share one I/O thread for receiving. The writer thread stays per port; it only runs while there is data to send.
+--
+-- With a CaptureWriter set, each chunk is recorded as it is received, before it enters the ring, and each batch as
+-- it is handed to the transport. The writer must outlive the pipeline; open and close it at will. A TcpBridge set
+-- the same way is handed each received chunk next to the capture, and is just as free to open and close.
+--
+-- Flow control works in both directions when the transport supports it. The writer hands the transport at most
+-- transmitHigh bytes beyond what is still queued in the port, and once the port holds that many, or the far end
+-- holds the line with CTS or XOFF, waits until it is down to transmitLow and released, leaving the rest in the
+-- TransmitQueue. When the ring fills to receiveHigh the far end is paused with RTS or XOFF, and released once the
+-- consumer has drained it to receiveLow; the room above receiveHigh takes what is already on the way.
+-- Each pause in either direction is counted and timed.
+--
+-- The pipeline's LinkTelemetry counts every chunk delivered and every write, marks when undrained data first
+-- arrived, and is handed to the transport while running for line errors. It is reset by start.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t RX_RING_SIZE = 1 << 20;	// received bytes that may wait for the consumer
+constexpr size_t TX_FLOW_HIGH = 4096;		// bytes the port may hold before the writer waits, as TX_DRIVER_QUEUE
+constexpr size_t TX_FLOW_LOW = 1024;		// bytes the port must be down to before the writer goes on
+constexpr uint32_t TX_FLOW_POLL = 2;		// ms between checks of a held or full port
+
+struct FlowLimits {
+	size_t receiveHigh = RX_RING_SIZE / 4 * 3;	// ring fill that pauses the far end
+	size_t receiveLow = RX_RING_SIZE / 4;		// ring fill that releases it
+	size_t transmitHigh = TX_FLOW_HIGH;
+	size_t transmitLow = TX_FLOW_LOW;
+};
+
+struct FlowStats {
+	uint64_t receivePauses = 0;			// times the far end was asked to stop
+	double receivePausedSeconds = 0;
+	uint64_t transmitPauses = 0;		// times the far end held the line while there was data to send
+	double transmitPausedSeconds = 0;
+	bool isReceivePaused = false;
+	bool isTransmitPaused = false;
+};
+
+class SerialPipeline {
+public:
+	// Called when the ring goes from drained to holding data: on the reader or I/O thread, or on the consumer's
+	// when drainUntil stops with data left
+	typedef std::function<void()> NotifyFunction;
+private:
+	SerialTransport * transport = nullptr;
+	PortMultiplexer * sharedReader = nullptr;
+	CaptureWriter * capture = nullptr;
+	TcpBridge * bridge = nullptr;
+	NotifyFunction notify;
+	PortWorker reader;
+	std::atomic<bool> isRunning{ false };
+	std::atomic<bool> isDrainPending{ false };
+
+	LinkTelemetry telemetry;
+	FlowLimits flowLimits;
+	std::mutex flowLock;						// serializes pauseReceive and resumeReceive
+	std::atomic<bool> isReceivePaused{ false };
+	std::atomic<int64_t> receivePauseStart{ 0 };	// steady clock ns when the current pause began, 0 for none
+	std::atomic<int64_t> transmitPauseStart{ 0 };
+	std::atomic<uint64_t> receivePauses{ 0 };
+	std::atomic<uint64_t> receivePausedNs{ 0 };
+	std::atomic<uint64_t> transmitPauses{ 0 };
+	std::atomic<uint64_t> transmitPausedNs{ 0 };
+
+	char rxBuffer[RX_CHUNK_SIZE];
+	RingBuffer rxRing{ RX_RING_SIZE };
+	TransmitQueue transmitQueue;
+
+	void receiveLoop();
+	void deliver(const char * data, size_t length);
+	bool transmit(const char * data, size_t length);
+	bool waitForLine(FlowStatus * status);
+	void pauseReceive();
+	void resumeReceive();
+	void checkReceiveResume() {
+		if (isReceivePaused.load() && rxRing.size() <= flowLimits.receiveLow) {
+			resumeReceive();
+		}
+	};
+public:
+	SerialPipeline() {};
+	~SerialPipeline() { stop(); };
+	SerialPipeline(const SerialPipeline &) = delete;
+	SerialPipeline & operator=(const SerialPipeline &) = delete;
+
+	bool start(SerialTransport * port, NotifyFunction notifyFunction, PortMultiplexer * multiplexer = nullptr);
+	void stop();
+	// Call before start
+	void setCapture(CaptureWriter * writer) { capture = writer; };
+	// Call before start
+	void setBridge(TcpBridge * server) { bridge = server; };
+	// Call before start
+	void setFlowLimits(const FlowLimits & limits) { flowLimits = limits; };
+	size_t send(const char * data, size_t length) { return transmitQueue.submit(data, length); };
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	drain
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	void drain(Visit visit)
+	--					Visit visit:	called as visit(const char * data, size_t length) for each contiguous piece
+	--
+	-- RETURNS:		void
+	--
+	-- NOTES:
+	-- Call this function from the consumer after notify. The pending flag is cleared first so data queued while
+	-- draining raises a fresh notify instead of being left behind. A paused far end is released once drained.
+	--------------------------------------------------------------------------------------------------------------*/
+	template <typename Visit>
+	void drain(Visit visit) {
+		const char * data;
+		size_t available;
+
+		isDrainPending.store(false, std::memory_order_release);
+		while ((available = rxRing.peek(&data)) > 0) {
+			visit(data, available);
+			rxRing.consume(available);
+		}
+		checkReceiveResume();
+	}
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	drainUntil
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	bool drainUntil(Visit visit)
+	--					Visit visit:	called as visit(const char * data, size_t length) for each piece of at most
+	--									RX_CHUNK_SIZE bytes; returns false to stop
+	--
+	-- RETURNS:		bool - false if visit stopped the drain with data still queued
+	--
+	-- NOTES:
+	-- Like drain, but the consumer can stop early, for instance when its frame budget is spent. Whatever is left is
+	-- announced with a fresh notify, so it is drawn by the next drain rather than waiting for more data to arrive.
+	--------------------------------------------------------------------------------------------------------------*/
+	template <typename Visit>
+	bool drainUntil(Visit visit) {
+		const char * data;
+		size_t available;
+
+		isDrainPending.store(false, std::memory_order_release);
+		while ((available = rxRing.peek(&data)) > 0) {
+			size_t length = available < RX_CHUNK_SIZE ? available : RX_CHUNK_SIZE;
+			bool isMore = visit(data, length);
+			rxRing.consume(length);
+			if (!isMore && rxRing.size() > 0) {
+				if (!isDrainPending.exchange(true, std::memory_order_acq_rel)) {
+					notify();
+				}
+				checkReceiveResume();
+				return false;
+			}
+		}
+		checkReceiveResume();
+		return true;
+	}
+
+	bool isActive() const { return isRunning.load(std::memory_order_relaxed); };
+	const RingBuffer & getReceiveRing() const { return rxRing; };
+	const TransmitQueue & getTransmitQueue() const { return transmitQueue; };
+	FlowStats getFlowStats() const;
+	// The consumer times its paints with takeArrival and countPaint
+	LinkTelemetry & getTelemetry() { return telemetry; };
+	TelemetrySnapshot sampleTelemetry();
+	// Threads created over the pipeline's life; stays at two however often it is restarted
+	uint64_t getThreadStarts() const { return reader.getThreadStarts() + transmitQueue.getThreadStarts(); };
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+class LinkTelemetry;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		SerialTransport.h -	The port operations the I/O pipeline needs, independent of the platform.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					std::unique_ptr<SerialTransport> createSerialTransport(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - RX_CHUNK_SIZE moved here from SerialPipeline.h for the multiplexers
+--					Oct 17, 2026 - getFlowStatus and setReceivePaused for flow control driven by SerialPipeline
+--					Oct 17, 2026 - setTelemetry for line errors and driver queue depths
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Win32Transport drives a COM port with overlapped I/O; PosixTransport drives a tty or pty with termios and epoll.
+-- open and configure return 0 or one of the codes in error_codes.h so the caller can pass them to ErrorHandler.
+-- read is called from one reader thread, or a PortMultiplexer's I/O thread, and write from one writer thread; cancel
+-- may be called from any thread and makes both return false promptly, until the port is closed and opened again.
+--
+-- getFlowStatus reports what the writer needs to pace itself: how much it has written that has not left the port,
+-- and whether the far end is holding the line with CTS or XOFF. setReceivePaused drops RTS or sends XOFF, whichever
+-- the settings enable, and undoes it; it may be called from any thread. A transport that cannot do either keeps the
+-- defaults, which report nothing and refuse.
+--
+-- SerialPipeline counts bytes and calls itself; setTelemetry hands the transport the port's LinkTelemetry for what
+-- only the transport sees, the UART's line errors and the driver's input queue. getFlowStatus is also a chance to
+-- collect them: the pipeline also calls it from the window thread whenever telemetry is sampled, so it may run on
+-- two threads at once.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint32_t RX_WAIT_TIMEOUT = 100;	// ms the reader blocks before re-checking whether the port is still active
+constexpr uint32_t TX_WAIT_TIMEOUT = 100;	// ms between checks for a cancel request during a blocked write
+constexpr size_t RX_CHUNK_SIZE = 4096;		// largest single read handed downstream
+constexpr char FLOW_XON = 0x11;				// DC1, resume sending
+constexpr char FLOW_XOFF = 0x13;			// DC3, stop sending
+
+// Scoped so the names cannot collide with the PARITY_ macros from winbase.h
+enum class ParityMode { None, Odd, Even };
+
+struct PortSettings {
+	uint32_t baudRate = 9600;
+	uint8_t dataBits = 8;
+	ParityMode parity = ParityMode::None;
+	uint8_t stopBits = 1;
+	bool rtsCts = false;		// hardware flow control
+	bool xonXoff = false;		// software flow control
+};
+
+struct FlowStatus {
+	size_t outputQueued = 0;	// bytes written that have not yet left the port
+	bool isCtsHeld = false;		// the far end has dropped CTS
+	bool isXoffHeld = false;	// the far end has sent XOFF
+};
+
+class SerialTransport {
+public:
+	virtual ~SerialTransport() {};
+
+	virtual int open(const std::string & portName) = 0;
+	virtual int configure(const PortSettings & settings) = 0;
+	virtual void close() = 0;
+	virtual bool isOpen() const = 0;
+
+	// Waits up to timeout ms for data; returns false if the port failed or was cancelled. 0 bytes means timed out.
+	virtual bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) = 0;
+	// Writes every byte; returns false if the port failed or was cancelled
+	virtual bool write(const char * data, size_t length) = 0;
+	virtual void cancel() = 0;
+
+	// Returns false if the port cannot tell
+	virtual bool getFlowStatus(FlowStatus *) { return false; }
+	// Returns false if no flow control is set, or the port cannot signal it
+	virtual bool setReceivePaused(bool) { return false; }
+	// Set while the pipeline runs, nullptr otherwise
+	virtual void setTelemetry(LinkTelemetry *) {}
+};
+
+std::unique_ptr<SerialTransport> createSerialTransport();
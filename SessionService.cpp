@@ -1,11 +1,17 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <string>
 #include <windows.h>
+#include <commdlg.h>
+#include <dbt.h>
 #include "error_codes.h"
 #include "key_press.h"
 #include "modes.h"
 #include "ErrorHandler.h"
 #include "SessionService.h"
 #include "idm.h"
+#include "messages.h"
+#include "WINDOW.h"
 
 /*------------------------------------------------------------------------------------------------------------------
 -- SOURCE FILE:		SessionService.cpp -A class that handles all session level events according to the OSI network
@@ -14,16 +20,46 @@
 -- PROGRAM:			DumbSerialPortEmulator
 --
 -- FUNCTIONS:
---					VOID createReadThread(void)
 --					VOID handlePortConfig(LPCWSTR portName)
 --					VOID handleCommandeMode(UINT Message, WPARAM wParam)
 --					VOID handleConnectMode(UINT Message, WPARAM wParam)
---					VOID handleProcess(UINT Message, WPARAM wParam);
+--					VOID handleProcess(UINT Message, WPARAM wParam, LPARAM lParam);
+--					VOID pasteClipboard(void)
+--					SerialCommController * getSession(LPCWSTR portName, int * index)
+--					VOID openSession(LPCWSTR portName)
+--					VOID openSimulatedSession(void)
+--					VOID openReplaySession(void)
+--					VOID closeSession(void)
+--					VOID nextSession(void)
+--					VOID showSession(int index)
+--					VOID toggleCapture(void)
+--					VOID toggleBridge(void)
+--					VOID sendFile(void)
+--					VOID receiveFile(void)
+--					VOID selectProtocol(UINT command)
+--					VOID toggleTelemetry(void)
+--					VOID refreshTelemetry(void)
+--					VOID saveTelemetry(void)
+--					VOID updatePortMenus(void)
+--					VOID fillPortMenu(HMENU popup, UINT firstCommand)
+--					LPCWSTR getListedPort(UINT command, UINT firstCommand)
+--					VOID handleDeviceChange(WPARAM event, LPARAM data)
+--					VOID configurePort(LPCWSTR portName)
+--					VOID closeAll(void)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Drains received data on the window thread
+--					Oct 17, 2026 - Routes paint and size messages to DisplayService
+--					Oct 17, 2026 - Routes scroll bar and mouse wheel messages to DisplayService
+--					Oct 17, 2026 - Shift+Insert pastes the clipboard in connect mode
+--					Oct 17, 2026 - The controller starts its own I/O threads; connect mode is only entered on success
+--					Oct 17, 2026 - Several ports open at once; Ctrl+Tab switches between them
+--					Oct 17, 2026 - Transfer menu sends and receives files with XMODEM, YMODEM or ZMODEM
+--					Oct 17, 2026 - View menu shows link telemetry in a status bar and saves it as JSON
+--					Oct 17, 2026 - Port menus are built from the PortEnumerator and follow ports arriving and leaving
+--					Oct 17, 2026 - Connect menu serves the session shown over TCP
 --
 -- DESIGNER:		Henry Ho
 --
@@ -34,42 +70,18 @@
 -- resource file.
 ----------------------------------------------------------------------------------------------------------------------*/
 
-/*------------------------------------------------------------------------------------------------------------------
--- FUNCTION:	createReadThread
---
--- DATE:		Sept 28, 2019
---
--- REVISIONS:	(N/A)
---
--- DESIGNER:	Henry Ho
---
--- PROGRAMMER:	Henry Ho
---
--- INTERFACE:	VOID createReadThread(void)
---
--- RETURNS:		void
---
--- NOTES:
--- Call this function to create a thread to enable the application to read inputs from the COM port.
-----------------------------------------------------------------------------------------------------------------------*/
-VOID SessionService::createReadThread() {
-	DWORD readThreadId;
-	HANDLE readThread;
-	readThread = CreateThread(NULL, 0, SerialCommController::readFunc, (LPVOID)commController, 0, &readThreadId);
-	if (!readThread) {
-		ErrorHandler::handleError(ERROR_RD_THREAD);
-	}
-	else {
-		CloseHandle(readThread);
-	}
-}
-
 /*------------------------------------------------------------------------------------------------------------------
 -- FUNCTION:	handleCommandMode
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Enters connect mode only if the port opened
+--				Oct 17, 2026 - Connect menu can open a simulated loopback port
+--				Oct 17, 2026 - COM2 settings configure COM2 rather than COM1; each port has its own session
+--				Oct 17, 2026 - Replay Capture opens a capture file as a port
+--				Oct 17, 2026 - Transfer menu protocol can be chosen before connecting
+--				Oct 17, 2026 - Link telemetry can be shown or saved
+--				Oct 17, 2026 - Settings and Connect take the listed ports rather than COM1 and COM2
 --
 -- DESIGNER:	Henry Ho
 --
@@ -86,33 +98,48 @@ VOID SessionService::createReadThread() {
 -- exit command mode, it configures the current mode to command mode.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SessionService::handleCommandMode(UINT Message, WPARAM wParam) {
+	LPCWSTR portName;
+
 	switch (Message) {
 	case WM_COMMAND:
 		switch (LOWORD(wParam)) {
-		case IDM_COM1:
-			commController->setCommConfig(TEXT("COM1"));
+		case IDM_Connect_SIM:
+			openSimulatedSession();
+			break;
+		case IDM_Connect_Replay:
+			openReplaySession();
 			break;
-		case IDM_COM2:
-			commController->setCommConfig(TEXT("COM1"));
+		case IDM_Transfer_Send:
+		case IDM_Transfer_Receive:
+			ErrorHandler::handleError(ERROR_TRANSFER_START);
 			break;
-		case IDM_Connect_COM1:
-			commController->initializeConnection(TEXT("COM1"));
-			createReadThread();
-			currentMode = CONNECT_MODE;
+		case IDM_Protocol_Xmodem:
+		case IDM_Protocol_Xmodem1k:
+		case IDM_Protocol_Ymodem:
+		case IDM_Protocol_Zmodem:
+			selectProtocol(LOWORD(wParam));
 			break;
-		case IDM_Connect_COM2:
-			commController->initializeConnection(TEXT("COM2"));
-			createReadThread();
-			currentMode = CONNECT_MODE;
+		case IDM_Telemetry_Show:
+			toggleTelemetry();
+			break;
+		case IDM_Telemetry_Save:
+			saveTelemetry();
 			break;
 		case IDM_Exit:
-			commController->closePort();
+			closeAll();
 			PostQuitMessage(0);
 			break;
 		case IDM_HELP:
-			DisplayService::displayMessageBox("Press <ESC> to disconnect.");
+			DisplayService::displayMessageBox("Press <ESC> to disconnect or cancel a transfer, "
+				"and Ctrl+Tab to switch ports.");
 			break;
 		default:
+			if ((portName = getListedPort(LOWORD(wParam), IDM_Connect_Port)) != NULL) {
+				openSession(portName);
+			}
+			else if ((portName = getListedPort(LOWORD(wParam), IDM_Settings_Port)) != NULL) {
+				configurePort(portName);
+			}
 			break;
 		}
 	}
@@ -123,7 +150,15 @@ VOID SessionService::handleCommandMode(UINT Message, WPARAM wParam) {
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Menu commands no longer fall through and get sent as characters
+--				Oct 17, 2026 - Shift+Insert pastes the clipboard
+--				Oct 17, 2026 - More ports can be connected; Ctrl+Tab shows the next one; ESC closes the one shown
+--				Oct 17, 2026 - Capture to File starts or stops recording the session shown
+--				Oct 17, 2026 - Replay Capture opens a capture file as a port
+--				Oct 17, 2026 - Transfer menu sends or receives a file; ESC cancels a transfer before it disconnects
+--				Oct 17, 2026 - Link telemetry can be shown or saved
+--				Oct 17, 2026 - Connect takes the listed ports rather than COM1 and COM2
+--				Oct 17, 2026 - Serve on TCP starts or stops serving the session shown
 --
 -- DESIGNER:	Henry Ho
 --
@@ -136,51 +171,156 @@ VOID SessionService::handleCommandMode(UINT Message, WPARAM wParam) {
 -- RETURNS:		void
 --
 -- NOTES:
--- Call this function during connect mode to handle incoming messages and parameters.
+-- Call this function during connect mode to handle incoming messages and parameters. Keys go to the session shown.
 ----------------------------------------------------------------------------------------------------------------------*/
 VOID SessionService::handleConnectMode(UINT Message, WPARAM wParam) {
+	LPCWSTR portName;
+
 	switch (Message) {
 	case WM_COMMAND:
 		switch (LOWORD(wParam)) {
+		case IDM_Connect_SIM:
+			openSimulatedSession();
+			break;
+		case IDM_Connect_Replay:
+			openReplaySession();
+			break;
+		case IDM_Next_Session:
+			nextSession();
+			break;
+		case IDM_Capture:
+			toggleCapture();
+			break;
+		case IDM_Bridge:
+			toggleBridge();
+			break;
+		case IDM_Transfer_Send:
+			sendFile();
+			break;
+		case IDM_Transfer_Receive:
+			receiveFile();
+			break;
+		case IDM_Protocol_Xmodem:
+		case IDM_Protocol_Xmodem1k:
+		case IDM_Protocol_Ymodem:
+		case IDM_Protocol_Zmodem:
+			selectProtocol(LOWORD(wParam));
+			break;
+		case IDM_Telemetry_Show:
+			toggleTelemetry();
+			break;
+		case IDM_Telemetry_Save:
+			saveTelemetry();
+			break;
 		case IDM_Exit:
-			commController->closePort();
+			closeAll();
 			PostQuitMessage(0);
 			currentMode = COMMAND_MODE;
 			break;
 		case IDM_HELP:
-			DisplayService::displayMessageBox("Press <ESC> to disconnect.");
+			DisplayService::displayMessageBox("Press <ESC> to disconnect or cancel a transfer, "
+				"and Ctrl+Tab to switch ports.");
 			break;
 		default:
-			DisplayService::displayMessageBox("In connect mode. Press <ESC> to disconnect.");
+			if ((portName = getListedPort(LOWORD(wParam), IDM_Connect_Port)) != NULL) {
+				openSession(portName);
+			}
+			else {
+				DisplayService::displayMessageBox("In connect mode. Press <ESC> to disconnect.");
+			}
 			break;
 		}
+		break;
+	case WM_KEYDOWN:
+		if (wParam == VK_INSERT && GetKeyState(VK_SHIFT) < 0) {
+			pasteClipboard();
+		}
+		else if (wParam == VK_TAB && GetKeyState(VK_CONTROL) < 0) {
+			nextSession();
+		}
+		break;
 	case WM_CHAR:
 		switch (wParam) {
 		case ESC_KEY:
-			commController->closePort();
-			currentMode = COMMAND_MODE;
+			if (sessions[activeSession]->isTransferring()) {
+				sessions[activeSession]->cancelTransfer();
+			}
+			else {
+				closeSession();
+			}
 			break;
 		default:
-			commController->handleParam(&wParam);
+			sessions[activeSession]->handleParam(&wParam);
 			break;
 		}
 	}
 }
 
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	pasteClipboard
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID pasteClipboard(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to send the text on the clipboard. Line breaks are sent as a single carriage return, the same
+-- as pressing Enter. The whole paste is handed to the transmit queue at once.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::pasteClipboard() {
+	HANDLE clipboardData;
+	const char * text;
+	std::string paste;
+
+	if (!IsClipboardFormatAvailable(CF_TEXT) || !OpenClipboard(*displayService->getWindowHandle())) {
+		return;
+	}
+	clipboardData = GetClipboardData(CF_TEXT);
+	if (clipboardData != NULL && (text = (const char *)GlobalLock(clipboardData)) != NULL) {
+		for (; *text; text++) {
+			if (*text == '\r' && text[1] == '\n') {
+				continue;
+			}
+			paste.push_back(*text == '\n' ? '\r' : *text);
+		}
+		GlobalUnlock(clipboardData);
+	}
+	CloseClipboard();
+
+	if (!paste.empty()) {
+		sessions[activeSession]->handlePaste(paste.data(), paste.size());
+	}
+}
+
 /*------------------------------------------------------------------------------------------------------------------
 -- FUNCTION:	handleProcess
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Handles WM_RX_DATA in every mode
+--				Oct 17, 2026 - Handles WM_PAINT and WM_SIZE in every mode
+--				Oct 17, 2026 - Handles WM_VSCROLL and WM_MOUSEWHEEL in every mode
+--				Oct 17, 2026 - WM_RX_DATA drains the session named by its wParam
+--				Oct 17, 2026 - WM_TRANSFER_DONE reports the transfer of the session named by its wParam
+--				Oct 17, 2026 - WM_TIMER refreshes the telemetry status bar
+--				Oct 17, 2026 - WM_PORTS_CHANGED rebuilds the port menus; WM_DEVICECHANGE updates the port list
 --
 -- DESIGNER:	Henry Ho
 --
 -- PROGRAMMER:	Henry Ho
 --
--- INTERFACE:	VOID handleProcess(UINT Message, WPARAM wParam)
+-- INTERFACE:	VOID handleProcess(UINT Message, WPARAM wParam, LPARAM lParam)
 --					UINT Message:	the message dispatched to handle
 --					WPARAM wParam:	the parameter attached to the event
+--					LPARAM lParam:	the second parameter, which WM_DEVICECHANGE points at its device with
 --
 -- RETURNS:		void
 --
@@ -188,7 +328,51 @@ VOID SessionService::handleConnectMode(UINT Message, WPARAM wParam) {
 -- Call this function in the main window processing function to handle event messages. This function passes
 -- the messages to different handlers based on the application's mode.
 ----------------------------------------------------------------------------------------------------------------------*/
-VOID SessionService::handleProcess(UINT Message, WPARAM wParam) {
+VOID SessionService::handleProcess(UINT Message, WPARAM wParam, LPARAM lParam) {
+	// Messages can arrive while the window is being created, before the services exist
+	if (displayService == NULL) {
+		return;
+	}
+
+	switch (Message) {
+	case WM_RX_DATA:
+		// Data queued just before a disconnect is still drawn
+		if (wParam < (WPARAM)MAX_PORT_SESSIONS && sessions[wParam]) {
+			sessions[wParam]->drainReceived();
+		}
+		return;
+	case WM_TRANSFER_DONE:
+		if (wParam < (WPARAM)MAX_PORT_SESSIONS && sessions[wParam]) {
+			sessions[wParam]->finishTransfer();
+		}
+		return;
+	case WM_TIMER:
+		if (wParam == TELEMETRY_TIMER) {
+			refreshTelemetry();
+		}
+		return;
+	case WM_PORTS_CHANGED:
+		updatePortMenus();
+		return;
+	case WM_DEVICECHANGE:
+		handleDeviceChange(wParam, lParam);
+		return;
+	case WM_PAINT:
+		displayService->paint();
+		return;
+	case WM_SIZE:
+		displayService->resize();
+		return;
+	case WM_VSCROLL:
+		displayService->handleScroll(wParam);
+		return;
+	case WM_MOUSEWHEEL:
+		displayService->scrollView(GET_WHEEL_DELTA_WPARAM(wParam) * WHEEL_SCROLL_LINES / WHEEL_DELTA);
+		return;
+	default:
+		break;
+	}
+
 	switch (currentMode) {
 	case COMMAND_MODE:
 		handleCommandMode(Message, wParam);
@@ -199,4 +383,738 @@ VOID SessionService::handleProcess(UINT Message, WPARAM wParam) {
 	default:
 		break;
 	}
-}
\ No newline at end of file
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	SerialCommController * getSession(LPCWSTR portName, int * index)
+--					LPCWSTR portName:	the port, such as "COM1"
+--					int * index:		set to the session's slot
+--
+-- RETURNS:		SerialCommController * - the port's session, or NULL if every slot holds an open port
+--
+-- NOTES:
+-- A port keeps its slot once it has one. A new port takes an empty slot, or failing that the slot of a port that is
+-- no longer connected.
+----------------------------------------------------------------------------------------------------------------------*/
+SerialCommController * SessionService::getSession(LPCWSTR portName, int * index) {
+	int freeSlot = -1;
+
+	for (int i = 0; i < MAX_PORT_SESSIONS; i++) {
+		if (!sessions[i]) {
+			freeSlot = freeSlot < 0 ? i : freeSlot;
+		}
+		else if (wcscmp(sessions[i]->getComPortName(), portName) == 0) {
+			*index = i;
+			return sessions[i].get();
+		}
+	}
+	for (int i = 0; i < MAX_PORT_SESSIONS && freeSlot < 0; i++) {
+		if (!sessions[i]->isConnected() && i != activeSession) {
+			freeSlot = i;
+		}
+	}
+	if (freeSlot < 0) {
+		return NULL;
+	}
+	sessions[freeSlot].reset(new SerialCommController(displayService, portName, freeSlot,
+		multiplexer != NULL && multiplexer->isActive() ? multiplexer : NULL));
+	*index = freeSlot;
+	return sessions[freeSlot].get();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID openSession(LPCWSTR portName)
+--					LPCWSTR portName:	the port to connect
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function for a Connect menu item. The port is connected and shown, leaving any other open ports
+-- running; a port that is already connected is just shown.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::openSession(LPCWSTR portName) {
+	int index;
+	SerialCommController * session = getSession(portName, &index);
+
+	if (session == NULL) {
+		ErrorHandler::handleError(ERROR_SESSION_LIMIT);
+		return;
+	}
+	if (session->isConnected() || session->initializeConnection(portName)) {
+		showSession(index);
+		currentMode = CONNECT_MODE;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openSimulatedSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID openSimulatedSession(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Each Connect Simulated opens another loopback, named SIM1, SIM2 and so on; the lowest name not connected is used.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::openSimulatedSession() {
+	wchar_t portName[16];
+	int index;
+
+	for (int number = 1; number <= MAX_PORT_SESSIONS; number++) {
+		swprintf(portName, sizeof(portName) / sizeof(portName[0]), L"SIM%d", number);
+		SerialCommController * session = getSession(portName, &index);
+
+		if (session == NULL || !session->isConnected()) {
+			openSession(portName);
+			return;
+		}
+	}
+	ErrorHandler::handleError(ERROR_SESSION_LIMIT);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openReplaySession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID openReplaySession(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Asks for a capture file and opens it as a port, which plays back what was received at the captured timing. The
+-- session is named by the file's path, so replaying the same file again while it plays just shows it.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::openReplaySession() {
+	wchar_t path[MAX_PATH] = L"";
+	OPENFILENAMEW dialog = {};
+
+	dialog.lStructSize = sizeof(dialog);
+	dialog.hwndOwner = *displayService->getWindowHandle();
+	dialog.lpstrFilter = L"Captures (*.dspcap)\0*.dspcap\0";
+	dialog.lpstrFile = path;
+	dialog.nMaxFile = MAX_PATH;
+	dialog.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST | OFN_NOCHANGEDIR;
+	if (GetOpenFileNameW(&dialog)) {
+		openSession(path);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID closeSession(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Disconnects the port being shown and moves to the next one still connected, or back to command mode if there is
+-- none.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::closeSession() {
+	sessions[activeSession]->closePort();
+	nextSession();
+	if (!sessions[activeSession]->isConnected()) {
+		currentMode = COMMAND_MODE;
+		SetWindowText(*displayService->getWindowHandle(), WINDOW_NAME);
+		CheckMenuItem(GetMenu(*displayService->getWindowHandle()), IDM_Capture, MF_BYCOMMAND | MF_UNCHECKED);
+		CheckMenuItem(GetMenu(*displayService->getWindowHandle()), IDM_Bridge, MF_BYCOMMAND | MF_UNCHECKED);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	nextSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID nextSession(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Shows the next connected port after the current one, wrapping around. Nothing changes if no other is connected.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::nextSession() {
+	for (int step = 1; step < MAX_PORT_SESSIONS; step++) {
+		int index = (activeSession + step) % MAX_PORT_SESSIONS;
+
+		if (sessions[index] && sessions[index]->isConnected()) {
+			showSession(index);
+			return;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	showSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID showSession(int index)
+--					int index:	the session's slot
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Switches the window to the session's pane and names its port in the title bar. Capture to File is checked if the
+-- session is being captured, Serve on TCP if it is being served, and the telemetry shown, if any, switches to the
+-- session's.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::showSession(int index) {
+	std::wstring title = std::wstring(WINDOW_NAME) + TEXT(" - ") + sessions[index]->getComPortName();
+	HWND window = *displayService->getWindowHandle();
+
+	activeSession = index;
+	displayService->showPane(index);
+	if (isTelemetryShown) {
+		refreshTelemetry();
+	}
+	SetWindowText(window, title.c_str());
+	CheckMenuItem(GetMenu(window), IDM_Capture,
+		MF_BYCOMMAND | (sessions[index]->isCapturing() ? MF_CHECKED : MF_UNCHECKED));
+	CheckMenuItem(GetMenu(window), IDM_Bridge,
+		MF_BYCOMMAND | (sessions[index]->isServing() ? MF_CHECKED : MF_UNCHECKED));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toggleCapture
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID toggleCapture(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Starts recording the session shown to a capture file, or stops the recording already running. The menu item is
+-- checked while the session shown is being captured.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::toggleCapture() {
+	SerialCommController * session = sessions[activeSession].get();
+
+	if (session->isCapturing()) {
+		session->stopCapture();
+	}
+	else {
+		session->startCapture();
+	}
+	CheckMenuItem(GetMenu(*displayService->getWindowHandle()), IDM_Capture,
+		MF_BYCOMMAND | (session->isCapturing() ? MF_CHECKED : MF_UNCHECKED));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toggleBridge
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID toggleBridge(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Starts serving the session shown on a local TCP port, or stops serving it. The menu item is checked while the
+-- session shown is being served.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::toggleBridge() {
+	SerialCommController * session = sessions[activeSession].get();
+
+	if (session->isServing()) {
+		session->stopBridge();
+	}
+	else {
+		session->startBridge();
+	}
+	CheckMenuItem(GetMenu(*displayService->getWindowHandle()), IDM_Bridge,
+		MF_BYCOMMAND | (session->isServing() ? MF_CHECKED : MF_UNCHECKED));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeAll
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID closeAll(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before exiting. Every port is closed and every session released while the multiplexer and the
+-- DisplayService they use still exist.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::closeAll() {
+	for (std::unique_ptr<SerialCommController> & session : sessions) {
+		session.reset();
+	}
+	activeSession = 0;
+	currentMode = COMMAND_MODE;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID sendFile(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Asks for a file and sends it on the session shown with the protocol checked in the Transfer menu. The far end has
+-- to be receiving; a ZMODEM receiver such as rz is started by the request the sender opens with.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::sendFile() {
+	wchar_t path[MAX_PATH] = L"";
+	OPENFILENAMEW dialog = {};
+	SerialCommController * session = sessions[activeSession].get();
+
+	if (session == NULL || !session->isConnected() || session->isTransferring()) {
+		ErrorHandler::handleError(ERROR_TRANSFER_START);
+		return;
+	}
+	dialog.lStructSize = sizeof(dialog);
+	dialog.hwndOwner = *displayService->getWindowHandle();
+	dialog.lpstrFilter = L"All files (*.*)\0*.*\0";
+	dialog.lpstrFile = path;
+	dialog.nMaxFile = MAX_PATH;
+	dialog.Flags = OFN_FILEMUSTEXIST | OFN_PATHMUSTEXIST | OFN_NOCHANGEDIR;
+	if (GetOpenFileNameW(&dialog)) {
+		session->startTransfer(transferProtocol, path, true);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID receiveFile(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Waits on the session shown for the far end to send a file with the protocol checked in the Transfer menu. Files
+-- are written to the working directory under the name the sender gives; XMODEM gives none, so its file is named
+-- received.bin.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::receiveFile() {
+	SerialCommController * session = sessions[activeSession].get();
+
+	if (session == NULL || !session->isConnected()) {
+		ErrorHandler::handleError(ERROR_TRANSFER_START);
+		return;
+	}
+	session->startTransfer(transferProtocol, L"", false);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	selectProtocol
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID selectProtocol(UINT command)
+--					UINT command:	the Transfer menu item chosen, IDM_Protocol_Xmodem to IDM_Protocol_Zmodem
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Sets the protocol for later transfers and moves the menu's radio check to it. A transfer already running keeps
+-- its protocol.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::selectProtocol(UINT command) {
+	switch (command) {
+	case IDM_Protocol_Xmodem:
+		transferProtocol = TransferProtocol::Xmodem;
+		break;
+	case IDM_Protocol_Xmodem1k:
+		transferProtocol = TransferProtocol::Xmodem1k;
+		break;
+	case IDM_Protocol_Ymodem:
+		transferProtocol = TransferProtocol::Ymodem;
+		break;
+	default:
+		transferProtocol = TransferProtocol::Zmodem;
+		command = IDM_Protocol_Zmodem;
+		break;
+	}
+	CheckMenuRadioItem(GetMenu(*displayService->getWindowHandle()), IDM_Protocol_Xmodem, IDM_Protocol_Zmodem,
+		command, MF_BYCOMMAND);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toggleTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID toggleTelemetry(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Shows the link telemetry of the session shown in the status bar, or hides it if it is already shown. While it is
+-- shown a window timer refreshes it every TELEMETRY_REFRESH ms, and the menu item is checked.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::toggleTelemetry() {
+	HWND window = *displayService->getWindowHandle();
+
+	isTelemetryShown = !isTelemetryShown;
+	if (isTelemetryShown) {
+		refreshTelemetry();
+		SetTimer(window, TELEMETRY_TIMER, TELEMETRY_REFRESH, NULL);
+	}
+	else {
+		KillTimer(window, TELEMETRY_TIMER);
+		displayService->hideStatus();
+	}
+	CheckMenuItem(GetMenu(window), IDM_Telemetry_Show, MF_BYCOMMAND | (isTelemetryShown ? MF_CHECKED : MF_UNCHECKED));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	refreshTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID refreshTelemetry(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Puts the current telemetry of the session shown in the status bar. A session that has disconnected keeps showing
+-- the counters of its last connection.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::refreshTelemetry() {
+	char status[MESSAGE_BOX_MAX];
+	wchar_t text[MESSAGE_BOX_MAX];
+	SerialCommController * session = sessions[activeSession].get();
+
+	if (session == NULL) {
+		displayService->showStatus(TEXT("No port connected"));
+		return;
+	}
+	session->describeTelemetry(status, sizeof(status));
+	displayService->showStatus(utils::strToLPCWSTR(status, text, MESSAGE_BOX_MAX));
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	saveTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID saveTelemetry(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Asks for a file and writes the link telemetry of every connected session to it as one JSON object, with a "ports"
+-- array holding an object per port.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::saveTelemetry() {
+	wchar_t path[MAX_PATH] = L"telemetry.json";
+	OPENFILENAMEW dialog = {};
+	FILE * out;
+	const char * separator = "";
+
+	dialog.lStructSize = sizeof(dialog);
+	dialog.hwndOwner = *displayService->getWindowHandle();
+	dialog.lpstrFilter = L"JSON (*.json)\0*.json\0";
+	dialog.lpstrFile = path;
+	dialog.lpstrDefExt = L"json";
+	dialog.nMaxFile = MAX_PATH;
+	dialog.Flags = OFN_OVERWRITEPROMPT | OFN_PATHMUSTEXIST | OFN_NOCHANGEDIR;
+	if (!GetSaveFileNameW(&dialog)) {
+		return;
+	}
+	if ((out = _wfopen(path, L"w")) == NULL) {
+		ErrorHandler::handleError(ERROR_TELEMETRY_SAVE);
+		return;
+	}
+	fputs("{\"ports\": [", out);
+	for (std::unique_ptr<SerialCommController> & session : sessions) {
+		if (session && session->isConnected()) {
+			fputs(separator, out);
+			session->writeTelemetry(out);
+			separator = ",";
+		}
+	}
+	fputs("]}\n", out);
+	if (fclose(out) != 0) {
+		ErrorHandler::handleError(ERROR_TELEMETRY_SAVE);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	updatePortMenus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID updatePortMenus(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function on WM_PORTS_CHANGED. listedPorts is taken from the PortEnumerator's cache, which is only read,
+-- and the Settings and Connect menus are rebuilt from it. Past MAX_LISTED_PORTS, the rest of the ports are left out.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::updatePortMenus() {
+	HMENU menu = GetMenu(*displayService->getWindowHandle());
+	wchar_t name[MESSAGE_BOX_MAX];
+
+	listedPorts.clear();
+	for (const std::string & port : portEnumerator->getPorts()) {
+		if (listedPorts.size() == MAX_LISTED_PORTS) {
+			break;
+		}
+		listedPorts.push_back(utils::strToLPCWSTR(port.c_str(), name, MESSAGE_BOX_MAX));
+	}
+	fillPortMenu(GetSubMenu(menu, SETTINGS_MENU), IDM_Settings_Port);
+	fillPortMenu(GetSubMenu(menu, CONNECT_MENU), IDM_Connect_Port);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	fillPortMenu
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID fillPortMenu(HMENU popup, UINT firstCommand)
+--					HMENU popup:		the Settings or Connect menu
+--					UINT firstCommand:	the command of the menu's first port, IDM_Settings_Port or IDM_Connect_Port
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The ports put in last time, or the placeholder, are taken out, and listedPorts is put at the top of the menu. The
+-- other items stay where they are. With no ports listed, a grayed placeholder says whether the first scan is still
+-- running.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::fillPortMenu(HMENU popup, UINT firstCommand) {
+	for (int position = GetMenuItemCount(popup) - 1; position >= 0; position--) {
+		UINT command = GetMenuItemID(popup, position);
+
+		if (command == IDM_Ports_None || (command >= firstCommand && command < firstCommand + MAX_LISTED_PORTS)) {
+			DeleteMenu(popup, position, MF_BYPOSITION);
+		}
+	}
+	if (listedPorts.empty()) {
+		InsertMenuW(popup, 0, MF_BYPOSITION | MF_STRING | MF_GRAYED, IDM_Ports_None,
+			portEnumerator->isReady() ? L"No ports found" : L"Searching for ports...");
+		return;
+	}
+	for (UINT index = 0; index < listedPorts.size(); index++) {
+		InsertMenuW(popup, index, MF_BYPOSITION | MF_STRING, firstCommand + index, listedPorts[index].c_str());
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getListedPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	LPCWSTR getListedPort(UINT command, UINT firstCommand)
+--					UINT command:		a menu command
+--					UINT firstCommand:	the command of the menu's first port, IDM_Settings_Port or IDM_Connect_Port
+--
+-- RETURNS:		LPCWSTR - the port the command was given for, or NULL if it is not one of that menu's ports
+----------------------------------------------------------------------------------------------------------------------*/
+LPCWSTR SessionService::getListedPort(UINT command, UINT firstCommand) {
+	if (command < firstCommand || command - firstCommand >= listedPorts.size()) {
+		return NULL;
+	}
+	return listedPorts[command - firstCommand].c_str();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	handleDeviceChange
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID handleDeviceChange(WPARAM event, LPARAM data)
+--					WPARAM event:	the WM_DEVICECHANGE event, such as DBT_DEVICEARRIVAL
+--					LPARAM data:	the DEV_BROADCAST_HDR of the device, or 0
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Windows broadcasts a port arriving or being removed to every top-level window. The port is added to or removed
+-- from the PortEnumerator's cache, which posts WM_PORTS_CHANGED if the list changed. Parallel ports are announced
+-- the same way and are ignored. A session on a port that is removed stays open until its I/O fails or it is closed.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::handleDeviceChange(WPARAM event, LPARAM data) {
+	const DEV_BROADCAST_HDR * header = (const DEV_BROADCAST_HDR *)data;
+	char name[MAX_PATH];
+
+	if ((event != DBT_DEVICEARRIVAL && event != DBT_DEVICEREMOVECOMPLETE) || header == NULL ||
+		header->dbch_devicetype != DBT_DEVTYP_PORT || portEnumerator == NULL) {
+		return;
+	}
+	const DEV_BROADCAST_PORT * port = (const DEV_BROADCAST_PORT *)header;
+
+	if (wcsncmp(port->dbcp_name, L"LPT", 3) == 0 ||
+		WideCharToMultiByte(CP_UTF8, 0, port->dbcp_name, -1, name, sizeof(name), NULL, NULL) <= 1) {
+		return;
+	}
+	if (event == DBT_DEVICEARRIVAL) {
+		portEnumerator->addPort(name);
+	}
+	else {
+		portEnumerator->removePort(name);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	configurePort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID configurePort(LPCWSTR portName)
+--					LPCWSTR portName:	a port from the Settings menu
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Shows the port's settings dialog. The port gets a session, so the settings chosen are kept for its next connect.
+----------------------------------------------------------------------------------------------------------------------*/
+VOID SessionService::configurePort(LPCWSTR portName) {
+	int index;
+	SerialCommController * session = getSession(portName, &index);
+
+	if (session != NULL) {
+		session->setCommConfig(portName);
+	}
+}
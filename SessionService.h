@@ -1,7 +1,13 @@
 #pragma once
 
 #include <windows.h>
+#include <memory>
+#include <string>
+#include <vector>
 #include "modes.h"
+#include "FileTransfer.h"
+#include "PortEnumerator.h"
+#include "PortMultiplexer.h"
 #include "SerialCommController.h"
 
 /*------------------------------------------------------------------------------------------------------------------
@@ -11,16 +17,46 @@
 -- PROGRAM:			DumbSerialPortEmulator
 --
 -- FUNCTIONS:		
---					VOID createReadThread(void)
 --					VOID handlePortConfig(LPCWSTR portName)
 --					VOID handleCommandeMode(UINT Message, WPARAM wParam)
 --					VOID handleConnectMode(UINT Message, WPARAM wParam)
---					VOID handleProcess(UINT Message, WPARAM wParam);
+--					VOID handleProcess(UINT Message, WPARAM wParam, LPARAM lParam);
+--					VOID pasteClipboard(void)
+--					SerialCommController * getSession(LPCWSTR portName, int * index)
+--					VOID openSession(LPCWSTR portName)
+--					VOID openSimulatedSession(void)
+--					VOID openReplaySession(void)
+--					VOID closeSession(void)
+--					VOID nextSession(void)
+--					VOID showSession(int index)
+--					VOID toggleCapture(void)
+--					VOID toggleBridge(void)
+--					VOID sendFile(void)
+--					VOID receiveFile(void)
+--					VOID selectProtocol(UINT command)
+--					VOID toggleTelemetry(void)
+--					VOID refreshTelemetry(void)
+--					VOID saveTelemetry(void)
+--					VOID updatePortMenus(void)
+--					VOID fillPortMenu(HMENU popup, UINT firstCommand)
+--					LPCWSTR getListedPort(UINT command, UINT firstCommand)
+--					VOID handleDeviceChange(WPARAM event, LPARAM data)
+--					VOID configurePort(LPCWSTR portName)
+--					VOID closeAll(void)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - Routes paint, size and scroll messages to DisplayService
+--					Oct 17, 2026 - Shift+Insert pastes the clipboard in connect mode
+--					Oct 17, 2026 - Read thread creation moved into SerialPipeline
+--					Oct 17, 2026 - Keeps up to MAX_PORT_SESSIONS ports open at once, one shown at a time
+--					Oct 17, 2026 - Capture to File records the session shown
+--					Oct 17, 2026 - Replay Capture plays a capture file back as a port
+--					Oct 17, 2026 - Transfer menu sends and receives files on the session shown
+--					Oct 17, 2026 - View menu shows link telemetry live and saves it as JSON
+--					Oct 17, 2026 - Settings and Connect list the ports a PortEnumerator finds instead of COM1 and COM2
+--					Oct 17, 2026 - Serve on TCP shares the session shown with local TCP clients
 --
 -- DESIGNER:		Henry Ho
 --
@@ -29,19 +65,71 @@
 -- NOTES:
 -- The service class handles messages from the system. All actions are mapped to the menu items defined in WINMENU
 -- resource file.
+--
+-- Each port gets its own SerialCommController, kept in a fixed slot whose index is also its DisplayService pane and
+-- the wParam of its WM_RX_DATA. A controller stays in its slot after it disconnects so the port's settings are kept
+-- for the next connect. Every open port receives through the one PortMultiplexer passed in; keystrokes go to the
+-- session being shown.
+--
+-- The Transfer menu's protocol applies to every session. A session stays in connect mode while it transfers, but
+-- keystrokes are not sent and ESC cancels the transfer instead of disconnecting.
+--
+-- Link Telemetry shows the session shown's counters in the status bar, refreshed by a window timer. Save Telemetry
+-- writes every connected session's counters to one JSON file.
+--
+-- The ports at the top of the Settings and Connect menus come from the PortEnumerator's cache. They are filled in
+-- when WM_PORTS_CHANGED arrives, so the window is up before the ports have been listed, and redone whenever a port
+-- arrives or leaves. A command names its port by its place in listedPorts, the list the menus were last built from.
 ----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr int MAX_PORT_SESSIONS = 16;
+constexpr UINT_PTR TELEMETRY_TIMER = 1;
+constexpr UINT TELEMETRY_REFRESH = 500;		// ms between status bar updates
+constexpr UINT MAX_LISTED_PORTS = 64;		// ports shown in each port menu; command IDs are reserved for this many
+constexpr int SETTINGS_MENU = 0;			// positions of the port menus in the menu bar
+constexpr int CONNECT_MENU = 1;
+
 class SessionService {
 private:
-	SerialCommController * commController;
-	VOID createReadThread();
+	std::unique_ptr<SerialCommController> sessions[MAX_PORT_SESSIONS];
+	int activeSession = 0;
+	PortMultiplexer * multiplexer = NULL;
+	PortEnumerator * portEnumerator = NULL;
+	std::vector<std::wstring> listedPorts;
+	DisplayService * displayService = NULL;
 	INT currentMode;
+	TransferProtocol transferProtocol = TransferProtocol::Zmodem;
+	BOOL isTelemetryShown = FALSE;
 
 	VOID handleCommandMode(UINT Message, WPARAM wParam);
 	VOID handleConnectMode(UINT Message, WPARAM wParam);
+	VOID pasteClipboard();
+	SerialCommController * getSession(LPCWSTR portName, int * index);
+	VOID openSession(LPCWSTR portName);
+	VOID openSimulatedSession();
+	VOID openReplaySession();
+	VOID closeSession();
+	VOID nextSession();
+	VOID showSession(int index);
+	VOID toggleCapture();
+	VOID toggleBridge();
+	VOID sendFile();
+	VOID receiveFile();
+	VOID selectProtocol(UINT command);
+	VOID toggleTelemetry();
+	VOID refreshTelemetry();
+	VOID saveTelemetry();
+	VOID updatePortMenus();
+	VOID fillPortMenu(HMENU popup, UINT firstCommand);
+	LPCWSTR getListedPort(UINT command, UINT firstCommand);
+	VOID handleDeviceChange(WPARAM event, LPARAM data);
+	VOID configurePort(LPCWSTR portName);
 public:
 	SessionService() {};
-	SessionService(SerialCommController * controller) : commController(controller) {
+	SessionService(PortMultiplexer * sharedReader, PortEnumerator * ports, DisplayService * display) :
+		multiplexer(sharedReader), portEnumerator(ports), displayService(display) {
 		currentMode = COMMAND_MODE;
 	};
-	VOID handleProcess(UINT Message, WPARAM wParam);
+	VOID handleProcess(UINT Message, WPARAM wParam, LPARAM lParam);
+	VOID closeAll();
 };
\ No newline at end of file
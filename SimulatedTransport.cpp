@@ -0,0 +1,819 @@
+#include <string.h>
+#include "LinkTelemetry.h"
+#include "SimulatedTransport.h"
+#include "error_codes.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		SimulatedTransport.cpp -	An in-process serial port with line timing, a finite FIFO and errors.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					void connect(SimulatedTransport * other)
+--					void feed(const char * data, size_t length)
+--					void setArrivalNotify(std::function<void()> notify)
+--					bool getNextArrival(std::chrono::steady_clock::time_point * when) const
+--					void advance(Clock::time_point now)
+--					void deliver(char byte)
+--					void seedRandom(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Arrival notify and getNextArrival for the PortMultiplexer
+--					Oct 17, 2026 - Flow control holds between the two ends
+--					Oct 17, 2026 - Line errors and FIFO depth are recorded in a LinkTelemetry
+--					Oct 17, 2026 - The seed is scrambled before the first error check
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Everything is guarded by one lock per port. A write never holds its own lock while feeding the peer, so two
+-- connected ports writing to each other cannot deadlock. For the same reason the hold a port puts on its peer is an
+-- atomic the peer reads under its own lock; releasing it takes the peer's lock only to wake its writer.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	SimulatedTransport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	SimulatedTransport(void)
+--
+-- NOTES:
+-- The port starts at the PortSettings defaults, 9600 8N1, with no errors injected.
+----------------------------------------------------------------------------------------------------------------------*/
+SimulatedTransport::SimulatedTransport() {
+	updateByteTime();
+	fifo.resize(simulation.fifoSize);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	~SimulatedTransport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	~SimulatedTransport(void)
+--
+-- NOTES:
+-- A connected peer is turned back into a loopback so it never writes to a destroyed port.
+----------------------------------------------------------------------------------------------------------------------*/
+SimulatedTransport::~SimulatedTransport() {
+	close();
+	if (peer != this) {
+		std::lock_guard<std::mutex> guard(peer->lock);
+		peer->peer = peer;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Clears any hold on the peer
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int open(const std::string & name)
+--					const std::string & name:	name of the port, kept for reference
+--
+-- RETURNS:		int - always 0
+--
+-- NOTES:
+-- Opening empties the line and the FIFO, clears the statistics and any hold on the peer, and restarts the error
+-- generator from its seed.
+----------------------------------------------------------------------------------------------------------------------*/
+int SimulatedTransport::open(const std::string & name) {
+	std::lock_guard<std::mutex> guard(lock);
+	Clock::time_point now = Clock::now();
+
+	portName = name;
+	line.clear();
+	lineHead = 0;
+	fifoHead = 0;
+	fifoCount = 0;
+	nextArrival = now;
+	transmitDone = now;
+	stats = SimulationStats();
+	seedRandom();
+	isCancelled = false;
+	isHoldingPeer.store(false);
+	isPortOpen = true;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	configure
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Flow control settings are honoured
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int configure(const PortSettings & settings)
+--					const PortSettings & settings:	line settings that set the frame time
+--
+-- RETURNS:		int - 0 on success, ERROR_PORT_CONFIG if the baud rate or frame format is not usable
+--
+-- NOTES:
+-- Bytes already on the line keep travelling at the new rate.
+----------------------------------------------------------------------------------------------------------------------*/
+int SimulatedTransport::configure(const PortSettings & settings) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	if (settings.baudRate == 0 || settings.dataBits < 5 || settings.dataBits > 8 ||
+		settings.stopBits < 1 || settings.stopBits > 2) {
+		return ERROR_PORT_CONFIG;
+	}
+	portSettings = settings;
+	updateByteTime();
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Bytes fed to a closed port are dropped, as they would be by a port nobody has open.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::close() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	isPortOpen = false;
+	arrived.notify_all();
+	writeDone.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isOpen
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isOpen(void) const
+--
+-- RETURNS:		bool - true between open and close
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::isOpen() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return isPortOpen;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	read
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Records the FIFO's depth as the input queue
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					char * buffer:		the buffer that receives the chunk
+--					size_t capacity:	size of the buffer in bytes
+--					uint32_t timeout:	ms to wait for data
+--					size_t * bytesRead:	set to the number of bytes placed in the buffer, 0 on timeout
+--
+-- RETURNS:		bool - false if the port is closed or was cancelled
+--
+-- NOTES:
+-- Like a driver signalling EV_RXCHAR, the reader is woken when the first byte lands in an empty FIFO and takes
+-- everything the FIFO holds at that moment.
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) {
+	std::unique_lock<std::mutex> guard(lock);
+	Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout);
+	Clock::time_point now;
+	size_t count, first;
+
+	*bytesRead = 0;
+	for (;;) {
+		if (!isPortOpen || isCancelled) {
+			return false;
+		}
+		now = Clock::now();
+		advance(now);
+
+		if (fifoCount > 0) {
+			if (telemetry != nullptr) {
+				telemetry->noteInputQueue(fifoCount);
+			}
+			count = fifoCount < capacity ? fifoCount : capacity;
+			first = fifo.size() - fifoHead < count ? fifo.size() - fifoHead : count;
+			memcpy(buffer, &fifo[fifoHead], first);
+			memcpy(buffer + first, &fifo[0], count - first);
+			fifoHead = (fifoHead + count) % fifo.size();
+			fifoCount -= count;
+			stats.bytesRead += count;
+			*bytesRead = count;
+			return true;
+		}
+		if (now >= deadline) {
+			return true;
+		}
+		arrived.wait_until(guard, lineHead < line.size() && nextArrival < deadline ? nextArrival : deadline);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	write
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Waits while flow control has the line held
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool write(const char * data, size_t length)
+--					const char * data:	the bytes to write
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		bool - false if the port is closed or was cancelled
+--
+-- NOTES:
+-- The bytes are put on the peer's line at once and the call returns when the last of them would have left the
+-- transmitter, so a caller writing back to back keeps the line exactly full. With flow control set, nothing is put
+-- on the line while the peer holds it.
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::write(const char * data, size_t length) {
+	SimulatedTransport * target;
+	Clock::time_point done;
+
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		Clock::time_point now;
+
+		while (isPortOpen && !isCancelled && (portSettings.rtsCts || portSettings.xonXoff) &&
+			peer->isHoldingPeer.load()) {
+			writeDone.wait_for(guard, std::chrono::milliseconds(TX_WAIT_TIMEOUT));
+		}
+		if (!isPortOpen || isCancelled) {
+			return false;
+		}
+		now = Clock::now();
+		transmitDone = (transmitDone > now ? transmitDone : now) + byteTime * length;
+		done = transmitDone;
+		stats.bytesWritten += length;
+		target = peer;
+	}
+
+	target->feed(data, length);
+
+	std::unique_lock<std::mutex> guard(lock);
+	while (isPortOpen && !isCancelled && Clock::now() < done) {
+		writeDone.wait_until(guard, done);
+	}
+	return isPortOpen && !isCancelled;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cancel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void cancel(void)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::cancel() {
+	std::lock_guard<std::mutex> guard(lock);
+
+	isCancelled = true;
+	arrived.notify_all();
+	writeDone.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getFlowStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getFlowStatus(FlowStatus * status)
+--					FlowStatus * status:	set to the bytes still leaving the transmitter and any hold by the peer
+--
+-- RETURNS:		bool - false if the port is closed
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::getFlowStatus(FlowStatus * status) {
+	std::lock_guard<std::mutex> guard(lock);
+	Clock::time_point now = Clock::now();
+	bool isHeld;
+
+	if (!isPortOpen) {
+		return false;
+	}
+	isHeld = peer->isHoldingPeer.load();
+	status->outputQueued = transmitDone > now ? (size_t)((transmitDone - now) / byteTime) : 0;
+	status->isCtsHeld = portSettings.rtsCts && isHeld;
+	status->isXoffHeld = portSettings.xonXoff && isHeld;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setReceivePaused
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool setReceivePaused(bool paused)
+--					bool paused:	true to hold the peer's writes, false to release them
+--
+-- RETURNS:		bool - false if neither kind of flow control is set
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::setReceivePaused(bool paused) {
+	SimulatedTransport * target;
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		if (!portSettings.rtsCts && !portSettings.xonXoff) {
+			return false;
+		}
+		isHoldingPeer.store(paused);
+		target = peer;
+	}
+	if (!paused) {
+		std::lock_guard<std::mutex> guard(target->lock);
+		target->writeDone.notify_all();
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setTelemetry
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setTelemetry(LinkTelemetry * telemetry)
+--					LinkTelemetry * telemetry:	where to record line errors and FIFO depth, or nullptr to stop
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::setTelemetry(LinkTelemetry * portTelemetry) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	telemetry = portTelemetry;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	connect
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void connect(SimulatedTransport * other)
+--					SimulatedTransport * other:	the port at the far end of the cable
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before either port is used. Each port's writes then arrive at the other, like a null-modem
+-- cable. Both ports should use the same settings, as real ones must.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::connect(SimulatedTransport * other) {
+	if (other == this) {
+		std::lock_guard<std::mutex> guard(lock);
+		peer = this;
+		return;
+	}
+	std::lock(lock, other->lock);
+	std::lock_guard<std::mutex> ownGuard(lock, std::adopt_lock);
+	std::lock_guard<std::mutex> otherGuard(other->lock, std::adopt_lock);
+	peer = other;
+	other->peer = this;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	feed
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Calls the arrival notify when the line was idle
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void feed(const char * data, size_t length)
+--					const char * data:	bytes the far end sends
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to play the far end of the line. The bytes queue behind anything still travelling; an idle
+-- line starts the first of them now.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::feed(const char * data, size_t length) {
+	std::lock_guard<std::mutex> guard(lock);
+	Clock::time_point now = Clock::now();
+
+	if (!isPortOpen || length == 0) {
+		return;
+	}
+	advance(now);
+	if (lineHead == line.size()) {
+		line.clear();
+		lineHead = 0;
+		nextArrival = now + byteTime;
+		if (arrivalNotify) {
+			arrivalNotify();
+		}
+	}
+	else if (lineHead >= line.size() / 2) {
+		line.erase(line.begin(), line.begin() + lineHead);
+		lineHead = 0;
+	}
+	line.insert(line.end(), data, data + length);
+	stats.bytesFed += length;
+	arrived.notify_all();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setArrivalNotify
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setArrivalNotify(std::function<void()> notify)
+--					std::function<void()> notify:	called when bytes start on an idle line; nullptr for none
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- notify runs under the port's lock, on whichever thread fed the bytes, so it must only signal. Once this returns
+-- with nullptr the old notify is not running and will not be called again.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::setArrivalNotify(std::function<void()> notify) {
+	std::lock_guard<std::mutex> guard(lock);
+	arrivalNotify = notify;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getNextArrival
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getNextArrival(std::chrono::steady_clock::time_point * when) const
+--					std::chrono::steady_clock::time_point * when:	set to when a read will next find data
+--
+-- RETURNS:		bool - false if the FIFO is empty and nothing is on the line
+--
+-- NOTES:
+-- If the FIFO already holds bytes, when is now.
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::getNextArrival(std::chrono::steady_clock::time_point * when) const {
+	std::lock_guard<std::mutex> guard(lock);
+
+	if (fifoCount > 0) {
+		*when = Clock::now();
+		return true;
+	}
+	if (lineHead < line.size()) {
+		*when = nextArrival;
+		return true;
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setSimulation
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setSimulation(const SimulationSettings & settings)
+--					const SimulationSettings & settings:	FIFO size, error rates and seed
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before open. Changing the FIFO size empties it.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::setSimulation(const SimulationSettings & settings) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	simulation = settings;
+	if (simulation.fifoSize < 1) {
+		simulation.fifoSize = 1;
+	}
+	fifo.assign(simulation.fifoSize, 0);
+	fifoHead = 0;
+	fifoCount = 0;
+	seedRandom();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	SimulationStats getStats(void) const
+--
+-- RETURNS:		SimulationStats - a copy taken under the lock
+----------------------------------------------------------------------------------------------------------------------*/
+SimulationStats SimulatedTransport::getStats() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return stats;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getByteTime
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double getByteTime(void) const
+--
+-- RETURNS:		double - seconds one frame takes on the line
+----------------------------------------------------------------------------------------------------------------------*/
+double SimulatedTransport::getByteTime() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return std::chrono::duration<double>(byteTime).count();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isSimulatedPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isSimulatedPort(const std::string & name)
+--					const std::string & name:	a port name
+--
+-- RETURNS:		bool - true if the name should open a SimulatedTransport rather than a device
+----------------------------------------------------------------------------------------------------------------------*/
+bool SimulatedTransport::isSimulatedPort(const std::string & name) {
+	return name.compare(0, strlen(SIMULATED_PORT_PREFIX), SIMULATED_PORT_PREFIX) == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	advance
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void advance(Clock::time_point now)
+--					Clock::time_point now:	the current time
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function with the lock held. Every byte whose frame has finished by now is delivered in order.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::advance(Clock::time_point now) {
+	while (lineHead < line.size() && nextArrival <= now) {
+		deliver(line[lineHead++]);
+		nextArrival += byteTime;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	deliver
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Counts each error in the LinkTelemetry
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void deliver(char byte)
+--					char byte:	a byte that has just finished its frame
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function with the lock held. The error generator is only drawn from when a rate is set, so a clean
+-- run does not pay for it.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::deliver(char byte) {
+	stats.bytesArrived++;
+
+	if (simulation.overrunErrorRate > 0 && nextRandom() < simulation.overrunErrorRate) {
+		stats.injectedOverruns++;
+		if (telemetry != nullptr) {
+			telemetry->countLineError(LineError::Overrun);
+		}
+		return;
+	}
+	if (simulation.framingErrorRate > 0 && nextRandom() < simulation.framingErrorRate) {
+		// The stop bit was not where it should be; what the UART latched is noise
+		byte = (char)(randomState >> 24);
+		stats.framingErrors++;
+		if (telemetry != nullptr) {
+			telemetry->countLineError(LineError::Framing);
+		}
+	}
+	if (simulation.parityErrorRate > 0 && nextRandom() < simulation.parityErrorRate) {
+		byte ^= (char)(1 << (randomState % portSettings.dataBits));
+		stats.parityErrors++;
+		if (telemetry != nullptr) {
+			telemetry->countLineError(LineError::Parity);
+		}
+	}
+
+	if (fifoCount == fifo.size()) {
+		stats.fifoOverruns++;
+		if (telemetry != nullptr) {
+			telemetry->countLineError(LineError::InputOverflow);
+		}
+		return;
+	}
+	fifo[(fifoHead + fifoCount) % fifo.size()] = byte;
+	fifoCount++;
+	if (fifoCount > stats.fifoHighWater) {
+		stats.fifoHighWater = fifoCount;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	seedRandom
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void seedRandom(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- xorshift started straight from a small seed gives small values first; seed 1 gives about 6.3e-5, so every error
+-- check at a higher rate fired on the first byte. One splitmix32 step spreads the seed's bits first.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::seedRandom() {
+	uint32_t z = simulation.seed + 0x9E3779B9u;
+
+	z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+	z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+	z ^= z >> 16;
+	randomState = z != 0 ? z : 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	nextRandom
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	double nextRandom(void)
+--
+-- RETURNS:		double - the next value of a xorshift generator, in [0, 1)
+----------------------------------------------------------------------------------------------------------------------*/
+double SimulatedTransport::nextRandom() {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState / 4294967296.0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	updateByteTime
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void updateByteTime(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- One frame is a start bit, the data bits, the parity bit if any, and the stop bits.
+----------------------------------------------------------------------------------------------------------------------*/
+void SimulatedTransport::updateByteTime() {
+	int frameBits = 1 + portSettings.dataBits + (portSettings.parity != ParityMode::None ? 1 : 0) +
+		portSettings.stopBits;
+
+	byteTime = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>((double)frameBits / portSettings.baudRate));
+}
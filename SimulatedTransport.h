@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		SimulatedTransport.h -	An in-process serial port with line timing, a finite FIFO and errors.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					void connect(SimulatedTransport * other)
+--					void feed(const char * data, size_t length)
+--					void setArrivalNotify(std::function<void()> notify)
+--					bool getNextArrival(std::chrono::steady_clock::time_point * when) const
+--					void setSimulation(const SimulationSettings & settings)
+--					SimulationStats getStats(void) const
+--					double getByteTime(void) const
+--					bool isSimulatedPort(const std::string & portName)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Reports when its next byte is due so a PortMultiplexer can time its reads
+--					Oct 17, 2026 - Models RTS/CTS and XON/XOFF holds between the two ends
+--					Oct 17, 2026 - Reports its line errors and FIFO depth to a LinkTelemetry
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Bytes fed to the port, by the test or by the connected peer's write, queue on the line and arrive one frame time
+-- apart: start bit, data bits, parity bit and stop bits at the configured baud rate. An arriving byte goes into the
+-- receive FIFO, or is lost as an overrun if the reader has let the FIFO fill. Arrivals are worked out when the port
+-- is next read or fed rather than by a timer thread, which gives the same result because the FIFO only empties when
+-- it is read. Framing, parity and overrun errors are injected per byte from a seeded generator, so a run with the
+-- same seed and the same read pattern loses and corrupts the same bytes. Writes take the frame time of the bytes
+-- written. A port is its own peer until connect joins it to another, like a loopback plug.
+--
+-- With flow control set, a port paused by setReceivePaused holds its peer: the peer's writes wait before putting
+-- anything on the line, and its getFlowStatus reports the hold as CTS or XOFF. Bytes already on the line keep
+-- coming, as they would from a UART whose transmit FIFO was loaded before the hold.
+--
+-- With a LinkTelemetry set, each injected error is counted as the driver would report it: an injected overrun as
+-- an overrun, a full FIFO as an input overflow. The FIFO's depth at each read is its input queue.
+--
+-- A port read by a PortMultiplexer is polled rather than waited on: getNextArrival says when a read will next find
+-- data, and the arrival notify is called, under the lock, when fed bytes start on an idle line.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr const char * SIMULATED_PORT_PREFIX = "SIM";	// port names that open a SimulatedTransport
+constexpr size_t SIMULATED_FIFO_SIZE = 16384;			// receive FIFO, the same as the driver queue on Windows
+
+struct SimulationSettings {
+	size_t fifoSize = SIMULATED_FIFO_SIZE;
+	double framingErrorRate = 0;	// chance per byte that it arrives with a framing error and a garbled value
+	double parityErrorRate = 0;		// chance per byte that one bit flips, which parity catches
+	double overrunErrorRate = 0;	// chance per byte that the UART loses it even though the FIFO has room
+	uint32_t seed = 1;
+};
+
+struct SimulationStats {
+	uint64_t bytesFed = 0;			// bytes put on the line toward this port
+	uint64_t bytesArrived = 0;		// bytes that finished their frame time
+	uint64_t bytesRead = 0;			// bytes handed to the reader
+	uint64_t bytesWritten = 0;		// bytes this port sent to its peer
+	uint64_t fifoOverruns = 0;		// bytes lost because the FIFO was full
+	uint64_t injectedOverruns = 0;
+	uint64_t framingErrors = 0;
+	uint64_t parityErrors = 0;
+	size_t fifoHighWater = 0;
+};
+
+class SimulatedTransport : public SerialTransport {
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	mutable std::mutex lock;
+	std::condition_variable arrived;
+	std::condition_variable writeDone;
+	bool isPortOpen = false;
+	bool isCancelled = false;
+	std::atomic<bool> isHoldingPeer{ false };	// read by the peer's writer without this port's lock
+	std::string portName;
+	SimulatedTransport * peer = this;
+
+	PortSettings portSettings;
+	SimulationSettings simulation;
+	Clock::duration byteTime;
+	uint32_t randomState = 1;
+
+	std::vector<char> line;			// fed bytes still travelling
+	size_t lineHead = 0;
+	Clock::time_point nextArrival;
+	std::vector<char> fifo;
+	size_t fifoHead = 0;
+	size_t fifoCount = 0;
+	Clock::time_point transmitDone;
+	SimulationStats stats;
+	std::function<void()> arrivalNotify;
+	LinkTelemetry * telemetry = nullptr;
+
+	void advance(Clock::time_point now);
+	void deliver(char byte);
+	void seedRandom();
+	double nextRandom();
+	void updateByteTime();
+public:
+	SimulatedTransport();
+	~SimulatedTransport();
+	SimulatedTransport(const SimulatedTransport &) = delete;
+	SimulatedTransport & operator=(const SimulatedTransport &) = delete;
+
+	int open(const std::string & name) override;
+	int configure(const PortSettings & settings) override;
+	void close() override;
+	bool isOpen() const override;
+	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) override;
+	bool write(const char * data, size_t length) override;
+	void cancel() override;
+	bool getFlowStatus(FlowStatus * status) override;
+	bool setReceivePaused(bool paused) override;
+	void setTelemetry(LinkTelemetry * portTelemetry) override;
+
+	void connect(SimulatedTransport * other);
+	void feed(const char * data, size_t length);
+	void setArrivalNotify(std::function<void()> notify);
+	bool getNextArrival(std::chrono::steady_clock::time_point * when) const;
+	void setSimulation(const SimulationSettings & settings);
+	SimulationStats getStats() const;
+	double getByteTime() const;
+
+	static bool isSimulatedPort(const std::string & name);
+};
@@ -0,0 +1,638 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <string.h>
+#include <system_error>
+#include "TcpBridge.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		TcpBridge.cpp -	Serves a port's received data to any number of local TCP clients.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const BridgeSettings & bridgeSettings, SendFunction send)
+--					void close(void)
+--					void publish(const char * data, size_t length)
+--					BridgeStats getStats(void) const
+--					void run(void)
+--					void acceptClients(void)
+--					bool receiveFrom(Client * client)
+--					bool sendTo(Client * client)
+--					bool checkLag(Client * client)
+--					void dropClient(size_t index)
+--					void wake(void)
+--					void closeSocket(intptr_t socket)
+--					bool setNonBlocking(intptr_t socket)
+--					bool isWouldBlock(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The bridge thread waits in poll, or WSAPoll on Windows, on a wake socket, the listener and every client. The wake
+-- socket is a UDP socket on the loopback connected to itself, so publish wakes the thread with a one byte send on
+-- either platform. The thread clears the pending flag before it goes over the clients, so a chunk published while it
+-- does is announced by a fresh wake rather than missed.
+--
+-- Every client is sent at most BRIDGE_SEND_BUDGET bytes a pass. One that still has more goes round again without
+-- waiting, so a fast client on a busy port cannot keep the thread from the rest.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t BRIDGE_SEND_BUDGET = 256 * 1024;
+
+#ifdef _WIN32
+typedef WSAPOLLFD PollEntry;
+typedef int SocketLength;
+constexpr int SEND_FLAGS = 0;
+#define pollSockets WSAPoll
+#else
+typedef pollfd PollEntry;
+typedef socklen_t SocketLength;
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;	// a client gone away is an error, not a SIGPIPE
+#define pollSockets poll
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	closeSocket
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void closeSocket(intptr_t socket)
+--					intptr_t socket:	the socket to close; -1 is ignored
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+static void closeSocket(intptr_t socket) {
+	if (socket != -1) {
+#ifdef _WIN32
+		closesocket((SOCKET)socket);
+#else
+		::close((int)socket);
+#endif
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setNonBlocking
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool setNonBlocking(intptr_t socket)
+--					intptr_t socket:	the socket to change
+--
+-- RETURNS:		bool - false if the mode could not be set
+----------------------------------------------------------------------------------------------------------------------*/
+static bool setNonBlocking(intptr_t socket) {
+#ifdef _WIN32
+	u_long isNonBlocking = 1;
+
+	return ioctlsocket((SOCKET)socket, FIONBIO, &isNonBlocking) == 0;
+#else
+	int flags = fcntl((int)socket, F_GETFL);
+
+	return flags != -1 && fcntl((int)socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	isWouldBlock
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool isWouldBlock(void)
+--
+-- RETURNS:		bool - true if the last socket call failed only because it would have had to wait
+----------------------------------------------------------------------------------------------------------------------*/
+static bool isWouldBlock() {
+#ifdef _WIN32
+	return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+	return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool open(const BridgeSettings & bridgeSettings, SendFunction send)
+--					const BridgeSettings & bridgeSettings:	where to listen and how to treat a lagging client
+--					SendFunction send:						takes what clients send, on the bridge thread
+--
+-- RETURNS:		bool - false if already open, or the port could not be bound or the thread started
+--
+-- NOTES:
+-- Call this function to start serving. Only connections from this machine can reach the listener.
+----------------------------------------------------------------------------------------------------------------------*/
+bool TcpBridge::open(const BridgeSettings & bridgeSettings, SendFunction send) {
+	sockaddr_in address;
+	SocketLength addressLength = sizeof(address);
+
+	if (isOpen.load()) {
+		return false;
+	}
+#ifdef _WIN32
+	WSADATA wsaData;
+
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+		return false;
+	}
+#endif
+	hasSockets = true;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(bridgeSettings.port);
+	listener = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	wakeSocket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifndef _WIN32
+	// On Windows the same option would let another program bind the port too
+	int isReused = 1;
+
+	setsockopt((int)listener, SOL_SOCKET, SO_REUSEADDR, &isReused, sizeof(isReused));
+#endif
+	if (listener == -1 || wakeSocket == -1 ||
+		bind(listener, (sockaddr *)&address, sizeof(address)) != 0 ||
+		listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener) ||
+		getsockname(listener, (sockaddr *)&address, &addressLength) != 0) {
+		close();
+		return false;
+	}
+	boundPort = ntohs(address.sin_port);
+
+	address.sin_port = 0;
+	addressLength = sizeof(address);
+	if (bind(wakeSocket, (sockaddr *)&address, sizeof(address)) != 0 ||
+		getsockname(wakeSocket, (sockaddr *)&address, &addressLength) != 0 ||
+		connect(wakeSocket, (sockaddr *)&address, addressLength) != 0 || !setNonBlocking(wakeSocket)) {
+		close();
+		return false;
+	}
+
+	settings = bridgeSettings;
+	toPort = send;
+	isStopping.store(false);
+	isWakePending.store(false);
+	try {
+		worker = std::thread(&TcpBridge::run, this);
+	}
+	catch (const std::system_error &) {
+		close();
+		return false;
+	}
+	isOpen.store(true);
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function to stop serving. Every client is disconnected, and publish does nothing from here on. Also
+-- tidies up after an open that failed partway.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::close() {
+	{
+		std::lock_guard<std::mutex> guard(publishLock);
+		isOpen.store(false);
+	}
+	if (worker.joinable()) {
+		isStopping.store(true);
+		wake();
+		worker.join();
+	}
+	if (!hasSockets) {
+		return;
+	}
+	hasSockets = false;
+	closeSocket(listener);
+	closeSocket(wakeSocket);
+	listener = -1;
+	wakeSocket = -1;
+	boundPort = 0;
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	publish
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void publish(const char * data, size_t length)
+--					const char * data:	a chunk received from the port
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function on the port's reader or I/O thread. The lock is only ever held by the bridge thread while it
+-- attaches a client, so publish does not wait on the clients however slow they are.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::publish(const char * data, size_t length) {
+	if (!isOpen.load(std::memory_order_relaxed)) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(publishLock);
+
+		if (!isOpen.load(std::memory_order_relaxed)) {
+			return;
+		}
+		buffer.append(data, length);
+	}
+	bytesPublished.fetch_add(length, std::memory_order_relaxed);
+	if (!isWakePending.exchange(true, std::memory_order_acq_rel)) {
+		wake();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BridgeStats getStats(void) const
+--
+-- RETURNS:		BridgeStats - the counters since the bridge was made
+----------------------------------------------------------------------------------------------------------------------*/
+BridgeStats TcpBridge::getStats() const {
+	BridgeStats stats;
+
+	stats.clients = clientCount.load(std::memory_order_relaxed);
+	stats.accepted = accepted.load(std::memory_order_relaxed);
+	stats.refused = refused.load(std::memory_order_relaxed);
+	stats.bytesPublished = bytesPublished.load(std::memory_order_relaxed);
+	stats.bytesSent = bytesSent.load(std::memory_order_relaxed);
+	stats.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+	stats.drops = drops.load(std::memory_order_relaxed);
+	stats.droppedBytes = droppedBytes.load(std::memory_order_relaxed);
+	stats.disconnects = disconnects.load(std::memory_order_relaxed);
+	stats.wakeups = wakeups.load(std::memory_order_relaxed);
+	stats.blocksAllocated = buffer.getBlocksAllocated();
+	return stats;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The bridge thread. Clients are gone over from the last, so dropping one, which moves the last into its place,
+-- never skips another. New clients are accepted after the others have been served.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::run() {
+	std::vector<PollEntry> entries;
+	bool isMorePending = false;
+
+	while (!isStopping.load()) {
+		PollEntry entry;
+		char drained[64];
+
+		entries.clear();
+		memset(&entry, 0, sizeof(entry));
+		entry.fd = wakeSocket;
+		entry.events = POLLIN;
+		entries.push_back(entry);
+		entry.fd = listener;
+		entries.push_back(entry);
+		for (const std::unique_ptr<Client> & client : clients) {
+			entry.fd = client->socket;
+			entry.events = POLLIN | (client->isBlocked ? POLLOUT : 0);
+			entries.push_back(entry);
+		}
+		if (pollSockets(entries.data(), (unsigned long)entries.size(), isMorePending ? 0 : -1) < 0) {
+			if (isWouldBlock()) {
+				continue;
+			}
+			break;
+		}
+		wakeups.fetch_add(1, std::memory_order_relaxed);
+		if (entries[0].revents != 0) {
+			while (recv(wakeSocket, drained, sizeof(drained), 0) > 0) {
+			}
+			isWakePending.store(false, std::memory_order_release);
+		}
+		isMorePending = false;
+
+		for (size_t index = clients.size(); index-- > 0;) {
+			Client * client = clients[index].get();
+			short events = entries[2 + index].revents;
+			bool isAlive = (events & POLLNVAL) == 0;
+
+			if (isAlive && (events & (POLLIN | POLLHUP | POLLERR)) != 0) {
+				isAlive = receiveFrom(client);
+			}
+			if (isAlive && (events & POLLOUT) != 0) {
+				client->isBlocked = false;
+			}
+			isAlive = isAlive && checkLag(client);
+			if (isAlive && !client->isBlocked) {
+				isAlive = sendTo(client);
+				isMorePending = isMorePending || (isAlive && !client->isBlocked &&
+					client->cursor.position() < buffer.getWritten());
+			}
+			if (!isAlive) {
+				dropClient(index);
+			}
+		}
+		if ((entries[1].revents & POLLIN) != 0) {
+			acceptClients();
+		}
+	}
+
+	while (!clients.empty()) {
+		dropClient(clients.size() - 1);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	acceptClients
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void acceptClients(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Takes every connection waiting on the listener. A client starts at the end of the stream, attached under the
+-- publish lock so the tail cannot move while it is taken. Past maxClients, connections are closed as they come.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::acceptClients() {
+	intptr_t socket;
+	int isNoDelay = 1;
+
+	while ((socket = (intptr_t)accept(listener, NULL, NULL)) != -1) {
+		if (clients.size() >= settings.maxClients || !setNonBlocking(socket)) {
+			closeSocket(socket);
+			refused.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+		setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char *)&isNoDelay, sizeof(isNoDelay));
+
+		std::unique_ptr<Client> client(new Client());
+		client->socket = socket;
+		{
+			std::lock_guard<std::mutex> guard(publishLock);
+			buffer.attach(&client->cursor);
+		}
+		clients.push_back(std::move(client));
+		accepted.fetch_add(1, std::memory_order_relaxed);
+		clientCount.store(clients.size(), std::memory_order_relaxed);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveFrom
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool receiveFrom(Client * client)
+--					Client * client:	a client poll found readable
+--
+-- RETURNS:		bool - false if the client has hung up or failed
+--
+-- NOTES:
+-- Hands what the client sent to the port. Clients are not told apart, so bytes from two typing at once interleave.
+----------------------------------------------------------------------------------------------------------------------*/
+bool TcpBridge::receiveFrom(Client * client) {
+	char data[BRIDGE_RECEIVE_SIZE];
+	int received = (int)recv(client->socket, data, sizeof(data), 0);
+
+	if (received > 0) {
+		bytesReceived.fetch_add(received, std::memory_order_relaxed);
+		if (toPort) {
+			toPort(data, received);
+		}
+		return true;
+	}
+	return received < 0 && isWouldBlock();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendTo
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool sendTo(Client * client)
+--					Client * client:	a client that is not blocked
+--
+-- RETURNS:		bool - false if the send failed
+--
+-- NOTES:
+-- Sends the client what it has not seen, up to BRIDGE_SEND_BUDGET bytes, straight from the buffer's blocks. A full
+-- socket marks the client blocked until poll finds it writable.
+----------------------------------------------------------------------------------------------------------------------*/
+bool TcpBridge::sendTo(Client * client) {
+	size_t budget = BRIDGE_SEND_BUDGET;
+	const char * data;
+	size_t available;
+
+	while (budget > 0 && (available = buffer.peek(&client->cursor, &data)) > 0) {
+		int length = (int)(available < budget ? available : budget);
+		int sent = (int)send(client->socket, data, length, SEND_FLAGS);
+
+		if (sent < 0) {
+			if (isWouldBlock()) {
+				client->isBlocked = true;
+				return true;
+			}
+			return false;
+		}
+		buffer.consume(&client->cursor, sent);
+		bytesSent.fetch_add(sent, std::memory_order_relaxed);
+		budget -= sent;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	checkLag
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool checkLag(Client * client)
+--					Client * client:	the client to check
+--
+-- RETURNS:		bool - false if the client is to be disconnected
+--
+-- NOTES:
+-- Applies the policy to a client more than lagLimit bytes behind. Under Drop the cursor is moved to the end of the
+-- stream, letting go of the blocks it held, and the bytes skipped are counted.
+----------------------------------------------------------------------------------------------------------------------*/
+bool TcpBridge::checkLag(Client * client) {
+	uint64_t written = buffer.getWritten();
+	uint64_t position = client->cursor.position();
+
+	if (written <= position || written - position <= settings.lagLimit) {
+		return true;
+	}
+	if (settings.policy == BacklogPolicy::Disconnect) {
+		disconnects.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> guard(publishLock);
+
+		buffer.detach(&client->cursor);
+		buffer.attach(&client->cursor);
+	}
+	drops.fetch_add(1, std::memory_order_relaxed);
+	droppedBytes.fetch_add(client->cursor.position() - position, std::memory_order_relaxed);
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	dropClient
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void dropClient(size_t index)
+--					size_t index:	the client's place in clients
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Closes the client and lets go of its blocks. The last client takes its place.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::dropClient(size_t index) {
+	closeSocket(clients[index]->socket);
+	buffer.detach(&clients[index]->cursor);
+	clients[index] = std::move(clients.back());
+	clients.pop_back();
+	clientCount.store(clients.size(), std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	wake
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void wake(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Brings the bridge thread out of poll. Safe from any thread.
+----------------------------------------------------------------------------------------------------------------------*/
+void TcpBridge::wake() {
+	char signal = 0;
+
+	send(wakeSocket, &signal, 1, SEND_FLAGS);
+}
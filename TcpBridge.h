@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FanoutBuffer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		TcpBridge.h -	Serves a port's received data to any number of local TCP clients.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool open(const BridgeSettings & bridgeSettings, SendFunction send)
+--					void close(void)
+--					void publish(const char * data, size_t length)
+--					bool isServing(void) const
+--					uint16_t getPort(void) const
+--					BridgeStats getStats(void) const
+--					void run(void)
+--					void acceptClients(void)
+--					bool receiveFrom(Client * client)
+--					bool sendTo(Client * client)
+--					bool checkLag(Client * client)
+--					void dropClient(size_t index)
+--					void wake(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The bridge listens on 127.0.0.1 and sends everything the port receives to every client connected, from the moment
+-- it connects. publish is called on the reader or I/O thread with each chunk: it appends the chunk to a FanoutBuffer
+-- and, unless a wake is already pending, wakes the bridge thread, then returns. It never waits on a client. The
+-- bridge thread accepts clients, sends each one what it has not seen straight out of the buffer's blocks, and hands
+-- whatever a client sends to the send function, which goes to the port.
+--
+-- Each client has a FanoutCursor, so the data is held once however many clients there are. A client that stops
+-- reading holds its blocks in memory; once it is more than lagLimit bytes behind, the policy applies. Drop moves
+-- its cursor to the end of the stream, skipping what it missed, and Disconnect closes it. Either way the port and
+-- the other clients go on as before.
+--
+-- Sockets are kept as intptr_t so this header does not pull in the socket headers, which clash with windows.h
+-- unless they come first.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint16_t BRIDGE_BASE_PORT = 3980;			// a session serves on BRIDGE_BASE_PORT plus its pane
+constexpr size_t BRIDGE_LAG_LIMIT = 4 << 20;		// bytes a client may fall behind before the policy applies
+constexpr size_t BRIDGE_MAX_CLIENTS = 128;
+constexpr size_t BRIDGE_RECEIVE_SIZE = 4096;		// bytes read from a client at a time
+
+enum class BacklogPolicy : uint8_t {
+	Drop,			// skip the client ahead to the newest data
+	Disconnect		// close the client
+};
+
+struct BridgeSettings {
+	uint16_t port = 0;								// 0 for any free port
+	BacklogPolicy policy = BacklogPolicy::Drop;
+	size_t lagLimit = BRIDGE_LAG_LIMIT;
+	size_t maxClients = BRIDGE_MAX_CLIENTS;
+};
+
+struct BridgeStats {
+	uint64_t clients = 0;			// connected now
+	uint64_t accepted = 0;
+	uint64_t refused = 0;			// turned away at maxClients
+	uint64_t bytesPublished = 0;
+	uint64_t bytesSent = 0;			// summed over every client
+	uint64_t bytesReceived = 0;		// from clients, handed to the port
+	uint64_t drops = 0;				// times a client was skipped ahead
+	uint64_t droppedBytes = 0;
+	uint64_t disconnects = 0;		// clients closed for lagging
+	uint64_t wakeups = 0;
+	uint64_t blocksAllocated = 0;
+};
+
+class TcpBridge {
+public:
+	// Called on the bridge thread with what a client sent
+	typedef std::function<void(const char * data, size_t length)> SendFunction;
+private:
+	struct Client {
+		intptr_t socket;
+		FanoutCursor cursor;
+		bool isBlocked = false;		// the socket is full; wait for it to drain
+	};
+
+	FanoutBuffer buffer;
+	std::mutex publishLock;						// serializes append with attach
+	std::atomic<bool> isOpen{ false };
+	std::atomic<bool> isStopping{ false };
+	std::atomic<bool> isWakePending{ false };
+	bool hasSockets = false;					// open got far enough to leave something for close
+	intptr_t listener = -1;
+	intptr_t wakeSocket = -1;					// a UDP socket connected to itself
+	uint16_t boundPort = 0;
+	BridgeSettings settings;
+	SendFunction toPort;
+	std::vector<std::unique_ptr<Client>> clients;	// owned by the bridge thread
+	std::thread worker;
+
+	std::atomic<uint64_t> clientCount{ 0 };
+	std::atomic<uint64_t> accepted{ 0 };
+	std::atomic<uint64_t> refused{ 0 };
+	std::atomic<uint64_t> bytesPublished{ 0 };
+	std::atomic<uint64_t> bytesSent{ 0 };
+	std::atomic<uint64_t> bytesReceived{ 0 };
+	std::atomic<uint64_t> drops{ 0 };
+	std::atomic<uint64_t> droppedBytes{ 0 };
+	std::atomic<uint64_t> disconnects{ 0 };
+	std::atomic<uint64_t> wakeups{ 0 };
+
+	void run();
+	void acceptClients();
+	bool receiveFrom(Client * client);
+	bool sendTo(Client * client);
+	bool checkLag(Client * client);
+	void dropClient(size_t index);
+	void wake();
+public:
+	TcpBridge() {};
+	~TcpBridge() { close(); };
+	TcpBridge(const TcpBridge &) = delete;
+	TcpBridge & operator=(const TcpBridge &) = delete;
+
+	bool open(const BridgeSettings & bridgeSettings, SendFunction send);
+	void close();
+	void publish(const char * data, size_t length);
+	bool isServing() const { return isOpen.load(std::memory_order_relaxed); };
+	uint16_t getPort() const { return boundPort; };
+	BridgeStats getStats() const;
+};
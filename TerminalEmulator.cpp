@@ -0,0 +1,468 @@
+#include "TerminalEmulator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		TerminalEmulator.cpp -	Applies received text and escape sequences to a ScreenModel.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void reset(void)
+--					void print(const char * text, size_t length)
+--					void execute(uint8_t control)
+--					void escDispatch(const VtSequence & sequence)
+--					void csiDispatch(const VtSequence & sequence)
+--					void selectGraphicRendition(const VtSequence & sequence)
+--					void eraseInDisplay(int mode)
+--					void eraseInLine(int mode)
+--					void updateAttribute(void)
+--					int paramOr(const VtSequence & sequence, int index, int fallback)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Printed text is decoded as UTF-8
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Cursor moves work from the cursor's column clamped to the last column, so a move made while a wrap is pending
+-- cancels the wrap as it does on a VT100.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	paramOr
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int paramOr(const VtSequence & sequence, int index, int fallback)
+--					const VtSequence & sequence:	a parsed sequence
+--					int index:						which parameter
+--					int fallback:					value for an omitted or 0 parameter
+--
+-- RETURNS:		int - the parameter, or fallback
+----------------------------------------------------------------------------------------------------------------------*/
+static int paramOr(const VtSequence & sequence, int index, int fallback) {
+	return index < sequence.paramCount && sequence.params[index] != 0 ? sequence.params[index] : fallback;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	reset
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void reset(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Full reset (ESC c): default colours, a cleared screen with the cursor home, and the parser back in its ground
+-- state. The scrollback is kept.
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::reset() {
+	parser.reset();
+	decoder.reset();
+	foreground = attributeForeground(ATTR_DEFAULT);
+	background = attributeBackground(ATTR_DEFAULT);
+	isBright = false;
+	isReverse = false;
+	updateAttribute();
+	eraseInDisplay(2);
+	screen.setCursor(0, 0);
+	savedX = 0;
+	savedY = 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	print
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void print(const char * text, size_t length)
+--					const char * text:	a run of printable UTF-8 bytes, possibly cut mid-character at either end
+--					size_t length:		number of bytes in text
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::print(const char * text, size_t length) {
+	while (length > 0) {
+		size_t slice = length < TERMINAL_DECODE_SLICE ? length : TERMINAL_DECODE_SLICE;
+		screen.putGlyphs(decoded, decoder.decode(text, slice, decoded));
+		text += slice;
+		length -= slice;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	execute
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void execute(uint8_t control)
+--					uint8_t control:	a C0 control byte
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::execute(uint8_t control) {
+	endText();
+
+	int x = screen.getCursorX() < screen.getColumns() ? screen.getCursorX() : screen.getColumns() - 1;
+
+	switch (control) {
+	case '\b':
+		if (x > 0) {
+			screen.setCursor(x - 1, screen.getCursorY());
+		}
+		break;
+	case '\t':
+		screen.setCursor((x / TAB_WIDTH + 1) * TAB_WIDTH, screen.getCursorY());
+		break;
+	case '\n':
+	case '\v':
+	case '\f':
+		screen.lineFeed();
+		break;
+	case '\r':
+		screen.carriageReturn();
+		break;
+	default:
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	escDispatch
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void escDispatch(const VtSequence & sequence)
+--					const VtSequence & sequence:	ESC [intermediates] final
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Sequences with intermediates, such as the character set designations ESC ( B, are ignored.
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::escDispatch(const VtSequence & sequence) {
+	endText();
+	if (sequence.intermediateCount > 0 || sequence.isOverflowed) {
+		return;
+	}
+
+	switch (sequence.finalByte) {
+	case '7':
+		savedX = screen.getCursorX();
+		savedY = screen.getCursorY();
+		break;
+	case '8':
+		screen.setCursor(savedX, savedY);
+		break;
+	case 'D':
+		screen.lineFeed();
+		break;
+	case 'E':
+		screen.carriageReturn();
+		screen.lineFeed();
+		break;
+	case 'c':
+		reset();
+		break;
+	default:
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	csiDispatch
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void csiDispatch(const VtSequence & sequence)
+--					const VtSequence & sequence:	CSI [private] [params] [intermediates] final
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Counts default to 1 and positions are 1 based, as in the standard. Private and intermediate forms are ignored.
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::csiDispatch(const VtSequence & sequence) {
+	endText();
+
+	int x = screen.getCursorX() < screen.getColumns() ? screen.getCursorX() : screen.getColumns() - 1;
+	int y = screen.getCursorY();
+	int count = paramOr(sequence, 0, 1);
+
+	if (sequence.intermediateCount > 0 || sequence.isOverflowed) {
+		return;
+	}
+
+	switch (sequence.finalByte) {
+	case 'A':
+		screen.setCursor(x, y - count);
+		break;
+	case 'B':
+	case 'e':
+		screen.setCursor(x, y + count);
+		break;
+	case 'C':
+	case 'a':
+		screen.setCursor(x + count, y);
+		break;
+	case 'D':
+		screen.setCursor(x - count, y);
+		break;
+	case 'E':
+		screen.setCursor(0, y + count);
+		break;
+	case 'F':
+		screen.setCursor(0, y - count);
+		break;
+	case 'G':
+	case '`':
+		screen.setCursor(count - 1, y);
+		break;
+	case 'H':
+	case 'f':
+		screen.setCursor(paramOr(sequence, 1, 1) - 1, count - 1);
+		break;
+	case 'd':
+		screen.setCursor(x, count - 1);
+		break;
+	case 'J':
+		eraseInDisplay(paramOr(sequence, 0, 0));
+		break;
+	case 'K':
+		eraseInLine(paramOr(sequence, 0, 0));
+		break;
+	case 'X':
+		screen.eraseCells(y, x, count);
+		break;
+	case 'm':
+		selectGraphicRendition(sequence);
+		break;
+	case 's':
+		savedX = screen.getCursorX();
+		savedY = y;
+		break;
+	case 'u':
+		screen.setCursor(savedX, savedY);
+		break;
+	default:
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	selectGraphicRendition
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void selectGraphicRendition(const VtSequence & sequence)
+--					const VtSequence & sequence:	CSI params m
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The attribute byte only has room for two palette indexes, so bold is shown as the bright colour and reverse
+-- swaps the two. 256 colour and RGB forms are skipped over whole; only their first 16 colours are shown.
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::selectGraphicRendition(const VtSequence & sequence) {
+	int count = sequence.paramCount > 0 ? sequence.paramCount : 1;
+
+	for (int i = 0; i < count; i++) {
+		int value = i < sequence.paramCount ? sequence.params[i] : 0;
+
+		if (value == 0) {
+			foreground = attributeForeground(ATTR_DEFAULT);
+			background = attributeBackground(ATTR_DEFAULT);
+			isBright = false;
+			isReverse = false;
+		}
+		else if (value == 1) {
+			isBright = true;
+		}
+		else if (value == 22) {
+			isBright = false;
+		}
+		else if (value == 7) {
+			isReverse = true;
+		}
+		else if (value == 27) {
+			isReverse = false;
+		}
+		else if (value >= 30 && value <= 37) {
+			foreground = (uint8_t)(value - 30);
+		}
+		else if (value == 39) {
+			foreground = attributeForeground(ATTR_DEFAULT);
+		}
+		else if (value >= 40 && value <= 47) {
+			background = (uint8_t)(value - 40);
+		}
+		else if (value == 49) {
+			background = attributeBackground(ATTR_DEFAULT);
+		}
+		else if (value >= 90 && value <= 97) {
+			foreground = (uint8_t)(value - 90 + 8);
+		}
+		else if (value >= 100 && value <= 107) {
+			background = (uint8_t)(value - 100 + 8);
+		}
+		else if ((value == 38 || value == 48) && i + 1 < sequence.paramCount) {
+			if (sequence.params[i + 1] == 5 && i + 2 < sequence.paramCount) {
+				if (sequence.params[i + 2] < 16) {
+					*(value == 38 ? &foreground : &background) = (uint8_t)sequence.params[i + 2];
+				}
+				i += 2;
+			}
+			else if (sequence.params[i + 1] == 2) {
+				i += 4;
+			}
+		}
+	}
+	updateAttribute();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	eraseInDisplay
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void eraseInDisplay(int mode)
+--					int mode:	0 from the cursor to the end, 1 from the start to the cursor, 2 or 3 everything
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::eraseInDisplay(int mode) {
+	int y = screen.getCursorY();
+	int first = 0, last = screen.getRows() - 1;
+
+	if (mode == 0) {
+		eraseInLine(0);
+		first = y + 1;
+	}
+	else if (mode == 1) {
+		eraseInLine(1);
+		last = y - 1;
+	}
+	else if (mode != 2 && mode != 3) {
+		return;
+	}
+	for (int row = first; row <= last; row++) {
+		screen.eraseCells(row, 0, screen.getColumns());
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	eraseInLine
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void eraseInLine(int mode)
+--					int mode:	0 from the cursor to the end, 1 from the start to the cursor, 2 the whole line
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::eraseInLine(int mode) {
+	int x = screen.getCursorX() < screen.getColumns() ? screen.getCursorX() : screen.getColumns() - 1;
+	int y = screen.getCursorY();
+
+	switch (mode) {
+	case 0:
+		screen.eraseCells(y, x, screen.getColumns() - x);
+		break;
+	case 1:
+		screen.eraseCells(y, 0, x + 1);
+		break;
+	case 2:
+		screen.eraseCells(y, 0, screen.getColumns());
+		break;
+	default:
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	updateAttribute
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void updateAttribute(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Folds the rendition state into the attribute byte the screen writes with.
+----------------------------------------------------------------------------------------------------------------------*/
+void TerminalEmulator::updateAttribute() {
+	uint8_t shownForeground = isBright && foreground < 8 ? (uint8_t)(foreground | 8) : foreground;
+	uint8_t shownBackground = background;
+
+	if (isReverse) {
+		uint8_t swap = shownForeground;
+		shownForeground = shownBackground;
+		shownBackground = swap;
+	}
+	screen.setAttribute(makeAttribute(shownForeground, shownBackground));
+}
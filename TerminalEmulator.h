@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ScreenModel.h"
+#include "VtParser.h"
+#include "Utf8Decoder.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		TerminalEmulator.h -	Applies received text and escape sequences to a ScreenModel.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void receive(const char * data, size_t length)
+--					void reset(void)
+--					void print(const char * text, size_t length)
+--					void endText(void)
+--					void execute(uint8_t control)
+--					void escDispatch(const VtSequence & sequence)
+--					void csiDispatch(const VtSequence & sequence)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Printed text is decoded as UTF-8
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The VtParser handler for the terminal window. Supported, as a VT100 with ANSI colour does them:
+--
+--		controls	BS, HT (stops every 8 columns), LF, VT, FF, CR; everything else is ignored
+--		ESC			7 8 (save and restore cursor), D (index), E (next line), c (reset)
+--		CSI			A B C D E F G H J K X a d e f m s u `
+--		SGR			0, 1 and 22 (bright), 7 and 27 (reverse), 30-37, 39, 40-47, 49, 90-97, 100-107, and the
+--					16 colour forms of 38;5 and 48;5
+--
+-- Other sequences, including private modes such as CSI ?25h, are parsed and ignored so they never reach the screen.
+--
+-- Printed text is UTF-8. It is decoded a slice at a time into a fixed buffer, so receiving never allocates, and a
+-- character split between two reads is joined up by the decoder. A control or sequence arriving in the middle of a
+-- character ends it as U+FFFD.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr int TAB_WIDTH = 8;
+constexpr size_t TERMINAL_DECODE_SLICE = 1024;
+
+class TerminalEmulator {
+private:
+	ScreenModel & screen;
+	VtParser parser;
+	Utf8Decoder decoder;
+	char16_t decoded[utf8MaxOutput(TERMINAL_DECODE_SLICE)];
+
+	uint8_t foreground = attributeForeground(ATTR_DEFAULT);
+	uint8_t background = attributeBackground(ATTR_DEFAULT);
+	bool isBright = false;
+	bool isReverse = false;
+	int savedX = 0;
+	int savedY = 0;
+
+	void selectGraphicRendition(const VtSequence & sequence);
+	void eraseInDisplay(int mode);
+	void eraseInLine(int mode);
+	void updateAttribute();
+	void endText() {
+		if (decoder.hasPending()) {
+			screen.putGlyphs(decoded, decoder.flush(decoded));
+		}
+	};
+public:
+	TerminalEmulator(ScreenModel & model) : screen(model) {};
+	TerminalEmulator(const TerminalEmulator &) = delete;
+	TerminalEmulator & operator=(const TerminalEmulator &) = delete;
+
+	void receive(const char * data, size_t length) { parser.feed(data, length, *this); };
+	void reset();
+
+	// Called by the parser
+	void print(const char * text, size_t length);
+	void execute(uint8_t control);
+	void escDispatch(const VtSequence & sequence);
+	void csiDispatch(const VtSequence & sequence);
+};
@@ -0,0 +1,358 @@
+#include <string.h>
+#include "TextScan.h"
+#if TEXT_SCAN_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		TextScan.cpp -	Finds the end of a run of plain printable ASCII in received data.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					const uint8_t * scanPlainTextScalar(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * scanPlainTextSse2(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * scanPlainTextAvx2(const uint8_t * text, const uint8_t * end)
+--					const ScanKernel * getScanKernels(size_t * count)
+--					const ScanKernel & getSelectedScanKernel(void)
+--					const uint8_t * scanPlainTextFirstCall(const uint8_t * text, const uint8_t * end)
+--					bool cpuHasSse2(void)
+--					bool cpuHasAvx2(void)
+--					int lowestSetBit(uint64_t value)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - selectedPlainTextScan is atomic
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The vector kernels use one signed compare: as signed bytes, high-bit bytes are negative, so v > 0x1F is true for
+-- exactly 0x20-0x7F and DEL is the only other byte to test for. GCC and Clang compile the AVX2 kernel with a target
+-- attribute so the rest of the program still runs on CPUs without it; MSVC needs nothing for intrinsics.
+----------------------------------------------------------------------------------------------------------------------*/
+
+#if TEXT_SCAN_X86 && !defined(_MSC_VER)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	lowestSetBit
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int lowestSetBit(uint64_t value)
+--					uint64_t value:		not 0
+--
+-- RETURNS:		int - index of the lowest set bit
+----------------------------------------------------------------------------------------------------------------------*/
+static inline int lowestSetBit(uint64_t value) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, value);
+	return (int)index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)value)) {
+		return (int)index;
+	}
+	_BitScanForward(&index, (unsigned long)(value >> 32));
+	return (int)index + 32;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scanPlainTextScalar
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint8_t * scanPlainTextScalar(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * text:	first byte to look at
+--					const uint8_t * end:	one past the last byte
+--
+-- RETURNS:		const uint8_t * - the first special byte, or end
+--
+-- NOTES:
+-- Tests eight bytes per step with the usual SWAR tricks: a byte below 0x20 borrows in (word - 0x20..20) & ~word,
+-- DEL is the zero byte of word ^ 0x7F..7F, and a high byte has its own top bit set. A borrow only starts at a byte
+-- that really is special, so the lowest flag bit always marks the first one; the first byte is the low byte on
+-- the little-endian targets this builds for.
+----------------------------------------------------------------------------------------------------------------------*/
+const uint8_t * scanPlainTextScalar(const uint8_t * text, const uint8_t * end) {
+	const uint64_t ones = 0x0101010101010101ULL;
+	const uint64_t highs = 0x8080808080808080ULL;
+
+	while (end - text >= 8) {
+		uint64_t word, del, found;
+		memcpy(&word, text, sizeof(word));
+		del = word ^ (ones * 0x7F);
+		found = (((word - ones * 0x20) & ~word) | ((del - ones) & ~del) | word) & highs;
+		if (found != 0) {
+			return text + (lowestSetBit(found) >> 3);
+		}
+		text += 8;
+	}
+	while (text < end && *text >= 0x20 && *text < 0x7F) {
+		text++;
+	}
+	return text;
+}
+
+#if TEXT_SCAN_X86
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scanPlainTextSse2
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint8_t * scanPlainTextSse2(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * text:	first byte to look at
+--					const uint8_t * end:	one past the last byte
+--
+-- RETURNS:		const uint8_t * - the first special byte, or end
+--
+-- NOTES:
+-- Sixteen bytes a step; the last partial block goes to the scalar kernel.
+----------------------------------------------------------------------------------------------------------------------*/
+TARGET_SSE2 const uint8_t * scanPlainTextSse2(const uint8_t * text, const uint8_t * end) {
+	const __m128i lastControl = _mm_set1_epi8(0x1F);
+	const __m128i del = _mm_set1_epi8(0x7F);
+
+	while (end - text >= 16) {
+		__m128i block = _mm_loadu_si128((const __m128i *)text);
+		unsigned plain = (unsigned)_mm_movemask_epi8(_mm_cmpgt_epi8(block, lastControl));
+		unsigned isDel = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, del));
+		unsigned special = (~plain | isDel) & 0xFFFF;
+		if (special != 0) {
+			return text + lowestSetBit(special);
+		}
+		text += 16;
+	}
+	return scanPlainTextScalar(text, end);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scanPlainTextAvx2
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint8_t * scanPlainTextAvx2(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * text:	first byte to look at
+--					const uint8_t * end:	one past the last byte
+--
+-- RETURNS:		const uint8_t * - the first special byte, or end
+--
+-- NOTES:
+-- Thirty-two bytes a step; the last partial block goes to the SSE2 kernel. Only call this when cpuHasAvx2 is true.
+----------------------------------------------------------------------------------------------------------------------*/
+TARGET_AVX2 const uint8_t * scanPlainTextAvx2(const uint8_t * text, const uint8_t * end) {
+	const __m256i lastControl = _mm256_set1_epi8(0x1F);
+	const __m256i del = _mm256_set1_epi8(0x7F);
+
+	while (end - text >= 32) {
+		__m256i block = _mm256_loadu_si256((const __m256i *)text);
+		uint32_t plain = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(block, lastControl));
+		uint32_t isDel = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, del));
+		uint32_t special = ~plain | isDel;
+		if (special != 0) {
+			return text + lowestSetBit(special);
+		}
+		text += 32;
+	}
+	return scanPlainTextSse2(text, end);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cpuHasSse2
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool cpuHasSse2(void)
+--
+-- RETURNS:		bool - true if the CPU runs SSE2; always true on x64
+----------------------------------------------------------------------------------------------------------------------*/
+static bool cpuHasSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+	return true;
+#elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2");
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cpuHasAvx2
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool cpuHasAvx2(void)
+--
+-- RETURNS:		bool - true if the CPU has AVX2 and the OS saves the YMM registers
+----------------------------------------------------------------------------------------------------------------------*/
+static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	// OSXSAVE and AVX, then XMM and YMM state enabled by the OS
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getScanKernels
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const ScanKernel * getScanKernels(size_t * count)
+--					size_t * count:		set to the number of kernels returned
+--
+-- RETURNS:		const ScanKernel * - the kernels this CPU can run, scalar first and fastest last
+--
+-- NOTES:
+-- The CPU is asked once; the list is built on the first call and never changes.
+----------------------------------------------------------------------------------------------------------------------*/
+const ScanKernel * getScanKernels(size_t * count) {
+	struct KernelList {
+		ScanKernel kernels[3];
+		size_t count = 0;
+
+		KernelList() {
+			kernels[count++] = { "scalar", scanPlainTextScalar };
+#if TEXT_SCAN_X86
+			if (cpuHasSse2()) {
+				kernels[count++] = { "sse2", scanPlainTextSse2 };
+				if (cpuHasAvx2()) {
+					kernels[count++] = { "avx2", scanPlainTextAvx2 };
+				}
+			}
+#endif
+		};
+	};
+	static const KernelList list;
+
+	*count = list.count;
+	return list.kernels;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getSelectedScanKernel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const ScanKernel & getSelectedScanKernel(void)
+--
+-- RETURNS:		const ScanKernel & - the kernel scanPlainText uses
+----------------------------------------------------------------------------------------------------------------------*/
+const ScanKernel & getSelectedScanKernel() {
+	size_t count;
+	const ScanKernel * kernels = getScanKernels(&count);
+
+	return kernels[count - 1];
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scanPlainTextFirstCall
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Stores the kernel atomically
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint8_t * scanPlainTextFirstCall(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * text:	first byte to look at
+--					const uint8_t * end:	one past the last byte
+--
+-- RETURNS:		const uint8_t * - the first special byte, or end
+--
+-- NOTES:
+-- The pointer starts here so it is valid before any constructor runs. The first scan picks the kernel and replaces
+-- the pointer with it. Threads racing it each store the same value, and as the pointer is atomic that is not a
+-- data race; relaxed order is enough because the kernels are plain functions with nothing to publish.
+----------------------------------------------------------------------------------------------------------------------*/
+static const uint8_t * scanPlainTextFirstCall(const uint8_t * text, const uint8_t * end) {
+	ScanFunction scan = getSelectedScanKernel().scan;
+
+	selectedPlainTextScan.store(scan, std::memory_order_relaxed);
+	return scan(text, end);
+}
+
+std::atomic<ScanFunction> selectedPlainTextScan{ scanPlainTextFirstCall };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		TextScan.h -	Finds the end of a run of plain printable ASCII in received data.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					const uint8_t * scanPlainText(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * scanPlainTextScalar(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * scanPlainTextSse2(const uint8_t * text, const uint8_t * end)
+--					const uint8_t * scanPlainTextAvx2(const uint8_t * text, const uint8_t * end)
+--					const ScanKernel * getScanKernels(size_t * count)
+--					const ScanKernel & getSelectedScanKernel(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The kernel pointer is atomic, since parsers on several threads scan at once
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Plain text is 0x20-0x7E. Anything else is special: a C0 control (ESC among them), DEL, or a byte with the high bit
+-- set. Every kernel returns a pointer to the first special byte at or after text, or end if there is none, and all
+-- of them must agree byte for byte; only their speed differs.
+--
+-- The kernel is picked once, at startup, from what the CPU can run: AVX2 (32 bytes a step), then SSE2 (16), then a
+-- portable SWAR loop (8). scanPlainText calls the picked kernel through a pointer, once per run, not per byte, and
+-- only once it has seen that the run is not empty. The pointer is atomic because the first scans may come from
+-- several sessions' threads at once; a relaxed load costs the same as a plain one.
+----------------------------------------------------------------------------------------------------------------------*/
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TEXT_SCAN_X86 1
+#else
+#define TEXT_SCAN_X86 0
+#endif
+
+typedef const uint8_t * (*ScanFunction)(const uint8_t * text, const uint8_t * end);
+
+struct ScanKernel {
+	const char * name;
+	ScanFunction scan;
+};
+
+const uint8_t * scanPlainTextScalar(const uint8_t * text, const uint8_t * end);
+#if TEXT_SCAN_X86
+const uint8_t * scanPlainTextSse2(const uint8_t * text, const uint8_t * end);
+const uint8_t * scanPlainTextAvx2(const uint8_t * text, const uint8_t * end);
+#endif
+
+const ScanKernel * getScanKernels(size_t * count);
+const ScanKernel & getSelectedScanKernel();
+
+extern std::atomic<ScanFunction> selectedPlainTextScan;
+
+inline const uint8_t * scanPlainText(const uint8_t * text, const uint8_t * end) {
+	// Binary data is mostly runs of zero or one byte; don't pay for the indirect call to learn that
+	if (text == end || *text < 0x20 || *text >= 0x7F) {
+		return text;
+	}
+	return selectedPlainTextScan.load(std::memory_order_relaxed)(text + 1, end);
+}
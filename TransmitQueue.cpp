@@ -0,0 +1,191 @@
+#include "TransmitQueue.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		TransmitQueue.cpp -	The writer stage between keystrokes and the port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(WriteFunction write)
+--					void stop(void)
+--					size_t submit(const char * data, size_t length)
+--					void run(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - start and stop hand the writer loop to a PortWorker rather than a new thread
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The queue depth counts bytes submitted but not yet written, including the batch currently being written.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	start
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Runs the writer on the parked PortWorker
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool start(WriteFunction write)
+--					WriteFunction write:	writes a batch to the port
+--
+-- RETURNS:		bool - false if the writer is already running
+--
+-- NOTES:
+-- Call this function once the port is open. Throws std::system_error if the writer thread has to be created and
+-- cannot be.
+----------------------------------------------------------------------------------------------------------------------*/
+bool TransmitQueue::start(WriteFunction write) {
+	std::lock_guard<std::mutex> guard(lock);
+
+	if (isRunning) {
+		return false;
+	}
+	writeFunction = write;
+	pending.clear();
+	pending.reserve(4096);
+	queueDepth.store(0, std::memory_order_relaxed);
+	stopping.store(false, std::memory_order_relaxed);
+	isRunning = true;
+	try {
+		writer.start([this] { run(); });
+	}
+	catch (...) {
+		isRunning = false;
+		throw;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	stop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Parks the writer thread instead of joining it
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void stop(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function before closing the port. Bytes not yet written are discarded. A write in progress is expected
+-- to notice isStopping and give up, since the line may be held off by flow control indefinitely. Returns once the
+-- writer loop has ended; the thread stays parked for the next start.
+----------------------------------------------------------------------------------------------------------------------*/
+void TransmitQueue::stop() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!isRunning) {
+			return;
+		}
+		isRunning = false;
+		stopping.store(true, std::memory_order_relaxed);
+		pending.clear();
+	}
+	wake.notify_all();
+	writer.stop();
+	queueDepth.store(0, std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	submit
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t submit(const char * data, size_t length)
+--					const char * data:	bytes to send
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		size_t - bytes queued; less than length if the queue limit was reached or the writer is stopped
+--
+-- NOTES:
+-- Call this function from any thread. It does not wait for the port.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t TransmitQueue::submit(const char * data, size_t length) {
+	size_t accepted, depth;
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (!isRunning) {
+			return 0;
+		}
+		depth = queueDepth.load(std::memory_order_relaxed);
+		accepted = depth + length <= limit ? length : (depth < limit ? limit - depth : 0);
+		pending.insert(pending.end(), data, data + accepted);
+		depth = queueDepth.fetch_add(accepted, std::memory_order_relaxed) + accepted;
+	}
+	if (accepted < length) {
+		droppedBytes.fetch_add(length - accepted, std::memory_order_relaxed);
+	}
+	if (depth > peakDepth.load(std::memory_order_relaxed)) {
+		peakDepth.store(depth, std::memory_order_relaxed);
+	}
+	if (accepted > 0) {
+		wake.notify_one();
+	}
+	return accepted;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	run
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Returns to the PortWorker when stopped instead of ending the thread
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void run(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The writer loop, run on the PortWorker for each start. It sleeps until bytes are pending, takes all of them, and
+-- writes them as one batch. The two buffers are swapped rather than copied, and keep their capacity between batches
+-- and between connections.
+----------------------------------------------------------------------------------------------------------------------*/
+void TransmitQueue::run() {
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [this] { return !isRunning || !pending.empty(); });
+			if (!isRunning) {
+				return;
+			}
+			inFlight.swap(pending);
+		}
+
+		bool written = writeFunction(inFlight.data(), inFlight.size());
+		writeCount.fetch_add(1, std::memory_order_relaxed);
+		if (written) {
+			bytesWritten.fetch_add(inFlight.size(), std::memory_order_relaxed);
+		}
+		else {
+			droppedBytes.fetch_add(inFlight.size(), std::memory_order_relaxed);
+		}
+		queueDepth.fetch_sub(inFlight.size(), std::memory_order_relaxed);
+		inFlight.clear();
+	}
+}
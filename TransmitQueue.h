@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "PortWorker.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		TransmitQueue.h -	The writer stage between keystrokes and the port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool start(WriteFunction write)
+--					void stop(void)
+--					size_t submit(const char * data, size_t length)
+--					bool isStopping(void) const
+--					size_t getQueueDepth(void) const
+--					size_t getPeakDepth(void) const
+--					uint64_t getWriteCount(void) const
+--					uint64_t getBytesWritten(void) const
+--					uint64_t getDroppedBytes(void) const
+--					uint64_t getThreadStarts(void) const
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The writer is a PortWorker kept from one start to the next
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Any thread may submit bytes; a single writer thread owns the port writes. Submitting only appends to the pending
+-- buffer under a short lock and wakes the writer, so it never waits for the line. The writer swaps the whole pending
+-- buffer out and writes it in one call, so keystrokes typed or pasted while a write is in flight go out together in
+-- the next one. Bytes beyond the queue limit are dropped and counted.
+--
+-- The writer thread is created by the first start and parked by stop, so a reconnect reuses it along with both
+-- buffers and their capacity.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t TX_QUEUE_LIMIT = 1 << 20;	// bytes that may wait for the writer
+
+class TransmitQueue {
+public:
+	// Writes every byte or returns false; called only from the writer thread
+	typedef std::function<bool(const char * data, size_t length)> WriteFunction;
+private:
+	std::mutex lock;
+	std::condition_variable wake;
+	std::vector<char> pending;
+	std::vector<char> inFlight;
+	PortWorker writer;
+	WriteFunction writeFunction;
+	bool isRunning = false;
+	std::atomic<bool> stopping{ false };
+	size_t limit;
+
+	std::atomic<size_t> queueDepth{ 0 };
+	std::atomic<size_t> peakDepth{ 0 };
+	std::atomic<uint64_t> writeCount{ 0 };
+	std::atomic<uint64_t> bytesWritten{ 0 };
+	std::atomic<uint64_t> droppedBytes{ 0 };
+
+	void run();
+public:
+	TransmitQueue(size_t maxQueued = TX_QUEUE_LIMIT) : limit(maxQueued) {};
+	~TransmitQueue() { stop(); };
+	TransmitQueue(const TransmitQueue &) = delete;
+	TransmitQueue & operator=(const TransmitQueue &) = delete;
+
+	bool start(WriteFunction write);
+	void stop();
+	size_t submit(const char * data, size_t length);
+	bool isStopping() const { return stopping.load(std::memory_order_relaxed); };
+
+	size_t getQueueDepth() const { return queueDepth.load(std::memory_order_relaxed); };
+	size_t getPeakDepth() const { return peakDepth.load(std::memory_order_relaxed); };
+	uint64_t getWriteCount() const { return writeCount.load(std::memory_order_relaxed); };
+	uint64_t getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); };
+	uint64_t getDroppedBytes() const { return droppedBytes.load(std::memory_order_relaxed); };
+	uint64_t getThreadStarts() const { return writer.getThreadStarts(); };
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FileTransfer.h"
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		TransportChannel.h -	A TransferChannel straight onto a SerialTransport.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const char * data, size_t length)
+--					bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- For a port with no SerialPipeline on it, such as the far end of a bench loopback: the transfer's thread is the
+-- port's only reader and writer.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class TransportChannel : public TransferChannel {
+private:
+	SerialTransport * transport;
+public:
+	explicit TransportChannel(SerialTransport * port) : transport(port) {};
+
+	bool send(const char * data, size_t length) override {
+		return transport->write(data, length);
+	}
+
+	bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived) override {
+		return transport->read(buffer, capacity, timeout, bytesReceived);
+	}
+};
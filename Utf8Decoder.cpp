@@ -0,0 +1,232 @@
+#include "Utf8Decoder.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTF8_DECODER_SSE2 1
+#include <emmintrin.h>
+#else
+#define UTF8_DECODER_SSE2 0
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Utf8Decoder.cpp -	An incremental UTF-8 to UTF-16 decoder.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					size_t decode(const char * data, size_t length, char16_t * out)
+--					size_t flush(char16_t * out)
+--					const uint8_t * widenAscii(const uint8_t * in, const uint8_t * end, char16_t ** out)
+--					char16_t * putCodePoint(char16_t * out, uint32_t codePoint)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The lead byte fixes how many continuation bytes follow and, for E0, ED, F0 and F4, a narrower range for the first
+-- of them. Checking that range up front is what rejects overlongs, surrogates and values above U+10FFFF without a
+-- second pass over the finished code point. SSE2 is part of every x64 target, so it is used without a CPU check.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	widenAscii
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const uint8_t * widenAscii(const uint8_t * in, const uint8_t * end, char16_t ** out)
+--					const uint8_t * in:		first byte to look at
+--					const uint8_t * end:	one past the last byte
+--					char16_t ** out:		where to write; moved past what was written
+--
+-- RETURNS:		const uint8_t * - the first byte at or after in that is not ASCII, or end
+--
+-- NOTES:
+-- A block that has a high byte in it is finished a byte at a time, so nothing is written past the ASCII prefix.
+----------------------------------------------------------------------------------------------------------------------*/
+static inline const uint8_t * widenAscii(const uint8_t * in, const uint8_t * end, char16_t ** out) {
+	char16_t * write = *out;
+#if UTF8_DECODER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	while (end - in >= 16) {
+		__m128i block = _mm_loadu_si128((const __m128i *)in);
+		if (_mm_movemask_epi8(block) != 0) {
+			break;
+		}
+		_mm_storeu_si128((__m128i *)write, _mm_unpacklo_epi8(block, zero));
+		_mm_storeu_si128((__m128i *)(write + 8), _mm_unpackhi_epi8(block, zero));
+		in += 16;
+		write += 16;
+	}
+#endif
+	while (in < end && *in < 0x80) {
+		*write++ = *in++;
+	}
+	*out = write;
+	return in;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	putCodePoint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	char16_t * putCodePoint(char16_t * out, uint32_t codePoint)
+--					char16_t * out:			where to write
+--					uint32_t codePoint:		a scalar value, never a surrogate
+--
+-- RETURNS:		char16_t * - one past the last unit written
+----------------------------------------------------------------------------------------------------------------------*/
+static inline char16_t * putCodePoint(char16_t * out, uint32_t codePoint) {
+	if (codePoint < 0x10000) {
+		*out++ = (char16_t)codePoint;
+	}
+	else {
+		codePoint -= 0x10000;
+		*out++ = (char16_t)(0xD800 + (codePoint >> 10));
+		*out++ = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+	}
+	return out;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	decode
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t decode(const char * data, size_t length, char16_t * out)
+--					const char * data:	UTF-8 bytes, cut anywhere
+--					size_t length:		number of bytes in data
+--					char16_t * out:		room for utf8MaxOutput(length) units
+--
+-- RETURNS:		size_t - number of UTF-16 units written to out
+--
+-- NOTES:
+-- A character whose last bytes have not arrived yet is kept and not written; the next call or flush finishes it.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t Utf8Decoder::decode(const char * data, size_t length, char16_t * out) {
+	const uint8_t * in = (const uint8_t *)data;
+	const uint8_t * end = in + length;
+	char16_t * start = out;
+
+	// Work on locals so the state is not reloaded after every store to out
+	uint32_t value = codePoint;
+	int remaining = needed;
+	uint8_t low = lower;
+	uint8_t high = upper;
+
+	while (in < end) {
+		if (remaining == 0) {
+			if (*in < 0x80) {
+				in = widenAscii(in, end, &out);
+				if (in == end) {
+					break;
+				}
+			}
+
+			uint8_t lead = *in++;
+			low = 0x80;
+			high = 0xBF;
+			if (lead >= 0xC2 && lead <= 0xDF) {
+				remaining = 1;
+				value = lead & 0x1F;
+			}
+			else if (lead >= 0xE0 && lead <= 0xEF) {
+				remaining = 2;
+				value = lead & 0x0F;
+				if (lead == 0xE0) {
+					low = 0xA0;			// no overlongs
+				}
+				else if (lead == 0xED) {
+					high = 0x9F;		// no surrogates
+				}
+			}
+			else if (lead >= 0xF0 && lead <= 0xF4) {
+				remaining = 3;
+				value = lead & 0x07;
+				if (lead == 0xF0) {
+					low = 0x90;			// no overlongs
+				}
+				else if (lead == 0xF4) {
+					high = 0x8F;		// nothing past U+10FFFF
+				}
+			}
+			else {
+				// A stray continuation byte, C0, C1 or F5-FF
+				*out++ = REPLACEMENT_CHARACTER;
+			}
+			continue;
+		}
+
+		uint8_t byte = *in;
+		if (byte < low || byte > high) {
+			// Replace what was kept and decode this byte again as the start of something new
+			*out++ = REPLACEMENT_CHARACTER;
+			remaining = 0;
+			continue;
+		}
+		in++;
+		low = 0x80;
+		high = 0xBF;
+		value = (value << 6) | (byte & 0x3F);
+		if (--remaining == 0) {
+			out = putCodePoint(out, value);
+		}
+	}
+
+	codePoint = value;
+	needed = remaining;
+	lower = low;
+	upper = high;
+	return (size_t)(out - start);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	flush
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t flush(char16_t * out)
+--					char16_t * out:		room for one unit
+--
+-- RETURNS:		size_t - 1 if an unfinished character was replaced, otherwise 0
+--
+-- NOTES:
+-- Call this function when the text is known to have ended, such as before a control byte, so a character cut short
+-- shows as U+FFFD instead of joining with whatever comes after.
+----------------------------------------------------------------------------------------------------------------------*/
+size_t Utf8Decoder::flush(char16_t * out) {
+	if (needed == 0) {
+		return 0;
+	}
+	*out = REPLACEMENT_CHARACTER;
+	reset();
+	return 1;
+}
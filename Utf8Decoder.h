@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Utf8Decoder.h -	An incremental UTF-8 to UTF-16 decoder.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					size_t decode(const char * data, size_t length, char16_t * out)
+--					size_t flush(char16_t * out)
+--					bool hasPending(void) const
+--					size_t utf8MaxOutput(size_t length)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Serial reads end wherever the driver's buffer did, so a character is often split between two chunks. The decoder
+-- keeps the first part of such a character and finishes it on the next call; nothing is lost or doubled however
+-- the input is cut. It never allocates: the caller passes a buffer of at least utf8MaxOutput(length) units.
+--
+-- Malformed input follows the Unicode "maximal subpart" practice: each ill-formed piece becomes one U+FFFD and the
+-- byte that exposed it is decoded afresh, so one bad byte never swallows the good text after it. Overlong forms,
+-- surrogates and values past U+10FFFF are rejected at their first byte that proves it. Characters outside the BMP
+-- come out as surrogate pairs.
+--
+-- Runs of ASCII, which is most of what a serial console sends, are widened sixteen bytes at a time with SSE2 where
+-- the target has it, and a byte at a time elsewhere.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr char16_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	utf8MaxOutput
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t utf8MaxOutput(size_t length)
+--					size_t length:	bytes passed to one decode call
+--
+-- RETURNS:		size_t - the most UTF-16 units that call can write
+--
+-- NOTES:
+-- One unit per byte, plus one for a character or error carried in from the previous call.
+----------------------------------------------------------------------------------------------------------------------*/
+constexpr size_t utf8MaxOutput(size_t length) {
+	return length + 1;
+}
+
+class Utf8Decoder {
+private:
+	uint32_t codePoint = 0;
+	int needed = 0;			// continuation bytes still to come; 0 between characters
+	uint8_t lower = 0x80;	// allowed range of the next continuation byte
+	uint8_t upper = 0xBF;
+public:
+	size_t decode(const char * data, size_t length, char16_t * out);
+	size_t flush(char16_t * out);
+	bool hasPending() const { return needed != 0; };
+	void reset() { needed = 0; lower = 0x80; upper = 0xBF; };
+};
@@ -0,0 +1,195 @@
+#include "VtParser.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		VtParser.cpp -	A streaming VT100/ANSI escape sequence parser.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void collect(uint8_t byte)
+--					void param(uint8_t byte)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The two tables below are the whole grammar. A transition byte holds the action in its high nibble and the next
+-- state in its low nibble. ESC, CAN and SUB do the same thing from every state; everything else is per state.
+----------------------------------------------------------------------------------------------------------------------*/
+
+#define VT(action, next)	(uint8_t)(((action) << 4) | (next))
+
+// Class of every byte value; see VtClass in VtParser.h
+const uint8_t VT_BYTE_CLASS[256] = {
+	// 0x00-0x0F: NUL ... BEL BS HT LF VT FF CR SO SI
+	VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_BEL,
+	VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE,
+	// 0x10-0x1F: DLE ... CAN EM SUB ESC FS GS RS US
+	VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE,
+	VC_CANCEL, VC_EXECUTE, VC_CANCEL, VC_ESC, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE, VC_EXECUTE,
+	// 0x20-0x2F: space ! " # $ % & ' ( ) * + , - . /
+	VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE,
+	VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE,
+	VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE,
+	VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE, VC_INTERMEDIATE,
+	// 0x30-0x3F: 0-9 : ; < = > ?
+	VC_DIGIT, VC_DIGIT, VC_DIGIT, VC_DIGIT, VC_DIGIT, VC_DIGIT, VC_DIGIT, VC_DIGIT,
+	VC_DIGIT, VC_DIGIT, VC_COLON, VC_SEMICOLON, VC_PRIVATE, VC_PRIVATE, VC_PRIVATE, VC_PRIVATE,
+	// 0x40-0x4F: @ A-O
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	// 0x50-0x5F: P-Z [ \ ] ^ _
+	VC_STRING, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	VC_STRING, VC_FINAL, VC_FINAL, VC_CSI, VC_FINAL, VC_OSC, VC_STRING, VC_STRING,
+	// 0x60-0x6F: ` a-o
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	// 0x70-0x7F: p-z { | } ~ DEL
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL,
+	VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_FINAL, VC_DEL,
+	// 0x80-0xFF
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH,
+	VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH, VC_HIGH
+};
+
+// Columns: EXECUTE BEL CANCEL ESC INTERMEDIATE DIGIT COLON SEMICOLON PRIVATE FINAL CSI OSC STRING DEL HIGH
+const uint8_t VT_TRANSITIONS[VT_STATE_COUNT][VC_CLASS_COUNT] = {
+	// VT_GROUND: printable bytes normally never get here, scanPlainText takes them in bulk
+	{ VT(VT_EXECUTE, VT_GROUND), VT(VT_EXECUTE, VT_GROUND), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND),
+	  VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND), VT(VT_PRINT, VT_GROUND),
+	  VT(VT_PRINT, VT_GROUND), VT(VT_NONE, VT_GROUND), VT(VT_PRINT, VT_GROUND) },
+	// VT_ESCAPE
+	{ VT(VT_EXECUTE, VT_ESCAPE), VT(VT_EXECUTE, VT_ESCAPE), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_COLLECT, VT_ESCAPE_INTERMEDIATE), VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND),
+	  VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND),
+	  VT(VT_NONE, VT_CSI_ENTRY), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_STRING_IGNORE),
+	  VT(VT_NONE, VT_ESCAPE), VT(VT_NONE, VT_GROUND) },
+	// VT_ESCAPE_INTERMEDIATE
+	{ VT(VT_EXECUTE, VT_ESCAPE_INTERMEDIATE), VT(VT_EXECUTE, VT_ESCAPE_INTERMEDIATE), VT(VT_EXECUTE, VT_GROUND),
+	  VT(VT_CLEAR, VT_ESCAPE), VT(VT_COLLECT, VT_ESCAPE_INTERMEDIATE), VT(VT_ESC_DISPATCH, VT_GROUND),
+	  VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND),
+	  VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_ESC_DISPATCH, VT_GROUND),
+	  VT(VT_ESC_DISPATCH, VT_GROUND), VT(VT_NONE, VT_ESCAPE_INTERMEDIATE), VT(VT_NONE, VT_GROUND) },
+	// VT_CSI_ENTRY
+	{ VT(VT_EXECUTE, VT_CSI_ENTRY), VT(VT_EXECUTE, VT_CSI_ENTRY), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_COLLECT, VT_CSI_INTERMEDIATE), VT(VT_PARAM, VT_CSI_PARAM), VT(VT_NONE, VT_CSI_IGNORE),
+	  VT(VT_PARAM, VT_CSI_PARAM), VT(VT_COLLECT, VT_CSI_PARAM), VT(VT_CSI_DISPATCH, VT_GROUND),
+	  VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND),
+	  VT(VT_NONE, VT_CSI_ENTRY), VT(VT_NONE, VT_CSI_IGNORE) },
+	// VT_CSI_PARAM
+	{ VT(VT_EXECUTE, VT_CSI_PARAM), VT(VT_EXECUTE, VT_CSI_PARAM), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_COLLECT, VT_CSI_INTERMEDIATE), VT(VT_PARAM, VT_CSI_PARAM), VT(VT_NONE, VT_CSI_IGNORE),
+	  VT(VT_PARAM, VT_CSI_PARAM), VT(VT_NONE, VT_CSI_IGNORE), VT(VT_CSI_DISPATCH, VT_GROUND),
+	  VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND),
+	  VT(VT_NONE, VT_CSI_PARAM), VT(VT_NONE, VT_CSI_IGNORE) },
+	// VT_CSI_INTERMEDIATE
+	{ VT(VT_EXECUTE, VT_CSI_INTERMEDIATE), VT(VT_EXECUTE, VT_CSI_INTERMEDIATE), VT(VT_EXECUTE, VT_GROUND),
+	  VT(VT_CLEAR, VT_ESCAPE), VT(VT_COLLECT, VT_CSI_INTERMEDIATE), VT(VT_NONE, VT_CSI_IGNORE),
+	  VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE),
+	  VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_CSI_DISPATCH, VT_GROUND),
+	  VT(VT_CSI_DISPATCH, VT_GROUND), VT(VT_NONE, VT_CSI_INTERMEDIATE), VT(VT_NONE, VT_CSI_IGNORE) },
+	// VT_CSI_IGNORE: a malformed sequence is swallowed up to its final byte
+	{ VT(VT_EXECUTE, VT_CSI_IGNORE), VT(VT_EXECUTE, VT_CSI_IGNORE), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE),
+	  VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_GROUND), VT(VT_NONE, VT_GROUND), VT(VT_NONE, VT_GROUND),
+	  VT(VT_NONE, VT_GROUND), VT(VT_NONE, VT_CSI_IGNORE), VT(VT_NONE, VT_CSI_IGNORE) },
+	// VT_OSC_STRING: ended by BEL or by ST (ESC \), which arrives as an escape sequence
+	{ VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_GROUND), VT(VT_EXECUTE, VT_GROUND), VT(VT_CLEAR, VT_ESCAPE),
+	  VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING),
+	  VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING),
+	  VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING), VT(VT_NONE, VT_OSC_STRING) },
+	// VT_STRING_IGNORE: DCS, SOS, PM and APC, ended only by ST
+	{ VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE), VT(VT_EXECUTE, VT_GROUND),
+	  VT(VT_CLEAR, VT_ESCAPE), VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE),
+	  VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE),
+	  VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE),
+	  VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE), VT(VT_NONE, VT_STRING_IGNORE) }
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	collect
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void collect(uint8_t byte)
+--					uint8_t byte:	an intermediate byte or a private marker
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Bytes past VT_MAX_INTERMEDIATES are dropped and the sequence is marked overflowed so the handler can ignore it.
+----------------------------------------------------------------------------------------------------------------------*/
+void VtParser::collect(uint8_t byte) {
+	if (sequence.intermediateCount >= VT_MAX_INTERMEDIATES) {
+		sequence.isOverflowed = true;
+		return;
+	}
+	sequence.intermediates[sequence.intermediateCount++] = (char)byte;
+	sequence.intermediates[sequence.intermediateCount] = '\0';
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	param
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void param(uint8_t byte)
+--					uint8_t byte:	a digit or ';'
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- A ';' with nothing before it starts with an omitted (0) parameter, so "CSI ;5H" has two parameters. Values stop
+-- growing at VT_MAX_PARAM_VALUE; parameters past VT_MAX_PARAMS are dropped and mark the sequence overflowed.
+----------------------------------------------------------------------------------------------------------------------*/
+void VtParser::param(uint8_t byte) {
+	if (sequence.paramCount == 0) {
+		sequence.params[0] = 0;
+		sequence.paramCount = 1;
+	}
+	if (byte == ';') {
+		if (sequence.paramCount >= VT_MAX_PARAMS) {
+			sequence.isOverflowed = true;
+			return;
+		}
+		sequence.params[sequence.paramCount++] = 0;
+		return;
+	}
+
+	uint16_t * value = &sequence.params[sequence.paramCount - 1];
+	unsigned next = *value * 10u + (byte - '0');
+	*value = next > VT_MAX_PARAM_VALUE ? VT_MAX_PARAM_VALUE : (uint16_t)next;
+}
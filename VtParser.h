@@ -0,0 +1,204 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "TextScan.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		VtParser.h -	A streaming VT100/ANSI escape sequence parser.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void feed(const char * data, size_t length, Handler & handler)
+--					void reset(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Printable runs are found by the runtime-selected TextScan kernel
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The states and transitions follow the DEC parser state diagram (the one xterm and most emulators are built on),
+-- cut down to what a VT100 needs: control strings (OSC, DCS, SOS, PM, APC) are recognised and skipped, not passed
+-- on. Each byte is mapped to one of a few classes, and one table indexed by state and class gives the action and the
+-- next state, packed into a byte. The parser keeps all of its state between calls, so a sequence split across two
+-- reads is handled the same as one that arrives whole.
+--
+-- In the ground state the table is not used at all: scanPlainText finds the end of each plain ASCII stretch with
+-- the widest vector kernel the CPU has, bytes from 0x80 up are stepped over as printable, and the whole run up to
+-- the next control byte goes to the handler as one print. High bytes are left for the handler to decode.
+--
+-- The handler is any type with these members, called as the input is parsed:
+--
+--		void print(const char * text, size_t length)		a run of printable bytes, 0x20-0x7E and 0x80-0xFF
+--		void execute(uint8_t control)						a C0 control such as CR, LF, BS or BEL
+--		void escDispatch(const VtSequence & sequence)		ESC [intermediates] final
+--		void csiDispatch(const VtSequence & sequence)		CSI [private] [params] [intermediates] final
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr int VT_MAX_PARAMS = 16;
+constexpr int VT_MAX_INTERMEDIATES = 2;
+constexpr uint16_t VT_MAX_PARAM_VALUE = 9999;
+
+// A parsed escape or control sequence; params are 0 when omitted
+struct VtSequence {
+	uint16_t params[VT_MAX_PARAMS];
+	int paramCount;
+	char intermediates[VT_MAX_INTERMEDIATES + 1];
+	int intermediateCount;
+	uint8_t finalByte;
+	bool isOverflowed;
+};
+
+enum VtState : uint8_t {
+	VT_GROUND,
+	VT_ESCAPE,
+	VT_ESCAPE_INTERMEDIATE,
+	VT_CSI_ENTRY,
+	VT_CSI_PARAM,
+	VT_CSI_INTERMEDIATE,
+	VT_CSI_IGNORE,
+	VT_OSC_STRING,
+	VT_STRING_IGNORE,
+	VT_STATE_COUNT
+};
+
+enum VtAction : uint8_t {
+	VT_NONE,
+	VT_PRINT,
+	VT_EXECUTE,
+	VT_CLEAR,
+	VT_COLLECT,
+	VT_PARAM,
+	VT_ESC_DISPATCH,
+	VT_CSI_DISPATCH
+};
+
+enum VtClass : uint8_t {
+	VC_EXECUTE,			// C0 controls other than the ones below
+	VC_BEL,				// 0x07, also ends an OSC string
+	VC_CANCEL,			// CAN and SUB abort any sequence
+	VC_ESC,
+	VC_INTERMEDIATE,	// 0x20-0x2F
+	VC_DIGIT,			// 0x30-0x39
+	VC_COLON,			// 0x3A
+	VC_SEMICOLON,		// 0x3B
+	VC_PRIVATE,			// 0x3C-0x3F
+	VC_FINAL,			// 0x40-0x7E not listed below
+	VC_CSI,				// '['
+	VC_OSC,				// ']'
+	VC_STRING,			// 'P', 'X', '^', '_': DCS, SOS, PM and APC
+	VC_DEL,
+	VC_HIGH,			// 0x80-0xFF
+	VC_CLASS_COUNT
+};
+
+extern const uint8_t VT_BYTE_CLASS[256];
+extern const uint8_t VT_TRANSITIONS[VT_STATE_COUNT][VC_CLASS_COUNT];
+
+class VtParser {
+private:
+	uint8_t state = VT_GROUND;
+	VtSequence sequence;
+
+	void clear() {
+		sequence.paramCount = 0;
+		sequence.intermediateCount = 0;
+		sequence.intermediates[0] = '\0';
+		sequence.isOverflowed = false;
+	};
+	void collect(uint8_t byte);
+	void param(uint8_t byte);
+public:
+	VtParser() { clear(); };
+
+	void reset() { state = VT_GROUND; clear(); };
+	uint8_t getState() const { return state; };
+
+	/*--------------------------------------------------------------------------------------------------------------
+	-- FUNCTION:	feed
+	--
+	-- DATE:		Oct 17, 2026
+	--
+	-- REVISIONS:	(N/A)
+	--
+	-- DESIGNER:	Henry Ho
+	--
+	-- PROGRAMMER:	Henry Ho
+	--
+	-- INTERFACE:	void feed(const char * data, size_t length, Handler & handler)
+	--					const char * data:		received bytes
+	--					size_t length:			number of bytes in data
+	--					Handler & handler:		receives the printable runs, controls and sequences
+	--
+	-- RETURNS:		void
+	--
+	-- NOTES:
+	-- A printable run that reaches the end of data is handed over at once, not held back for the next call.
+	--------------------------------------------------------------------------------------------------------------*/
+	template <typename Handler>
+	void feed(const char * data, size_t length, Handler & handler) {
+		const uint8_t * text = (const uint8_t *)data;
+		const uint8_t * end = text + length;
+
+		while (text < end) {
+			if (state == VT_GROUND) {
+				// Bulk path: the whole printable run in one call
+				const uint8_t * run = text;
+				for (;;) {
+					text = scanPlainText(text, end);
+					if (text == end || *text < 0x80) {
+						break;
+					}
+					while (text < end && *text >= 0x80) {
+						text++;
+					}
+				}
+				if (text != run) {
+					handler.print((const char *)run, (size_t)(text - run));
+				}
+				if (text == end) {
+					break;
+				}
+			}
+
+			uint8_t byte = *text++;
+			uint8_t transition = VT_TRANSITIONS[state][VT_BYTE_CLASS[byte]];
+			state = transition & 0x0F;
+
+			switch ((VtAction)(transition >> 4)) {
+			case VT_PRINT:
+				handler.print((const char *)text - 1, 1);
+				break;
+			case VT_EXECUTE:
+				handler.execute(byte);
+				break;
+			case VT_CLEAR:
+				clear();
+				break;
+			case VT_COLLECT:
+				collect(byte);
+				break;
+			case VT_PARAM:
+				param(byte);
+				break;
+			case VT_ESC_DISPATCH:
+				sequence.finalByte = byte;
+				handler.escDispatch(sequence);
+				break;
+			case VT_CSI_DISPATCH:
+				sequence.finalByte = byte;
+				handler.csiDispatch(sequence);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+};
@@ -0,0 +1,95 @@
+#include <windows.h>
+#include "Win32PortEnumerator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Win32PortEnumerator.cpp -	PortEnumerator that lists the COM ports Windows has registered.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void scan(std::vector<std::string> * ports)
+--					std::unique_ptr<PortEnumerator> createPortEnumerator(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This file is built on Windows only; LinuxPortEnumerator.cpp provides createPortEnumerator elsewhere.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr DWORD REGISTRY_NAME_SIZE = 256;	// characters in a SERIALCOMM value name, which names the driver's device
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	scan
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void scan(std::vector<std::string> * ports)
+--					std::vector<std::string> * ports:	the name of each port found, such as COM3, is appended
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Each value under the key holds a port name. No port is opened. A machine with no serial ports has no key at all,
+-- which leaves the list empty.
+----------------------------------------------------------------------------------------------------------------------*/
+void Win32PortEnumerator::scan(std::vector<std::string> * ports) {
+	HKEY key;
+	wchar_t valueName[REGISTRY_NAME_SIZE];
+	wchar_t portName[REGISTRY_NAME_SIZE];
+	char name[REGISTRY_NAME_SIZE * 3];
+
+	if (RegOpenKeyExW(HKEY_LOCAL_MACHINE, L"HARDWARE\\DEVICEMAP\\SERIALCOMM", 0, KEY_READ, &key) != ERROR_SUCCESS) {
+		return;
+	}
+	for (DWORD index = 0; ; index++) {
+		DWORD nameLength = REGISTRY_NAME_SIZE;
+		DWORD dataSize = sizeof(portName) - sizeof(wchar_t);
+		DWORD type;
+		LONG result = RegEnumValueW(key, index, valueName, &nameLength, NULL, &type, (LPBYTE)portName, &dataSize);
+
+		if (result == ERROR_NO_MORE_ITEMS) {
+			break;
+		}
+		if (result != ERROR_SUCCESS || type != REG_SZ) {
+			continue;
+		}
+		// Registry strings are not always terminated
+		portName[dataSize / sizeof(wchar_t)] = L'\0';
+		if (WideCharToMultiByte(CP_UTF8, 0, portName, -1, name, sizeof(name), NULL, NULL) > 1) {
+			ports->push_back(name);
+		}
+	}
+	RegCloseKey(key);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createPortEnumerator
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<PortEnumerator> createPortEnumerator(void)
+--
+-- RETURNS:		std::unique_ptr<PortEnumerator> - an enumerator that has not been started
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<PortEnumerator> createPortEnumerator() {
+	return std::unique_ptr<PortEnumerator>(new Win32PortEnumerator());
+}
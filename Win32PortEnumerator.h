@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "PortEnumerator.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Win32PortEnumerator.h -	PortEnumerator that lists the COM ports Windows has registered.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					void scan(std::vector<std::string> * ports)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Every serial port driver lists the ports it has created under HKLM\HARDWARE\DEVICEMAP\SERIALCOMM, so the scan
+-- reads that key instead of trying to open COM1 to COM256 one at a time.
+--
+-- Windows announces a port arriving or leaving by broadcasting WM_DEVICECHANGE to every top-level window, with the
+-- port's name in a DEV_BROADCAST_PORT. There is no watch of the enumerator's own: the window passes each announcement
+-- to addPort or removePort, and the thread ends after the first scan.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class Win32PortEnumerator : public PortEnumerator {
+protected:
+	void scan(std::vector<std::string> * ports) override;
+public:
+	Win32PortEnumerator() {};
+	~Win32PortEnumerator() { stop(); };
+};
@@ -0,0 +1,436 @@
+#include "Win32Transport.h"
+#include "error_codes.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		Win32Transport.cpp -	SerialTransport for a Windows COM port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					PortSettings fromDcb(const DCB & dcb)
+--					void toDcb(const PortSettings & settings, DCB * dcb)
+--					std::unique_ptr<SerialTransport> createSerialTransport(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Tag the write event so writes stay off a multiplexer's completion port
+--					Oct 17, 2026 - Flow control status and receive pausing
+--					Oct 17, 2026 - ClearCommError results are recorded in the LinkTelemetry
+--					Oct 17, 2026 - Cancelling ends waits at once; events are kept across reopening the port
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- This file is built on Windows only; PosixTransport.cpp provides createSerialTransport elsewhere.
+----------------------------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	~Win32Transport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	~Win32Transport(void)
+--
+-- NOTES:
+-- Closes the port if it is still open and releases the events kept between opens.
+----------------------------------------------------------------------------------------------------------------------*/
+Win32Transport::~Win32Transport() {
+	close();
+	if (writeEvent) {
+		CloseHandle(writeEvent);
+	}
+	if (cancelEvent) {
+		CloseHandle(cancelEvent);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	open
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Creates the write and cancel events only the first time
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int open(const std::string & portName)
+--					const std::string & portName:	name of the port, such as "COM1"
+--
+-- RETURNS:		int - 0 on success, otherwise an error code from error_codes.h
+--
+-- NOTES:
+-- Call this function to open the port and size the driver queues. The line settings are left as the driver has
+-- them until configure is called.
+----------------------------------------------------------------------------------------------------------------------*/
+int Win32Transport::open(const std::string & portName) {
+	close();
+	commHandle = CreateFileA(portName.c_str(), GENERIC_READ | GENERIC_WRITE, 0,
+		NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL);
+	if (commHandle == INVALID_HANDLE_VALUE) {
+		return ERROR_OPEN_PORT;
+	}
+
+	if (!GetCommProperties(commHandle, &commProp)) {
+		close();
+		return ERROR_PORT_PROP;
+	}
+	SetupComm(commHandle, RX_DRIVER_QUEUE, TX_DRIVER_QUEUE);
+
+	overlapWrite = {};
+	if (!writeEvent) {
+		writeEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	}
+	if (!cancelEvent) {
+		cancelEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	}
+	if (!writeEvent || !cancelEvent || !commReader.attach(commHandle, cancelEvent)) {
+		close();
+		return ERROR_OPEN_PORT;
+	}
+	ResetEvent(cancelEvent);
+	// The tag bit stops writes from posting to a completion port; the kernel ignores it when it waits on the event
+	overlapWrite.hEvent = (HANDLE)((ULONG_PTR)writeEvent | 1);
+	isCancelled.store(false);
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	configure
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Keeps the settings for setReceivePaused
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int configure(const PortSettings & settings)
+--					const PortSettings & settings:	line settings to apply
+--
+-- RETURNS:		int - 0 on success, otherwise an error code from error_codes.h
+--
+-- NOTES:
+-- The driver's current DCB is read first so fields PortSettings does not cover keep their values. RTS is raised,
+-- which also ends any pause in progress.
+----------------------------------------------------------------------------------------------------------------------*/
+int Win32Transport::configure(const PortSettings & settings) {
+	DCB dcb = {};
+
+	dcb.DCBlength = sizeof(DCB);
+	if (!GetCommState(commHandle, &dcb)) {
+		return ERROR_COM_STATE_NULL;
+	}
+	toDcb(settings, &dcb);
+	if (!SetCommState(commHandle, &dcb)) {
+		return ERROR_PORT_CONFIG;
+	}
+	portSettings = settings;
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	close
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Leaves the events for the next open
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void close(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function once the reader and writer have stopped using the port.
+----------------------------------------------------------------------------------------------------------------------*/
+void Win32Transport::close() {
+	if (commHandle != INVALID_HANDLE_VALUE) {
+		commReader.detach();
+		PurgeComm(commHandle, PURGE_RXCLEAR | PURGE_TXCLEAR);
+		CloseHandle(commHandle);
+		commHandle = INVALID_HANDLE_VALUE;
+	}
+	overlapWrite.hEvent = NULL;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	read
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					char * buffer:		the buffer that receives the chunk
+--					size_t capacity:	size of the buffer in bytes
+--					uint32_t timeout:	ms to wait for data
+--					size_t * bytesRead:	set to the number of bytes placed in the buffer, 0 on timeout
+--
+-- RETURNS:		bool - false if the port failed or was cancelled
+----------------------------------------------------------------------------------------------------------------------*/
+bool Win32Transport::read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) {
+	DWORD received = 0;
+	BOOL isReadable;
+
+	*bytesRead = 0;
+	if (isCancelled.load(std::memory_order_relaxed)) {
+		return false;
+	}
+	isReadable = commReader.read(buffer, capacity < MAXDWORD ? (DWORD)capacity : MAXDWORD, timeout, &received);
+	*bytesRead = received;
+	return isReadable && !isCancelled.load(std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	write
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Waits on the cancel event as well instead of polling for a cancel
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool write(const char * data, size_t length)
+--					const char * data:	the bytes to write
+--					size_t length:		number of bytes in data
+--
+-- RETURNS:		bool - false if the write failed or was cancelled
+--
+-- NOTES:
+-- The wait also ends on the cancel event, so cancel is not held up by a line that flow control has stopped. The
+-- write is then cancelled here as well, in case it was issued after cancel's CancelIoEx.
+----------------------------------------------------------------------------------------------------------------------*/
+bool Win32Transport::write(const char * data, size_t length) {
+	HANDLE waits[2] = { writeEvent, cancelEvent };
+	DWORD written;
+	size_t total = 0;
+
+	while (total < length) {
+		if (isCancelled.load(std::memory_order_relaxed)) {
+			return false;
+		}
+		ResetEvent(writeEvent);
+		if (!WriteFile(commHandle, data + total, (DWORD)(length - total), &written, &overlapWrite)) {
+			if (GetLastError() != ERROR_IO_PENDING) {
+				return false;
+			}
+			if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0) {
+				CancelIoEx(commHandle, &overlapWrite);
+			}
+			if (!GetOverlappedResult(commHandle, &overlapWrite, &written, TRUE)) {
+				return false;
+			}
+		}
+		if (written == 0) {
+			return false;
+		}
+		total += written;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	cancel
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Wakes the waits with the cancel event and aborts outstanding I/O with CancelIoEx
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void cancel(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Call this function from any thread while the port is open. A blocked read or write returns false at once, and
+-- so does every later one until the port is opened again. CancelIoEx aborts the pending WaitCommEvent and WriteFile
+-- of any thread, so both have completed by the time their waits return and the port can be closed straight after.
+-- A multiplexed port must have been removed from its multiplexer first, since its pending read would be cancelled too.
+----------------------------------------------------------------------------------------------------------------------*/
+void Win32Transport::cancel() {
+	isCancelled.store(true);
+	if (cancelEvent) {
+		SetEvent(cancelEvent);
+	}
+	if (commHandle != INVALID_HANDLE_VALUE) {
+		CancelIoEx(commHandle, NULL);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	getFlowStatus
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Records the line errors it clears
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool getFlowStatus(FlowStatus * status)
+--					FlowStatus * status:	set to the output queue and the holds the driver reports
+--
+-- RETURNS:		bool - false if ClearCommError failed
+--
+-- NOTES:
+-- ClearCommError also clears any line errors, so they are recorded here as they are by CommReader. Under an
+-- IocpMultiplexer this is the only place they are collected.
+----------------------------------------------------------------------------------------------------------------------*/
+bool Win32Transport::getFlowStatus(FlowStatus * status) {
+	DWORD errors;
+	COMSTAT comStat;
+
+	if (!ClearCommError(commHandle, &errors, &comStat)) {
+		return false;
+	}
+	CommReader::recordLineStatus(telemetry, errors, comStat);
+	status->outputQueued = comStat.cbOutQue;
+	status->isCtsHeld = comStat.fCtsHold != 0;
+	status->isXoffHeld = comStat.fXoffHold != 0;
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setReceivePaused
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool setReceivePaused(bool paused)
+--					bool paused:	true to ask the far end to stop sending, false to let it resume
+--
+-- RETURNS:		bool - false if neither kind of flow control is set or the driver refused
+--
+-- NOTES:
+-- Drops or raises RTS, and sends XOFF or XON ahead of anything queued, as the settings call for.
+----------------------------------------------------------------------------------------------------------------------*/
+bool Win32Transport::setReceivePaused(bool paused) {
+	bool isSignalled = false;
+
+	if (portSettings.rtsCts) {
+		isSignalled = EscapeCommFunction(commHandle, paused ? CLRRTS : SETRTS) != 0;
+	}
+	if (portSettings.xonXoff) {
+		isSignalled = TransmitCommChar(commHandle, paused ? FLOW_XOFF : FLOW_XON) != 0 || isSignalled;
+	}
+	return isSignalled;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	fromDcb
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	PortSettings fromDcb(const DCB & dcb)
+--					const DCB & dcb:	settings as filled in by CommConfigDialog
+--
+-- RETURNS:		PortSettings
+----------------------------------------------------------------------------------------------------------------------*/
+PortSettings Win32Transport::fromDcb(const DCB & dcb) {
+	PortSettings settings;
+
+	settings.baudRate = dcb.BaudRate;
+	settings.dataBits = dcb.ByteSize;
+	settings.parity = dcb.Parity == ODDPARITY ? ParityMode::Odd :
+		(dcb.Parity == EVENPARITY ? ParityMode::Even : ParityMode::None);
+	settings.stopBits = dcb.StopBits == TWOSTOPBITS ? 2 : 1;
+	settings.rtsCts = dcb.fOutxCtsFlow != 0;
+	settings.xonXoff = dcb.fOutX != 0;
+	return settings;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	toDcb
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - RTS is raised rather than handed to the driver; SerialPipeline drops it to pause
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void toDcb(const PortSettings & settings, DCB * dcb)
+--					const PortSettings & settings:	settings to copy
+--					DCB * dcb:						the DCB to update
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void Win32Transport::toDcb(const PortSettings & settings, DCB * dcb) {
+	dcb->BaudRate = settings.baudRate;
+	dcb->ByteSize = settings.dataBits;
+	dcb->Parity = settings.parity == ParityMode::Odd ? ODDPARITY :
+		(settings.parity == ParityMode::Even ? EVENPARITY : NOPARITY);
+	dcb->StopBits = settings.stopBits == 2 ? TWOSTOPBITS : ONESTOPBIT;
+	dcb->fBinary = TRUE;
+	dcb->fParity = settings.parity != ParityMode::None;
+	dcb->fOutxCtsFlow = settings.rtsCts;
+	dcb->fRtsControl = RTS_CONTROL_ENABLE;
+	dcb->fOutX = settings.xonXoff;
+	dcb->fInX = settings.xonXoff;
+	dcb->XonChar = FLOW_XON;
+	dcb->XoffChar = FLOW_XOFF;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	createSerialTransport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::unique_ptr<SerialTransport> createSerialTransport(void)
+--
+-- RETURNS:		std::unique_ptr<SerialTransport> - a closed transport for this platform
+----------------------------------------------------------------------------------------------------------------------*/
+std::unique_ptr<SerialTransport> createSerialTransport() {
+	return std::unique_ptr<SerialTransport>(new Win32Transport());
+}
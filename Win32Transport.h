@@ -0,0 +1,95 @@
+#pragma once
+
+#include <windows.h>
+#include <atomic>
+#include "CommReader.h"
+#include "SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Win32Transport.h -	SerialTransport for a Windows COM port.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					int open(const std::string & portName)
+--					int configure(const PortSettings & settings)
+--					void close(void)
+--					bool isOpen(void) const
+--					bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead)
+--					bool write(const char * data, size_t length)
+--					void cancel(void)
+--					bool getFlowStatus(FlowStatus * status)
+--					bool setReceivePaused(bool paused)
+--					void setTelemetry(LinkTelemetry * telemetry)
+--					const RxStats & getStats(void) const
+--					HANDLE getHandle(void) const
+--					PortSettings fromDcb(const DCB & dcb)
+--					void toDcb(const PortSettings & settings, DCB * dcb)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Add getHandle and tag the write event for IocpMultiplexer
+--					Oct 17, 2026 - Reports CTS and XOFF holds, and pauses the far end on request
+--					Oct 17, 2026 - Records line errors in the port's LinkTelemetry
+--					Oct 17, 2026 - cancel wakes a blocked read or write at once with a cancel event and CancelIoEx
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The port is opened with FILE_FLAG_OVERLAPPED. Reads go through CommReader. Writes use an OVERLAPPED that lives as
+-- long as the port, so it stays valid while the driver completes the write. Its event handle carries the low tag
+-- bit, which keeps the write's completion off the I/O completion port an IocpMultiplexer attaches the handle to;
+-- the writer waits on the event itself.
+--
+-- cancel sets a manual-reset cancel event that the read and write waits also watch, and cancels whatever I/O is
+-- outstanding on the handle with CancelIoEx, so a disconnect takes as long as the driver needs to abort rather than
+-- a poll interval. The write and cancel events are created by the first open and kept until the transport is
+-- destroyed, so a reopened port only costs the CreateFile and the driver setup.
+--
+-- With RTS/CTS the driver holds output while CTS is low, but RTS is left to SerialPipeline: the reader keeps the
+-- driver's queue empty, so the driver would never drop RTS itself while the ring behind it overflows.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr DWORD RX_DRIVER_QUEUE = 16384;	// driver input queue requested from SetupComm
+constexpr DWORD TX_DRIVER_QUEUE = 4096;		// driver output queue requested from SetupComm
+
+class Win32Transport : public SerialTransport {
+private:
+	HANDLE commHandle = INVALID_HANDLE_VALUE;
+	COMMPROP commProp;
+	CommReader commReader;
+	OVERLAPPED overlapWrite = {};
+	HANDLE writeEvent = NULL;
+	HANDLE cancelEvent = NULL;
+	std::atomic<bool> isCancelled{ false };
+	PortSettings portSettings;
+	LinkTelemetry * telemetry = nullptr;
+public:
+	Win32Transport() {};
+	~Win32Transport();
+	Win32Transport(const Win32Transport &) = delete;
+	Win32Transport & operator=(const Win32Transport &) = delete;
+
+	int open(const std::string & portName) override;
+	int configure(const PortSettings & settings) override;
+	void close() override;
+	bool isOpen() const override { return commHandle != INVALID_HANDLE_VALUE; };
+	bool read(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesRead) override;
+	bool write(const char * data, size_t length) override;
+	void cancel() override;
+	bool getFlowStatus(FlowStatus * status) override;
+	bool setReceivePaused(bool paused) override;
+	void setTelemetry(LinkTelemetry * portTelemetry) override {
+		telemetry = portTelemetry;
+		commReader.setTelemetry(portTelemetry);
+	};
+
+	const RxStats & getStats() const { return commReader.getStats(); };
+	HANDLE getHandle() const { return commHandle; };
+
+	static PortSettings fromDcb(const DCB & dcb);
+	static void toDcb(const PortSettings & settings, DCB * dcb);
+};
@@ -7,8 +7,11 @@
 #include <stdio.h>
 #include <iostream>
 #include "idm.h"
+#include "messages.h"
 #include "modes.h"
 #include "DisplayService.h"
+#include "PortEnumerator.h"
+#include "PortMultiplexer.h"
 #include "SerialCommController.h"
 #include "SessionService.h"
 #include "WINDOW.h"
@@ -47,7 +50,11 @@ LRESULT CALLBACK MainProc(HWND, UINT, WPARAM, LPARAM);
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Controller is constructed in place since it owns the receive ring
+--				Oct 17, 2026 - Window has a vertical scroll bar for the scrollback
+--				Oct 17, 2026 - Starts the PortMultiplexer shared by every port session
+--				Oct 17, 2026 - Window clips its children so painting leaves the status bar alone
+--				Oct 17, 2026 - Lists the serial ports in the background once the window is up
 --
 -- DESIGNER:	Henry Ho
 --
@@ -93,7 +100,7 @@ int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hprevInstance, LPSTR lspsqCmdParam
 	hwnd = CreateWindow(
 		WINDOW_NAME, 
 		WINDOW_NAME, 
-		WS_OVERLAPPEDWINDOW, 
+		WS_OVERLAPPEDWINDOW | WS_VSCROLL | WS_CLIPCHILDREN, 
 		10, 
 		10, 
 		WINDOW_WIDTH, 
@@ -107,15 +114,21 @@ int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hprevInstance, LPSTR lspsqCmdParam
 	ShowWindow(hwnd, nCmdShow);
 	UpdateWindow(hwnd);
 
-	DisplayService displayService = DisplayService{ &hwnd };
-	SerialCommController commController = SerialCommController{ &displayService };
-	sessionService = SessionService{ &commController };
+	DisplayService displayService{ &hwnd };
+	std::unique_ptr<PortMultiplexer> multiplexer = createPortMultiplexer();
+	// If it cannot start, each port falls back to a reader thread of its own
+	multiplexer->start();
+	std::unique_ptr<PortEnumerator> portEnumerator = createPortEnumerator();
+	sessionService = SessionService{ multiplexer.get(), portEnumerator.get(), &displayService };
+	// The port menus say the ports are being searched for until the first scan posts its list
+	portEnumerator->start([hwnd]() { PostMessage(hwnd, WM_PORTS_CHANGED, 0, 0); });
 
 	while (GetMessage(&Msg, NULL, 0, 0))
 	{
 		TranslateMessage(&Msg);
 		DispatchMessage(&Msg);
 	}
+	sessionService.closeAll();
 	return Msg.wParam;
 }
 
@@ -124,7 +137,7 @@ int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hprevInstance, LPSTR lspsqCmdParam
 --
 -- DATE:		Sept 28, 2019
 --
--- REVISIONS:	(N/A)
+-- REVISIONS:	Oct 17, 2026 - Passes lParam on for WM_DEVICECHANGE
 --
 -- DESIGNER:	Henry Ho
 --
@@ -143,6 +156,6 @@ int WINAPI WinMain(HINSTANCE hInst, HINSTANCE hprevInstance, LPSTR lspsqCmdParam
 ----------------------------------------------------------------------------------------------------------------------*/
 LRESULT CALLBACK MainProc(HWND hwnd, UINT Message, WPARAM wParam, LPARAM lParam)
 {
-	sessionService.handleProcess(Message, wParam);
+	sessionService.handleProcess(Message, wParam, lParam);
 	return DefWindowProc(hwnd, Message, wParam, lParam);
 }
@@ -0,0 +1,714 @@
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "Crc.h"
+#include "XmodemTransfer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		XmodemTransfer.cpp -	XMODEM, XMODEM-1K and YMODEM file transfer.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const std::string & path)
+--					bool receive(const std::string & directory)
+--					TransferStatus sendSession(const MappedFile & file, const std::string & name)
+--					TransferStatus receiveSession(const std::string & directory)
+--					int waitForStart(void)
+--					int sendBlock(uint8_t number, const char * data, size_t length, size_t blockSize, char pad)
+--					void setCheck(std::vector<char> & packet, size_t blockSize)
+--					bool sendEndOfFile(void)
+--					int readByteBy(Clock::time_point deadline)
+--					int readBlock(std::vector<char> & block, uint8_t * number, size_t * length)
+--					void purge(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The first block may switch the check; a receiver that has seen a block keeps CRC
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+----------------------------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+constexpr char SOH = 0x01;		// 128-byte block
+constexpr char STX = 0x02;		// 1024-byte block
+constexpr char EOT = 0x04;
+constexpr char ACK = 0x06;
+constexpr char NAK = 0x15;
+constexpr char CAN = 0x18;
+constexpr char CRC_REQUEST = 'C';
+constexpr char CPMEOF = 0x1A;	// pads the last block
+
+constexpr size_t SHORT_BLOCK = 128;
+constexpr size_t LONG_BLOCK = 1024;
+constexpr uint32_t START_INTERVAL = 3000;	// ms between the receiver's requests to start
+constexpr int CRC_REQUESTS = 3;				// 'C's an XMODEM receiver sends before it asks for checksums
+constexpr uint32_t PURGE_TIMEOUT = 100;		// ms of silence that ends a purge
+
+bool isFatal(int result) {
+	return result == FileTransfer::LINK_FAILED || result == FileTransfer::PEER_CANCELLED;
+}
+
+TransferStatus fatalStatus(int result) {
+	return result == FileTransfer::PEER_CANCELLED ? TransferStatus::Cancelled : TransferStatus::Failed;
+}
+
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	send
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool send(const std::string & path)
+--					const std::string & path:	the file to send, UTF-8
+--
+-- RETURNS:		bool - true if every block and the end of the file were acknowledged
+----------------------------------------------------------------------------------------------------------------------*/
+bool XmodemTransfer::send(const std::string & path) {
+	MappedFile file;
+	std::string name = baseName(path);
+	TransferStatus status = TransferStatus::Failed;
+
+	if (!name.empty() && file.open(path)) {
+		status = sendSession(file, name);
+	}
+	if (status == TransferStatus::Failed) {
+		sendAbort();
+	}
+	finish(status);
+	return status == TransferStatus::Complete;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus sendSession(const MappedFile & file, const std::string & name)
+--					const MappedFile & file:	the file to send
+--					const std::string & name:	its name without directories, for YMODEM's block 0
+--
+-- RETURNS:		TransferStatus - Complete, or why the transfer ended
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus XmodemTransfer::sendSession(const MappedFile & file, const std::string & name) {
+	const char * data = file.getData();
+	size_t size = file.getSize();
+	size_t blockSize = protocol == TransferProtocol::Xmodem ? SHORT_BLOCK : LONG_BLOCK;
+	uint8_t number = 1;
+	int result = waitForStart();
+
+	if (result < 0) {
+		return fatalStatus(result);
+	}
+	if (protocol == TransferProtocol::Ymodem) {
+		std::string info = name;
+		char sizeText[32];
+
+		snprintf(sizeText, sizeof(sizeText), "%llu 0 100644", (unsigned long long)size);
+		info.push_back('\0');
+		info += sizeText;
+		info.push_back('\0');
+		result = sendBlock(0, info.data(), info.size(), info.size() > SHORT_BLOCK ? LONG_BLOCK : SHORT_BLOCK, 0);
+		if (result < 0 || (result = waitForStart()) < 0) {
+			return fatalStatus(result);
+		}
+	}
+	beginFile(name, size, 0);
+	for (size_t position = 0; position < size; number++) {
+		size_t length = std::min(blockSize, size - position);
+
+		result = sendBlock(number, data + position, length, length <= SHORT_BLOCK ? SHORT_BLOCK : blockSize,
+			CPMEOF);
+		if (result < 0) {
+			return fatalStatus(result);
+		}
+		position += length;
+		setProgress(position);
+	}
+	if (!sendEndOfFile()) {
+		return TransferStatus::Failed;
+	}
+	if (protocol == TransferProtocol::Ymodem) {
+		// An empty block 0 ends the batch
+		if ((result = waitForStart()) < 0 || (result = sendBlock(0, nullptr, 0, SHORT_BLOCK, 0)) < 0) {
+			return fatalStatus(result);
+		}
+	}
+	return TransferStatus::Complete;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	waitForStart
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Drops repeated requests and lets the first block change the check
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int waitForStart(void)
+--
+-- RETURNS:		int - 'C' or NAK, or LINK_FAILED, PEER_CANCELLED or TIMED_OUT after the retry limit
+--
+-- NOTES:
+-- Sets whether blocks carry a CRC or a checksum from what the receiver asked for last, and lets the first block
+-- change it again.
+----------------------------------------------------------------------------------------------------------------------*/
+int XmodemTransfer::waitForStart() {
+	bool isCan = false;
+
+	for (int errors = 0; errors <= options.retries; ) {
+		int c = readByte(options.timeout);
+
+		if (c == CRC_REQUEST || c == NAK) {
+			int next;
+
+			// Requests repeated while the sender was not listening are already answered
+			while ((next = readByte(0)) == CRC_REQUEST || next == NAK) {
+				c = next;
+			}
+			if (next >= 0) {
+				unreadByte();
+			}
+			useCrc = c == CRC_REQUEST;
+			isNegotiating = true;
+			return c;
+		}
+		if (c == CAN && isCan) {
+			return PEER_CANCELLED;
+		}
+		isCan = c == CAN;
+		if (c == LINK_FAILED) {
+			return c;
+		}
+		if (c == TIMED_OUT) {
+			errors++;
+		}
+	}
+	return TIMED_OUT;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendBlock
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - One deadline per attempt; a 'C' or NAK before the first ACK changes the check and resends
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int sendBlock(uint8_t number, const char * data, size_t length, size_t blockSize, char pad)
+--					uint8_t number:		the block number
+--					const char * data:	the block's bytes
+--					size_t length:		bytes in data, up to blockSize
+--					size_t blockSize:	SHORT_BLOCK or LONG_BLOCK
+--					char pad:			fills the block past length
+--
+-- RETURNS:		int - 0 once acknowledged, or LINK_FAILED, PEER_CANCELLED or TIMED_OUT after the retry limit
+--
+-- NOTES:
+-- Each attempt waits at most options.timeout in all for ACK or NAK; other bytes do not restart the wait. Until the
+-- first block after a start is acknowledged, the receiver may still be asking to start, having lost the block: a
+-- 'C' then counts as a NAK, and either one switches the block to the check it asks for. Once a block has been
+-- acknowledged a 'C' is ignored, since a stray one would send the block twice and leave the second ACK to be
+-- mistaken for the next block's.
+----------------------------------------------------------------------------------------------------------------------*/
+int XmodemTransfer::sendBlock(uint8_t number, const char * data, size_t length, size_t blockSize, char pad) {
+	std::vector<char> packet(3 + blockSize + 2);
+	size_t checkStart = 3 + blockSize;
+
+	packet[0] = blockSize == LONG_BLOCK ? STX : SOH;
+	packet[1] = (char)number;
+	packet[2] = (char)~number;
+	if (length > 0) {
+		memcpy(&packet[3], data, length);
+	}
+	memset(&packet[3 + length], pad, blockSize - length);
+	setCheck(packet, blockSize);
+
+	for (int errors = 0; errors <= options.retries; errors++) {
+		Clock::time_point deadline;
+		bool isCan = false;
+		int c;
+
+		if (errors > 0) {
+			countRetry();
+		}
+		if (!write(packet.data(), checkStart + (useCrc ? 2 : 1))) {
+			return LINK_FAILED;
+		}
+		deadline = Clock::now() + std::chrono::milliseconds(options.timeout);
+		do {
+			c = readByteBy(deadline);
+			if (c == CAN && isCan) {
+				return PEER_CANCELLED;
+			}
+			isCan = c == CAN;
+		} while (c >= 0 && c != ACK && c != NAK && !(isNegotiating && c == CRC_REQUEST));
+		if (c == ACK) {
+			isNegotiating = false;
+			return 0;
+		}
+		if (c == LINK_FAILED) {
+			return c;
+		}
+		if (isNegotiating && (c == CRC_REQUEST || c == NAK)) {
+			useCrc = c == CRC_REQUEST;
+			setCheck(packet, blockSize);
+		}
+	}
+	return TIMED_OUT;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	setCheck
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void setCheck(std::vector<char> & packet, size_t blockSize)
+--					std::vector<char> & packet:	a block with its header and data filled in
+--					size_t blockSize:			SHORT_BLOCK or LONG_BLOCK
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Writes the CRC-16, or the checksum, after the data, whichever the receiver asked for last.
+----------------------------------------------------------------------------------------------------------------------*/
+void XmodemTransfer::setCheck(std::vector<char> & packet, size_t blockSize) {
+	if (useCrc) {
+		uint16_t crc = crc16(&packet[3], blockSize);
+
+		packet[3 + blockSize] = (char)(crc >> 8);
+		packet[4 + blockSize] = (char)crc;
+	}
+	else {
+		uint8_t sum = 0;
+
+		for (size_t i = 0; i < blockSize; i++) {
+			sum = (uint8_t)(sum + (uint8_t)packet[3 + i]);
+		}
+		packet[3 + blockSize] = (char)sum;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendEndOfFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - One deadline per attempt
+--				Oct 17, 2026 - The receiver's NAK of the first EOT is not a retry
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool sendEndOfFile(void)
+--
+-- RETURNS:		bool - true once EOT is acknowledged
+--
+-- NOTES:
+-- The receiver NAKs the first EOT it sees and waits for it again, so that first NAK is part of the exchange and is
+-- not counted as a retry. A NAK of a repeated EOT, or no answer, is.
+----------------------------------------------------------------------------------------------------------------------*/
+bool XmodemTransfer::sendEndOfFile() {
+	bool isConfirming = true;		// the receiver has yet to NAK the first EOT
+
+	for (int errors = 0; errors <= options.retries; ) {
+		Clock::time_point deadline;
+		int c;
+
+		if (!write(&EOT, 1)) {
+			return false;
+		}
+		deadline = Clock::now() + std::chrono::milliseconds(options.timeout);
+		do {
+			c = readByteBy(deadline);
+		} while (c >= 0 && c != ACK && c != NAK);
+		if (c == ACK) {
+			return true;
+		}
+		if (c == LINK_FAILED) {
+			return false;
+		}
+		if (c == NAK && isConfirming) {
+			isConfirming = false;
+			continue;
+		}
+		countRetry();
+		errors++;
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readByteBy
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readByteBy(Clock::time_point deadline)
+--					Clock::time_point deadline:	when to give up waiting
+--
+-- RETURNS:		int - the byte, or TIMED_OUT or LINK_FAILED
+--
+-- NOTES:
+-- readByte with whatever time is left, so a run of unwanted bytes cannot keep a wait going past the deadline.
+----------------------------------------------------------------------------------------------------------------------*/
+int XmodemTransfer::readByteBy(Clock::time_point deadline) {
+	Clock::time_point now = Clock::now();
+
+	if (now >= deadline) {
+		return TIMED_OUT;
+	}
+	return readByte((uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool receive(const std::string & directory)
+--					const std::string & directory:	where received files go, UTF-8; empty for the current directory
+--
+-- RETURNS:		bool - true if the file, or YMODEM's batch, was received whole
+----------------------------------------------------------------------------------------------------------------------*/
+bool XmodemTransfer::receive(const std::string & directory) {
+	TransferStatus status = receiveSession(directory);
+
+	if (status == TransferStatus::Failed) {
+		sendAbort();
+	}
+	finish(status);
+	return status == TransferStatus::Complete;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Stays with CRC once a block has been seen
+--				Oct 17, 2026 - NAKs the first EOT, and again after any block
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus receiveSession(const std::string & directory)
+--					const std::string & directory:	where received files go
+--
+-- RETURNS:		TransferStatus - Complete, or why the transfer ended
+--
+-- NOTES:
+-- Asks to start every START_INTERVAL until the first block arrives, then NAKs bad or missing blocks. XMODEM falls
+-- back to asking for checksums after CRC_REQUESTS unanswered 'C's, but not once any block has started to arrive,
+-- even a damaged one: that sender is already sending CRC blocks. A repeat of the last block, sent because its ACK
+-- was lost, is acknowledged again and dropped; any other block out of order means the two ends have lost step, and
+-- ends the transfer. The first EOT is NAKed and only the sender's repeat of it is acknowledged, since a damaged
+-- header can leave a data byte of 0x04 to be read as EOT. Any block, good or bad, in between starts that over.
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus XmodemTransfer::receiveSession(const std::string & directory) {
+	std::vector<char> block(LONG_BLOCK);
+	bool isYmodem = protocol == TransferProtocol::Ymodem;
+	bool isStarted = false;
+	FILE * file = nullptr;
+	uint64_t size = 0;
+	uint64_t received = 0;
+	uint64_t existing = 0;
+	bool isHeaderNext = isYmodem;		// YMODEM's block 0, not a data block whose number wrapped to 0
+	uint8_t expected = isYmodem ? 0 : 1;
+	uint8_t number = 0;
+	size_t length = 0;
+	int errors = 0;
+	bool isEotSeen = false;				// NAKed once; the next EOT is the sender's
+	char request = CRC_REQUEST;
+
+	auto fail = [&](TransferStatus status) {
+		if (file != nullptr) {
+			fclose(file);
+		}
+		return status;
+	};
+
+	if (!isYmodem) {
+		file = openReceived(directory, options.receiveName, 0, &existing);
+		if (file == nullptr) {
+			return TransferStatus::Failed;
+		}
+		beginFile(options.receiveName, 0, 0);
+	}
+	useCrc = true;
+	isBlockSeen = false;
+	if (!write(&request, 1)) {
+		return fail(TransferStatus::Failed);
+	}
+	for (;;) {
+		int result = readBlock(block, &number, &length);
+
+		if (isFatal(result)) {
+			return fail(fatalStatus(result));
+		}
+		if (result == TIMED_OUT || result == FRAME_ERROR) {
+			if (++errors > options.retries) {
+				return fail(TransferStatus::Failed);
+			}
+			countRetry();
+			purge();
+			// A bad block is not the EOT repeated, so a later EOT has to be confirmed again
+			if (result == FRAME_ERROR) {
+				isEotSeen = false;
+			}
+			// A sender that has answered with a block speaks CRC; only a silent one may want checksums
+			if (!isStarted && !isYmodem && !isBlockSeen && errors == CRC_REQUESTS) {
+				request = NAK;
+				useCrc = false;
+			}
+			if (!write(isStarted ? &NAK : &request, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			continue;
+		}
+		if (result == EOT && !isEotSeen) {
+			// A data byte read past a damaged header can look like EOT; only a repeated one ends the file
+			isEotSeen = true;
+			if (!write(&NAK, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			continue;
+		}
+		if (result == EOT) {
+			isEotSeen = false;
+			if (!write(&ACK, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			if (file != nullptr && fclose(file) != 0) {
+				file = nullptr;
+				return TransferStatus::Failed;
+			}
+			file = nullptr;
+			if (!isYmodem) {
+				return TransferStatus::Complete;
+			}
+			// Ask for the next block 0, which names another file or ends the batch
+			expected = 0;
+			isHeaderNext = true;
+			isStarted = false;
+			if (!write(&request, 1)) {
+				return TransferStatus::Failed;
+			}
+			continue;
+		}
+
+		isStarted = true;
+		isEotSeen = false;
+		errors = 0;
+		if (number == (uint8_t)(expected - 1) && !isHeaderNext) {
+			if (!write(&ACK, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			continue;
+		}
+		if (number != expected) {
+			return fail(TransferStatus::Failed);
+		}
+		if (isHeaderNext) {
+			block[length - 1] = '\0';
+			std::string name = baseName(std::string(block.data()));
+			size_t nameLength = strlen(block.data());
+
+			if (!write(&ACK, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			if (block[0] == '\0') {
+				return TransferStatus::Complete;
+			}
+			if (name.empty()) {
+				name = options.receiveName;
+			}
+			size = nameLength + 1 < length ? strtoull(block.data() + nameLength + 1, nullptr, 10) : 0;
+			received = 0;
+			file = openReceived(directory, name, 0, &existing);
+			if (file == nullptr) {
+				return TransferStatus::Failed;
+			}
+			beginFile(name, size, 0);
+			expected = 1;
+			isHeaderNext = false;
+			// Until block 1 arrives the sender takes a NAK as a request for checksums, so keep asking with 'C'
+			isStarted = false;
+			if (!write(&request, 1)) {
+				return fail(TransferStatus::Failed);
+			}
+			continue;
+		}
+
+		size_t keep = length;
+
+		if (isYmodem && size > 0) {
+			keep = (size_t)std::min<uint64_t>(length, size - std::min(size, received));
+		}
+		if (keep > 0 && fwrite(block.data(), 1, keep, file) != keep) {
+			return fail(TransferStatus::Failed);
+		}
+		received += keep;
+		setProgress(received);
+		expected++;
+		if (!write(&ACK, 1)) {
+			return fail(TransferStatus::Failed);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readBlock
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Sets isBlockSeen
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readBlock(std::vector<char> & block, uint8_t * number, size_t * length)
+--					std::vector<char> & block:	filled with the block's data, LONG_BLOCK bytes at most
+--					uint8_t * number:			set to the block number
+--					size_t * length:			set to SHORT_BLOCK or LONG_BLOCK
+--
+-- RETURNS:		int - SOH or STX for a good block, EOT, or TIMED_OUT, LINK_FAILED, FRAME_ERROR or PEER_CANCELLED
+--
+-- NOTES:
+-- Noise before the block's first byte is skipped. The wait for a block to start is at most START_INTERVAL, so the
+-- request to start, or the NAK for a lost block, is repeated promptly. isBlockSeen is set once a block starts,
+-- whether or not it turns out good.
+----------------------------------------------------------------------------------------------------------------------*/
+int XmodemTransfer::readBlock(std::vector<char> & block, uint8_t * number, size_t * length) {
+	uint32_t firstWait = std::min(options.timeout, START_INTERVAL);
+	bool isCan = false;
+	int start;
+
+	for (;;) {
+		start = readByte(firstWait);
+		if (start < 0 || start == SOH || start == STX || start == EOT) {
+			break;
+		}
+		if (start == CAN && isCan) {
+			return PEER_CANCELLED;
+		}
+		isCan = start == CAN;
+	}
+	if (start < 0 || start == EOT) {
+		return start;
+	}
+	isBlockSeen = true;
+
+	size_t blockSize = start == STX ? LONG_BLOCK : SHORT_BLOCK;
+	int header[2];
+	int check[2];
+	int checkLength = useCrc ? 2 : 1;
+
+	for (int i = 0; i < 2; i++) {
+		if ((header[i] = readByte(options.timeout)) < 0) {
+			return header[i];
+		}
+	}
+	for (size_t i = 0; i < blockSize; i++) {
+		int c = readByte(options.timeout);
+
+		if (c < 0) {
+			return c;
+		}
+		block[i] = (char)c;
+	}
+	for (int i = 0; i < checkLength; i++) {
+		if ((check[i] = readByte(options.timeout)) < 0) {
+			return check[i];
+		}
+	}
+	if ((header[0] ^ header[1]) != 0xFF) {
+		return FRAME_ERROR;
+	}
+	if (useCrc) {
+		uint16_t crc = crc16(block.data(), blockSize);
+
+		if (check[0] != (crc >> 8) || check[1] != (crc & 0xFF)) {
+			return FRAME_ERROR;
+		}
+	}
+	else {
+		uint8_t sum = 0;
+
+		for (size_t i = 0; i < blockSize; i++) {
+			sum = (uint8_t)(sum + (uint8_t)block[i]);
+		}
+		if (check[0] != sum) {
+			return FRAME_ERROR;
+		}
+	}
+	*number = (uint8_t)header[0];
+	*length = blockSize;
+	return start;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	purge
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void purge(void)
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Drops whatever is left of a bad block, so the NAK's answer starts on a clean line.
+----------------------------------------------------------------------------------------------------------------------*/
+void XmodemTransfer::purge() {
+	while (readByte(PURGE_TIMEOUT) >= 0) {
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "FileTransfer.h"
+#include "MappedFile.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		XmodemTransfer.h -	XMODEM, XMODEM-1K and YMODEM file transfer.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const std::string & path)
+--					bool receive(const std::string & directory)
+--					TransferStatus sendSession(const MappedFile & file, const std::string & name)
+--					TransferStatus receiveSession(const std::string & directory)
+--					int waitForStart(void)
+--					int sendBlock(uint8_t number, const char * data, size_t length, size_t blockSize, char pad)
+--					void setCheck(std::vector<char> & packet, size_t blockSize)
+--					bool sendEndOfFile(void)
+--					int readByteBy(Clock::time_point deadline)
+--					int readBlock(std::vector<char> & block, uint8_t * number, size_t * length)
+--					void purge(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The first block may switch the check; a receiver that has seen a block keeps CRC
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- The receiver drives: it sends 'C' to ask for CRC-16 blocks (or NAK, for XMODEM, to ask for checksums once a few
+-- 'C's have gone unanswered), then ACK or NAK for each block. The sender sends one block and waits, so throughput
+-- falls with the link's round trip. Blocks are 128 bytes for XMODEM and 1024 for XMODEM-1K and YMODEM, with a
+-- short last block sent as 128. YMODEM's block 0 carries the name and length, so the padding after the end is cut
+-- off; an empty block 0 ends the batch. XMODEM sends no name, so its receiver writes options.receiveName and keeps
+-- the padding. None of these can resume.
+----------------------------------------------------------------------------------------------------------------------*/
+
+class XmodemTransfer : public FileTransfer {
+private:
+	TransferProtocol protocol;
+	bool useCrc = true;
+	bool isNegotiating = false;		// sending: no block has been acknowledged since the receiver asked to start
+	bool isBlockSeen = false;		// receiving: a block has started to arrive, so the sender is sending CRC blocks
+
+	TransferStatus sendSession(const MappedFile & file, const std::string & name);
+	TransferStatus receiveSession(const std::string & directory);
+	int waitForStart();
+	int sendBlock(uint8_t number, const char * data, size_t length, size_t blockSize, char pad);
+	void setCheck(std::vector<char> & packet, size_t blockSize);
+	bool sendEndOfFile();
+	int readByteBy(Clock::time_point deadline);
+	int readBlock(std::vector<char> & block, uint8_t * number, size_t * length);
+	void purge();
+public:
+	XmodemTransfer(TransferProtocol transferProtocol, TransferChannel * link, const TransferOptions & transferOptions) :
+		FileTransfer(link, transferOptions), protocol(transferProtocol) {};
+
+	bool send(const std::string & path) override;
+	bool receive(const std::string & directory) override;
+};
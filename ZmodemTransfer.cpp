@@ -0,0 +1,1253 @@
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "Crc.h"
+#include "ZmodemTransfer.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ZmodemTransfer.cpp -	ZMODEM file transfer, streaming with CRC-32 subpackets.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const std::string & path)
+--					bool receive(const std::string & directory)
+--					TransferStatus offerFile(const MappedFile & file, const std::string & name, uint32_t * offset)
+--					TransferStatus sendData(const MappedFile & file, uint32_t offset)
+--					bool endSession(void)
+--					TransferStatus receiveSession(const std::string & directory)
+--					TransferStatus receiveFile(const std::string & directory, std::vector<char> & info,
+--						size_t length, bool isResume)
+--					TransferStatus receiveData(FILE * file, uint32_t offset, std::vector<char> & data)
+--					void appendEscaped(const char * data, size_t length)
+--					void appendRaw(const char * data, size_t length)
+--					bool flushFrame(void)
+--					bool sendHexHeader(int type, uint32_t argument)
+--					bool sendBinaryHeader(int type, uint32_t argument)
+--					bool sendSubpacket(const char * data, size_t length, char end)
+--					int readEscaped(uint32_t timeout)
+--					int readHeader(uint32_t timeout, uint32_t * argument)
+--					int readBinaryHeader(bool is32, uint32_t timeout, uint32_t * argument)
+--					int readHexHeader(uint32_t timeout, uint32_t * argument)
+--					int pollHeader(uint32_t * argument)
+--					int readSubpacket(std::vector<char> & data, size_t * length)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+----------------------------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+// Framing
+constexpr char ZPAD = '*';
+constexpr char ZDLE = 0x18;
+constexpr char ZBIN = 'A';
+constexpr char ZHEX = 'B';
+constexpr char ZBIN32 = 'C';
+constexpr char XON = 0x11;
+constexpr char XOFF = 0x13;
+constexpr char CAN = 0x18;
+
+// Header types
+constexpr int ZRQINIT = 0;
+constexpr int ZRINIT = 1;
+constexpr int ZSINIT = 2;
+constexpr int ZACK = 3;
+constexpr int ZFILE = 4;
+constexpr int ZSKIP = 5;
+constexpr int ZNAK = 6;
+constexpr int ZFIN = 8;
+constexpr int ZRPOS = 9;
+constexpr int ZDATA = 10;
+constexpr int ZEOF = 11;
+constexpr int ZCHALLENGE = 14;
+
+// Subpacket ends
+constexpr char ZCRCE = 'h';		// end of frame, header follows
+constexpr char ZCRCG = 'i';		// frame continues, no reply wanted
+constexpr char ZCRCQ = 'j';		// frame continues, ZACK wanted
+constexpr char ZCRCW = 'k';		// end of frame, ZACK wanted
+constexpr char ZRUB0 = 'l';		// escaped 0x7F
+constexpr char ZRUB1 = 'm';		// escaped 0xFF
+
+// ZRINIT flags, in the argument's top byte
+constexpr uint32_t CANFDX = 0x01;
+constexpr uint32_t CANOVIO = 0x02;
+constexpr uint32_t CANFC32 = 0x20;
+
+// ZFILE conversion options, in the argument's top byte
+constexpr uint32_t ZCBIN = 1;
+constexpr uint32_t ZCRESUM = 3;
+
+constexpr int CANCEL_COUNT = 5;					// CANs in a row that end a session
+constexpr size_t GARBAGE_LIMIT = 4 << 20;		// bytes skipped looking for a header before calling it an error
+constexpr size_t FRAME_FLUSH = 8192;			// encoded bytes gathered before a write during a frame
+constexpr uint32_t FINISH_TIMEOUT = 1000;		// ms to wait for the sender's "OO" after ZFIN
+
+// The bytes escaped with ZDLE: ZDLE itself, and DLE, XON and XOFF with or without the high bit, which modems and
+// flow control eat
+struct EscapeTable {
+	bool isEscaped[256];
+
+	EscapeTable() {
+		memset(isEscaped, 0, sizeof(isEscaped));
+		for (uint8_t byte : { 0x18, 0x10, 0x11, 0x13 }) {
+			isEscaped[byte] = true;
+			isEscaped[byte | 0x80] = true;
+		}
+	}
+};
+
+const EscapeTable escapeTable;
+
+bool isFlowControl(int c) {
+	return (c & 0x7F) == XON || (c & 0x7F) == XOFF;
+}
+
+int hexValue(int c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+bool isFatal(int result) {
+	return result == FileTransfer::LINK_FAILED || result == ZmodemTransfer::PEER_CANCELLED;
+}
+
+TransferStatus fatalStatus(int result) {
+	return result == ZmodemTransfer::PEER_CANCELLED ? TransferStatus::Cancelled : TransferStatus::Failed;
+}
+
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	send
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool send(const std::string & path)
+--					const std::string & path:	the file to send, UTF-8
+--
+-- RETURNS:		bool - true if the receiver has the whole file, whether sent now or skipped as already there
+--
+-- NOTES:
+-- Runs a whole session for the one file: wakes the receiver, offers the file, streams it from the position the
+-- receiver asks for and closes the session with ZFIN. A failed or cancelled session is ended with the CAN sequence.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::send(const std::string & path) {
+	MappedFile file;
+	std::string name = baseName(path);
+	TransferStatus status = TransferStatus::Failed;
+	uint32_t offset = 0;
+
+	if (!name.empty() && file.open(path) && file.getSize() <= UINT32_MAX) {
+		status = offerFile(file, name, &offset);
+		if (status == TransferStatus::Running) {
+			status = sendData(file, offset);
+		}
+		if ((status == TransferStatus::Complete || status == TransferStatus::Skipped) && !endSession()) {
+			status = TransferStatus::Failed;
+		}
+	}
+	if (status == TransferStatus::Failed) {
+		sendAbort();
+	}
+	finish(status);
+	return status == TransferStatus::Complete || status == TransferStatus::Skipped;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	offerFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus offerFile(const MappedFile & file, const std::string & name, uint32_t * offset)
+--					const MappedFile & file:	the file to send
+--					const std::string & name:	its name without directories
+--					uint32_t * offset:			set to where the receiver wants the data to start
+--
+-- RETURNS:		TransferStatus - Running when the receiver has asked for the data, Skipped if it has the file, or
+--				why the session ended
+--
+-- NOTES:
+-- The receiver may have sent ZRINIT before it saw ZRQINIT and again after, so a ZRINIT while waiting for the
+-- answer to ZFILE is a stale one; ZFILE is only sent again on ZNAK or a timeout.
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus ZmodemTransfer::offerFile(const MappedFile & file, const std::string & name, uint32_t * offset) {
+	uint32_t argument = 0;
+	int errors = 0;
+	int type;
+	char sizeText[32];
+	std::string info = name;
+
+	if (!write("rz\r", 3) || !sendHexHeader(ZRQINIT, 0)) {
+		return TransferStatus::Failed;
+	}
+	while ((type = readHeader(options.timeout, &argument)) != ZRINIT) {
+		if (isFatal(type)) {
+			return fatalStatus(type);
+		}
+		if (type == ZCHALLENGE) {
+			sendHexHeader(ZACK, argument);
+		}
+		else if (type == TIMED_OUT || type == FRAME_ERROR) {
+			if (++errors > options.retries) {
+				return TransferStatus::Failed;
+			}
+			countRetry();
+			sendHexHeader(ZRQINIT, 0);
+		}
+	}
+	useCrc32 = ((argument >> 24) & CANFC32) != 0;
+
+	// name, NUL, then length, modification time in octal and mode in octal, NUL
+	snprintf(sizeText, sizeof(sizeText), "%llu 0 100644", (unsigned long long)file.getSize());
+	info.push_back('\0');
+	info += sizeText;
+	info.push_back('\0');
+	for (errors = 0;; ) {
+		if (!sendBinaryHeader(ZFILE, (options.allowResume ? ZCRESUM : ZCBIN) << 24) ||
+			!sendSubpacket(info.data(), info.size(), ZCRCW)) {
+			return TransferStatus::Failed;
+		}
+		do {
+			type = readHeader(options.timeout, &argument);
+		} while (type == ZRINIT || type == ZRQINIT || type == ZACK);
+		if (type == ZRPOS) {
+			*offset = std::min(argument, (uint32_t)file.getSize());
+			beginFile(name, file.getSize(), *offset);
+			return TransferStatus::Running;
+		}
+		if (type == ZSKIP) {
+			beginFile(name, file.getSize(), file.getSize());
+			return TransferStatus::Skipped;
+		}
+		if (isFatal(type)) {
+			return fatalStatus(type);
+		}
+		if (++errors > options.retries) {
+			return TransferStatus::Failed;
+		}
+		countRetry();
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendData
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus sendData(const MappedFile & file, uint32_t offset)
+--					const MappedFile & file:	the file to send
+--					uint32_t offset:			where the receiver asked to start
+--
+-- RETURNS:		TransferStatus - Complete once the receiver has acknowledged ZEOF with ZRINIT, or why it ended
+--
+-- NOTES:
+-- Subpackets are sent straight out of the mapping. Without a window the sender never waits for the receiver until
+-- ZEOF; with one it asks for a ZACK every quarter window and waits when a whole window is unacknowledged. ZRPOS
+-- rewinds to the receiver's position at any point, including after ZEOF. The same position asked for more than
+-- the retry limit in a row ends the transfer.
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus ZmodemTransfer::sendData(const MappedFile & file, uint32_t offset) {
+	const char * data = file.getData();
+	uint32_t size = (uint32_t)file.getSize();
+	uint32_t position = offset;
+	uint32_t acknowledged = offset;
+	uint32_t lastQuery = offset;
+	uint32_t lastRewind = UINT32_MAX;
+	size_t queryEvery = std::max<size_t>(options.window / 4, 1);
+	int errors = 0;
+	uint32_t argument = 0;
+	int type;
+
+	auto rewind = [&](uint32_t to) {
+		position = std::min(to, size);
+		acknowledged = position;
+		lastQuery = position;
+		errors = position == lastRewind ? errors + 1 : 0;
+		lastRewind = position;
+		countRetry();
+		if (isFrameOpen && !sendSubpacket(nullptr, 0, ZCRCE)) {
+			return false;
+		}
+		return position >= size || sendBinaryHeader(ZDATA, position);
+	};
+
+	if (position < size && !sendBinaryHeader(ZDATA, position)) {
+		return TransferStatus::Failed;
+	}
+	for (;;) {
+		while (position < size) {
+			if (options.window > 0 && position - acknowledged >= options.window) {
+				if (!flushFrame()) {
+					return TransferStatus::Failed;
+				}
+				type = readHeader(options.timeout, &argument);
+				if (type == ZACK) {
+					acknowledged = std::max(acknowledged, std::min(argument, position));
+					continue;
+				}
+				if (isFatal(type)) {
+					return fatalStatus(type);
+				}
+				if (type == ZRPOS || type == TIMED_OUT || type == FRAME_ERROR) {
+					if (!rewind(type == ZRPOS ? argument : acknowledged) || errors > options.retries) {
+						return TransferStatus::Failed;
+					}
+				}
+				continue;
+			}
+			size_t length = std::min<size_t>(options.subpacketSize, size - position);
+			char end = ZCRCG;
+
+			if (position + length == size) {
+				end = ZCRCE;
+			}
+			else if (options.window > 0 && position + length - lastQuery >= queryEvery) {
+				end = ZCRCQ;
+				lastQuery = position + (uint32_t)length;
+			}
+			if (!sendSubpacket(data + position, length, end)) {
+				return TransferStatus::Failed;
+			}
+			position += (uint32_t)length;
+			setProgress(position);
+
+			type = pollHeader(&argument);
+			if (type == ZACK) {
+				acknowledged = std::max(acknowledged, std::min(argument, position));
+			}
+			else if (type == ZRPOS) {
+				if (!rewind(argument) || errors > options.retries) {
+					return TransferStatus::Failed;
+				}
+			}
+			else if (isFatal(type)) {
+				return fatalStatus(type);
+			}
+		}
+
+		if (!sendBinaryHeader(ZEOF, size)) {
+			return TransferStatus::Failed;
+		}
+		do {
+			type = readHeader(options.timeout, &argument);
+		} while (type == ZACK);
+		if (type == ZRINIT) {
+			setProgress(size);
+			return TransferStatus::Complete;
+		}
+		if (isFatal(type)) {
+			return fatalStatus(type);
+		}
+		if (type == ZRPOS) {
+			if (!rewind(argument) || errors > options.retries) {
+				return TransferStatus::Failed;
+			}
+		}
+		else if (++errors > options.retries) {
+			return TransferStatus::Failed;
+		}
+		else {
+			countRetry();
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	endSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool endSession(void)
+--
+-- RETURNS:		bool - false if the receiver never answered ZFIN
+--
+-- NOTES:
+-- Sends ZFIN until the receiver answers with its own, then "OO", which the receiver reads as over and out.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::endSession() {
+	uint32_t argument = 0;
+
+	for (int errors = 0; errors <= options.retries; errors++) {
+		if (!sendHexHeader(ZFIN, 0)) {
+			return false;
+		}
+		int type;
+
+		do {
+			type = readHeader(options.timeout, &argument);
+		} while (type == ZRINIT || type == ZACK);
+		if (type == ZFIN) {
+			return write("OO", 2);
+		}
+		if (isFatal(type)) {
+			return false;
+		}
+		countRetry();
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool receive(const std::string & directory)
+--					const std::string & directory:	where received files go, UTF-8; empty for the current directory
+--
+-- RETURNS:		bool - true if the session ended with the last file offered received or skipped
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::receive(const std::string & directory) {
+	TransferStatus status = receiveSession(directory);
+
+	if (status == TransferStatus::Failed) {
+		sendAbort();
+	}
+	finish(status);
+	return status == TransferStatus::Complete || status == TransferStatus::Skipped;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveSession
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus receiveSession(const std::string & directory)
+--					const std::string & directory:	where received files go
+--
+-- RETURNS:		TransferStatus - how the last file went when the sender sent ZFIN, or why the session ended
+--
+-- NOTES:
+-- ZRINIT is repeated until the sender offers a file, so the receiver can be started first. Each file offered is
+-- received in turn; the session ends at ZFIN.
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus ZmodemTransfer::receiveSession(const std::string & directory) {
+	const uint32_t capabilities = (CANFDX | CANOVIO | CANFC32) << 24;
+	std::vector<char> data(ZMODEM_MAX_SUBPACKET + 1);
+	TransferStatus status = TransferStatus::Failed;
+	uint32_t argument = 0;
+	size_t length = 0;
+	int errors = 0;
+
+	if (!sendHexHeader(ZRINIT, capabilities)) {
+		return TransferStatus::Failed;
+	}
+	for (;;) {
+		int type = readHeader(options.timeout, &argument);
+		int end;
+
+		switch (type) {
+		case ZRQINIT:
+			sendHexHeader(ZRINIT, capabilities);
+			break;
+		case ZSINIT:
+			if (readSubpacket(data, &length) >= 0) {
+				sendHexHeader(ZACK, 0);
+			}
+			break;
+		case ZFILE:
+			end = readSubpacket(data, &length);
+			if (isFatal(end)) {
+				return fatalStatus(end);
+			}
+			if (end < 0) {
+				countRetry();
+				sendHexHeader(ZNAK, 0);
+				break;
+			}
+			status = receiveFile(directory, data, length, (argument >> 24) == ZCRESUM);
+			if (status != TransferStatus::Complete && status != TransferStatus::Skipped) {
+				return status;
+			}
+			if (status == TransferStatus::Complete) {
+				sendHexHeader(ZRINIT, capabilities);
+			}
+			errors = 0;
+			break;
+		case ZFIN:
+			sendHexHeader(ZFIN, 0);
+			if (readByte(FINISH_TIMEOUT) == 'O') {
+				readByte(FINISH_TIMEOUT);
+			}
+			return status;
+		case TIMED_OUT:
+		case FRAME_ERROR:
+			if (++errors > options.retries) {
+				return TransferStatus::Failed;
+			}
+			countRetry();
+			sendHexHeader(ZRINIT, capabilities);
+			break;
+		case LINK_FAILED:
+		case PEER_CANCELLED:
+			return fatalStatus(type);
+		default:
+			break;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveFile
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus receiveFile(const std::string & directory, std::vector<char> & info, size_t length,
+--					bool isResume)
+--					const std::string & directory:	where the file goes
+--					std::vector<char> & info:		the ZFILE subpacket, reused for data subpackets
+--					size_t length:					bytes in the subpacket
+--					bool isResume:					the sender offered ZCRESUM
+--
+-- RETURNS:		TransferStatus - Complete, Skipped if the whole file was already there, or why it ended
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus ZmodemTransfer::receiveFile(const std::string & directory, std::vector<char> & info, size_t length,
+	bool isResume) {
+	info[length] = '\0';
+	std::string name = baseName(std::string(info.data()));
+	size_t nameLength = strlen(info.data());
+	uint64_t size = nameLength + 1 < length ? strtoull(info.data() + nameLength + 1, nullptr, 10) : 0;
+	uint64_t existing = 0;
+	TransferStatus status;
+
+	if (name.empty()) {
+		name = options.receiveName;
+	}
+	FILE * file = openReceived(directory, name, isResume && options.allowResume ? size : 0, &existing);
+
+	if (file == nullptr || existing > UINT32_MAX) {
+		if (file != nullptr) {
+			fclose(file);
+		}
+		return TransferStatus::Failed;
+	}
+	if (existing > 0 && existing == size) {
+		fclose(file);
+		beginFile(name, size, size);
+		sendHexHeader(ZSKIP, 0);
+		return TransferStatus::Skipped;
+	}
+	beginFile(name, size, existing);
+	setvbuf(file, nullptr, _IOFBF, 1 << 16);
+	status = receiveData(file, (uint32_t)existing, info);
+	if (fclose(file) != 0 && status == TransferStatus::Complete) {
+		status = TransferStatus::Failed;
+	}
+	return status;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	receiveData
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	TransferStatus receiveData(FILE * file, uint32_t offset, std::vector<char> & data)
+--					FILE * file:				the file, positioned at offset
+--					uint32_t offset:			bytes the file already has
+--					std::vector<char> & data:	a buffer for one subpacket
+--
+-- RETURNS:		TransferStatus - Complete at a ZEOF for the length received, or why it ended
+--
+-- NOTES:
+-- Asks for the data from offset, then writes each subpacket whose CRC checks. Anything else, including a ZDATA or
+-- ZEOF for another position, is answered with ZRPOS for the length written so far: data arrives in order, so a ZEOF
+-- past the end of what was written means some was lost.
+----------------------------------------------------------------------------------------------------------------------*/
+TransferStatus ZmodemTransfer::receiveData(FILE * file, uint32_t offset, std::vector<char> & data) {
+	uint32_t argument = 0;
+	size_t length = 0;
+	int errors = 0;
+
+	auto resync = [&]() {
+		if (++errors > options.retries) {
+			return false;
+		}
+		countRetry();
+		return sendHexHeader(ZRPOS, offset);
+	};
+
+	if (!sendHexHeader(ZRPOS, offset)) {
+		return TransferStatus::Failed;
+	}
+	for (;;) {
+		int type = readHeader(options.timeout, &argument);
+
+		if (isFatal(type)) {
+			return fatalStatus(type);
+		}
+		if (type == ZDATA && argument == offset) {
+			int end;
+
+			do {
+				end = readSubpacket(data, &length);
+				if (end < 0) {
+					break;
+				}
+				if (length > 0 && fwrite(data.data(), 1, length, file) != length) {
+					return TransferStatus::Failed;
+				}
+				offset += (uint32_t)length;
+				setProgress(offset);
+				errors = 0;
+				if ((end == ZCRCQ || end == ZCRCW) && !sendHexHeader(ZACK, offset)) {
+					return TransferStatus::Failed;
+				}
+			} while (end == ZCRCG || end == ZCRCQ);
+			if (isFatal(end)) {
+				return fatalStatus(end);
+			}
+			if (end < 0 && !resync()) {
+				return TransferStatus::Failed;
+			}
+		}
+		else if (type == ZEOF && argument == offset) {
+			return TransferStatus::Complete;
+		}
+		else if (type == ZFILE) {
+			// The sender missed the first ZRPOS
+			int end = readSubpacket(data, &length);
+
+			if (isFatal(end)) {
+				return fatalStatus(end);
+			}
+			if (!sendHexHeader(ZRPOS, offset)) {
+				return TransferStatus::Failed;
+			}
+		}
+		else if ((type == ZDATA || type == ZEOF || type == TIMED_OUT || type == FRAME_ERROR) && !resync()) {
+			return TransferStatus::Failed;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	appendEscaped
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void appendEscaped(const char * data, size_t length)
+--					const char * data:	bytes to send
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Grows the frame buffer once for the worst case, every byte escaped, then encodes straight into it.
+----------------------------------------------------------------------------------------------------------------------*/
+void ZmodemTransfer::appendEscaped(const char * data, size_t length) {
+	if (frame.size() < frameLength + length * 2) {
+		frame.resize(std::max(frameLength + length * 2, frame.size() * 2));
+	}
+	char * out = frame.data() + frameLength;
+
+	for (size_t i = 0; i < length; i++) {
+		uint8_t byte = (uint8_t)data[i];
+
+		if (escapeTable.isEscaped[byte]) {
+			*out++ = ZDLE;
+			*out++ = (char)(byte ^ 0x40);
+		}
+		else {
+			*out++ = (char)byte;
+		}
+	}
+	frameLength = out - frame.data();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	appendRaw
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void appendRaw(const char * data, size_t length)
+--					const char * data:	framing bytes to send as they are
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void ZmodemTransfer::appendRaw(const char * data, size_t length) {
+	if (frame.size() < frameLength + length) {
+		frame.resize(std::max(frameLength + length, frame.size() * 2));
+	}
+	memcpy(frame.data() + frameLength, data, length);
+	frameLength += length;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	flushFrame
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool flushFrame(void)
+--
+-- RETURNS:		bool - false if the link failed
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::flushFrame() {
+	bool isWritten = frameLength == 0 || write(frame.data(), frameLength);
+
+	frameLength = 0;
+	return isWritten;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendHexHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool sendHexHeader(int type, uint32_t argument)
+--					int type:			the header type
+--					uint32_t argument:	a position, or flags in the top byte
+--
+-- RETURNS:		bool - false if the link failed
+--
+-- NOTES:
+-- The header is printable apart from its padding: type, argument and CRC-16 in lowercase hex, then CR, LF with the
+-- high bit set, and XON unless the header is ZACK or ZFIN.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::sendHexHeader(int type, uint32_t argument) {
+	static const char digits[] = "0123456789abcdef";
+	char bytes[7] = { (char)type, (char)argument, (char)(argument >> 8), (char)(argument >> 16),
+		(char)(argument >> 24) };
+	uint16_t crc = crc16(bytes, 5);
+	char text[4 + 14 + 3] = { ZPAD, ZPAD, ZDLE, ZHEX };
+	size_t length = 4;
+
+	bytes[5] = (char)(crc >> 8);
+	bytes[6] = (char)crc;
+	for (int i = 0; i < 7; i++) {
+		text[length++] = digits[(uint8_t)bytes[i] >> 4];
+		text[length++] = digits[bytes[i] & 0x0F];
+	}
+	text[length++] = '\r';
+	text[length++] = (char)0x8A;
+	if (type != ZACK && type != ZFIN) {
+		text[length++] = XON;
+	}
+	return flushFrame() && write(text, length);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendBinaryHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool sendBinaryHeader(int type, uint32_t argument)
+--					int type:			the header type
+--					uint32_t argument:	a position, or flags in the top byte
+--
+-- RETURNS:		bool - false if the link failed
+--
+-- NOTES:
+-- ZBIN32 with a CRC-32 if the receiver can check one, ZBIN with a CRC-16 if not. A ZDATA header opens a frame.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::sendBinaryHeader(int type, uint32_t argument) {
+	const char bytes[5] = { (char)type, (char)argument, (char)(argument >> 8), (char)(argument >> 16),
+		(char)(argument >> 24) };
+	const char start[3] = { ZPAD, ZDLE, useCrc32 ? ZBIN32 : ZBIN };
+	char check[4];
+
+	appendRaw(start, sizeof(start));
+	appendEscaped(bytes, sizeof(bytes));
+	if (useCrc32) {
+		uint32_t crc = crc32(bytes, sizeof(bytes));
+
+		for (int i = 0; i < 4; i++) {
+			check[i] = (char)(crc >> (8 * i));
+		}
+		appendEscaped(check, 4);
+	}
+	else {
+		uint16_t crc = crc16(bytes, sizeof(bytes));
+
+		check[0] = (char)(crc >> 8);
+		check[1] = (char)crc;
+		appendEscaped(check, 2);
+	}
+	isFrameOpen = false;
+	return flushFrame();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	sendSubpacket
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool sendSubpacket(const char * data, size_t length, char end)
+--					const char * data:	the subpacket's bytes
+--					size_t length:		bytes in data, up to ZMODEM_MAX_SUBPACKET
+--					char end:			ZCRCE, ZCRCG, ZCRCQ or ZCRCW
+--
+-- RETURNS:		bool - false if the link failed
+--
+-- NOTES:
+-- The CRC covers the data and the end byte. ZCRCG subpackets are gathered up to FRAME_FLUSH bytes before they are
+-- written; any other end is written at once, since it either asks for a reply or comes before a header.
+----------------------------------------------------------------------------------------------------------------------*/
+bool ZmodemTransfer::sendSubpacket(const char * data, size_t length, char end) {
+	char check[4];
+
+	const char terminator[2] = { ZDLE, end };
+
+	appendEscaped(data, length);
+	appendRaw(terminator, sizeof(terminator));
+	if (useCrc32) {
+		uint32_t crc = crc32(&end, 1, crc32(data, length));
+
+		for (int i = 0; i < 4; i++) {
+			check[i] = (char)(crc >> (8 * i));
+		}
+		appendEscaped(check, 4);
+	}
+	else {
+		uint16_t crc = crc16(&end, 1, crc16(data, length));
+
+		check[0] = (char)(crc >> 8);
+		check[1] = (char)crc;
+		appendEscaped(check, 2);
+	}
+	isFrameOpen = end == ZCRCG || end == ZCRCQ;
+	if (end == ZCRCG && frameLength < FRAME_FLUSH) {
+		return true;
+	}
+	return flushFrame();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readEscaped
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readEscaped(uint32_t timeout)
+--					uint32_t timeout:	ms to wait for each byte
+--
+-- RETURNS:		int - a decoded byte, GOT_END with a subpacket end in the low byte, or TIMED_OUT, LINK_FAILED,
+--				FRAME_ERROR or PEER_CANCELLED
+--
+-- NOTES:
+-- XON and XOFF are dropped wherever they appear, since the sender always escapes its own.
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::readEscaped(uint32_t timeout) {
+	int c;
+
+	do {
+		c = readByte(timeout);
+	} while (c >= 0 && isFlowControl(c));
+	if (c != (uint8_t)ZDLE) {
+		return c;
+	}
+	for (int cans = 1;; ) {
+		c = readByte(timeout);
+		if (c < 0) {
+			return c;
+		}
+		if (c == (uint8_t)CAN) {
+			if (++cans >= CANCEL_COUNT) {
+				return PEER_CANCELLED;
+			}
+		}
+		else if (!isFlowControl(c)) {
+			break;
+		}
+	}
+	switch (c) {
+	case ZCRCE:
+	case ZCRCG:
+	case ZCRCQ:
+	case ZCRCW:
+		return GOT_END | c;
+	case ZRUB0:
+		return 0x7F;
+	case ZRUB1:
+		return 0xFF;
+	default:
+		return (c & 0x60) == 0x40 ? c ^ 0x40 : FRAME_ERROR;
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readHeader(uint32_t timeout, uint32_t * argument)
+--					uint32_t timeout:		ms to wait for each byte
+--					uint32_t * argument:	set to the header's position or flags
+--
+-- RETURNS:		int - the header type, or TIMED_OUT, LINK_FAILED, FRAME_ERROR or PEER_CANCELLED
+--
+-- NOTES:
+-- Skips anything before ZPAD ZDLE and a format byte, which is how a receiver that lost its place finds the next
+-- header in the middle of a stream.
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::readHeader(uint32_t timeout, uint32_t * argument) {
+	size_t garbage = 0;
+	int cans = 0;
+
+	for (;;) {
+		int c = readByte(timeout);
+
+		if (c < 0) {
+			return c;
+		}
+		if (c != ZPAD) {
+			cans = c == (uint8_t)CAN ? cans + 1 : 0;
+			if (cans >= CANCEL_COUNT) {
+				return PEER_CANCELLED;
+			}
+			if (++garbage > GARBAGE_LIMIT) {
+				return FRAME_ERROR;
+			}
+			continue;
+		}
+		cans = 0;
+		do {
+			c = readByte(timeout);
+		} while (c == ZPAD);
+		if (c < 0) {
+			return c;
+		}
+		if (c != (uint8_t)ZDLE) {
+			unreadByte();
+			continue;
+		}
+		c = readByte(timeout);
+		if (c < 0) {
+			return c;
+		}
+		switch (c) {
+		case ZBIN:
+			return readBinaryHeader(false, timeout, argument);
+		case ZBIN32:
+			return readBinaryHeader(true, timeout, argument);
+		case ZHEX:
+			return readHexHeader(timeout, argument);
+		default:
+			unreadByte();
+			break;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readBinaryHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readBinaryHeader(bool is32, uint32_t timeout, uint32_t * argument)
+--					bool is32:				ZBIN32 rather than ZBIN
+--					uint32_t timeout:		ms to wait for each byte
+--					uint32_t * argument:	set to the header's position or flags
+--
+-- RETURNS:		int - the header type, or TIMED_OUT, LINK_FAILED, FRAME_ERROR or PEER_CANCELLED
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::readBinaryHeader(bool is32, uint32_t timeout, uint32_t * argument) {
+	uint8_t bytes[9];
+	int length = is32 ? 9 : 7;
+
+	for (int i = 0; i < length; i++) {
+		int c = readEscaped(timeout);
+
+		if (c < 0) {
+			return c;
+		}
+		if (c & GOT_END) {
+			return FRAME_ERROR;
+		}
+		bytes[i] = (uint8_t)c;
+	}
+	if (is32) {
+		uint32_t crc = crc32((const char *)bytes, 5);
+
+		if (crc != (bytes[5] | (uint32_t)bytes[6] << 8 | (uint32_t)bytes[7] << 16 | (uint32_t)bytes[8] << 24)) {
+			return FRAME_ERROR;
+		}
+	}
+	else if (crc16((const char *)bytes, 5) != (bytes[5] << 8 | bytes[6])) {
+		return FRAME_ERROR;
+	}
+	isFrame32 = is32;
+	*argument = bytes[1] | (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3] << 16 | (uint32_t)bytes[4] << 24;
+	return bytes[0];
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readHexHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readHexHeader(uint32_t timeout, uint32_t * argument)
+--					uint32_t timeout:		ms to wait for each byte
+--					uint32_t * argument:	set to the header's position or flags
+--
+-- RETURNS:		int - the header type, or TIMED_OUT, LINK_FAILED or FRAME_ERROR
+--
+-- NOTES:
+-- The CR, LF and XON after the header are taken if they have already arrived; any that arrive later are skipped
+-- as noise by whatever reads next.
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::readHexHeader(uint32_t timeout, uint32_t * argument) {
+	uint8_t bytes[7];
+
+	for (int i = 0; i < 7; i++) {
+		int high = readByte(timeout);
+		int low = high < 0 ? high : readByte(timeout);
+
+		if (low < 0) {
+			return low;
+		}
+		high = hexValue(high & 0x7F);
+		low = hexValue(low & 0x7F);
+		if (high < 0 || low < 0) {
+			return FRAME_ERROR;
+		}
+		bytes[i] = (uint8_t)(high << 4 | low);
+	}
+	if (crc16((const char *)bytes, 5) != (bytes[5] << 8 | bytes[6])) {
+		return FRAME_ERROR;
+	}
+	for (int trailer : { (int)'\r', (int)'\n', (int)XON }) {
+		int c = readByte(0);
+
+		if (c < 0) {
+			break;
+		}
+		if ((c & 0x7F) != trailer) {
+			unreadByte();
+			break;
+		}
+	}
+	isFrame32 = false;
+	*argument = bytes[1] | (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3] << 16 | (uint32_t)bytes[4] << 24;
+	return bytes[0];
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	pollHeader
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int pollHeader(uint32_t * argument)
+--					uint32_t * argument:	set to the header's position or flags
+--
+-- RETURNS:		int - the type of a header that has started to arrive, TIMED_OUT if none has, or LINK_FAILED,
+--				FRAME_ERROR or PEER_CANCELLED
+--
+-- NOTES:
+-- Used by the sender between subpackets. Noise is dropped without waiting; once ZPAD or CAN arrives the rest of
+-- the header is waited for as usual.
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::pollHeader(uint32_t * argument) {
+	for (;;) {
+		int c = readByte(0);
+
+		if (c < 0) {
+			return c;
+		}
+		if (c == ZPAD || c == (uint8_t)CAN) {
+			unreadByte();
+			return readHeader(options.timeout, argument);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readSubpacket
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int readSubpacket(std::vector<char> & data, size_t * length)
+--					std::vector<char> & data:	filled with the subpacket, ZMODEM_MAX_SUBPACKET bytes at most
+--					size_t * length:			set to the bytes in the subpacket
+--
+-- RETURNS:		int - the subpacket's end, or TIMED_OUT, LINK_FAILED, FRAME_ERROR or PEER_CANCELLED
+--
+-- NOTES:
+-- The CRC is the kind the frame's header carried.
+----------------------------------------------------------------------------------------------------------------------*/
+int ZmodemTransfer::readSubpacket(std::vector<char> & data, size_t * length) {
+	size_t count = 0;
+	size_t capacity = std::min(data.size(), ZMODEM_MAX_SUBPACKET);
+	char check[4];
+
+	for (;;) {
+		int c = readEscaped(options.timeout);
+
+		if (c < 0) {
+			return c;
+		}
+		if (c & GOT_END) {
+			char end = (char)(c & 0xFF);
+			int checkLength = isFrame32 ? 4 : 2;
+
+			for (int i = 0; i < checkLength; i++) {
+				int byte = readEscaped(options.timeout);
+
+				if (byte < 0) {
+					return byte;
+				}
+				if (byte & GOT_END) {
+					return FRAME_ERROR;
+				}
+				check[i] = (char)byte;
+			}
+			if (isFrame32) {
+				uint32_t crc = crc32(&end, 1, crc32(data.data(), count));
+
+				for (int i = 0; i < 4; i++) {
+					if ((uint8_t)check[i] != (uint8_t)(crc >> (8 * i))) {
+						return FRAME_ERROR;
+					}
+				}
+			}
+			else {
+				uint16_t crc = crc16(&end, 1, crc16(data.data(), count));
+
+				if ((uint8_t)check[0] != (uint8_t)(crc >> 8) || (uint8_t)check[1] != (uint8_t)crc) {
+					return FRAME_ERROR;
+				}
+			}
+			*length = count;
+			return end;
+		}
+		if (count >= capacity) {
+			return FRAME_ERROR;
+		}
+		data[count++] = (char)c;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "FileTransfer.h"
+#include "MappedFile.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		ZmodemTransfer.h -	ZMODEM file transfer, streaming with CRC-32 subpackets.
+--
+-- PROGRAM:			DumbSerialPortEmulator
+--
+-- FUNCTIONS:
+--					bool send(const std::string & path)
+--					bool receive(const std::string & directory)
+--					TransferStatus offerFile(const MappedFile & file, const std::string & name, uint32_t * offset)
+--					TransferStatus sendData(const MappedFile & file, uint32_t offset)
+--					bool endSession(void)
+--					TransferStatus receiveSession(const std::string & directory)
+--					TransferStatus receiveFile(const std::string & directory, std::vector<char> & info,
+--						size_t length, bool isResume)
+--					TransferStatus receiveData(FILE * file, uint32_t offset, std::vector<char> & data)
+--					void appendEscaped(const char * data, size_t length)
+--					void appendRaw(const char * data, size_t length)
+--					bool flushFrame(void)
+--					bool sendHexHeader(int type, uint32_t argument)
+--					bool sendBinaryHeader(int type, uint32_t argument)
+--					bool sendSubpacket(const char * data, size_t length, char end)
+--					int readEscaped(uint32_t timeout)
+--					int readHeader(uint32_t timeout, uint32_t * argument)
+--					int readBinaryHeader(bool is32, uint32_t timeout, uint32_t * argument)
+--					int readHexHeader(uint32_t timeout, uint32_t * argument)
+--					int pollHeader(uint32_t * argument)
+--					int readSubpacket(std::vector<char> & data, size_t * length)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Follows Forsberg's ZMODEM as lrzsz speaks it. Every header carries a four-byte argument, a file position or flag
+-- bytes. The receiver sends hex headers and asks for CRC-32, so the sender's binary headers and data subpackets
+-- carry CRC-32. The data subpackets of a ZDATA frame end in ZCRCG, which asks for no reply; the sender checks for
+-- a ZRPOS between subpackets without blocking and only stops to wait when a window is set and full. The receiver
+-- writes only subpackets whose CRC checks, and on any error sends ZRPOS with the length it has and ignores the link
+-- until a ZDATA header for that position arrives. Before a new header the sender ends any frame still open with an
+-- empty ZCRCE subpacket, so a receiver that was not out of step reads the header as a header.
+--
+-- The sender offers the file with ZCRESUM when resuming is allowed; a receiver that also allows it and has a
+-- shorter file of the same name answers with ZRPOS at its length, and one that has the whole file answers ZSKIP.
+-- Positions are 32 bits, so files of 4 GiB or more are refused.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t ZMODEM_MAX_SUBPACKET = 8192;	// longest subpacket a receiver takes, as ZMODEM-8K allows
+
+class ZmodemTransfer : public FileTransfer {
+public:
+	static constexpr int GOT_END = 0x100;		// readEscaped: ZDLE and a subpacket end, in the low byte
+private:
+	std::vector<char> frame;		// encoded bytes not yet written
+	size_t frameLength = 0;
+	bool useCrc32 = false;			// for binary headers and subpackets sent
+	bool isFrame32 = false;			// the last binary header read was ZBIN32, so its subpackets carry CRC-32
+	bool isFrameOpen = false;		// a subpacket that asks for more has been sent and not yet ended
+
+	TransferStatus offerFile(const MappedFile & file, const std::string & name, uint32_t * offset);
+	TransferStatus sendData(const MappedFile & file, uint32_t offset);
+	bool endSession();
+	TransferStatus receiveSession(const std::string & directory);
+	TransferStatus receiveFile(const std::string & directory, std::vector<char> & info, size_t length,
+		bool isResume);
+	TransferStatus receiveData(FILE * file, uint32_t offset, std::vector<char> & data);
+
+	void appendEscaped(const char * data, size_t length);
+	void appendRaw(const char * data, size_t length);
+	bool flushFrame();
+	bool sendHexHeader(int type, uint32_t argument);
+	bool sendBinaryHeader(int type, uint32_t argument);
+	bool sendSubpacket(const char * data, size_t length, char end);
+	int readEscaped(uint32_t timeout);
+	int readHeader(uint32_t timeout, uint32_t * argument);
+	int readBinaryHeader(bool is32, uint32_t timeout, uint32_t * argument);
+	int readHexHeader(uint32_t timeout, uint32_t * argument);
+	int pollHeader(uint32_t * argument);
+	int readSubpacket(std::vector<char> & data, size_t * length);
+public:
+	ZmodemTransfer(TransferChannel * link, const TransferOptions & transferOptions) :
+		FileTransfer(link, transferOptions) {};
+
+	bool send(const std::string & path) override;
+	bool receive(const std::string & directory) override;
+};
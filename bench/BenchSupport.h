@@ -0,0 +1,365 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include "../PosixTransport.h"
+#endif
+#include "../SerialTransport.h"
+#include "../SimulatedTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		BenchSupport.h -	Option parsing, loopbacks, CPU time and latency reports for the benchmarks.
+--
+-- PROGRAM:			Benchmarks
+--
+-- FUNCTIONS:
+--					const char * defaultTransport(void)
+--					bool parseArguments(int argc, char * argv[], std::initializer_list<const char *> flags,
+--						const OptionHandler & handle)
+--					bool parseCounts(const char * text, std::vector<size_t> * counts)
+--					ProcessUsage processUsage(void)
+--					void printLatency(FILE * out, const char * name, std::vector<double> & samples, bool isLast)
+--					bool openFarEnd(const LoopbackOptions & options, Loopback * loopback)
+--					bool openNearEnd(const LoopbackOptions & options, Loopback * loopback)
+--					bool openLoopback(const LoopbackOptions & options, Loopback * loopback)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- A loopback is two transports wired to each other: the near end, which the code being measured runs on, and the
+-- far end, which the bench drives. sim connects two SimulatedTransports, which have real line timing; pty opens a
+-- pseudo-terminal pair on Linux, adopting the master as the far end and opening the slave by name as the near end;
+-- serial opens two ports by name with createSerialTransport, such as the ends of a null modem cable. A pty has no
+-- line rate and no modem lines, so it is only configured for XON/XOFF, and RTS/CTS is refused on one.
+----------------------------------------------------------------------------------------------------------------------*/
+
+typedef std::chrono::steady_clock Clock;
+
+// Called with each option and the argument after it; value is NULL for a flag, name is NULL for a bare argument
+typedef std::function<bool(const char * name, const char * value)> OptionHandler;
+
+struct ProcessUsage {
+	double cpuSeconds = 0;			// user plus kernel
+	uint64_t contextSwitches = 0;	// 0 on Windows
+};
+
+struct LoopbackOptions {
+	std::string transport;				// sim, pty or serial
+	PortSettings settings;
+	SimulationSettings simulation;		// sim only, for both ends
+	int index = 0;						// numbers the simulated ports, so several loopbacks have distinct names
+	std::string localName;				// serial only
+	std::string remoteName;				// serial only
+};
+
+struct Loopback {
+	std::unique_ptr<SerialTransport> local;		// the near end, which the code being measured runs on
+	std::unique_ptr<SerialTransport> remote;	// the far end, which the bench drives
+	SimulatedTransport * simulated = nullptr;	// local, when the loopback is simulated
+	std::string localName;						// what local opens by
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	defaultTransport
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const char * defaultTransport(void)
+--
+-- RETURNS:		const char * - "pty" on Linux, "sim" on Windows, which has no pseudo-terminals
+----------------------------------------------------------------------------------------------------------------------*/
+inline const char * defaultTransport() {
+#ifdef _WIN32
+	return "sim";
+#else
+	return "pty";
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseArguments
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseArguments(int argc, char * argv[], std::initializer_list<const char *> flags,
+--					const OptionHandler & handle)
+--					int argc:									argument count
+--					char * argv[]:								arguments
+--					std::initializer_list<const char *> flags:	options that take no argument
+--					const OptionHandler & handle:				applies one option; false if it is not understood
+--
+-- RETURNS:		bool - false if an option is missing its argument or handle rejects one
+--
+-- NOTES:
+-- Anything starting with '-' is an option and, unless it is one of flags, takes the next argument as its value.
+-- Anything else is a bare argument, handed over with a NULL name.
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool parseArguments(int argc, char * argv[], std::initializer_list<const char *> flags,
+	const OptionHandler & handle) {
+	for (int i = 1; i < argc; i++) {
+		bool isFlag = false;
+
+		if (argv[i][0] != '-') {
+			if (!handle(NULL, argv[i])) {
+				return false;
+			}
+			continue;
+		}
+		for (const char * flag : flags) {
+			isFlag = isFlag || strcmp(argv[i], flag) == 0;
+		}
+		if (isFlag) {
+			if (!handle(argv[i], NULL)) {
+				return false;
+			}
+			continue;
+		}
+		if (i + 1 >= argc || !handle(argv[i], argv[i + 1])) {
+			return false;
+		}
+		i++;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseCounts
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseCounts(const char * text, std::vector<size_t> * counts)
+--					const char * text:				a comma-separated list such as 1,2,4
+--					std::vector<size_t> * counts:	replaced by the numbers in text
+--
+-- RETURNS:		bool - false if text holds anything but positive numbers
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool parseCounts(const char * text, std::vector<size_t> * counts) {
+	counts->clear();
+	for (const char * next = text; *next != '\0';) {
+		char * end;
+		size_t count = (size_t)strtoul(next, &end, 10);
+
+		if (end == next || count == 0) {
+			return false;
+		}
+		counts->push_back(count);
+		next = *end == ',' ? end + 1 : end;
+	}
+	return !counts->empty();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	processUsage
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	ProcessUsage processUsage(void)
+--
+-- RETURNS:		ProcessUsage - CPU time and context switches of this process so far
+----------------------------------------------------------------------------------------------------------------------*/
+inline ProcessUsage processUsage() {
+	ProcessUsage usage;
+#ifdef _WIN32
+	FILETIME created, exited, kernel, user;
+	ULARGE_INTEGER k, u;
+
+	GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user);
+	k.LowPart = kernel.dwLowDateTime;
+	k.HighPart = kernel.dwHighDateTime;
+	u.LowPart = user.dwLowDateTime;
+	u.HighPart = user.dwHighDateTime;
+	usage.cpuSeconds = (k.QuadPart + u.QuadPart) / 1e7;
+#else
+	struct rusage self;
+
+	getrusage(RUSAGE_SELF, &self);
+	usage.cpuSeconds = self.ru_utime.tv_sec + self.ru_utime.tv_usec / 1e6 +
+		self.ru_stime.tv_sec + self.ru_stime.tv_usec / 1e6;
+	usage.contextSwitches = (uint64_t)self.ru_nvcsw + (uint64_t)self.ru_nivcsw;
+#endif
+	return usage;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printLatency
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printLatency(FILE * out, const char * name, std::vector<double> & samples, bool isLast)
+--					FILE * out:						where the report goes
+--					const char * name:				JSON key of the histogram
+--					std::vector<double> & samples:	latencies in microseconds; sorted by this call
+--					bool isLast:					leave off the trailing comma
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+inline void printLatency(FILE * out, const char * name, std::vector<double> & samples, bool isLast) {
+	double p50 = 0, p99 = 0, p999 = 0, worst = 0;
+
+	std::sort(samples.begin(), samples.end());
+	if (!samples.empty()) {
+		p50 = samples[(size_t)(samples.size() * 0.50)];
+		p99 = samples[(size_t)(samples.size() * 0.99)];
+		p999 = samples[(size_t)(samples.size() * 0.999)];
+		worst = samples.back();
+	}
+	fprintf(out, "  \"%s\": { \"samples\": %zu, \"p50\": %.1f, \"p99\": %.1f, \"p999\": %.1f, \"max\": %.1f }%s\n",
+		name, samples.size(), p50, p99, p999, worst, isLast ? "" : ",");
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openFarEnd
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openFarEnd(const LoopbackOptions & options, Loopback * loopback)
+--					const LoopbackOptions & options:	which transport and line settings to use
+--					Loopback * loopback:				set to both ends, with only the far end open
+--
+-- RETURNS:		bool - false if the transport is not known or the far end could not be opened
+--
+-- NOTES:
+-- Call this function on its own when the bench opens and closes the near end itself, as ReconnectBench does.
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool openFarEnd(const LoopbackOptions & options, Loopback * loopback) {
+	if (options.transport == "sim") {
+		SimulatedTransport * local = new SimulatedTransport();
+		SimulatedTransport * remote = new SimulatedTransport();
+
+		loopback->local.reset(local);
+		loopback->remote.reset(remote);
+		loopback->simulated = local;
+		loopback->localName = SIMULATED_PORT_PREFIX + std::to_string(2 * options.index + 1);
+		local->setSimulation(options.simulation);
+		remote->setSimulation(options.simulation);
+		local->connect(remote);
+		return remote->open(SIMULATED_PORT_PREFIX + std::to_string(2 * options.index + 2)) == 0 &&
+			remote->configure(options.settings) == 0;
+	}
+	if (options.transport == "serial") {
+		loopback->local = createSerialTransport();
+		loopback->remote = createSerialTransport();
+		loopback->localName = options.localName;
+		return loopback->remote->open(options.remoteName) == 0 && loopback->remote->configure(options.settings) == 0;
+	}
+#ifndef _WIN32
+	if (options.transport == "pty") {
+		PosixTransport * remote = new PosixTransport();
+		int master;
+
+		loopback->local.reset(new PosixTransport());
+		loopback->remote.reset(remote);
+		return !options.settings.rtsCts && PosixTransport::openPtyPair(&master, &loopback->localName) &&
+			remote->adopt(master, "pty master") == 0;
+	}
+#endif
+	return false;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openNearEnd
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openNearEnd(const LoopbackOptions & options, Loopback * loopback)
+--					const LoopbackOptions & options:	the line settings to use
+--					Loopback * loopback:				a loopback from openFarEnd
+--
+-- RETURNS:		bool - false if the near end could not be opened or configured
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool openNearEnd(const LoopbackOptions & options, Loopback * loopback) {
+	bool isPty = options.transport == "pty";
+
+	if (loopback->local->open(loopback->localName) != 0) {
+		return false;
+	}
+	return (isPty && !options.settings.xonXoff) || loopback->local->configure(options.settings) == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openLoopback
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool openLoopback(const LoopbackOptions & options, Loopback * loopback)
+--					const LoopbackOptions & options:	which transport and line settings to use
+--					Loopback * loopback:				set to the two open ends
+--
+-- RETURNS:		bool - false if the ends could not be opened, or the transport cannot do the flow control asked for
+--
+-- NOTES:
+-- The far end is opened first: a pty master read before its slave is open reports a hang-up, and the master is
+-- not read until the bench starts.
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool openLoopback(const LoopbackOptions & options, Loopback * loopback) {
+	return openFarEnd(options, loopback) && openNearEnd(options, loopback);
+}
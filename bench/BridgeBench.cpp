@@ -0,0 +1,463 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../TcpBridge.h"
+#include "BenchSupport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		BridgeBench.cpp -	How fast a TcpBridge fans received data out to many local clients.
+--
+-- PROGRAM:			BridgeBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					intptr_t connectClient(uint16_t port)
+--					void readClient(Reader * reader)
+--					void publishAll(const BenchOptions & options, TcpBridge * bridge, const ReaderList & readers,
+--						RunResult * result)
+--					bool runPoint(const BenchOptions & options, size_t clientCount, RunResult * result)
+--					void printResult(FILE * out, RunResult & result, bool isLast)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Option parsing comes from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: BridgeBench [--clients 1,2,5,...] [--megabytes N] [--chunk BYTES] [--rate MB/S] [--policy drop|disconnect]
+--                    [--lag BYTES] [--slow] [--out FILE]
+--
+-- For each client count (1, 2, 5, 10, 20, 50 and 100 by default) a bridge is opened on a free loopback port and
+-- that many clients connect, each read by a thread of its own as fast as it can. One thread then publishes
+-- --megabytes (64 by default) in --chunk pieces (4096 bytes, RX_CHUNK_SIZE), as the port's reader would, either as
+-- fast as it can or at --rate MB/s. Every publish call is timed: it is the cost the serial reader pays for the bridge.
+-- Once the clients have stopped receiving, delivered_mb_s is everything the clients read over the time from the
+-- first publish to the last byte read.
+--
+-- --slow adds a client that connects and never reads. It should fill its socket, fall lagLimit behind and be dropped
+-- or disconnected by the policy, while publish times and the other clients' throughput stay as they were.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint32_t SETTLE_TIME = 300;		// ms without a byte read before the clients count as finished
+
+struct BenchOptions {
+	std::vector<size_t> clientCounts;
+	size_t megabytes = 64;
+	size_t chunk = 4096;
+	double rate = 0;						// MB/s to publish at; 0 for as fast as possible
+	BridgeSettings settings;
+	bool hasSlowClient = false;
+	const char * outPath = NULL;
+};
+
+struct Reader {
+	intptr_t socket = -1;
+	std::atomic<uint64_t> received{ 0 };
+	std::atomic<int64_t> lastRead{ 0 };		// steady clock ns of the last read that returned data
+	std::thread thread;
+};
+
+typedef std::vector<std::unique_ptr<Reader>> ReaderList;
+
+struct RunResult {
+	size_t clients = 0;
+	uint64_t published = 0;
+	uint64_t delivered = 0;					// summed over the reading clients
+	double seconds = 0;
+	double publishSeconds = 0;
+	std::vector<double> publishNs;
+	BridgeStats stats;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					BenchOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument was not understood
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+	bool isParsed;
+
+	options->clientCounts = { 1, 2, 5, 10, 20, 50, 100 };
+	isParsed = parseArguments(argc, argv, { "--slow" }, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--slow") == 0) {
+			options->hasSlowClient = true;
+		}
+		else if (strcmp(name, "--clients") == 0) {
+			return parseCounts(value, &options->clientCounts);
+		}
+		else if (strcmp(name, "--megabytes") == 0) {
+			options->megabytes = (size_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--chunk") == 0) {
+			options->chunk = (size_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--rate") == 0) {
+			options->rate = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--policy") == 0) {
+			if (strcmp(value, "drop") == 0) {
+				options->settings.policy = BacklogPolicy::Drop;
+			}
+			else if (strcmp(value, "disconnect") == 0) {
+				options->settings.policy = BacklogPolicy::Disconnect;
+			}
+			else {
+				return false;
+			}
+		}
+		else if (strcmp(name, "--lag") == 0) {
+			options->settings.lagLimit = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	return isParsed && !options->clientCounts.empty() && options->megabytes > 0 && options->chunk > 0 &&
+		options->rate >= 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	connectClient
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	intptr_t connectClient(uint16_t port)
+--					uint16_t port:	the bridge's port on 127.0.0.1
+--
+-- RETURNS:		intptr_t - a connected blocking socket, or -1
+----------------------------------------------------------------------------------------------------------------------*/
+static intptr_t connectClient(uint16_t port) {
+	sockaddr_in address;
+	intptr_t client = (intptr_t)socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	if (client != -1 && connect(client, (sockaddr *)&address, sizeof(address)) != 0) {
+#ifdef _WIN32
+		closesocket((SOCKET)client);
+#else
+		close((int)client);
+#endif
+		return -1;
+	}
+	return client;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	readClient
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void readClient(Reader * reader)
+--					Reader * reader:	the client to read until the bridge closes it
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+static void readClient(Reader * reader) {
+	std::unique_ptr<char[]> data(new char[FANOUT_BLOCK_SIZE]);
+	int received;
+
+	while ((received = (int)recv(reader->socket, data.get(), (int)FANOUT_BLOCK_SIZE, 0)) > 0) {
+		reader->received.fetch_add(received, std::memory_order_relaxed);
+		reader->lastRead.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	publishAll
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void publishAll(const BenchOptions & options, TcpBridge * bridge, const ReaderList & readers,
+--					RunResult * result)
+--					const BenchOptions & options:	how much to publish and how fast
+--					TcpBridge * bridge:				the bridge the clients are connected to
+--					const ReaderList & readers:		the reading clients
+--					RunResult * result:				filled in with the publish times and what was delivered
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Publishes everything, then waits for the readers to go SETTLE_TIME without reading anything more.
+----------------------------------------------------------------------------------------------------------------------*/
+static void publishAll(const BenchOptions & options, TcpBridge * bridge, const ReaderList & readers,
+	RunResult * result) {
+	std::vector<char> chunk(options.chunk);
+	uint64_t total = (uint64_t)options.megabytes << 20;
+	int64_t lastRead = 0;
+
+	for (size_t i = 0; i < chunk.size(); i++) {
+		chunk[i] = (char)('a' + i % 26);
+	}
+	result->publishNs.reserve((size_t)(total / options.chunk) + 1);
+	Clock::time_point begin = Clock::now();
+	for (uint64_t published = 0; published < total; published += options.chunk) {
+		Clock::time_point before = Clock::now();
+
+		bridge->publish(chunk.data(), chunk.size());
+		Clock::time_point after = Clock::now();
+		result->publishNs.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+		result->published += chunk.size();
+		if (options.rate > 0) {
+			std::this_thread::sleep_until(begin + std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>((published + options.chunk) / (options.rate * (1 << 20)))));
+		}
+	}
+	result->publishSeconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+	for (uint64_t last = UINT64_MAX;;) {
+		uint64_t delivered = 0;
+
+		for (const std::unique_ptr<Reader> & reader : readers) {
+			delivered += reader->received.load();
+		}
+		if (delivered == last || delivered == result->published * readers.size()) {
+			result->delivered = delivered;
+			break;
+		}
+		last = delivered;
+		std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_TIME));
+	}
+	for (const std::unique_ptr<Reader> & reader : readers) {
+		lastRead = std::max(lastRead, reader->lastRead.load());
+	}
+	result->seconds = std::chrono::duration<double>(Clock::duration(lastRead) - begin.time_since_epoch()).count();
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runPoint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool runPoint(const BenchOptions & options, size_t clientCount, RunResult * result)
+--					const BenchOptions & options:	how much to publish and how
+--					size_t clientCount:				reading clients to connect
+--					RunResult * result:				filled in with the timings and the bridge's counters
+--
+-- RETURNS:		bool - false if the bridge could not be opened or a client could not connect
+--
+-- NOTES:
+-- The bridge is closed at the end, which closes every client and lets its reader thread return.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool runPoint(const BenchOptions & options, size_t clientCount, RunResult * result) {
+	TcpBridge bridge;
+	ReaderList readers;
+	intptr_t slowClient = -1;
+	size_t expected = clientCount + (options.hasSlowClient ? 1 : 0);
+
+	if (!bridge.open(options.settings, nullptr)) {
+		return false;
+	}
+	bool isConnected = true;
+
+	for (size_t i = 0; i < clientCount && isConnected; i++) {
+		std::unique_ptr<Reader> reader(new Reader());
+
+		if ((reader->socket = connectClient(bridge.getPort())) == -1) {
+			isConnected = false;
+			break;
+		}
+		reader->thread = std::thread(readClient, reader.get());
+		readers.push_back(std::move(reader));
+	}
+	if (isConnected && options.hasSlowClient && (slowClient = connectClient(bridge.getPort())) == -1) {
+		isConnected = false;
+	}
+	while (isConnected && bridge.getStats().clients < expected) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (isConnected) {
+		publishAll(options, &bridge, readers, result);
+	}
+	result->clients = clientCount;
+	result->stats = bridge.getStats();
+
+	bridge.close();
+	for (const std::unique_ptr<Reader> & reader : readers) {
+		reader->thread.join();
+#ifdef _WIN32
+		closesocket((SOCKET)reader->socket);
+#else
+		close((int)reader->socket);
+#endif
+	}
+	if (slowClient != -1) {
+#ifdef _WIN32
+		closesocket((SOCKET)slowClient);
+#else
+		close((int)slowClient);
+#endif
+	}
+	return isConnected;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printResult
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printResult(FILE * out, RunResult & result, bool isLast)
+--					FILE * out:					where the report goes
+--					RunResult & result:			one client count's run; its samples are sorted by this call
+--					bool isLast:				leave off the trailing comma
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+static void printResult(FILE * out, RunResult & result, bool isLast) {
+	std::vector<double> & samples = result.publishNs;
+	double p50 = 0, p99 = 0, worst = 0;
+
+	std::sort(samples.begin(), samples.end());
+	if (!samples.empty()) {
+		p50 = samples[(size_t)(samples.size() * 0.50)];
+		p99 = samples[(size_t)(samples.size() * 0.99)];
+		worst = samples.back();
+	}
+	fprintf(out, "    { \"clients\": %zu, \"published_bytes\": %llu, \"delivered_bytes\": %llu, ", result.clients,
+		(unsigned long long)result.published, (unsigned long long)result.delivered);
+	fprintf(out, "\"seconds\": %.3f, \"publish_mb_s\": %.1f, \"delivered_mb_s\": %.1f,\n", result.seconds,
+		result.published / result.publishSeconds / (1 << 20), result.delivered / result.seconds / (1 << 20));
+	fprintf(out, "      \"publish_ns\": { \"p50\": %.0f, \"p99\": %.0f, \"max\": %.0f },\n", p50, p99, worst);
+	fprintf(out, "      \"drops\": %llu, \"dropped_bytes\": %llu, \"disconnects\": %llu, \"wakeups\": %llu, "
+		"\"blocks_allocated\": %llu }%s\n", (unsigned long long)result.stats.drops,
+		(unsigned long long)result.stats.droppedBytes, (unsigned long long)result.stats.disconnects,
+		(unsigned long long)result.stats.wakeups, (unsigned long long)result.stats.blocksAllocated,
+		isLast ? "" : ",");
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if a bridge or client could not be set up
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	BenchOptions options;
+	std::vector<RunResult> results;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: BridgeBench [--clients 1,2,5,...] [--megabytes N] [--chunk BYTES] [--rate MB/S] "
+			"[--policy drop|disconnect] [--lag BYTES] [--slow] [--out FILE]\n");
+		return 1;
+	}
+#ifdef _WIN32
+	WSADATA wsaData;
+
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+	for (size_t count : options.clientCounts) {
+		RunResult result;
+
+		if (!runPoint(options, count, &result)) {
+			fprintf(stderr, "could not serve %zu clients\n", count);
+			return 2;
+		}
+		results.push_back(std::move(result));
+	}
+
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		return 1;
+	}
+	fprintf(out, "{\n");
+	fprintf(out, "  \"megabytes\": %zu,\n", options.megabytes);
+	fprintf(out, "  \"chunk\": %zu,\n", options.chunk);
+	fprintf(out, "  \"rate_mb_s\": %.1f,\n", options.rate);
+	fprintf(out, "  \"policy\": \"%s\",\n", options.settings.policy == BacklogPolicy::Drop ? "drop" : "disconnect");
+	fprintf(out, "  \"lag_limit\": %zu,\n", options.settings.lagLimit);
+	fprintf(out, "  \"slow_client\": %s,\n", options.hasSlowClient ? "true" : "false");
+	fprintf(out, "  \"runs\": [\n");
+	for (size_t i = 0; i < results.size(); i++) {
+		printResult(out, results[i], i + 1 == results.size());
+	}
+	fprintf(out, "  ]\n");
+	fprintf(out, "}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,866 @@
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <new>
+#include "../BitmapCompositor.h"
+#include "../Crc.h"
+#include "../GlyphAtlas.h"
+#include "../HeadlessRenderer.h"
+#include "../RingBuffer.h"
+#include "../ScreenModel.h"
+#include "../Scrollback.h"
+#include "../SerialPipeline.h"
+#include "../TerminalEmulator.h"
+#include "../TextScan.h"
+#include "../Utf8Decoder.h"
+#include "../VtParser.h"
+#ifdef _WIN32
+#include "../utils.h"
+#endif
+#include "MicroBench.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		HotPathBench.cpp -	Micro benchmarks for each per-byte stage between the port and the screen.
+--
+-- PROGRAM:			HotPathBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					void BM_ReceiveChunks(MicroState & state)
+--					void BM_ScreenPutText(MicroState & state)
+--					void BM_RenderHeadless(MicroState & state)
+--					void BM_RenderAtlas(MicroState & state)
+--					void BM_ParseEscapes(MicroState & state)
+--					void BM_TerminalReceive(MicroState & state)
+--					void BM_ScanPlainText(MicroState & state)
+--					bool verifyScanKernels(void)
+--					void BM_DecodeUtf8(MicroState & state)
+--					void BM_StrToLPCWSTR(MicroState & state)
+--					bool verifyUtf8Decoder(void)
+--					void BM_Crc16(MicroState & state)
+--					void BM_Crc32(MicroState & state)
+--					bool verifyCrc(void)
+--					void * operator new(size_t size)
+--					void operator delete(void * memory)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Added BM_RenderHeadless
+--					Oct 17, 2026 - Added BM_ParseEscapes and BM_TerminalReceive
+--					Oct 17, 2026 - Added BM_ScanPlainText per scan kernel, and a differential check of the kernels
+--					Oct 17, 2026 - Added BM_DecodeUtf8, a check of the UTF-8 decoder, and allocation counting
+--					Oct 17, 2026 - Added BM_RenderAtlas and the glyph atlas hit rate
+--					Oct 17, 2026 - Added BM_Crc16 and BM_Crc32 for the file transfers, and a check of both CRCs
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: HotPathBench [--min-time SECONDS] [--filter TEXT] [--json FILE]
+--
+-- Each case is one stage run alone over a whole dataset, so the ns/byte columns add up to roughly what the
+-- pipeline spends per byte. See MicroBench.h for the harness and the datasets.
+--
+-- Before anything is timed, every TextScan kernel the CPU can run is checked against a byte-at-a-time reference;
+-- the program stops with exit code 2 if any of them disagree. The UTF-8 decoder is checked the same way, and the
+-- global operator new is replaced with a counting one so the check can also prove that decoding and receiving text
+-- allocate nothing.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t CONVERT_PIECE = 64;	// length of the strings handed to strToLPCWSTR
+constexpr size_t CRC_BLOCK = 1024;		// length of the blocks and subpackets checked
+
+static uint64_t allocationCount = 0;
+
+// Glyph atlas counters summed over every BM_RenderAtlas run, reported after the table
+static uint64_t atlasHits = 0;
+static uint64_t atlasMisses = 0;
+static uint64_t atlasFlushes = 0;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	operator new
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void * operator new(size_t size)
+--					size_t size:	bytes wanted
+--
+-- RETURNS:		void * - the memory; throws std::bad_alloc if there is none
+--
+-- NOTES:
+-- Replaces the global allocator for this program only, to count allocations. The array forms call this one.
+----------------------------------------------------------------------------------------------------------------------*/
+void * operator new(size_t size) {
+	allocationCount++;
+	void * memory = malloc(size != 0 ? size : 1);
+	if (memory == NULL) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	operator delete
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void operator delete(void * memory)
+--					void * memory:	from operator new, or NULL
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void operator delete(void * memory) noexcept {
+	free(memory);
+}
+void operator delete(void * memory, size_t) noexcept {
+	free(memory);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_ReceiveChunks
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_ReceiveChunks(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The receive loop's share of the work: each read-sized chunk is pushed into the SPSC ring and the consumer takes
+-- it back out in place, as SerialPipeline and drain do. Both ends run on this thread so only the copying and the
+-- index bookkeeping are measured, not the hand-off between cores.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_ReceiveChunks(MicroState & state) {
+	RingBuffer ring(RX_RING_SIZE);
+	const char * data;
+	size_t available, checksum = 0;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			ring.push(state.data() + offset, length);
+			while ((available = ring.peek(&data)) > 0) {
+				checksum += (unsigned char)data[available - 1];
+				ring.consume(available);
+			}
+		}
+	}
+	doNotOptimize(checksum);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_ReceiveChunks);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_ScreenPutText
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_ScreenPutText(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The cell update and cursor advance behind DisplayService::drawInput, on an 80x24 screen with scrollback, fed in
+-- the chunks drain hands over. The dirty runs are walked once per chunk as the next paint would.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_ScreenPutText(MicroState & state) {
+	ScreenModel screen(80, 24);
+	Scrollback history(100000, 32 << 20);
+	int runs = 0;
+
+	screen.setScrollback(&history);
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			screen.putText(state.data() + offset, length);
+			screen.forEachDirtyRun([&runs](int, int, const char16_t *, int, uint8_t) { runs++; });
+		}
+	}
+	doNotOptimize(runs);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_ScreenPutText);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_RenderHeadless
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_RenderHeadless(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- BM_ScreenPutText with the walk replaced by a real frame: every chunk is followed by renderView into a
+-- HeadlessRenderer, the same calls paint makes with GDI, so the difference between the two cases is the paint
+-- path's own cost.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_RenderHeadless(MicroState & state) {
+	ScreenModel screen(80, 24);
+	Scrollback history(100000, 32 << 20);
+	HeadlessRenderer renderer(80, 24);
+
+	screen.setScrollback(&history);
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			screen.putText(state.data() + offset, length);
+			renderView(renderer, screen, history, 0);
+		}
+	}
+	doNotOptimize(renderer.getCellCount());
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_RenderHeadless);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_RenderAtlas
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_RenderAtlas(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- BM_RenderHeadless drawing pixels: every frame goes into a BitmapCompositor back buffer of 8 by 16 pixel cells,
+-- copied from a GlyphAtlas filled by PatternRasterizer. This is what GdiRenderer does before its one blit, so the
+-- difference from BM_RenderHeadless is the cost of the pixels themselves.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_RenderAtlas(MicroState & state) {
+	ScreenModel screen(80, 24);
+	Scrollback history(100000, 32 << 20);
+	PatternRasterizer rasterizer;
+	GlyphAtlas atlas(rasterizer);
+
+	atlas.setCellSize(8, 16);
+	BitmapCompositor compositor(atlas, 80, 24);
+	screen.setScrollback(&history);
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			screen.putText(state.data() + offset, length);
+			renderView(compositor, screen, history, 0);
+		}
+	}
+	doNotOptimize(compositor.getCellCount());
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+	atlasHits += atlas.getHits();
+	atlasMisses += atlas.getMisses();
+	atlasFlushes += atlas.getFlushes();
+}
+MICRO_BENCHMARK(BM_RenderAtlas);
+
+// Counts what the parser reports so nothing it finds can be optimised away
+struct CountingHandler {
+	size_t printed = 0;
+	size_t controls = 0;
+	size_t sequences = 0;
+
+	void print(const char *, size_t length) { printed += length; };
+	void execute(uint8_t) { controls++; };
+	void escDispatch(const VtSequence &) { sequences++; };
+	void csiDispatch(const VtSequence & sequence) { sequences += sequence.finalByte; };
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_ParseEscapes
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_ParseEscapes(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The VtParser alone, fed in drain-sized chunks, with a handler that only counts. On the ASCII dataset this is the
+-- printable fast path; the TUI dataset exercises the transition table.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_ParseEscapes(MicroState & state) {
+	VtParser parser;
+	CountingHandler handler;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			parser.feed(state.data() + offset, length, handler);
+		}
+	}
+	doNotOptimize(handler.printed + handler.controls + handler.sequences);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_ParseEscapes);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_TerminalReceive
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_TerminalReceive(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- What DisplayService::drawInput does per chunk: parse, move the cursor, and write the printable runs into an 80x24
+-- screen with scrollback.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_TerminalReceive(MicroState & state) {
+	ScreenModel screen(80, 24);
+	Scrollback history(100000, 32 << 20);
+	TerminalEmulator terminal(screen);
+
+	screen.setScrollback(&history);
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			terminal.receive(state.data() + offset, length);
+		}
+	}
+	doNotOptimize(screen.getScrollCount());
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_TerminalReceive);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_DecodeUtf8
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_DecodeUtf8(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The dataset is decoded in receive sized chunks into one reused buffer, as TerminalEmulator::print does.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_DecodeUtf8(MicroState & state) {
+	static char16_t decoded[utf8MaxOutput(RX_CHUNK_SIZE)];
+	Utf8Decoder decoder;
+	size_t units = 0;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += RX_CHUNK_SIZE) {
+			size_t length = state.size() - offset < RX_CHUNK_SIZE ? state.size() - offset : RX_CHUNK_SIZE;
+			units += decoder.decode(state.data() + offset, length, decoded);
+		}
+	}
+	doNotOptimize(units);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_DecodeUtf8);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_StrToLPCWSTR
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_StrToLPCWSTR(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The dataset is cut into 64 byte strings and each is converted into a stack buffer, as displayMessageBox does. Off
+-- Windows the same decode and flush are done with a Utf8Decoder directly.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_StrToLPCWSTR(MicroState & state) {
+	char piece[CONVERT_PIECE + 1];
+	size_t checksum = 0;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset + CONVERT_PIECE <= state.size(); offset += CONVERT_PIECE) {
+			memcpy(piece, state.data() + offset, CONVERT_PIECE);
+			piece[CONVERT_PIECE] = '\0';
+#ifdef _WIN32
+			wchar_t wide[CONVERT_PIECE + 2];
+			utils::strToLPCWSTR(piece, wide, CONVERT_PIECE + 2);
+#else
+			char16_t wide[utf8MaxOutput(CONVERT_PIECE) + 1];
+			Utf8Decoder decoder;
+			size_t length = decoder.decode(piece, strlen(piece), wide);
+			length += decoder.flush(wide + length);
+			wide[length] = u'\0';
+#endif
+			checksum += wide[0];
+		}
+	}
+	doNotOptimize(checksum);
+	state.setBytesProcessed((uint64_t)state.iterations() * (state.size() / CONVERT_PIECE * CONVERT_PIECE));
+}
+MICRO_BENCHMARK(BM_StrToLPCWSTR);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_Crc16
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_Crc16(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The dataset is checked in 1024 byte blocks, as XMODEM-1K and YMODEM send it.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_Crc16(MicroState & state) {
+	uint32_t checksum = 0;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += CRC_BLOCK) {
+			size_t length = state.size() - offset < CRC_BLOCK ? state.size() - offset : CRC_BLOCK;
+			checksum += crc16(state.data() + offset, length);
+		}
+	}
+	doNotOptimize(checksum);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_Crc16);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_Crc32
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_Crc32(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- The dataset is checked in 1024 byte subpackets, as ZMODEM sends it.
+----------------------------------------------------------------------------------------------------------------------*/
+static void BM_Crc32(MicroState & state) {
+	uint32_t checksum = 0;
+
+	for (auto _ : state) {
+		for (size_t offset = 0; offset < state.size(); offset += CRC_BLOCK) {
+			size_t length = state.size() - offset < CRC_BLOCK ? state.size() - offset : CRC_BLOCK;
+			checksum += crc32(state.data() + offset, length);
+		}
+	}
+	doNotOptimize(checksum);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+MICRO_BENCHMARK(BM_Crc32);
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	BM_ScanPlainText
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void BM_ScanPlainText<Kernel>(MicroState & state)
+--					MicroState & state:	iteration count and dataset
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Splits the dataset into plain runs and special bytes with one kernel, the way the parser's ground state does.
+-- main registers one case per kernel the CPU can run.
+----------------------------------------------------------------------------------------------------------------------*/
+template <size_t Kernel>
+static void BM_ScanPlainText(MicroState & state) {
+	size_t count;
+	ScanFunction scan = getScanKernels(&count)[Kernel].scan;
+	const uint8_t * start = (const uint8_t *)state.data();
+	const uint8_t * end = start + state.size();
+	size_t runs = 0;
+
+	for (auto _ : state) {
+		const uint8_t * text = start;
+		while (text < end) {
+			const uint8_t * next = scan(text, end);
+			runs += next != text;
+			text = next < end ? next + 1 : end;
+		}
+	}
+	doNotOptimize(runs);
+	state.setBytesProcessed((uint64_t)state.iterations() * state.size());
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	verifyScanKernels
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool verifyScanKernels(void)
+--
+-- RETURNS:		bool - true if every kernel matches the reference on every input
+--
+-- NOTES:
+-- Two sets of inputs: each of the 256 byte values placed at each position of a 96 byte plain buffer, which covers
+-- every lane of every vector width and the scalar tail; then random buffers of every length up to 300 at every
+-- start alignment up to 32, with special bytes at random densities.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool verifyScanKernels() {
+	size_t count;
+	const ScanKernel * kernels = getScanKernels(&count);
+	uint8_t buffer[340];
+	uint32_t random = 12345;
+	uint64_t cases = 0, failures = 0;
+
+	auto check = [&](const uint8_t * text, const uint8_t * end) {
+		const uint8_t * expected = text;
+		while (expected < end && *expected >= 0x20 && *expected < 0x7F) {
+			expected++;
+		}
+		for (size_t k = 0; k < count; k++) {
+			const uint8_t * found = kernels[k].scan(text, end);
+			if (found != expected) {
+				if (failures++ < 10) {
+					fprintf(stderr, "%s: length %zu, expected %zu, got %zu\n", kernels[k].name, (size_t)(end - text),
+						(size_t)(expected - text), (size_t)(found - text));
+				}
+			}
+		}
+		cases++;
+	};
+
+	for (int value = 0; value < 256; value++) {
+		for (size_t position = 0; position < 96; position++) {
+			memset(buffer, 'a', 96);
+			buffer[position] = (uint8_t)value;
+			check(buffer, buffer + 96);
+		}
+	}
+	for (size_t length = 0; length <= 300; length++) {
+		for (size_t alignment = 0; alignment < 32; alignment++) {
+			uint32_t density = 1 + nextPayloadRandom(&random) % 64;
+			for (size_t i = 0; i < length; i++) {
+				uint32_t r = nextPayloadRandom(&random);
+				buffer[alignment + i] = r % density == 0 ? (uint8_t)(r >> 8) : (uint8_t)(0x20 + (r >> 8) % 0x5F);
+			}
+			check(buffer + alignment, buffer + alignment + length);
+		}
+	}
+
+	printf("scan kernels:");
+	for (size_t k = 0; k < count; k++) {
+		printf(" %s", kernels[k].name);
+	}
+	printf(" (using %s); %llu inputs checked, %llu mismatches\n", getSelectedScanKernel().name,
+		(unsigned long long)cases, (unsigned long long)failures);
+	return failures == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	verifyUtf8Decoder
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool verifyUtf8Decoder(void)
+--
+-- RETURNS:		bool - true if every input decodes as expected and nothing was allocated
+--
+-- NOTES:
+-- Each input is random valid characters of every encoded length mixed with known ill-formed pieces, so the expected
+-- UTF-16 is built alongside it. It is decoded whole and then in chunks of every size from 1 to 17, which puts a cut
+-- inside every kind of sequence. A TerminalEmulator then receives the same bytes. The allocation count is taken
+-- around the decoding and receiving only; the buffers are set up before.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool verifyUtf8Decoder() {
+	// Stray continuation bytes follow a letter so they cannot complete a truncated piece before them
+	struct IllFormed {
+		const char * bytes;
+		const char16_t * units;
+	};
+	static const IllFormed illFormed[] = {
+		{ "a\x80", u"a\uFFFD" }, { "a\xBF", u"a\uFFFD" }, { "\xC0\xAF", u"\uFFFD\uFFFD" }, { "\xC1", u"\uFFFD" },
+		{ "\xC3", u"\uFFFD" }, { "\xE0\x80\xAF", u"\uFFFD\uFFFD\uFFFD" }, { "\xE2\x82", u"\uFFFD" },
+		{ "\xED\xA0\x80", u"\uFFFD\uFFFD\uFFFD" }, { "\xF0\x8F\xBF\xBF", u"\uFFFD\uFFFD\uFFFD\uFFFD" },
+		{ "\xF0\x9F\x98", u"\uFFFD" }, { "\xF4\x90\x80\x80", u"\uFFFD\uFFFD\uFFFD\uFFFD" },
+		{ "\xF5", u"\uFFFD" }, { "\xFF", u"\uFFFD" }
+	};
+	constexpr size_t INPUT_MAX = 1024;
+	constexpr int ROUNDS = 200;
+	static char input[INPUT_MAX];
+	static char16_t expected[INPUT_MAX + 1];
+	static char16_t decoded[INPUT_MAX + 1];
+	ScreenModel screen(80, 24);
+	TerminalEmulator terminal(screen);
+	uint32_t random = 54321;
+	uint64_t cases = 0, failures = 0;
+	uint64_t allocationsBefore = allocationCount;
+
+	for (int round = 0; round < ROUNDS; round++) {
+		size_t length = 0, units = 0;
+
+		while (length + 4 <= INPUT_MAX) {
+			uint32_t r = nextPayloadRandom(&random);
+			uint32_t codePoint;
+			switch (r % 6) {
+			case 0:
+				codePoint = 0x20 + (r >> 8) % 0x5F;
+				break;
+			case 1:
+				codePoint = 0x80 + (r >> 8) % 0x780;
+				break;
+			case 2:
+				codePoint = 0x800 + (r >> 8) % 0xF800;
+				if (codePoint >= 0xD800 && codePoint < 0xE000) {
+					codePoint -= 0x800;
+				}
+				break;
+			case 3:
+				codePoint = 0x10000 + (r >> 8) % 0x100000;
+				break;
+			default: {
+				const IllFormed & piece = illFormed[(r >> 8) % (sizeof(illFormed) / sizeof(illFormed[0]))];
+				size_t pieceLength = strlen(piece.bytes);
+				memcpy(input + length, piece.bytes, pieceLength);
+				length += pieceLength;
+				for (const char16_t * unit = piece.units; *unit != 0; unit++) {
+					expected[units++] = *unit;
+				}
+				continue;
+			}
+			}
+
+			if (codePoint < 0x80) {
+				input[length++] = (char)codePoint;
+			}
+			else if (codePoint < 0x800) {
+				input[length++] = (char)(0xC0 | codePoint >> 6);
+				input[length++] = (char)(0x80 | (codePoint & 0x3F));
+			}
+			else if (codePoint < 0x10000) {
+				input[length++] = (char)(0xE0 | codePoint >> 12);
+				input[length++] = (char)(0x80 | (codePoint >> 6 & 0x3F));
+				input[length++] = (char)(0x80 | (codePoint & 0x3F));
+			}
+			else {
+				input[length++] = (char)(0xF0 | codePoint >> 18);
+				input[length++] = (char)(0x80 | (codePoint >> 12 & 0x3F));
+				input[length++] = (char)(0x80 | (codePoint >> 6 & 0x3F));
+				input[length++] = (char)(0x80 | (codePoint & 0x3F));
+			}
+			if (codePoint < 0x10000) {
+				expected[units++] = (char16_t)codePoint;
+			}
+			else {
+				expected[units++] = (char16_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+				expected[units++] = (char16_t)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+			}
+		}
+
+		for (size_t chunk = 0; chunk <= 17; chunk++) {
+			Utf8Decoder decoder;
+			size_t written = 0;
+			size_t step = chunk == 0 ? length : chunk;
+
+			for (size_t offset = 0; offset < length; offset += step) {
+				size_t slice = length - offset < step ? length - offset : step;
+				written += decoder.decode(input + offset, slice, decoded + written);
+			}
+			written += decoder.flush(decoded + written);
+			if (written != units || memcmp(decoded, expected, units * sizeof(char16_t)) != 0) {
+				if (failures++ < 10) {
+					fprintf(stderr, "utf-8 round %d, chunk %zu: expected %zu units, got %zu\n", round, chunk, units,
+						written);
+				}
+			}
+			cases++;
+		}
+		terminal.receive(input, length);
+	}
+
+	uint64_t allocations = allocationCount - allocationsBefore;
+	printf("utf-8 decoder: %llu inputs checked, %llu mismatches, %llu allocations\n", (unsigned long long)cases,
+		(unsigned long long)failures, (unsigned long long)allocations);
+	return failures == 0 && allocations == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	verifyCrc
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool verifyCrc(void)
+--
+-- RETURNS:		bool - true if both CRCs give their standard check values and match a bit-at-a-time reference
+--
+-- NOTES:
+-- The table-driven CRCs take eight bytes at a time with a byte-wise head and tail, so random inputs of every length
+-- up to 64 are checked at every alignment from 0 to 7, whole and split in two to check the carried value.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool verifyCrc() {
+	static const char check[] = "123456789";
+	static char input[72];
+	uint32_t random = 97531;
+	uint64_t cases = 0, failures = 0;
+
+	failures += crc16(check, 9) != 0x31C3;
+	failures += crc32(check, 9) != 0xCBF43926u;
+	for (size_t i = 0; i < sizeof(input); i++) {
+		input[i] = (char)nextPayloadRandom(&random);
+	}
+	for (size_t align = 0; align < 8; align++) {
+		for (size_t length = 0; length <= 64; length++) {
+			const char * data = input + align;
+			uint16_t expected16 = 0;
+			uint32_t expected32 = 0xFFFFFFFFu;
+
+			for (size_t i = 0; i < length; i++) {
+				expected16 ^= (uint16_t)((uint8_t)data[i] << 8);
+				expected32 ^= (uint8_t)data[i];
+				for (int bit = 0; bit < 8; bit++) {
+					expected16 = (uint16_t)(expected16 & 0x8000 ? (expected16 << 1) ^ 0x1021 : expected16 << 1);
+					expected32 = expected32 & 1 ? (expected32 >> 1) ^ 0xEDB88320u : expected32 >> 1;
+				}
+			}
+			expected32 ^= 0xFFFFFFFFu;
+			failures += crc16(data, length) != expected16;
+			failures += crc32(data, length) != expected32;
+			failures += crc16(data + length / 2, length - length / 2, crc16(data, length / 2)) != expected16;
+			failures += crc32(data + length / 2, length - length / 2, crc32(data, length / 2)) != expected32;
+			cases++;
+		}
+	}
+	printf("crc: %llu inputs checked, %llu mismatches\n", (unsigned long long)cases, (unsigned long long)failures);
+	return failures == 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Also checks the UTF-8 decoder
+--				Oct 17, 2026 - Also checks the CRCs
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the scan kernels, the UTF-8 decoder or the CRCs fail
+--				their check
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	static const MicroFunction scanCases[] = { BM_ScanPlainText<0>, BM_ScanPlainText<1>, BM_ScanPlainText<2> };
+	static const char * const scanNames[] = {
+		"BM_ScanPlainText/scalar", "BM_ScanPlainText/sse2", "BM_ScanPlainText/avx2"
+	};
+	size_t count;
+
+	if (!verifyScanKernels() || !verifyUtf8Decoder() || !verifyCrc()) {
+		return 2;
+	}
+	getScanKernels(&count);
+	for (size_t k = 0; k < count; k++) {
+		microCases().push_back({ scanNames[k], scanCases[k] });
+	}
+
+	int result = runMicroBenchmarks(argc, argv);
+	if (atlasHits + atlasMisses > 0) {
+		printf("glyph atlas: %.2f%% hit rate over %llu lookups, %llu flushes\n",
+			100.0 * atlasHits / (atlasHits + atlasMisses), (unsigned long long)(atlasHits + atlasMisses),
+			(unsigned long long)atlasFlushes);
+	}
+	return result;
+}
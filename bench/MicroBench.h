@@ -0,0 +1,249 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "BenchSupport.h"
+#include "Payloads.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		MicroBench.h -	A small harness for per-stage micro benchmarks.
+--
+-- PROGRAM:			Benchmarks
+--
+-- FUNCTIONS:
+--					void setBytesProcessed(uint64_t bytes)
+--					std::vector<MicroCase> & microCases(void)
+--					void doNotOptimize(const T & value)
+--					int runMicroBenchmarks(int argc, char * argv[])
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Option parsing comes from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Modelled on Google Benchmark so cases read the same way, without the dependency:
+--
+--		static void BM_Something(MicroState & state) {
+--			for (auto _ : state) {
+--				... work on state.data() ...
+--			}
+--			state.setBytesProcessed(state.iterations() * state.size());
+--		}
+--		MICRO_BENCHMARK(BM_Something);
+--
+-- Every case runs once per dataset: 1 MiB each of ASCII log lines, binary noise and escape-heavy TUI output, all
+-- from Payloads.h with a fixed seed. The iteration count grows until a run lasts --min-time seconds, and the
+-- report gives ns per iteration, ns per byte and MB/s. --json FILE writes the same numbers for comparing commits;
+-- --filter TEXT runs only cases whose name contains TEXT.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr size_t MICRO_DATASET_SIZE = 1 << 20;
+
+// Marked unused so "for (auto _ : state)" compiles without warnings
+#if defined(__GNUC__)
+struct __attribute__((unused)) MicroValue {};
+#else
+struct MicroValue {};
+#endif
+
+class MicroState {
+private:
+	size_t iterationCount;
+	uint64_t bytesProcessed = 0;
+	const std::string * dataset;
+public:
+	struct Iterator {
+		size_t left;
+		bool operator!=(const Iterator & other) const { return left != other.left; };
+		void operator++() { left--; };
+		MicroValue operator*() const { return MicroValue(); };
+	};
+
+	MicroState(size_t iterations, const std::string * data) : iterationCount(iterations), dataset(data) {};
+	Iterator begin() const { return Iterator{ iterationCount }; };
+	Iterator end() const { return Iterator{ 0 }; };
+
+	size_t iterations() const { return iterationCount; };
+	const char * data() const { return dataset->data(); };
+	size_t size() const { return dataset->size(); };
+	void setBytesProcessed(uint64_t bytes) { bytesProcessed = bytes; };
+	uint64_t getBytesProcessed() const { return bytesProcessed; };
+};
+
+typedef void (*MicroFunction)(MicroState & state);
+
+struct MicroCase {
+	const char * name;
+	MicroFunction function;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	microCases
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::vector<MicroCase> & microCases(void)
+--
+-- RETURNS:		std::vector<MicroCase> & - every case registered with MICRO_BENCHMARK
+----------------------------------------------------------------------------------------------------------------------*/
+inline std::vector<MicroCase> & microCases() {
+	static std::vector<MicroCase> cases;
+	return cases;
+}
+
+struct MicroRegistrar {
+	MicroRegistrar(const char * name, MicroFunction function) { microCases().push_back({ name, function }); };
+};
+
+#define MICRO_BENCHMARK(function) static MicroRegistrar function##Registrar(#function, function)
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	doNotOptimize
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void doNotOptimize(const T & value)
+--					const T & value:	a result the compiler must not discard
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+template <typename T>
+inline void doNotOptimize(const T & value) {
+#if defined(_MSC_VER)
+	static volatile const void * sink;
+	sink = &value;
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runMicroBenchmarks
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int runMicroBenchmarks(int argc, char * argv[])
+--					int argc:		argument count
+--					char * argv[]:	[--min-time SECONDS] [--filter TEXT] [--json FILE]
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments
+--
+-- NOTES:
+-- Call this function from main once every case is registered.
+----------------------------------------------------------------------------------------------------------------------*/
+inline int runMicroBenchmarks(int argc, char * argv[]) {
+	const PayloadKind kinds[] = { PayloadKind::Ascii, PayloadKind::Binary, PayloadKind::Tui };
+	double minTime = 0.5;
+	const char * filter = NULL;
+	const char * jsonPath = NULL;
+	FILE * json = NULL;
+	bool isFirst = true;
+	bool isParsed;
+
+	isParsed = parseArguments(argc, argv, {}, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--min-time") == 0) {
+			minTime = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--filter") == 0) {
+			filter = value;
+		}
+		else if (strcmp(name, "--json") == 0) {
+			jsonPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	if (!isParsed) {
+		fprintf(stderr, "usage: %s [--min-time SECONDS] [--filter TEXT] [--json FILE]\n", argv[0]);
+		return 1;
+	}
+	if (jsonPath != NULL && (json = fopen(jsonPath, "w")) == NULL) {
+		fprintf(stderr, "could not write %s\n", jsonPath);
+		return 1;
+	}
+
+	std::vector<std::string> datasets;
+	for (PayloadKind kind : kinds) {
+		datasets.push_back(makePayload(kind, MICRO_DATASET_SIZE, 1));
+	}
+
+	printf("%-36s %-8s %12s %14s %10s %10s\n", "case", "dataset", "iterations", "ns/iter", "ns/byte", "MB/s");
+	if (json) {
+		fprintf(json, "{\n  \"results\": [\n");
+	}
+	for (const MicroCase & microCase : microCases()) {
+		if (filter != NULL && strstr(microCase.name, filter) == NULL) {
+			continue;
+		}
+		for (size_t d = 0; d < datasets.size(); d++) {
+			size_t iterations = 1;
+			double elapsed;
+			uint64_t bytes;
+
+			for (;;) {
+				MicroState state(iterations, &datasets[d]);
+				auto start = std::chrono::steady_clock::now();
+				microCase.function(state);
+				elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				bytes = state.getBytesProcessed();
+				if (elapsed >= minTime || iterations >= ((size_t)1 << 40)) {
+					break;
+				}
+				// Aim a little past the target so the last run usually is the measured one
+				double scale = elapsed > 0 ? minTime * 1.2 / elapsed : 10;
+				iterations = (size_t)(iterations * (scale < 2 ? 2 : (scale > 100 ? 100 : scale)));
+			}
+
+			double nsPerIteration = elapsed * 1e9 / iterations;
+			double nsPerByte = bytes ? elapsed * 1e9 / bytes : 0;
+			double megabytesPerSecond = bytes ? bytes / elapsed / 1e6 : 0;
+			printf("%-36s %-8s %12zu %14.1f %10.3f %10.1f\n", microCase.name, payloadName(kinds[d]), iterations,
+				nsPerIteration, nsPerByte, megabytesPerSecond);
+			if (json) {
+				fprintf(json, "%s    { \"case\": \"%s\", \"dataset\": \"%s\", \"iterations\": %zu, "
+					"\"ns_per_iter\": %.3f, \"ns_per_byte\": %.4f, \"mb_per_s\": %.2f }", isFirst ? "" : ",\n",
+					microCase.name, payloadName(kinds[d]), iterations, nsPerIteration, nsPerByte, megabytesPerSecond);
+				isFirst = false;
+			}
+		}
+	}
+	if (json) {
+		fprintf(json, "\n  ]\n}\n");
+		fclose(json);
+	}
+	return 0;
+}
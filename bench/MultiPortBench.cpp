@@ -0,0 +1,400 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../PortMultiplexer.h"
+#include "../SerialPipeline.h"
+#include "BenchSupport.h"
+#include "Payloads.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		MultiPortBench.cpp -	How receiving scales from 1 to 64 ports, shared I/O thread against one each.
+--
+-- PROGRAM:			MultiPortBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					bool runPoint(const BenchOptions & options, size_t portCount, bool isShared, RunResult * result)
+--					void printResult(FILE * out, const RunResult & result, bool isLast)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Loopbacks, option parsing and process usage come from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: MultiPortBench [--transport sim|pty] [--ports N,N,...] [--mode shared|threads|both] [--baud N]
+--                       [--rate BYTES_PER_SEC] [--seconds N] [--out FILE]
+--
+-- For each port count (1, 2, 4, 8, 16, 32 and 64 by default) N loopbacks are opened and a SerialPipeline started on
+-- each, either all receiving through one PortMultiplexer (shared) or each with its own reader thread (threads), as
+-- SessionService would run them. One generator thread keeps every line busy: simulated ports are fed at exactly the
+-- line rate of --baud (921600 by default), pty masters are written at --rate bytes per second each. One consumer
+-- thread plays the window thread and drains whichever pipeline notified.
+--
+-- Per run the JSON report gives aggregate MB/s over the generating time against what the lines can carry, process
+-- CPU per MB, bytes lost to FIFO overruns (a reader that fell behind its UART) or ring overflow, the I/O thread's
+-- wakeups for the shared mode, and the context switches per second for both, which is where a thread per port pays.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct BenchOptions {
+	std::string transport;
+	std::vector<size_t> portCounts;
+	bool isShared = true;
+	bool isThreaded = true;
+	uint32_t baudRate = 921600;
+	double rate = 92160;
+	double seconds = 2;
+	const char * outPath = NULL;
+};
+
+struct RunResult {
+	size_t ports = 0;
+	bool isShared = false;
+	double seconds = 0;
+	double lineRate = 0;			// bytes per second all the lines together can carry
+	uint64_t bytesSent = 0;
+	uint64_t bytesReceived = 0;
+	uint64_t fifoOverruns = 0;
+	uint64_t ringOverflow = 0;
+	uint64_t notifies = 0;
+	uint64_t wakeups = 0;
+	uint64_t contextSwitches = 0;
+	double cpuSeconds = 0;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					BenchOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument was not understood
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+	bool isParsed;
+
+	options->transport = "sim";
+	options->portCounts = { 1, 2, 4, 8, 16, 32, 64 };
+	isParsed = parseArguments(argc, argv, {}, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--transport") == 0) {
+			options->transport = value;
+		}
+		else if (strcmp(name, "--ports") == 0) {
+			return parseCounts(value, &options->portCounts);
+		}
+		else if (strcmp(name, "--mode") == 0) {
+			options->isShared = strcmp(value, "shared") == 0 || strcmp(value, "both") == 0;
+			options->isThreaded = strcmp(value, "threads") == 0 || strcmp(value, "both") == 0;
+			return options->isShared || options->isThreaded;
+		}
+		else if (strcmp(name, "--baud") == 0) {
+			options->baudRate = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--rate") == 0) {
+			options->rate = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--seconds") == 0) {
+			options->seconds = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	return isParsed && !options->portCounts.empty() && options->seconds > 0 && options->rate > 0 &&
+		options->baudRate > 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runPoint
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool runPoint(const BenchOptions & options, size_t portCount, bool isShared, RunResult * result)
+--					const BenchOptions & options:	transport, line rate and duration
+--					size_t portCount:				loopbacks to run at once
+--					bool isShared:					receive through one PortMultiplexer rather than a thread each
+--					RunResult * result:				filled in with the measurements
+--
+-- RETURNS:		bool - false if a loopback, the multiplexer or a pipeline could not be started
+--
+-- NOTES:
+-- The generator works in 1 ms steps, topping every line up to where its rate says it should be by now, so a port
+-- that is read late loses bytes to its FIFO just as it would behind a real UART.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool runPoint(const BenchOptions & options, size_t portCount, bool isShared, RunResult * result) {
+	std::vector<Loopback> loopbacks(portCount);
+	std::vector<std::unique_ptr<SerialPipeline>> pipelines;
+	std::unique_ptr<PortMultiplexer> multiplexer;
+	std::mutex wakeLock;
+	std::condition_variable wake;
+	std::vector<char> isNotified(portCount, 0);
+	std::atomic<bool> isGenerating{ true };
+	const std::string payload = makePayload(PayloadKind::Ascii, 1 << 20, 1);
+	double portRate = options.rate;
+	bool isStarted = true;
+	LoopbackOptions loopbackOptions;
+
+	loopbackOptions.transport = options.transport;
+	loopbackOptions.settings.baudRate = options.baudRate;
+	if (isShared) {
+		multiplexer = createPortMultiplexer();
+		if (!multiplexer->start()) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < portCount && isStarted; i++) {
+		loopbackOptions.index = (int)i;
+		if (!openLoopback(loopbackOptions, &loopbacks[i])) {
+			fprintf(stderr, "could not open %s loopback %zu\n", options.transport.c_str(), i + 1);
+			isStarted = false;
+			break;
+		}
+		if (loopbacks[i].simulated != nullptr) {
+			portRate = 1 / loopbacks[i].simulated->getByteTime();
+		}
+		pipelines.emplace_back(new SerialPipeline());
+		isStarted = pipelines.back()->start(loopbacks[i].local.get(), [&, i]() {
+			std::lock_guard<std::mutex> guard(wakeLock);
+			isNotified[i] = 1;
+			wake.notify_one();
+		}, multiplexer.get());
+	}
+
+	ProcessUsage usageStart = processUsage();
+	Clock::time_point start = Clock::now();
+	Clock::time_point stopAt = start + std::chrono::microseconds((long long)(options.seconds * 1e6));
+	std::vector<uint64_t> sent(portCount, 0);
+
+	std::thread generator([&]() {
+		Clock::time_point next = start;
+
+		while (isStarted && isGenerating.load(std::memory_order_relaxed)) {
+			double due = std::chrono::duration<double>(Clock::now() - start).count() * portRate;
+
+			for (size_t i = 0; i < portCount; i++) {
+				size_t offset = (size_t)(sent[i] % payload.size());
+				size_t length = std::min((size_t)(due - (double)sent[i]), payload.size() - offset);
+
+				if (due <= (double)sent[i] || length == 0) {
+					continue;
+				}
+				if (loopbacks[i].simulated != nullptr) {
+					loopbacks[i].simulated->feed(payload.data() + offset, length);
+				}
+				else if (!loopbacks[i].remote->write(payload.data() + offset, length)) {
+					continue;
+				}
+				sent[i] += length;
+			}
+			next += std::chrono::milliseconds(1);
+			std::this_thread::sleep_until(next);
+		}
+	});
+
+	// The consumer drains whichever pipeline notified until the run ends and the lines have gone quiet
+	std::vector<size_t> ready;
+	Clock::time_point lastData = start;
+	Clock::time_point end = stopAt;
+	uint64_t received = 0, notifies = 0;
+
+	while (isStarted) {
+		ready.clear();
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			wake.wait_for(guard, std::chrono::milliseconds(10));
+			for (size_t i = 0; i < portCount; i++) {
+				if (isNotified[i]) {
+					isNotified[i] = 0;
+					ready.push_back(i);
+				}
+			}
+		}
+		notifies += ready.size();
+		for (size_t i : ready) {
+			pipelines[i]->drain([&](const char *, size_t length) {
+				received += length;
+			});
+		}
+
+		Clock::time_point now = Clock::now();
+		if (!ready.empty()) {
+			lastData = now;
+		}
+		if (now >= stopAt && isGenerating.exchange(false)) {
+			generator.join();
+			lastData = now;
+			end = now;
+		}
+		if (!isGenerating.load() && now - lastData > std::chrono::milliseconds(200)) {
+			break;
+		}
+	}
+	if (generator.joinable()) {
+		isGenerating.store(false);
+		generator.join();
+	}
+	ProcessUsage usageEnd = processUsage();
+
+	for (size_t i = 0; i < pipelines.size(); i++) {
+		pipelines[i]->stop();
+		result->ringOverflow += pipelines[i]->getReceiveRing().getOverflowBytes();
+		if (loopbacks[i].simulated != nullptr) {
+			result->fifoOverruns += loopbacks[i].simulated->getStats().fifoOverruns;
+		}
+		loopbacks[i].local->close();
+		loopbacks[i].remote->close();
+	}
+	if (multiplexer) {
+		result->wakeups = multiplexer->getStats().wakeups;
+		multiplexer->stop();
+	}
+
+	result->ports = portCount;
+	result->isShared = isShared;
+	result->seconds = std::chrono::duration<double>(end - start).count();
+	result->lineRate = portRate * portCount;
+	for (uint64_t count : sent) {
+		result->bytesSent += count;
+	}
+	result->bytesReceived = received;
+	result->notifies = notifies;
+	result->contextSwitches = usageEnd.contextSwitches - usageStart.contextSwitches;
+	result->cpuSeconds = usageEnd.cpuSeconds - usageStart.cpuSeconds;
+	return isStarted;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printResult
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printResult(FILE * out, const RunResult & result, bool isLast)
+--					FILE * out:					where the report goes
+--					const RunResult & result:	one port count in one mode
+--					bool isLast:				leave off the trailing comma
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+static void printResult(FILE * out, const RunResult & result, bool isLast) {
+	double megabytes = result.bytesReceived / 1e6;
+
+	fprintf(out, "    { \"ports\": %zu, \"mode\": \"%s\", \"receive_threads\": %zu, \"seconds\": %.3f,\n",
+		result.ports, result.isShared ? "shared" : "threads", result.isShared ? (size_t)1 : result.ports,
+		result.seconds);
+	fprintf(out, "      \"line_rate_mb_s\": %.3f, \"throughput_mb_s\": %.3f, \"bytes_sent\": %llu, "
+		"\"bytes_received\": %llu,\n", result.lineRate / 1e6, megabytes / result.seconds,
+		(unsigned long long)result.bytesSent, (unsigned long long)result.bytesReceived);
+	fprintf(out, "      \"fifo_overrun_bytes\": %llu, \"ring_overflow_bytes\": %llu,\n",
+		(unsigned long long)result.fifoOverruns, (unsigned long long)result.ringOverflow);
+	fprintf(out, "      \"cpu_percent\": %.1f, \"cpu_ms_per_mb\": %.3f, \"context_switches_per_s\": %.0f,\n",
+		result.cpuSeconds * 100 / result.seconds, megabytes > 0 ? result.cpuSeconds * 1000 / megabytes : 0.0,
+		result.contextSwitches / result.seconds);
+	fprintf(out, "      \"io_wakeups_per_s\": %.0f, \"notifies_per_s\": %.0f }%s\n",
+		result.wakeups / result.seconds, result.notifies / result.seconds, isLast ? "" : ",");
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if a run could not be started
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	BenchOptions options;
+	std::vector<RunResult> results;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: MultiPortBench [--transport sim|pty] [--ports N,N,...] [--mode shared|threads|both] "
+			"[--baud N] [--rate BYTES_PER_SEC] [--seconds N] [--out FILE]\n");
+		return 1;
+	}
+	for (size_t portCount : options.portCounts) {
+		for (int shared = 1; shared >= 0; shared--) {
+			RunResult result;
+
+			if ((shared && !options.isShared) || (!shared && !options.isThreaded)) {
+				continue;
+			}
+			if (!runPoint(options, portCount, shared != 0, &result)) {
+				fprintf(stderr, "could not run %zu %s ports\n", portCount, options.transport.c_str());
+				return 2;
+			}
+			results.push_back(result);
+		}
+	}
+
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		return 1;
+	}
+	fprintf(out, "{\n");
+	fprintf(out, "  \"transport\": \"%s\",\n", options.transport.c_str());
+	if (options.transport == "sim") {
+		fprintf(out, "  \"baud\": %u,\n", options.baudRate);
+	}
+	else {
+		fprintf(out, "  \"rate_per_port\": %.0f,\n", options.rate);
+	}
+	fprintf(out, "  \"runs\": [\n");
+	for (size_t i = 0; i < results.size(); i++) {
+		printResult(out, results[i], i + 1 == results.size());
+	}
+	fprintf(out, "  ]\n}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+/*------------------------------------------------------------------------------------------------------------------
+-- HEADER FILE:		Payloads.h -	Synthetic line traffic shared by the benchmarks.
+--
+-- PROGRAM:			Benchmarks
+--
+-- FUNCTIONS:
+--					bool parsePayloadKind(const char * name, PayloadKind * kind)
+--					const char * payloadName(PayloadKind kind)
+--					std::string makePayload(PayloadKind kind, size_t length, uint32_t seed)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Three shapes of traffic: ASCII log lines as a device console prints them, uniformly random bytes as a binary
+-- protocol or a wrong baud rate produces, and a full-screen text UI redrawing itself with cursor moves, colours and
+-- line drawing. Every payload is generated from a seed so runs can be compared byte for byte.
+----------------------------------------------------------------------------------------------------------------------*/
+
+enum class PayloadKind { Ascii, Binary, Tui };
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	nextPayloadRandom
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	uint32_t nextPayloadRandom(uint32_t * state)
+--					uint32_t * state:	xorshift state, never 0
+--
+-- RETURNS:		uint32_t - the next value
+----------------------------------------------------------------------------------------------------------------------*/
+inline uint32_t nextPayloadRandom(uint32_t * state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+	return *state;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parsePayloadKind
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parsePayloadKind(const char * name, PayloadKind * kind)
+--					const char * name:		"ascii", "binary" or "tui"
+--					PayloadKind * kind:		set to the matching kind
+--
+-- RETURNS:		bool - false if the name is not known
+----------------------------------------------------------------------------------------------------------------------*/
+inline bool parsePayloadKind(const char * name, PayloadKind * kind) {
+	if (strcmp(name, "ascii") == 0) {
+		*kind = PayloadKind::Ascii;
+	}
+	else if (strcmp(name, "binary") == 0) {
+		*kind = PayloadKind::Binary;
+	}
+	else if (strcmp(name, "tui") == 0) {
+		*kind = PayloadKind::Tui;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	payloadName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const char * payloadName(PayloadKind kind)
+--					PayloadKind kind:	a payload kind
+--
+-- RETURNS:		const char * - the name parsePayloadKind accepts
+----------------------------------------------------------------------------------------------------------------------*/
+inline const char * payloadName(PayloadKind kind) {
+	switch (kind) {
+	case PayloadKind::Binary:
+		return "binary";
+	case PayloadKind::Tui:
+		return "tui";
+	default:
+		return "ascii";
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	makePayload
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	std::string makePayload(PayloadKind kind, size_t length, uint32_t seed)
+--					PayloadKind kind:	shape of the traffic
+--					size_t length:		bytes to generate
+--					uint32_t seed:		generator seed
+--
+-- RETURNS:		std::string - exactly length bytes
+----------------------------------------------------------------------------------------------------------------------*/
+inline std::string makePayload(PayloadKind kind, size_t length, uint32_t seed) {
+	static const char * const levels[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+	static const char * const words[] = { "link", "up", "rx", "tx", "frame", "timeout", "retry", "sensor",
+		"value", "ok", "queue", "flush", "config", "reset", "boot", "temp" };
+	std::string payload;
+	char piece[128];
+	uint32_t state = seed != 0 ? seed : 1;
+	unsigned long line = 0;
+
+	payload.reserve(length + sizeof(piece));
+	while (payload.size() < length) {
+		uint32_t r = nextPayloadRandom(&state);
+
+		switch (kind) {
+		case PayloadKind::Ascii:
+			snprintf(piece, sizeof(piece), "[%8lu.%03u] %s ", line / 10, (unsigned)(r % 1000),
+				levels[(r >> 10) % 4]);
+			payload += piece;
+			for (uint32_t w = 0, count = 3 + (r >> 12) % 12; w < count; w++) {
+				payload += words[nextPayloadRandom(&state) % 16];
+				payload += ' ';
+			}
+			payload += "\r\n";
+			line++;
+			break;
+		case PayloadKind::Binary:
+			payload.append((const char *)&r, sizeof(r));
+			break;
+		case PayloadKind::Tui:
+			// Move, set a colour, draw a short run of text or box characters, reset
+			snprintf(piece, sizeof(piece), "\x1b[%u;%uH\x1b[%u;%um", 1 + r % 24, 1 + (r >> 5) % 80,
+				30 + (r >> 12) % 8, 40 + (r >> 15) % 8);
+			payload += piece;
+			if ((r >> 18) % 4 == 0) {
+				payload += "\x1b(0lqqqqqqqqqqk\x1b(B";
+			}
+			else {
+				payload += words[(r >> 20) % 16];
+				payload += "  ";
+				payload += words[(r >> 24) % 16];
+			}
+			payload += "\x1b[0m";
+			if ((r >> 28) == 0) {
+				payload += "\x1b[2J";
+			}
+			break;
+		}
+	}
+	payload.resize(length);
+	return payload;
+}
@@ -0,0 +1,471 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../CaptureWriter.h"
+#include "../FramePacer.h"
+#include "../HeadlessRenderer.h"
+#include "../ScreenModel.h"
+#include "../Scrollback.h"
+#include "../SerialPipeline.h"
+#include "../TerminalEmulator.h"
+#include "BenchSupport.h"
+#include "Payloads.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PipelineBench.cpp -	End-to-end throughput and latency of the receive and transmit paths.
+--
+-- PROGRAM:			PipelineBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - The consumer paints each drain into a HeadlessRenderer and reports its final hash
+--					Oct 17, 2026 - Received text goes through a TerminalEmulator as it does in the window
+--					Oct 17, 2026 - The consumer presents through a FramePacer and reports skipped frames and render lag
+--					Oct 17, 2026 - --capture records the run through a CaptureWriter to measure its cost
+--					Oct 17, 2026 - --flow and --consumer-rate exercise flow control and report its pauses
+--					Oct 17, 2026 - Reports the pipeline's LinkTelemetry as the telemetry object
+--					Oct 17, 2026 - Loopbacks, option parsing, CPU time and latency reports come from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: PipelineBench [--transport pty|sim] [--baud N] [--rate BYTES_PER_SEC] [--chunk BYTES] [--seconds N]
+--                      [--payload ascii|binary|tui] [--keys PER_SEC] [--seed N] [--pacing adaptive|smooth]
+--                      [--capture FILE] [--flow none|rtscts|xonxoff] [--consumer-rate BYTES_PER_SEC]
+--                      [--flow-high BYTES] [--flow-low BYTES] [--out FILE]
+--
+-- The application side is a SerialPipeline on one end of a loopback, exactly as SerialCommController runs it;
+-- the far end is driven directly. A generator writes the payload into the far end at the given rate (0 for as
+-- fast as the line takes it) while the consumer thread plays the window thread: it waits for the notify, drains
+-- the ring through a TerminalEmulator into a ScreenModel with scrollback, and paints the dirty cells into a
+-- HeadlessRenderer as WM_PAINT would, with a FramePacer deciding which chunks are presented as DisplayService does.
+-- --pacing smooth keeps the pacer out of jump mode, for comparison. At the same time a typist sends single
+-- keystrokes through the pipeline's transmit queue and the far end reads them back. screen_hash is the renderer's
+-- hash of the final screen, for comparing runs without drops.
+--
+-- wire_to_screen is measured per generator write, from just before the write until the consumer has presented its
+-- last byte. frames_skipped, jump_entries and render_lag_ms are the pacer's counters. keystroke_to_wire runs from
+-- the pipeline send until the far end reads the byte. The JSON report also carries sustained MB/s, bytes lost to
+-- ring or FIFO overflow, and process CPU per MB received.
+-- The pty transport is the default on Linux; the simulated port (921600 baud unless --baud says otherwise) runs
+-- anywhere and adds real line timing.
+--
+-- --consumer-rate holds the consumer to that many bytes a second, so the ring fills when the line is faster. With
+-- --flow set on both ends the pipeline then pauses the far end at --flow-high bytes in the ring and releases it at
+-- --flow-low, and the flow object reports how often and for how long each direction was held; without it the
+-- excess shows up as ring_overflow_bytes. A pty has no modem lines, so only xonxoff works there: the far end
+-- watches for the STOP and START characters the tty sends and holds the generator itself, as a device would.
+--
+-- The telemetry object is the pipeline's LinkTelemetry, in the form Save Telemetry writes it, with the consumer
+-- counting a paint for each drain it finishes as SerialCommController does.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct BenchOptions {
+	std::string transport;
+	uint32_t baudRate = 921600;
+	double rate = 0;
+	size_t chunk = 4096;
+	double seconds = 5;
+	PayloadKind payload = PayloadKind::Ascii;
+	double keysPerSecond = 50;
+	uint32_t seed = 1;
+	bool isAdaptivePacing = true;
+	const char * capturePath = NULL;
+	const char * outPath = NULL;
+	std::string flow = "none";
+	double consumerRate = 0;
+	FlowLimits flowLimits;
+};
+
+struct WireMark {
+	uint64_t endOffset;			// bytes written once this write completes
+	Clock::time_point sent;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					BenchOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument was not understood
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+	bool isParsed;
+
+	options->transport = defaultTransport();
+	isParsed = parseArguments(argc, argv, {}, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--transport") == 0) {
+			options->transport = value;
+		}
+		else if (strcmp(name, "--baud") == 0) {
+			options->baudRate = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--rate") == 0) {
+			options->rate = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--chunk") == 0) {
+			options->chunk = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(name, "--seconds") == 0) {
+			options->seconds = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--payload") == 0) {
+			return parsePayloadKind(value, &options->payload);
+		}
+		else if (strcmp(name, "--keys") == 0) {
+			options->keysPerSecond = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--seed") == 0) {
+			options->seed = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--pacing") == 0) {
+			options->isAdaptivePacing = strcmp(value, "adaptive") == 0;
+			return options->isAdaptivePacing || strcmp(value, "smooth") == 0;
+		}
+		else if (strcmp(name, "--capture") == 0) {
+			options->capturePath = value;
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else if (strcmp(name, "--flow") == 0) {
+			options->flow = value;
+			return options->flow == "none" || options->flow == "rtscts" || options->flow == "xonxoff";
+		}
+		else if (strcmp(name, "--consumer-rate") == 0) {
+			options->consumerRate = strtod(value, NULL);
+		}
+		else if (strcmp(name, "--flow-high") == 0) {
+			options->flowLimits.receiveHigh = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(name, "--flow-low") == 0) {
+			options->flowLimits.receiveLow = (size_t)strtoull(value, NULL, 10);
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	return isParsed && options->chunk > 0 && options->seconds > 0 &&
+		options->flowLimits.receiveLow < options->flowLimits.receiveHigh &&
+		options->flowLimits.receiveHigh <= RX_RING_SIZE;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Opens the loopback through BenchSupport.h
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the loopback could not be opened
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	BenchOptions options;
+	LoopbackOptions loopbackOptions;
+	Loopback loopback;
+	CaptureWriter capture;
+	SerialPipeline pipeline;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: PipelineBench [--transport pty|sim] [--baud N] [--rate BYTES_PER_SEC] "
+			"[--chunk BYTES] [--seconds N] [--payload ascii|binary|tui] [--keys PER_SEC] [--seed N] "
+			"[--pacing adaptive|smooth] [--capture FILE] [--flow none|rtscts|xonxoff] "
+			"[--consumer-rate BYTES_PER_SEC] [--flow-high BYTES] [--flow-low BYTES] [--out FILE]\n");
+		return 1;
+	}
+	loopbackOptions.transport = options.transport;
+	loopbackOptions.settings.baudRate = options.baudRate;
+	loopbackOptions.settings.rtsCts = options.flow == "rtscts";
+	loopbackOptions.settings.xonXoff = options.flow == "xonxoff";
+	if (!openLoopback(loopbackOptions, &loopback)) {
+		fprintf(stderr, "could not open a %s loopback\n", options.transport.c_str());
+		return 2;
+	}
+
+	// A payload a few megabytes long is replayed round and round so generation is not part of the measurement
+	const std::string payload = makePayload(options.payload, 4 << 20, options.seed);
+	std::mutex wakeLock;
+	std::condition_variable wake;
+	bool isNotified = false;
+	std::mutex markLock;
+	std::deque<WireMark> wireMarks;
+	std::deque<Clock::time_point> keyMarks;
+	std::vector<double> wireToScreen, keyToWire;
+	std::atomic<bool> isGenerating{ true };
+	std::atomic<bool> isFarEndHeld{ false };
+	std::atomic<bool> isGeneratorDone{ false };
+	bool isGeneratorJoined = false;
+	std::atomic<uint64_t> bytesSent{ 0 };
+	uint64_t bytesShown = 0, keysSent = 0, keysSeen = 0;
+
+	ScreenModel screen(80, 24);
+	Scrollback history(100000, 32 << 20);
+	HeadlessRenderer renderer(80, 24);
+	TerminalEmulator terminal(screen);
+	FramePacer pacer;
+	screen.setScrollback(&history);
+	pacer.setAdaptive(options.isAdaptivePacing);
+
+	if (options.capturePath != NULL) {
+		if (!capture.open(options.capturePath, options.transport)) {
+			fprintf(stderr, "could not create %s\n", options.capturePath);
+			return 2;
+		}
+		pipeline.setCapture(&capture);
+	}
+	pipeline.setFlowLimits(options.flowLimits);
+	pipeline.start(loopback.local.get(), [&]() {
+		std::lock_guard<std::mutex> guard(wakeLock);
+		isNotified = true;
+		wake.notify_one();
+	});
+
+	double cpuStart = processUsage().cpuSeconds;
+	Clock::time_point start = Clock::now();
+	Clock::time_point stopAt = start + std::chrono::microseconds((long long)(options.seconds * 1e6));
+
+	std::thread generator([&]() {
+		size_t offset = 0;
+		uint64_t sent = 0;
+
+		while (isGenerating.load(std::memory_order_relaxed)) {
+			size_t length = std::min(options.chunk, payload.size() - offset);
+			if (options.rate > 0) {
+				std::this_thread::sleep_until(start +
+					std::chrono::microseconds((long long)(sent * 1e6 / options.rate)));
+			}
+			while (isFarEndHeld.load() && isGenerating.load(std::memory_order_relaxed)) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			{
+				std::lock_guard<std::mutex> guard(markLock);
+				wireMarks.push_back({ sent + length, Clock::now() });
+			}
+			if (!loopback.remote->write(payload.data() + offset, length)) {
+				break;
+			}
+			sent += length;
+			bytesSent.store(sent, std::memory_order_release);
+			offset = (offset + length) % payload.size();
+		}
+		isGeneratorDone.store(true);
+	});
+
+	std::thread typist([&]() {
+		Clock::time_point next = start;
+		char key = 'a';
+
+		while (options.keysPerSecond > 0 && isGenerating.load(std::memory_order_relaxed)) {
+			next += std::chrono::microseconds((long long)(1e6 / options.keysPerSecond));
+			std::this_thread::sleep_until(next);
+			{
+				std::lock_guard<std::mutex> guard(markLock);
+				keyMarks.push_back(Clock::now());
+			}
+			pipeline.send(&key, 1);
+			keysSent++;
+		}
+	});
+
+	std::thread farEnd([&]() {
+		char buffer[256];
+		size_t received;
+
+		while (loopback.remote->read(buffer, sizeof(buffer), RX_WAIT_TIMEOUT, &received)) {
+			Clock::time_point now = Clock::now();
+			std::lock_guard<std::mutex> guard(markLock);
+			for (size_t i = 0; i < received; i++) {
+				// The tty's STOP and START go out on the same line as the keys
+				if (options.flow == "xonxoff" && (buffer[i] == FLOW_XOFF || buffer[i] == FLOW_XON)) {
+					isFarEndHeld.store(buffer[i] == FLOW_XOFF);
+					continue;
+				}
+				if (keyMarks.empty()) {
+					continue;
+				}
+				keyToWire.push_back(std::chrono::duration<double, std::micro>(now - keyMarks.front()).count());
+				keyMarks.pop_front();
+				keysSeen++;
+			}
+		}
+	});
+
+	// The consumer plays the window thread until the run ends and the line has gone quiet
+	Clock::time_point lastData = start;
+	int64_t paintPendingSince = 0;
+	auto present = [&]() {
+		renderView(renderer, screen, history, 0);
+		Clock::time_point now = Clock::now();
+		pacer.presented(now);
+
+		std::lock_guard<std::mutex> guard(markLock);
+		while (!wireMarks.empty() && wireMarks.front().endOffset <= bytesShown) {
+			wireToScreen.push_back(std::chrono::duration<double, std::micro>(now - wireMarks.front().sent).count());
+			wireMarks.pop_front();
+		}
+	};
+	for (;;) {
+		if (options.consumerRate > 0) {
+			std::this_thread::sleep_until(start + std::chrono::microseconds((long long)(bytesShown * 1e6 /
+				options.consumerRate)));
+		}
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			wake.wait_for(guard, std::chrono::milliseconds(10), [&]() { return isNotified; });
+			isNotified = false;
+		}
+		uint64_t before = bytesShown;
+		int64_t arrival = pipeline.getTelemetry().takeArrival();
+		if (paintPendingSince == 0) {
+			paintPendingSince = arrival;
+		}
+		pacer.beginFrame(pipeline.getReceiveRing().size(), Clock::now());
+		bool isDrained = pipeline.drainUntil([&](const char * data, size_t length) {
+			terminal.receive(data, length);
+			bytesShown += length;
+			if (pacer.chunkApplied()) {
+				present();
+			}
+			Clock::time_point now = Clock::now();
+			if (options.consumerRate > 0 &&
+				bytesShown >= std::chrono::duration<double>(now - start).count() * options.consumerRate) {
+				return false;
+			}
+			return !pacer.isBudgetSpent(now);
+		});
+		if (pacer.endFrame(!isDrained)) {
+			present();
+		}
+		if (isDrained) {
+			pipeline.getTelemetry().countPaint(paintPendingSince);
+			paintPendingSince = 0;
+		}
+
+		Clock::time_point now = Clock::now();
+		if (bytesShown != before) {
+			lastData = now;
+		}
+		if (now >= stopAt) {
+			isGenerating.store(false);
+		}
+		if (!isGeneratorJoined && isGeneratorDone.load()) {
+			// The generator's last write may wait on flow control, so keep draining until it is done, then wait
+			// for the line to drain
+			generator.join();
+			isGeneratorJoined = true;
+			lastData = now;
+		}
+		if (isGeneratorJoined && (bytesShown >= bytesSent.load() ||
+			now - lastData > std::chrono::milliseconds(500))) {
+			break;
+		}
+	}
+	Clock::time_point end = Clock::now();
+	double cpuSeconds = processUsage().cpuSeconds - cpuStart;
+
+	typist.join();
+	pipeline.stop();
+	loopback.remote->cancel();
+	farEnd.join();
+	capture.close();
+
+	double elapsed = std::chrono::duration<double>(end - start).count();
+	double megabytes = bytesShown / 1e6;
+	uint64_t ringOverflow = pipeline.getReceiveRing().getOverflowBytes();
+	uint64_t fifoOverruns = loopback.simulated ? loopback.simulated->getStats().fifoOverruns : 0;
+	uint64_t sent = bytesSent.load();
+	const PacerStats & pacing = pacer.getStats();
+	FlowStats flow = pipeline.getFlowStats();
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		return 1;
+	}
+	fprintf(out, "{\n");
+	fprintf(out, "  \"transport\": \"%s\",\n", options.transport.c_str());
+	fprintf(out, "  \"payload\": \"%s\",\n", payloadName(options.payload));
+	if (loopback.simulated) {
+		fprintf(out, "  \"baud\": %u,\n", options.baudRate);
+	}
+	fprintf(out, "  \"rate_limit\": %.0f,\n", options.rate);
+	fprintf(out, "  \"chunk\": %zu,\n", options.chunk);
+	fprintf(out, "  \"seconds\": %.3f,\n", elapsed);
+	fprintf(out, "  \"bytes_sent\": %llu,\n", (unsigned long long)sent);
+	fprintf(out, "  \"bytes_received\": %llu,\n", (unsigned long long)bytesShown);
+	fprintf(out, "  \"bytes_dropped\": %llu,\n", (unsigned long long)(sent > bytesShown ? sent - bytesShown : 0));
+	fprintf(out, "  \"ring_overflow_bytes\": %llu,\n", (unsigned long long)ringOverflow);
+	fprintf(out, "  \"fifo_overrun_bytes\": %llu,\n", (unsigned long long)fifoOverruns);
+	fprintf(out, "  \"throughput_mb_s\": %.3f,\n", megabytes / elapsed);
+	fprintf(out, "  \"cpu_seconds\": %.3f,\n", cpuSeconds);
+	fprintf(out, "  \"cpu_ms_per_mb\": %.3f,\n", megabytes > 0 ? cpuSeconds * 1000 / megabytes : 0.0);
+	fprintf(out, "  \"keys_sent\": %llu,\n", (unsigned long long)keysSent);
+	fprintf(out, "  \"keys_seen\": %llu,\n", (unsigned long long)keysSeen);
+	fprintf(out, "  \"pacing\": \"%s\",\n", options.isAdaptivePacing ? "adaptive" : "smooth");
+	fprintf(out, "  \"frames\": %llu,\n", (unsigned long long)renderer.getFrameCount());
+	fprintf(out, "  \"frames_skipped\": %llu,\n", (unsigned long long)pacing.framesSkipped);
+	fprintf(out, "  \"jump_entries\": %llu,\n", (unsigned long long)pacing.jumpEntries);
+	fprintf(out, "  \"budget_yields\": %llu,\n", (unsigned long long)pacing.budgetYields);
+	fprintf(out, "  \"max_backlog_bytes\": %zu,\n", pacing.maxBacklog);
+	fprintf(out, "  \"render_lag_ms\": { \"mean\": %.3f, \"max\": %.3f },\n",
+		pacing.framesPresented > 0 ? pacing.totalLagMs / pacing.framesPresented : 0.0, pacing.maxLagMs);
+	fprintf(out, "  \"flow\": { \"mode\": \"%s\", \"consumer_rate\": %.0f, \"receive_pauses\": %llu, "
+		"\"receive_paused_ms\": %.3f, \"transmit_pauses\": %llu, \"transmit_paused_ms\": %.3f },\n",
+		options.flow.c_str(), options.consumerRate, (unsigned long long)flow.receivePauses,
+		flow.receivePausedSeconds * 1000, (unsigned long long)flow.transmitPauses, flow.transmitPausedSeconds * 1000);
+	fprintf(out, "  \"screen_hash\": \"%016llx\",\n", (unsigned long long)renderer.hash());
+	if (options.capturePath != NULL) {
+		CaptureStats captured = capture.getStats();
+		fprintf(out, "  \"capture\": { \"records\": %llu, \"bytes\": %llu, \"file_bytes\": %llu, "
+			"\"dropped_records\": %llu, \"write_errors\": %llu },\n",
+			(unsigned long long)captured.records, (unsigned long long)captured.bytesCaptured,
+			(unsigned long long)captured.bytesWritten, (unsigned long long)captured.droppedRecords,
+			(unsigned long long)captured.writeErrors);
+	}
+	fprintf(out, "  \"telemetry\": ");
+	LinkTelemetry::writeJson(out, NULL, pipeline.sampleTelemetry());
+	fprintf(out, ",\n");
+	printLatency(out, "wire_to_screen_us", wireToScreen, false);
+	printLatency(out, "keystroke_to_wire_us", keyToWire, true);
+	fprintf(out, "}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../PortMultiplexer.h"
+#include "../SerialPipeline.h"
+#include "BenchSupport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ReconnectBench.cpp -	How long a session takes to disconnect, reconnect and pass data again.
+--
+-- PROGRAM:			ReconnectBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					bool waitForEcho(SerialTransport * remote, Clock::time_point deadline)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Loopbacks, option parsing and latency reports come from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: ReconnectBench [--transport sim|pty|serial] [--local PORT] [--remote PORT] [--cycles N]
+--                       [--mode threads|shared] [--out FILE]
+--
+-- A SerialPipeline runs on one end of a loopback and is disconnected and reconnected --cycles times (200 by
+-- default), the way closePort and initializeConnection do it: stop the pipeline and close the transport, then open
+-- and configure the transport and start the pipeline on it again. The far end stays open throughout, as a device
+-- would. After each reconnect the far end sends a byte, which has to come out of the ring, and the pipeline sends
+-- one back, which the far end has to read, so a cycle only counts once both directions work again.
+--
+-- The line is idle when each disconnect starts, so the reader is blocked in a read that stop has to cancel.
+-- disconnect_us is stop plus close, connect_us open, configure and start, first_byte_us from the end of start
+-- until both bytes have crossed, and reconnect_us the whole cycle. thread_starts counts the threads the pipeline
+-- created over every cycle; with its workers kept between connections it stays at two, one with --mode shared.
+--
+-- --transport serial opens two ports by name with createSerialTransport, for instance the two ends of a null modem
+-- cable or a com0com pair, which is the only way to time the Win32 cancel path. The pty transport (the default on
+-- Linux) reopens the slave side by name while the master stays adopted.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr uint32_t ECHO_TIMEOUT = 2000;		// ms a cycle may take to pass its two bytes before it counts as failed
+
+struct BenchOptions {
+	std::string transport;
+	std::string localName;
+	std::string remoteName;
+	size_t cycles = 200;
+	bool isShared = false;
+	const char * outPath = NULL;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					BenchOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument was not understood
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+	bool isParsed;
+
+	options->transport = defaultTransport();
+	isParsed = parseArguments(argc, argv, {}, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--transport") == 0) {
+			options->transport = value;
+		}
+		else if (strcmp(name, "--local") == 0) {
+			options->localName = value;
+		}
+		else if (strcmp(name, "--remote") == 0) {
+			options->remoteName = value;
+		}
+		else if (strcmp(name, "--cycles") == 0) {
+			options->cycles = (size_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--mode") == 0) {
+			options->isShared = strcmp(value, "shared") == 0;
+			return options->isShared || strcmp(value, "threads") == 0;
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	if (options->transport == "serial" && (options->localName.empty() || options->remoteName.empty())) {
+		return false;
+	}
+	return isParsed && options->cycles > 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	waitForEcho
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool waitForEcho(SerialTransport * remote, Clock::time_point deadline)
+--					SerialTransport * remote:		the far end
+--					Clock::time_point deadline:		when to give up
+--
+-- RETURNS:		bool - true once the far end has read a byte
+----------------------------------------------------------------------------------------------------------------------*/
+static bool waitForEcho(SerialTransport * remote, Clock::time_point deadline) {
+	char echo;
+	size_t bytesRead;
+
+	while (Clock::now() < deadline) {
+		if (!remote->read(&echo, 1, 10, &bytesRead)) {
+			return false;
+		}
+		if (bytesRead > 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Opens only the far end of the loopback through openFarEnd
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the loopback could not be set up
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	BenchOptions options;
+	LoopbackOptions loopbackOptions;
+	Loopback loopback;
+	std::unique_ptr<PortMultiplexer> multiplexer;
+	SerialPipeline pipeline;
+	std::mutex wakeLock;
+	std::condition_variable wake;
+	bool isNotified = false;
+	std::vector<double> disconnect, connect, firstByte, reconnect;
+	size_t failures = 0;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: ReconnectBench [--transport sim|pty|serial] [--local PORT] [--remote PORT] "
+			"[--cycles N] [--mode threads|shared] [--out FILE]\n");
+		return 1;
+	}
+	// Only the far end is opened here; the first cycle opens the near end like every other
+	loopbackOptions.transport = options.transport;
+	loopbackOptions.localName = options.localName;
+	loopbackOptions.remoteName = options.remoteName;
+	if (options.transport == "sim") {
+		loopbackOptions.settings.baudRate = 921600;
+	}
+	if (!openFarEnd(loopbackOptions, &loopback)) {
+		fprintf(stderr, "could not open a %s loopback\n", options.transport.c_str());
+		return 2;
+	}
+	if (options.isShared) {
+		multiplexer = createPortMultiplexer();
+		if (!multiplexer->start()) {
+			fprintf(stderr, "could not start the multiplexer\n");
+			return 2;
+		}
+	}
+	auto notify = [&]() {
+		std::lock_guard<std::mutex> guard(wakeLock);
+		isNotified = true;
+		wake.notify_one();
+	};
+
+	for (size_t cycle = 0; cycle <= options.cycles; cycle++) {
+		// Cycle 0 only makes the first connection
+		Clock::time_point begin = Clock::now();
+		pipeline.stop();
+		loopback.local->close();
+		Clock::time_point closed = Clock::now();
+
+		if (loopback.local->open(loopback.localName) != 0 || loopback.local->configure(loopbackOptions.settings) != 0 ||
+			!pipeline.start(loopback.local.get(), notify, multiplexer.get())) {
+			fprintf(stderr, "could not reconnect %s on cycle %zu\n", loopback.localName.c_str(), cycle);
+			return 2;
+		}
+		Clock::time_point started = Clock::now();
+		Clock::time_point deadline = started + std::chrono::milliseconds(ECHO_TIMEOUT);
+		bool isEchoed = false;
+
+		loopback.remote->write("x", 1);
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			isEchoed = wake.wait_until(guard, deadline, [&]() { return isNotified; });
+			isNotified = false;
+		}
+		pipeline.drain([](const char *, size_t) {});
+		isEchoed = isEchoed && pipeline.send("y", 1) == 1 && waitForEcho(loopback.remote.get(), deadline);
+		Clock::time_point done = Clock::now();
+
+		if (cycle == 0) {
+			continue;
+		}
+		if (!isEchoed) {
+			failures++;
+			continue;
+		}
+		disconnect.push_back(std::chrono::duration<double, std::micro>(closed - begin).count());
+		connect.push_back(std::chrono::duration<double, std::micro>(started - closed).count());
+		firstByte.push_back(std::chrono::duration<double, std::micro>(done - started).count());
+		reconnect.push_back(std::chrono::duration<double, std::micro>(done - begin).count());
+	}
+	pipeline.stop();
+	loopback.local->close();
+	if (multiplexer) {
+		multiplexer->stop();
+	}
+
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		return 1;
+	}
+	fprintf(out, "{\n");
+	fprintf(out, "  \"transport\": \"%s\",\n", options.transport.c_str());
+	fprintf(out, "  \"mode\": \"%s\",\n", options.isShared ? "shared" : "threads");
+	fprintf(out, "  \"cycles\": %zu,\n", options.cycles);
+	fprintf(out, "  \"failed_cycles\": %zu,\n", failures);
+	fprintf(out, "  \"thread_starts\": %llu,\n", (unsigned long long)pipeline.getThreadStarts());
+	printLatency(out, "disconnect_us", disconnect, false);
+	printLatency(out, "connect_us", connect, false);
+	printLatency(out, "first_byte_us", firstByte, false);
+	printLatency(out, "reconnect_us", reconnect, true);
+	fprintf(out, "}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	return 0;
+}
@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include "../CaptureFile.h"
+#include "../FramePacer.h"
+#include "../HeadlessRenderer.h"
+#include "../ScreenModel.h"
+#include "../Scrollback.h"
+#include "../SerialTransport.h"
+#include "../TerminalEmulator.h"
+#include "BenchSupport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ReplayBench.cpp -	Replays a capture's received bytes through the display path.
+--
+-- PROGRAM:			ReplayBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], ReplayOptions * options)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Option parsing and CPU time come from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: ReplayBench [--speed original|fast|FACTOR] [--pacing adaptive|smooth] [--cols N] [--rows N]
+--                    [--expect HASH] [--out FILE] CAPTURE
+--
+-- The capture is mapped with CaptureFile and its received records are handed straight from the mapping to a
+-- TerminalEmulator, in pieces of at most RX_CHUNK_SIZE as the window thread drains them, with nothing copied on the
+-- way. A FramePacer decides which chunks are presented into a HeadlessRenderer, as DisplayService does. At the
+-- original speed each record is applied no sooner than its timestamp, so the frames drawn match what a user saw;
+-- fast applies everything as soon as the previous frame allows, which measures how quickly rendering keeps up with
+-- a flood of real device traffic. A FACTOR replays that many times faster than captured.
+--
+-- The JSON report gives the bytes applied per second, frames, skipped frames and render lag, and CPU per MB. The
+-- final frame is always presented, so screen_hash depends only on the bytes, not on the timing or the pacing:
+-- rendering changes can be checked against a capture by comparing it across runs, or with --expect, which makes a
+-- mismatch exit with 3.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct ReplayOptions {
+	double speed = 1;					// 0 for as fast as possible
+	bool isAdaptivePacing = true;
+	int columns = 80;
+	int rows = 24;
+	const char * expectedHash = NULL;
+	const char * inPath = NULL;
+	const char * outPath = NULL;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], ReplayOptions * options)
+--					int argc:					argument count
+--					char * argv[]:				arguments
+--					ReplayOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument is not recognised or no capture is named
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], ReplayOptions * options) {
+	bool isParsed;
+
+	isParsed = parseArguments(argc, argv, {}, [&](const char * name, const char * value) {
+		if (name == NULL) {
+			if (options->inPath != NULL) {
+				return false;
+			}
+			options->inPath = value;
+		}
+		else if (strcmp(name, "--speed") == 0) {
+			options->speed = strcmp(value, "original") == 0 ? 1 : strcmp(value, "fast") == 0 ? 0 : atof(value);
+			return options->speed >= 0;
+		}
+		else if (strcmp(name, "--pacing") == 0) {
+			options->isAdaptivePacing = strcmp(value, "adaptive") == 0;
+			return options->isAdaptivePacing || strcmp(value, "smooth") == 0;
+		}
+		else if (strcmp(name, "--cols") == 0) {
+			options->columns = atoi(value);
+		}
+		else if (strcmp(name, "--rows") == 0) {
+			options->rows = atoi(value);
+		}
+		else if (strcmp(name, "--expect") == 0) {
+			options->expectedHash = value;
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	return isParsed && options->inPath != NULL && options->columns > 0 && options->rows > 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--					int argc:		argument count
+--					char * argv[]:	see the usage in the file header
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the capture cannot be read, 3 if the screen hash is
+--				not the one expected
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	ReplayOptions options;
+	CaptureFile capture;
+	CaptureRecord record;
+	const char * payload;
+	uint64_t totalBytes = 0, records = 0, lastTimestamp = 0;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: ReplayBench [--speed original|fast|FACTOR] [--pacing adaptive|smooth] [--cols N] "
+			"[--rows N] [--expect HASH] [--out FILE] CAPTURE\n");
+		return 1;
+	}
+	if (!capture.open(options.inPath)) {
+		fprintf(stderr, "could not map %s as a capture\n", options.inPath);
+		return 2;
+	}
+
+	// One pass ahead of time counts the received bytes, so the backlog the pacer sees is known at every step
+	for (size_t offset = capture.begin(); capture.next(&offset, &record, &payload);) {
+		if (record.direction == CaptureDirection::Receive) {
+			totalBytes += record.length;
+			records++;
+			lastTimestamp = record.timestamp;
+		}
+	}
+
+	ScreenModel screen(options.columns, options.rows);
+	Scrollback history(100000, 32 << 20);
+	HeadlessRenderer renderer(options.columns, options.rows);
+	TerminalEmulator terminal(screen);
+	FramePacer pacer;
+	screen.setScrollback(&history);
+	pacer.setAdaptive(options.isAdaptivePacing);
+
+	size_t offset = capture.begin();
+	size_t consumed = 0;					// bytes of the current record already applied
+	bool hasRecord = false;
+	uint64_t applied = 0, dueBytes = 0;		// dueBytes: bytes of records whose time has come, applied or not
+	size_t dueOffset = capture.begin();		// the first record not yet due
+	auto nextReceived = [&](size_t * at, CaptureRecord * found, const char ** bytes) {
+		while (capture.next(at, found, bytes)) {
+			if (found->direction == CaptureDirection::Receive && found->length > 0) {
+				return true;
+			}
+		}
+		return false;
+	};
+	auto dueTime = [&](Clock::time_point start, uint64_t timestamp) {
+		return start + std::chrono::duration_cast<Clock::duration>(
+			std::chrono::nanoseconds((long long)(timestamp / options.speed)));
+	};
+	auto present = [&]() {
+		renderView(renderer, screen, history, 0);
+		pacer.presented(Clock::now());
+	};
+
+	double cpuStart = processUsage().cpuSeconds;
+	Clock::time_point start = Clock::now();
+	CaptureRecord lookahead;
+	const char * lookaheadBytes;
+	bool hasLookahead = nextReceived(&dueOffset, &lookahead, &lookaheadBytes);
+
+	hasRecord = nextReceived(&offset, &record, &payload);
+	while (hasRecord) {
+		Clock::time_point now = Clock::now();
+
+		// Everything captured by now counts as arrived, whether or not it has been applied
+		while (hasLookahead && (options.speed <= 0 || dueTime(start, lookahead.timestamp) <= now)) {
+			dueBytes += lookahead.length;
+			hasLookahead = nextReceived(&dueOffset, &lookahead, &lookaheadBytes);
+		}
+		if (dueBytes == applied) {
+			std::this_thread::sleep_until(dueTime(start, lookahead.timestamp));
+			continue;
+		}
+
+		pacer.beginFrame((size_t)(dueBytes - applied), now);
+		bool isBudgetSpent = false;
+		while (hasRecord && applied < dueBytes && !isBudgetSpent) {
+			size_t length = record.length - consumed < RX_CHUNK_SIZE ? record.length - consumed : RX_CHUNK_SIZE;
+
+			terminal.receive(payload + consumed, length);
+			consumed += length;
+			applied += length;
+			if (consumed == record.length) {
+				consumed = 0;
+				hasRecord = nextReceived(&offset, &record, &payload);
+			}
+			if (pacer.chunkApplied()) {
+				present();
+			}
+			isBudgetSpent = pacer.isBudgetSpent(Clock::now());
+		}
+		if (pacer.endFrame(applied < dueBytes)) {
+			present();
+		}
+	}
+	present();
+
+	Clock::time_point end = Clock::now();
+	double cpuSeconds = processUsage().cpuSeconds - cpuStart;
+	double elapsed = std::chrono::duration<double>(end - start).count();
+	double megabytes = applied / 1e6;
+	const PacerStats & pacing = pacer.getStats();
+	char hash[20];
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+
+	snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)renderer.hash());
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		return 1;
+	}
+	fprintf(out, "{\n");
+	fprintf(out, "  \"capture\": \"%s\",\n", options.inPath);
+	fprintf(out, "  \"port\": \"%s\",\n", capture.getHeader().portName);
+	fprintf(out, "  \"speed\": %.3f,\n", options.speed);
+	fprintf(out, "  \"pacing\": \"%s\",\n", options.isAdaptivePacing ? "adaptive" : "smooth");
+	fprintf(out, "  \"records\": %llu,\n", (unsigned long long)records);
+	fprintf(out, "  \"bytes\": %llu,\n", (unsigned long long)applied);
+	fprintf(out, "  \"truncated\": %s,\n", capture.isTruncated(dueOffset) ? "true" : "false");
+	fprintf(out, "  \"captured_seconds\": %.3f,\n", lastTimestamp / 1e9);
+	fprintf(out, "  \"seconds\": %.3f,\n", elapsed);
+	fprintf(out, "  \"throughput_mb_s\": %.3f,\n", elapsed > 0 ? megabytes / elapsed : 0.0);
+	fprintf(out, "  \"cpu_ms_per_mb\": %.3f,\n", megabytes > 0 ? cpuSeconds * 1000 / megabytes : 0.0);
+	fprintf(out, "  \"frames\": %llu,\n", (unsigned long long)renderer.getFrameCount());
+	fprintf(out, "  \"frames_skipped\": %llu,\n", (unsigned long long)pacing.framesSkipped);
+	fprintf(out, "  \"jump_entries\": %llu,\n", (unsigned long long)pacing.jumpEntries);
+	fprintf(out, "  \"max_backlog_bytes\": %zu,\n", pacing.maxBacklog);
+	fprintf(out, "  \"render_lag_ms\": { \"mean\": %.3f, \"max\": %.3f },\n",
+		pacing.framesPresented > 0 ? pacing.totalLagMs / pacing.framesPresented : 0.0, pacing.maxLagMs);
+	fprintf(out, "  \"scrollback_lines\": %zu,\n", history.size());
+	fprintf(out, "  \"screen_hash\": \"%s\"\n", hash);
+	fprintf(out, "}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	if (options.expectedHash != NULL && strcmp(options.expectedHash, hash) != 0) {
+		fprintf(stderr, "screen hash %s, expected %s\n", hash, options.expectedHash);
+		return 3;
+	}
+	return 0;
+}
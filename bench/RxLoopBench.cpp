@@ -0,0 +1,299 @@
+#define STRICT
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../CommReader.h"
+#include "BenchSupport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		RxLoopBench.cpp -	Compares the old one byte receive loop against CommReader.
+--
+-- PROGRAM:			RxLoopBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					LoopResult runLegacyLoop(HANDLE port, DWORD seconds)
+--					LoopResult runEventLoop(HANDLE port, DWORD seconds)
+--					DWORD WINAPI feedPort(LPVOID param)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - CPU time comes from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: RxLoopBench <rxPort> [seconds] [txPort]
+--
+-- Each strategy runs for the given number of seconds on rxPort. Without txPort the line is idle and the CPU column
+-- shows what the loop costs while waiting. With txPort (the other end of a null modem or virtual port pair) a
+-- feeder thread writes continuously so the syscalls-per-KB column can be compared under load.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct LoopResult {
+	ULONGLONG syscalls;
+	ULONGLONG bytes;
+	double cpuSeconds;
+	double wallSeconds;
+};
+
+static volatile LONG isFeeding = 0;
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runLegacyLoop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Takes CPU time from processUsage
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	LoopResult runLegacyLoop(HANDLE port, DWORD seconds)
+--					HANDLE port:	overlapped port handle
+--					DWORD seconds:	how long to run
+--
+-- RETURNS:		LoopResult
+--
+-- NOTES:
+-- Reproduces the receive loop SerialCommController used before CommReader: a one byte ReadFile followed by a
+-- non-blocking GetOverlappedResult, retried immediately.
+----------------------------------------------------------------------------------------------------------------------*/
+static LoopResult runLegacyLoop(HANDLE port, DWORD seconds) {
+	LoopResult result = {};
+	COMSTAT cs;
+	DWORD bytesReceived, lastError;
+	char inputBuffer[1];
+	OVERLAPPED overlapRead = {};
+	DWORD endTime = GetTickCount() + seconds * 1000;
+	double cpuStart = processUsage().cpuSeconds;
+	DWORD wallStart = GetTickCount();
+
+	overlapRead.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	while (GetTickCount() < endTime) {
+		result.syscalls++;
+		if (!ReadFile(port, inputBuffer, 1, &bytesReceived, &overlapRead)) {
+			bytesReceived = 0;
+			result.syscalls++;
+			if ((lastError = GetLastError()) == ERROR_IO_PENDING &&
+				GetOverlappedResult(port, &overlapRead, &bytesReceived, FALSE) &&
+				bytesReceived) {
+				result.bytes += bytesReceived;
+			}
+			else {
+				result.syscalls++;
+				ClearCommError(port, &lastError, &cs);
+			}
+		}
+		else {
+			result.bytes += bytesReceived;
+		}
+		result.syscalls++;
+		ResetEvent(overlapRead.hEvent);
+	}
+	CancelIo(port);
+	CloseHandle(overlapRead.hEvent);
+
+	result.cpuSeconds = processUsage().cpuSeconds - cpuStart;
+	result.wallSeconds = (GetTickCount() - wallStart) / 1000.0;
+	return result;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runEventLoop
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Takes CPU time from processUsage
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	LoopResult runEventLoop(HANDLE port, DWORD seconds)
+--					HANDLE port:	overlapped port handle
+--					DWORD seconds:	how long to run
+--
+-- RETURNS:		LoopResult
+--
+-- NOTES:
+-- Runs the same loop SerialCommController::handleRead now uses.
+----------------------------------------------------------------------------------------------------------------------*/
+static LoopResult runEventLoop(HANDLE port, DWORD seconds) {
+	LoopResult result = {};
+	CommReader reader;
+	static char buffer[4096];
+	DWORD bytesReceived;
+	DWORD endTime = GetTickCount() + seconds * 1000;
+	double cpuStart = processUsage().cpuSeconds;
+	DWORD wallStart = GetTickCount();
+
+	if (!reader.attach(port)) {
+		fprintf(stderr, "CommReader could not attach to the port\n");
+		return result;
+	}
+	while (GetTickCount() < endTime) {
+		if (!reader.read(buffer, sizeof(buffer), RX_WAIT_TIMEOUT, &bytesReceived)) {
+			break;
+		}
+	}
+	const RxStats & stats = reader.getStats();
+	result.syscalls = stats.waitCalls + stats.readCalls + stats.errorCalls;
+	result.bytes = stats.bytesReceived;
+	reader.detach();
+
+	result.cpuSeconds = processUsage().cpuSeconds - cpuStart;
+	result.wallSeconds = (GetTickCount() - wallStart) / 1000.0;
+	return result;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	feedPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	DWORD WINAPI feedPort(LPVOID param)
+--					LPVOID param:	the transmitting port handle
+--
+-- RETURNS:		DWORD
+--
+-- NOTES:
+-- Writes a printable pattern to the transmitting port as fast as the line allows.
+----------------------------------------------------------------------------------------------------------------------*/
+static DWORD WINAPI feedPort(LPVOID param) {
+	HANDLE port = (HANDLE)param;
+	char pattern[1024];
+	OVERLAPPED overlapWrite = {};
+	DWORD written;
+
+	for (DWORD i = 0; i < sizeof(pattern); i++) {
+		pattern[i] = (char)(' ' + i % 95);
+	}
+	overlapWrite.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	while (isFeeding) {
+		if (!WriteFile(port, pattern, sizeof(pattern), &written, &overlapWrite) && GetLastError() == ERROR_IO_PENDING) {
+			GetOverlappedResult(port, &overlapWrite, &written, TRUE);
+		}
+	}
+	CloseHandle(overlapWrite.hEvent);
+	return 0;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	openPort
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	HANDLE openPort(const char * name)
+--					const char * name:	port name such as COM3
+--
+-- RETURNS:		HANDLE - INVALID_HANDLE_VALUE on failure
+----------------------------------------------------------------------------------------------------------------------*/
+static HANDLE openPort(const char * name) {
+	char path[64];
+
+	_snprintf(path, sizeof(path), "\\\\.\\%s", name);
+	return CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, NULL);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printResult
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	VOID printResult(const char * name, const LoopResult & result)
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+static VOID printResult(const char * name, const LoopResult & result) {
+	double kilobytes = result.bytes / 1024.0;
+
+	printf("%-8s %12llu %12llu %16.1f %10.1f\n",
+		name,
+		result.bytes,
+		result.syscalls,
+		kilobytes > 0 ? result.syscalls / kilobytes : 0.0,
+		result.wallSeconds > 0 ? 100.0 * result.cpuSeconds / result.wallSeconds : 0.0);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success
+--
+-- NOTES:
+-- Prints one row per strategy.
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	HANDLE rxPort, txPort = INVALID_HANDLE_VALUE, feeder = NULL;
+	DWORD seconds = 5;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s <rxPort> [seconds] [txPort]\n", argv[0]);
+		return 1;
+	}
+	if (argc > 2) {
+		seconds = (DWORD)atoi(argv[2]);
+	}
+	if ((rxPort = openPort(argv[1])) == INVALID_HANDLE_VALUE) {
+		fprintf(stderr, "could not open %s\n", argv[1]);
+		return 1;
+	}
+	if (argc > 3) {
+		if ((txPort = openPort(argv[3])) == INVALID_HANDLE_VALUE) {
+			fprintf(stderr, "could not open %s\n", argv[3]);
+			return 1;
+		}
+		isFeeding = 1;
+		feeder = CreateThread(NULL, 0, feedPort, txPort, 0, NULL);
+	}
+
+	printf("%-8s %12s %12s %16s %10s\n", "loop", "bytes", "syscalls", "syscalls/KB", "cpu %");
+	printResult("legacy", runLegacyLoop(rxPort, seconds));
+	PurgeComm(rxPort, PURGE_RXCLEAR);
+	printResult("event", runEventLoop(rxPort, seconds));
+
+	if (feeder) {
+		InterlockedExchange(&isFeeding, 0);
+		CancelIoEx(txPort, NULL);
+		WaitForSingleObject(feeder, INFINITE);
+		CloseHandle(feeder);
+		CloseHandle(txPort);
+	}
+	CloseHandle(rxPort);
+	return 0;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#endif
+#include "../Scrollback.h"
+#include "../ScreenModel.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		ScrollbackBench.cpp -	Memory footprint and speed of the scrollback store.
+--
+-- PROGRAM:			ScrollbackBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					BenchResult runCase(size_t lines, size_t maxLines, size_t maxBytes)
+--					size_t residentBytes(void)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: ScrollbackBench [lines]		(default 2000000)
+--
+-- Appends log-like lines of 20 to 120 cells from an 80 column screen and reports, for several budgets, the bytes
+-- the store holds, bytes per kept line, growth of the process resident set, and the cost of append and of random
+-- lookups by index. The first case keeps every line; the others show the ring recycling chunks at a fixed size.
+----------------------------------------------------------------------------------------------------------------------*/
+
+struct BenchResult {
+	size_t kept;
+	size_t footprint;
+	size_t residentGrowth;
+	double appendNs;
+	double lookupNs;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	residentBytes
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	size_t residentBytes(void)
+--
+-- RETURNS:		size_t - resident set size of this process, 0 if unknown
+----------------------------------------------------------------------------------------------------------------------*/
+static size_t residentBytes() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.WorkingSetSize;
+	}
+	return 0;
+#else
+	unsigned long pages = 0, resident = 0;
+	FILE * statm = fopen("/proc/self/statm", "r");
+	if (statm == NULL) {
+		return 0;
+	}
+	if (fscanf(statm, "%lu %lu", &pages, &resident) != 2) {
+		resident = 0;
+	}
+	fclose(statm);
+	return resident * 4096;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runCase
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	BenchResult runCase(size_t lines, size_t maxLines, size_t maxBytes)
+--					size_t lines:		lines to append
+--					size_t maxLines:	line budget of the store
+--					size_t maxBytes:	byte budget of the store
+--
+-- RETURNS:		BenchResult
+----------------------------------------------------------------------------------------------------------------------*/
+static BenchResult runCase(size_t lines, size_t maxLines, size_t maxBytes) {
+	const int columns = 80;
+	const size_t lookups = 1000000;
+	BenchResult result;
+	std::vector<char16_t> glyphs(columns);
+	std::vector<uint8_t> attributes(columns, ATTR_DEFAULT);
+	ScrollbackLineView view;
+	size_t residentBefore = residentBytes();
+	uint32_t seed = 12345;
+	size_t checksum = 0;
+
+	Scrollback * history = new Scrollback(maxLines, maxBytes);
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < lines; i++) {
+		seed = seed * 1103515245 + 12345;
+		size_t length = 20 + (seed >> 16) % 101;
+		if (length > (size_t)columns) {
+			length = columns;
+		}
+		for (int c = 0; c < columns; c++) {
+			glyphs[c] = c < (int)length ? (char16_t)('!' + (i + c) % 90) : u' ';
+		}
+		history->append(glyphs.data(), attributes.data(), columns);
+	}
+	auto appended = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < lookups; i++) {
+		seed = seed * 1103515245 + 12345;
+		if (history->getLine(seed % history->size(), &view)) {
+			checksum += view.length + view.glyphs[0];
+		}
+	}
+	auto looked = std::chrono::steady_clock::now();
+
+	result.kept = history->size();
+	result.footprint = history->footprint();
+	result.residentGrowth = residentBytes() - residentBefore;
+	result.appendNs = std::chrono::duration<double, std::nano>(appended - start).count() / lines;
+	result.lookupNs = std::chrono::duration<double, std::nano>(looked - appended).count() / lookups;
+	delete history;
+
+	if (checksum == 0) {
+		fprintf(stderr, "no lines read back\n");
+	}
+	return result;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	size_t lines = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 2000000;
+	struct {
+		const char * name;
+		size_t maxLines;
+		size_t maxBytes;
+	} cases[] = {
+		{ "unbounded", lines, lines * 80 * 3 },
+		{ "1M lines", 1000000, lines * 80 * 3 },
+		{ "64 MiB", lines, 64u << 20 },
+		{ "8 MiB", lines, 8u << 20 },
+	};
+
+	printf("%-10s %10s %10s %14s %12s %12s %12s %12s\n", "budget", "appended", "kept", "footprint", "bytes/line",
+		"rss growth", "append ns", "lookup ns");
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+		BenchResult result = runCase(lines, cases[i].maxLines, cases[i].maxBytes);
+		printf("%-10s %10zu %10zu %14zu %12.1f %12zu %12.1f %12.1f\n", cases[i].name, lines, result.kept,
+			result.footprint, (double)result.footprint / result.kept, result.residentGrowth, result.appendNs,
+			result.lookupNs);
+	}
+	return 0;
+}
@@ -0,0 +1,464 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../FileTransfer.h"
+#include "../TransportChannel.h"
+#include "BenchSupport.h"
+#include "Payloads.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		TransferBench.cpp -	File transfers end to end over a loopback, checked byte for byte.
+--
+-- PROGRAM:			TransferBench
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					bool makeDirectory(const std::string & path)
+--					bool runTransfer(const BenchOptions & options, TransferProtocol protocol, uint64_t cancelAt,
+--						TransferStats * sent, TransferStats * received)
+--					bool verifyReceived(const BenchOptions & options, TransferProtocol protocol,
+--						const std::string & payload)
+--					const char * statusName(TransferStatus status)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		Oct 17, 2026 - Creates the receive directory; --lose-first-block
+--					Oct 17, 2026 - Loopbacks and option parsing come from BenchSupport.h
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: TransferBench [--transport pty|sim] [--baud N] [--protocol xmodem|xmodem1k|ymodem|zmodem|all]
+--                      [--size BYTES] [--window BYTES] [--errors RATE] [--resume] [--lose-first-block] [--seed N]
+--                      [--dir DIR] [--out FILE]
+--
+-- A file of random bytes is written to DIR and sent from one end of a loopback to a receiver on the other, each
+-- on a thread of its own as the window's transfer thread would run them, and the file received is compared with
+-- the one sent. XMODEM's copy may be padded to a whole block with CPMEOF, and nothing more. --errors makes the
+-- simulated port flip a bit in that fraction of bytes, which the receiver's CRC catches, to show the cost of
+-- recovering. --resume runs ZMODEM twice: the first run is cancelled from the receiving end halfway through, and
+-- the second has to pick up from the partial file it left. --lose-first-block throws away the first XMODEM or
+-- YMODEM block the sender writes, as a line glitch at the start would, so the receiver has to ask for it again.
+--
+-- The JSON report gives, per run, file bytes per second, the efficiency against what the line can carry at the
+-- baud rate (simulated port only; a pty has no line rate), wire bytes sent per file byte, retries on either end
+-- and where a resumed run started. The pty transport is the default on Linux; the simulated port (115200 baud
+-- unless --baud says otherwise) runs anywhere and has real line timing.
+----------------------------------------------------------------------------------------------------------------------*/
+
+constexpr const char * SOURCE_NAME = "transfer-source.bin";
+constexpr const char * RECEIVED_DIRECTORY = "received";
+
+struct BenchOptions {
+	std::string transport;
+	uint32_t baudRate = 115200;
+	std::vector<TransferProtocol> protocols;
+	size_t size = 1 << 20;
+	size_t window = 0;
+	double errorRate = 0;
+	bool isResumeRun = false;
+	bool isFirstBlockLost = false;
+	uint32_t seed = 1;
+	std::string directory = ".";
+	const char * outPath = NULL;
+};
+
+// Loses the first XMODEM or YMODEM block sent through it
+class LossyChannel : public TransferChannel {
+private:
+	TransferChannel * channel;
+	bool isArmed;
+public:
+	LossyChannel(TransferChannel * next, bool isLosing) : channel(next), isArmed(isLosing) {};
+
+	bool send(const char * data, size_t length) override {
+		if (isArmed && length > 0 && (data[0] == 0x01 || data[0] == 0x02)) {
+			isArmed = false;
+			return true;
+		}
+		return channel->send(data, length);
+	}
+
+	bool receive(char * buffer, size_t capacity, uint32_t timeout, size_t * bytesReceived) override {
+		return channel->receive(buffer, capacity, timeout, bytesReceived);
+	}
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - --lose-first-block
+--				Oct 17, 2026 - Walks the arguments with parseArguments
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], BenchOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					BenchOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument is not recognised
+----------------------------------------------------------------------------------------------------------------------*/
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+	bool isParsed;
+
+	options->transport = defaultTransport();
+	isParsed = parseArguments(argc, argv, { "--resume", "--lose-first-block" },
+		[&](const char * name, const char * value) {
+		if (name == NULL) {
+			return false;
+		}
+		if (strcmp(name, "--resume") == 0) {
+			options->isResumeRun = true;
+		}
+		else if (strcmp(name, "--lose-first-block") == 0) {
+			options->isFirstBlockLost = true;
+		}
+		else if (strcmp(name, "--transport") == 0) {
+			options->transport = value;
+		}
+		else if (strcmp(name, "--baud") == 0) {
+			options->baudRate = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--protocol") == 0) {
+			bool isAll = strcmp(value, "all") == 0;
+
+			if (isAll || strcmp(value, "xmodem") == 0) {
+				options->protocols.push_back(TransferProtocol::Xmodem);
+			}
+			if (isAll || strcmp(value, "xmodem1k") == 0) {
+				options->protocols.push_back(TransferProtocol::Xmodem1k);
+			}
+			if (isAll || strcmp(value, "ymodem") == 0) {
+				options->protocols.push_back(TransferProtocol::Ymodem);
+			}
+			if (isAll || strcmp(value, "zmodem") == 0) {
+				options->protocols.push_back(TransferProtocol::Zmodem);
+			}
+		}
+		else if (strcmp(name, "--size") == 0) {
+			options->size = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(name, "--window") == 0) {
+			options->window = (size_t)strtoull(value, NULL, 10);
+		}
+		else if (strcmp(name, "--errors") == 0) {
+			options->errorRate = atof(value);
+		}
+		else if (strcmp(name, "--seed") == 0) {
+			options->seed = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(name, "--dir") == 0) {
+			options->directory = value;
+		}
+		else if (strcmp(name, "--out") == 0) {
+			options->outPath = value;
+		}
+		else {
+			return false;
+		}
+		return true;
+	});
+	if (options->protocols.empty()) {
+		options->protocols.push_back(TransferProtocol::Zmodem);
+	}
+	return isParsed && options->size > 0 && options->seed != 0 && options->errorRate >= 0 &&
+		options->errorRate < 1;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	makeDirectory
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool makeDirectory(const std::string & path)
+--					const std::string & path:	the directory to create
+--
+-- RETURNS:		bool - true if the directory exists now, whether or not it did before
+----------------------------------------------------------------------------------------------------------------------*/
+static bool makeDirectory(const std::string & path) {
+#ifdef _WIN32
+	return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+	return mkdir(path.c_str(), 0777) == 0 || errno == EEXIST;
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	runTransfer
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Sends through a LossyChannel
+--				Oct 17, 2026 - Opens the loopback through BenchSupport.h
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool runTransfer(const BenchOptions & options, TransferProtocol protocol, uint64_t cancelAt,
+--					TransferStats * sent, TransferStats * received)
+--					const BenchOptions & options:	the loopback, file and window
+--					TransferProtocol protocol:		the protocol both ends speak
+--					uint64_t cancelAt:				cancel the receiver once it has this many bytes, 0 for never
+--					TransferStats * sent:			set to the sender's statistics
+--					TransferStats * received:		set to the receiver's statistics
+--
+-- RETURNS:		bool - false if the loopback could not be opened
+--
+-- NOTES:
+-- Each run gets a fresh loopback so nothing left on the line by a cancelled run reaches the next one, and with
+-- --lose-first-block, a first block of its own to lose. Once the receiver has stopped, the receiving port is
+-- drained until the sender notices, as a port left open would be.
+----------------------------------------------------------------------------------------------------------------------*/
+static bool runTransfer(const BenchOptions & options, TransferProtocol protocol, uint64_t cancelAt,
+	TransferStats * sent, TransferStats * received) {
+	LoopbackOptions loopbackOptions;
+	Loopback loopback;
+	TransferOptions transferOptions;
+
+	loopbackOptions.transport = options.transport;
+	loopbackOptions.settings.baudRate = options.baudRate;
+	loopbackOptions.simulation.parityErrorRate = options.errorRate;
+	loopbackOptions.simulation.seed = options.seed;
+	if (!openLoopback(loopbackOptions, &loopback)) {
+		return false;
+	}
+	TransportChannel receiving(loopback.local.get());
+	TransportChannel remote(loopback.remote.get());
+	LossyChannel sending(&remote, options.isFirstBlockLost && protocol != TransferProtocol::Zmodem);
+	std::atomic<bool> isSenderDone{ false };
+	std::atomic<bool> isReceiverDone{ false };
+
+	transferOptions.window = options.window;
+	transferOptions.receiveName = SOURCE_NAME;
+	std::unique_ptr<FileTransfer> receiver = createFileTransfer(protocol, &receiving, transferOptions);
+	std::unique_ptr<FileTransfer> sender = createFileTransfer(protocol, &sending, transferOptions);
+
+	std::thread receiverThread([&]() {
+		receiver->receive(options.directory + "/" + RECEIVED_DIRECTORY);
+		isReceiverDone.store(true);
+	});
+	std::thread senderThread([&]() {
+		sender->send(options.directory + "/" + SOURCE_NAME);
+		isSenderDone.store(true);
+	});
+
+	while (!isReceiverDone.load()) {
+		if (cancelAt > 0 && receiver->getStats().offset >= cancelAt) {
+			receiver->cancel();
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	receiverThread.join();
+	while (!isSenderDone.load()) {
+		char buffer[RX_CHUNK_SIZE];
+		size_t length;
+
+		if (!loopback.local->read(buffer, sizeof(buffer), RX_WAIT_TIMEOUT, &length)) {
+			break;
+		}
+	}
+	senderThread.join();
+	*sent = sender->getStats();
+	*received = receiver->getStats();
+	return true;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	verifyReceived
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool verifyReceived(const BenchOptions & options, TransferProtocol protocol,
+--					const std::string & payload)
+--					const BenchOptions & options:	where the received file is
+--					TransferProtocol protocol:		the protocol used, since XMODEM pads
+--					const std::string & payload:	the bytes sent
+--
+-- RETURNS:		bool - true if the received file holds exactly the bytes sent
+----------------------------------------------------------------------------------------------------------------------*/
+static bool verifyReceived(const BenchOptions & options, TransferProtocol protocol, const std::string & payload) {
+	std::string path = options.directory + "/" + RECEIVED_DIRECTORY + "/" + SOURCE_NAME;
+	FILE * file = fopen(path.c_str(), "rb");
+	std::string contents;
+	char buffer[65536];
+	size_t length;
+	bool isPadded = protocol == TransferProtocol::Xmodem || protocol == TransferProtocol::Xmodem1k;
+
+	if (file == NULL) {
+		return false;
+	}
+	while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		contents.append(buffer, length);
+	}
+	fclose(file);
+	if (contents.size() < payload.size() || (!isPadded && contents.size() != payload.size()) ||
+		memcmp(contents.data(), payload.data(), payload.size()) != 0) {
+		return false;
+	}
+	return contents.find_first_not_of('\x1A', payload.size()) == std::string::npos;
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	statusName
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	const char * statusName(TransferStatus status)
+--					TransferStatus status:	how a transfer ended
+--
+-- RETURNS:		const char * - its name in the report
+----------------------------------------------------------------------------------------------------------------------*/
+static const char * statusName(TransferStatus status) {
+	switch (status) {
+	case TransferStatus::Running:
+		return "running";
+	case TransferStatus::Complete:
+		return "complete";
+	case TransferStatus::Skipped:
+		return "skipped";
+	case TransferStatus::Cancelled:
+		return "cancelled";
+	default:
+		return "failed";
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	Oct 17, 2026 - Creates the receive directory
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--					int argc:		argument count
+--					char * argv[]:	see the usage in the file header
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the files or the loopback cannot be set up, 3 if a
+--				transfer failed or its file did not arrive intact
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	BenchOptions options;
+	PortSettings line;
+	bool isAllVerified = true;
+	bool isFirst = true;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: TransferBench [--transport pty|sim] [--baud N] "
+			"[--protocol xmodem|xmodem1k|ymodem|zmodem|all] [--size BYTES] [--window BYTES] [--errors RATE] "
+			"[--resume] [--lose-first-block] [--seed N] [--dir DIR] [--out FILE]\n");
+		return 1;
+	}
+	line.baudRate = options.baudRate;
+
+	const std::string payload = makePayload(PayloadKind::Binary, options.size, options.seed);
+	std::string sourcePath = options.directory + "/" + SOURCE_NAME;
+	std::string receivedPath = options.directory + "/" + RECEIVED_DIRECTORY + "/" + SOURCE_NAME;
+
+	if (!makeDirectory(options.directory + "/" + RECEIVED_DIRECTORY)) {
+		fprintf(stderr, "could not create %s/%s\n", options.directory.c_str(), RECEIVED_DIRECTORY);
+		return 2;
+	}
+	FILE * source = fopen(sourcePath.c_str(), "wb");
+
+	if (source == NULL || fwrite(payload.data(), 1, payload.size(), source) != payload.size() || fclose(source) != 0) {
+		fprintf(stderr, "could not write %s\n", sourcePath.c_str());
+		return 2;
+	}
+	FILE * out = options.outPath != NULL ? fopen(options.outPath, "w") : stdout;
+
+	if (out == NULL) {
+		fprintf(stderr, "could not create %s\n", options.outPath);
+		return 2;
+	}
+	fprintf(out, "{\n  \"transport\": \"%s\",\n  \"baud\": %u,\n  \"file_bytes\": %zu,\n  \"window\": %zu,\n"
+		"  \"error_rate\": %g,\n  \"lose_first_block\": %s,\n  \"runs\": [\n", options.transport.c_str(),
+		options.baudRate, options.size, options.window, options.errorRate, options.isFirstBlockLost ? "true" : "false");
+
+	for (TransferProtocol protocol : options.protocols) {
+		bool isResumeRun = options.isResumeRun && protocol == TransferProtocol::Zmodem;
+
+		for (int pass = isResumeRun ? 0 : 1; pass < 2; pass++) {
+			TransferStats sent, received;
+
+			if (pass == 0 || !isResumeRun) {
+				remove(receivedPath.c_str());
+			}
+			if (!runTransfer(options, protocol, pass == 0 ? options.size / 2 : 0, &sent, &received)) {
+				fprintf(stderr, "could not open a %s loopback\n", options.transport.c_str());
+				return 2;
+			}
+			bool isVerified = pass == 0 ? received.status == TransferStatus::Cancelled :
+				received.status == TransferStatus::Complete && sent.status == TransferStatus::Complete &&
+				verifyReceived(options, protocol, payload);
+			uint64_t moved = received.offset - received.startOffset;
+			double efficiency = options.transport == "sim" ? linkEfficiency(received, line) : 0;
+
+			isAllVerified = isAllVerified && isVerified;
+			fprintf(out, "%s    { \"protocol\": \"%s\", \"pass\": \"%s\", \"sender\": \"%s\", \"receiver\": \"%s\", "
+				"\"verified\": %s, \"bytes\": %llu, \"seconds\": %.3f, \"mb_per_s\": %.3f, ",
+				isFirst ? "" : ",\n", protocolName(protocol),
+				pass == 0 ? "cancelled" : isResumeRun ? "resumed" : "full", statusName(sent.status),
+				statusName(received.status), isVerified ? "true" : "false", (unsigned long long)moved,
+				received.seconds, received.seconds > 0 ? moved / received.seconds / 1e6 : 0);
+			if (options.transport == "sim") {
+				fprintf(out, "\"efficiency\": %.4f, ", efficiency);
+			}
+			else {
+				fprintf(out, "\"efficiency\": null, ");
+			}
+			fprintf(out, "\"wire_overhead\": %.4f, \"retries\": %llu, \"resumed_from\": %llu }",
+				moved > 0 ? (double)sent.wireBytesSent / moved : 0,
+				(unsigned long long)(sent.retries + received.retries), (unsigned long long)received.startOffset);
+			isFirst = false;
+		}
+	}
+	fprintf(out, "\n  ]\n}\n");
+	if (out != stdout) {
+		fclose(out);
+	}
+	return isAllVerified ? 0 : 3;
+}
@@ -3,4 +3,9 @@
 #define ERROR_OPEN_PORT			902
 #define ERROR_PORT_PROP			903
 #define ERROR_COM_STATE_NULL	904
+#define ERROR_SESSION_LIMIT		905
+#define ERROR_CAPTURE_OPEN		906
+#define ERROR_TRANSFER_START	907
+#define ERROR_TELEMETRY_SAVE	908
+#define ERROR_BRIDGE_START		909
 
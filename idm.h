@@ -1,8 +1,20 @@
 #define IDM_Settings		100
 #define IDM_HELP			101
-#define IDM_COM1			102
-#define IDM_COM2			103
 #define IDM_Exit			104
-#define IDM_Connect_COM1	105
-#define IDM_Connect_COM2	106
+#define IDM_Connect_SIM		107
+#define IDM_Next_Session	108
+#define IDM_Capture			109
+#define IDM_Connect_Replay	110
+#define IDM_Transfer_Send	111
+#define IDM_Transfer_Receive	112
+#define IDM_Protocol_Xmodem	113
+#define IDM_Protocol_Xmodem1k	114
+#define IDM_Protocol_Ymodem	115
+#define IDM_Protocol_Zmodem	116
+#define IDM_Telemetry_Show	117
+#define IDM_Telemetry_Save	118
+#define IDM_Ports_None		119
+#define IDM_Bridge			120
+#define IDM_Settings_Port	200
+#define IDM_Connect_Port	300
 
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <windows.h>
+
+constexpr UINT WM_RX_DATA = WM_APP + 1;		// posted by the read thread when received data is waiting in the ring
+constexpr UINT WM_TRANSFER_DONE = WM_APP + 2;	// posted by a transfer thread when it ends; wParam is the pane
+constexpr UINT WM_PORTS_CHANGED = WM_APP + 3;	// posted by the PortEnumerator when its list of ports changes
@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "../CaptureFormat.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		CaptureDump.cpp -	Prints a session capture as text or a hex dump.
+--
+-- PROGRAM:			CaptureDump
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], DumpOptions * options)
+--					void printHex(FILE * out, const char * data, size_t length)
+--					void printText(FILE * out, const char * data, size_t length)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: CaptureDump [--hex|--text] [--rx|--tx] [--out FILE] CAPTURE
+--
+-- Each record is printed as a line giving its time since the capture started, its direction and its length,
+-- followed by its bytes: 16 to a line with offsets and an ASCII column in hex mode, or as one quoted line with C
+-- escapes for anything unprintable in text mode. A summary ends the output. A capture cut short, for instance by a
+-- crash, is printed up to its last whole record.
+----------------------------------------------------------------------------------------------------------------------*/
+
+enum class DumpMode : uint8_t { Hex, Text };
+
+struct DumpOptions {
+	DumpMode mode = DumpMode::Hex;
+	bool isReceiveShown = true;
+	bool isTransmitShown = true;
+	const char * inPath = NULL;
+	const char * outPath = NULL;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], DumpOptions * options)
+--					int argc:				argument count
+--					char * argv[]:			arguments
+--					DumpOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument is not recognised or no capture is named
+----------------------------------------------------------------------------------------------------------------------*/
+bool parseOptions(int argc, char * argv[], DumpOptions * options) {
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--hex") == 0) {
+			options->mode = DumpMode::Hex;
+		}
+		else if (strcmp(argv[i], "--text") == 0) {
+			options->mode = DumpMode::Text;
+		}
+		else if (strcmp(argv[i], "--rx") == 0) {
+			options->isTransmitShown = false;
+		}
+		else if (strcmp(argv[i], "--tx") == 0) {
+			options->isReceiveShown = false;
+		}
+		else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+			options->outPath = argv[++i];
+		}
+		else if (argv[i][0] != '-' && options->inPath == NULL) {
+			options->inPath = argv[i];
+		}
+		else {
+			return false;
+		}
+	}
+	return options->inPath != NULL && (options->isReceiveShown || options->isTransmitShown);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printHex
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printHex(FILE * out, const char * data, size_t length)
+--					FILE * out:			where to print
+--					const char * data:	a record's payload
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void printHex(FILE * out, const char * data, size_t length) {
+	for (size_t offset = 0; offset < length; offset += 16) {
+		size_t count = length - offset < 16 ? length - offset : 16;
+		char ascii[17];
+
+		fprintf(out, "  %04zx ", offset);
+		for (size_t i = 0; i < 16; i++) {
+			if (i < count) {
+				uint8_t byte = (uint8_t)data[offset + i];
+				fprintf(out, " %02x", byte);
+				ascii[i] = byte >= 0x20 && byte < 0x7F ? (char)byte : '.';
+			}
+			else {
+				fputs("   ", out);
+			}
+		}
+		ascii[count] = '\0';
+		fprintf(out, "  |%s|\n", ascii);
+	}
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printText
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printText(FILE * out, const char * data, size_t length)
+--					FILE * out:			where to print
+--					const char * data:	a record's payload
+--					size_t length:		bytes in data
+--
+-- RETURNS:		void
+--
+-- NOTES:
+-- Bytes of 0x80 and up are escaped too, so a UTF-8 sequence shows as its bytes.
+----------------------------------------------------------------------------------------------------------------------*/
+void printText(FILE * out, const char * data, size_t length) {
+	fputs("  \"", out);
+	for (size_t i = 0; i < length; i++) {
+		uint8_t byte = (uint8_t)data[i];
+
+		switch (byte) {
+		case '\r':
+			fputs("\\r", out);
+			break;
+		case '\n':
+			fputs("\\n", out);
+			break;
+		case '\t':
+			fputs("\\t", out);
+			break;
+		case '\\':
+			fputs("\\\\", out);
+			break;
+		case '"':
+			fputs("\\\"", out);
+			break;
+		default:
+			if (byte >= 0x20 && byte < 0x7F) {
+				fputc(byte, out);
+			}
+			else {
+				fprintf(out, "\\x%02x", byte);
+			}
+			break;
+		}
+	}
+	fputs("\"\n", out);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--					int argc:		argument count
+--					char * argv[]:	see the usage in the file header
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the file is not a capture, 3 if it was cut short
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	DumpOptions options;
+	CaptureHeader header;
+	CaptureRecord record;
+	char headerBytes[CAPTURE_HEADER_SIZE];
+	char recordBytes[CAPTURE_RECORD_SIZE];
+	std::vector<char> payload(CAPTURE_MAX_PAYLOAD);
+	uint64_t records = 0, lastTimestamp = 0;
+	uint64_t bytes[2] = { 0, 0 };
+	bool isTruncated = false;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: CaptureDump [--hex|--text] [--rx|--tx] [--out FILE] CAPTURE\n");
+		return 1;
+	}
+	FILE * in = fopen(options.inPath, "rb");
+	if (in == NULL) {
+		fprintf(stderr, "could not open %s\n", options.inPath);
+		return 2;
+	}
+	if (fread(headerBytes, 1, sizeof(headerBytes), in) != sizeof(headerBytes)
+		|| !decodeCaptureHeader(headerBytes, sizeof(headerBytes), &header)) {
+		fprintf(stderr, "%s is not a capture\n", options.inPath);
+		fclose(in);
+		return 2;
+	}
+	fseek(in, (long)header.headerSize, SEEK_SET);
+
+	FILE * out = options.outPath ? fopen(options.outPath, "w") : stdout;
+	if (out == NULL) {
+		fprintf(stderr, "could not write %s\n", options.outPath);
+		fclose(in);
+		return 1;
+	}
+
+	time_t startSeconds = (time_t)(header.startTime / 1000000000ULL);
+	char started[32];
+	strftime(started, sizeof(started), "%Y-%m-%d %H:%M:%S", gmtime(&startSeconds));
+	fprintf(out, "# capture of %s started %s.%03u UTC\n", header.portName, started,
+		(unsigned)(header.startTime / 1000000 % 1000));
+
+	for (;;) {
+		size_t got = fread(recordBytes, 1, sizeof(recordBytes), in);
+
+		if (got == 0) {
+			break;
+		}
+		if (got != sizeof(recordBytes)) {
+			isTruncated = true;
+			break;
+		}
+		decodeRecordHeader(recordBytes, &record);
+		if (record.length > payload.size()) {
+			payload.resize(record.length);
+		}
+		if (fread(payload.data(), 1, record.length, in) != record.length) {
+			isTruncated = true;
+			break;
+		}
+		records++;
+		lastTimestamp = record.timestamp;
+		bytes[(int)record.direction] += record.length;
+
+		bool isReceive = record.direction == CaptureDirection::Receive;
+		if (isReceive ? !options.isReceiveShown : !options.isTransmitShown) {
+			continue;
+		}
+		fprintf(out, "+%llu.%09llu %s %u\n", (unsigned long long)(record.timestamp / 1000000000ULL),
+			(unsigned long long)(record.timestamp % 1000000000ULL), isReceive ? "RX" : "TX", record.length);
+		if (options.mode == DumpMode::Hex) {
+			printHex(out, payload.data(), record.length);
+		}
+		else {
+			printText(out, payload.data(), record.length);
+		}
+	}
+	fprintf(out, "# %llu records over %.6f s: %llu bytes received, %llu bytes sent%s\n",
+		(unsigned long long)records, lastTimestamp / 1e9, (unsigned long long)bytes[0], (unsigned long long)bytes[1],
+		isTruncated ? "; the last record is cut short" : "");
+
+	fclose(in);
+	if (out != stdout) {
+		fclose(out);
+	}
+	return isTruncated ? 3 : 0;
+}
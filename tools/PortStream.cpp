@@ -0,0 +1,543 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/signalfd.h>
+#include <sys/stat.h>
+#include "../PosixTransport.h"
+#endif
+#include "../PortEnumerator.h"
+#include "../SerialTransport.h"
+
+/*------------------------------------------------------------------------------------------------------------------
+-- SOURCE FILE:		PortStream.cpp -	Streams a serial port to stdout and stdin to the port, with no window.
+--
+-- PROGRAM:			PortStream
+--
+-- FUNCTIONS:
+--					int main(int argc, char * argv[])
+--					bool parseOptions(int argc, char * argv[], StreamOptions * options)
+--					int listPorts(void)
+--					int streamPolled(PosixTransport * port, const StreamOptions & options, StreamStats * stats)
+--					int streamThreaded(SerialTransport * port, const StreamOptions & options, StreamStats * stats)
+--					void printStats(const StreamOptions & options, const StreamStats & stats, double seconds)
+--
+--
+-- DATE:			Oct 17, 2026
+--
+-- REVISIONS:		(N/A)
+--
+-- DESIGNER:		Henry Ho
+--
+-- PROGRAMMER:		Henry Ho
+--
+-- NOTES:
+-- Usage: PortStream [--baud N] [--data 5|6|7|8] [--parity none|odd|even] [--stop 1|2] [--flow none|rtscts|xonxoff]
+--                   [--idle MS] [--no-splice] [--stats] PORT
+--        PortStream --list
+--
+-- The port is opened and configured from the arguments, 9600 8N1 with no flow control unless told otherwise, and
+-- no dialog is shown. Everything the port receives is written to stdout as it arrives and everything read from stdin
+-- is sent, byte for byte; nothing is echoed or translated. The stream runs until the port fails, stdout is closed,
+-- or SIGINT or SIGTERM arrives. Once stdin reaches end of file, --idle ends it after the port has been quiet for that
+-- many ms, so a script can send a command and collect the reply.
+--
+-- On Linux one thread polls the port, stdin and a signalfd. Where the stdio side is a pipe the bytes are moved with
+-- splice, so they go between the tty and the pipe inside the kernel and never pass through this process; otherwise,
+-- or with --no-splice, they are read and written through a STREAM_BUFFER_SIZE buffer. Writes to stdout block, so a
+-- slow reader holds back the port rather than the tool buffering without limit.
+--
+-- Elsewhere the port is driven through SerialTransport, with a thread reading the port into stdout while the main
+-- thread sends stdin.
+--
+-- --stats prints the bytes each way, the wall and CPU time, and whether splice was used, as JSON on stderr.
+-- --list prints the ports a PortEnumerator finds, one per line. Exits 0 when the stream ends normally, 1 on bad
+-- arguments, 2 if the port cannot be opened or configured, and 3 if it fails while streaming.
+----------------------------------------------------------------------------------------------------------------------*/
+
+typedef std::chrono::steady_clock Clock;
+
+constexpr size_t STREAM_BUFFER_SIZE = 64 * 1024;	// bytes moved per read, write or splice
+
+struct StreamOptions {
+	PortSettings settings;
+	const char * portName = NULL;
+	long idleTimeout = -1;		// ms after stdin closes with the port quiet before stopping; -1 never
+	bool isSpliceAllowed = true;
+	bool isStatsShown = false;
+	bool isListing = false;
+};
+
+struct StreamStats {
+	uint64_t received = 0;		// port to stdout
+	uint64_t sent = 0;			// stdin to port
+	bool isReceiveSpliced = false;
+	bool isSendSpliced = false;
+};
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	parseOptions
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	bool parseOptions(int argc, char * argv[], StreamOptions * options)
+--					int argc:					argument count
+--					char * argv[]:				arguments
+--					StreamOptions * options:	filled in from the arguments
+--
+-- RETURNS:		bool - false if an argument is not recognised, or no port is named
+----------------------------------------------------------------------------------------------------------------------*/
+bool parseOptions(int argc, char * argv[], StreamOptions * options) {
+	for (int i = 1; i < argc; i++) {
+		const char * value = i + 1 < argc ? argv[i + 1] : "";
+
+		if (strcmp(argv[i], "--list") == 0) {
+			options->isListing = true;
+			continue;
+		}
+		else if (strcmp(argv[i], "--no-splice") == 0) {
+			options->isSpliceAllowed = false;
+			continue;
+		}
+		else if (strcmp(argv[i], "--stats") == 0) {
+			options->isStatsShown = true;
+			continue;
+		}
+		else if (argv[i][0] != '-') {
+			if (options->portName != NULL) {
+				return false;
+			}
+			options->portName = argv[i];
+			continue;
+		}
+
+		if (strcmp(argv[i], "--baud") == 0) {
+			options->settings.baudRate = (uint32_t)strtoul(value, NULL, 10);
+		}
+		else if (strcmp(argv[i], "--data") == 0) {
+			options->settings.dataBits = (uint8_t)atoi(value);
+			if (options->settings.dataBits < 5 || options->settings.dataBits > 8) {
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--parity") == 0) {
+			if (strcmp(value, "none") == 0) {
+				options->settings.parity = ParityMode::None;
+			}
+			else if (strcmp(value, "odd") == 0) {
+				options->settings.parity = ParityMode::Odd;
+			}
+			else if (strcmp(value, "even") == 0) {
+				options->settings.parity = ParityMode::Even;
+			}
+			else {
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--stop") == 0) {
+			options->settings.stopBits = (uint8_t)atoi(value);
+			if (options->settings.stopBits != 1 && options->settings.stopBits != 2) {
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--flow") == 0) {
+			options->settings.rtsCts = strcmp(value, "rtscts") == 0;
+			options->settings.xonXoff = strcmp(value, "xonxoff") == 0;
+			if (!options->settings.rtsCts && !options->settings.xonXoff && strcmp(value, "none") != 0) {
+				return false;
+			}
+		}
+		else if (strcmp(argv[i], "--idle") == 0) {
+			options->idleTimeout = strtol(value, NULL, 10);
+		}
+		else {
+			return false;
+		}
+		i++;
+	}
+	return options->isListing || (options->portName != NULL && options->settings.baudRate > 0);
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	listPorts
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int listPorts(void)
+--
+-- RETURNS:		int - 0
+--
+-- NOTES:
+-- Waits for the PortEnumerator's first scan and prints what it found, in the form PORT takes.
+----------------------------------------------------------------------------------------------------------------------*/
+int listPorts() {
+	std::unique_ptr<PortEnumerator> enumerator = createPortEnumerator();
+	std::mutex lock;
+	std::condition_variable scanned;
+
+	enumerator->start([&]() {
+		std::lock_guard<std::mutex> guard(lock);
+		scanned.notify_all();
+	});
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		scanned.wait(guard, [&]() { return enumerator->isReady(); });
+	}
+	for (const std::string & port : enumerator->getPorts()) {
+		printf("%s\n", port.c_str());
+	}
+	return 0;
+}
+
+#ifndef _WIN32
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	streamPolled
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int streamPolled(PosixTransport * port, const StreamOptions & options, StreamStats * stats)
+--					PosixTransport * port:			the open, configured port
+--					const StreamOptions & options:	idle timeout and whether splice may be tried
+--					StreamStats * stats:			counts the bytes moved each way
+--
+-- RETURNS:		int - 0 when the stream ends normally, 3 if the port fails
+--
+-- NOTES:
+-- splice is tried first each way where stdio is a pipe. A kernel whose tty cannot splice answers EINVAL, and that
+-- direction drops to the buffer for good. Bytes read from stdin that the port will not take yet are held in
+-- pending, and stdin is not read again until the port has taken them.
+--
+-- A spliced send only runs when poll has said stdin is readable, so it never blocks waiting for input; it can still
+-- find the port full, which it reports as EAGAIN with the bytes left in the pipe.
+----------------------------------------------------------------------------------------------------------------------*/
+int streamPolled(PosixTransport * port, const StreamOptions & options, StreamStats * stats) {
+	int portFd = port->getDescriptor();
+	std::vector<char> receiveBuffer(STREAM_BUFFER_SIZE);
+	std::vector<char> pending(STREAM_BUFFER_SIZE);
+	size_t pendingStart = 0, pendingEnd = 0;
+	bool isPortFull = false;
+	bool isInputOpen = true;
+	struct stat info;
+	Clock::time_point lastReceive = Clock::now();
+	sigset_t stopSignals;
+	int signalFd;
+
+	stats->isReceiveSpliced = options.isSpliceAllowed && fstat(STDOUT_FILENO, &info) == 0 && S_ISFIFO(info.st_mode);
+	stats->isSendSpliced = options.isSpliceAllowed && fstat(STDIN_FILENO, &info) == 0 && S_ISFIFO(info.st_mode);
+
+	sigemptyset(&stopSignals);
+	sigaddset(&stopSignals, SIGINT);
+	sigaddset(&stopSignals, SIGTERM);
+	sigprocmask(SIG_BLOCK, &stopSignals, NULL);
+	signalFd = signalfd(-1, &stopSignals, SFD_CLOEXEC);
+	// A reader that goes away shows up as EPIPE from the write instead
+	signal(SIGPIPE, SIG_IGN);
+
+	for (;;) {
+		struct pollfd waits[3] = {
+			{ portFd, (short)(POLLIN | (isPortFull ? POLLOUT : 0)), 0 },
+			{ isInputOpen && !isPortFull ? STDIN_FILENO : -1, POLLIN, 0 },
+			{ signalFd, POLLIN, 0 },
+		};
+		int timeout = -1;
+
+		if (!isInputOpen && !isPortFull && options.idleTimeout >= 0) {
+			long quiet = (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+				Clock::now() - lastReceive).count();
+
+			if (quiet >= options.idleTimeout) {
+				return 0;
+			}
+			timeout = (int)(options.idleTimeout - quiet);
+		}
+		if (poll(waits, 3, timeout) < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return 3;
+		}
+		if (waits[2].revents != 0) {
+			return 0;
+		}
+
+		// Port to stdout
+		if (waits[0].revents & POLLIN) {
+			ssize_t moved = -1;
+
+			if (stats->isReceiveSpliced) {
+				moved = splice(portFd, NULL, STDOUT_FILENO, NULL, STREAM_BUFFER_SIZE, SPLICE_F_MOVE);
+				if (moved < 0 && errno == EINVAL) {
+					stats->isReceiveSpliced = false;
+				}
+			}
+			if (!stats->isReceiveSpliced) {
+				moved = read(portFd, receiveBuffer.data(), receiveBuffer.size());
+				for (ssize_t written = 0, result; moved > 0 && written < moved; written += result) {
+					if ((result = write(STDOUT_FILENO, receiveBuffer.data() + written, moved - written)) < 0) {
+						if (errno == EINTR) {
+							result = 0;
+							continue;
+						}
+						return errno == EPIPE ? 0 : 3;
+					}
+				}
+			}
+			if (moved > 0) {
+				stats->received += (uint64_t)moved;
+				lastReceive = Clock::now();
+			}
+			else if (moved == 0) {
+				return 3;
+			}
+			else if (errno == EPIPE) {
+				return 0;
+			}
+			else if (errno != EAGAIN && errno != EINTR) {
+				return 3;
+			}
+		}
+		else if (waits[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			return 3;
+		}
+
+		// stdin to port
+		if (isPortFull && (waits[0].revents & POLLOUT)) {
+			isPortFull = false;
+		}
+		if (pendingStart < pendingEnd && !isPortFull) {
+			ssize_t written = write(portFd, pending.data() + pendingStart, pendingEnd - pendingStart);
+
+			if (written > 0) {
+				pendingStart += (size_t)written;
+				stats->sent += (uint64_t)written;
+			}
+			else if (errno == EAGAIN) {
+				isPortFull = true;
+			}
+			else if (errno != EINTR) {
+				return 3;
+			}
+			continue;
+		}
+		if (!(waits[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+			continue;
+		}
+		ssize_t moved = -1;
+
+		if (stats->isSendSpliced) {
+			moved = splice(STDIN_FILENO, NULL, portFd, NULL, STREAM_BUFFER_SIZE, SPLICE_F_MOVE);
+			if (moved < 0 && errno == EINVAL) {
+				stats->isSendSpliced = false;
+			}
+			else if (moved > 0) {
+				stats->sent += (uint64_t)moved;
+			}
+		}
+		if (!stats->isSendSpliced) {
+			moved = read(STDIN_FILENO, pending.data(), pending.size());
+			if (moved > 0) {
+				pendingStart = 0;
+				pendingEnd = (size_t)moved;
+			}
+		}
+		if (moved == 0) {
+			isInputOpen = false;
+			lastReceive = Clock::now();
+		}
+		else if (moved < 0 && errno == EAGAIN) {
+			isPortFull = true;
+		}
+		else if (moved < 0 && errno != EINTR) {
+			return 3;
+		}
+	}
+}
+#else
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	streamThreaded
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int streamThreaded(SerialTransport * port, const StreamOptions & options, StreamStats * stats)
+--					SerialTransport * port:			the open, configured port
+--					const StreamOptions & options:	idle timeout
+--					StreamStats * stats:			counts the bytes moved each way
+--
+-- RETURNS:		int - 0 when the stream ends normally, 3 if the port fails
+--
+-- NOTES:
+-- A thread reads the port into stdout while this one sends stdin. When stdin closes this thread waits out the idle
+-- timeout, if there is one, or for the port to fail; it then cancels the port so the reading thread returns.
+-- Ctrl+C ends the process without the summary.
+----------------------------------------------------------------------------------------------------------------------*/
+int streamThreaded(SerialTransport * port, const StreamOptions & options, StreamStats * stats) {
+	std::vector<char> sendBuffer(STREAM_BUFFER_SIZE);
+	std::atomic<bool> isStopping{ false };
+	std::atomic<bool> isPortFailed{ false };
+	std::atomic<int64_t> lastReceive{ Clock::now().time_since_epoch().count() };
+	int length;
+
+	_setmode(_fileno(stdin), _O_BINARY);
+	_setmode(_fileno(stdout), _O_BINARY);
+	std::thread receiver([&]() {
+		std::vector<char> receiveBuffer(STREAM_BUFFER_SIZE);
+		size_t bytesRead;
+
+		while (!isStopping.load()) {
+			if (!port->read(receiveBuffer.data(), receiveBuffer.size(), RX_WAIT_TIMEOUT, &bytesRead)) {
+				isPortFailed.store(!isStopping.load());
+				return;
+			}
+			if (bytesRead > 0) {
+				if (fwrite(receiveBuffer.data(), 1, bytesRead, stdout) != bytesRead || fflush(stdout) != 0) {
+					isStopping.store(true);
+					return;
+				}
+				stats->received += bytesRead;
+				lastReceive.store(Clock::now().time_since_epoch().count());
+			}
+		}
+	});
+
+	while (!isStopping.load() && (length = _read(_fileno(stdin), sendBuffer.data(), (unsigned)sendBuffer.size())) > 0) {
+		if (!port->write(sendBuffer.data(), (size_t)length)) {
+			isPortFailed.store(true);
+			break;
+		}
+		stats->sent += (uint64_t)length;
+	}
+	lastReceive.store(Clock::now().time_since_epoch().count());
+	while (!isStopping.load() && !isPortFailed.load()) {
+		Clock::time_point quietSince{ Clock::duration(lastReceive.load()) };
+
+		if (options.idleTimeout >= 0 && Clock::now() - quietSince >= std::chrono::milliseconds(options.idleTimeout)) {
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	isStopping.store(true);
+	port->cancel();
+	receiver.join();
+	return isPortFailed.load() ? 3 : 0;
+}
+#endif
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	printStats
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	void printStats(const StreamOptions & options, const StreamStats & stats, double seconds)
+--					const StreamOptions & options:	the port streamed
+--					const StreamStats & stats:		what was moved
+--					double seconds:					wall time the stream ran
+--
+-- RETURNS:		void
+----------------------------------------------------------------------------------------------------------------------*/
+void printStats(const StreamOptions & options, const StreamStats & stats, double seconds) {
+	fprintf(stderr, "{ \"port\": \"%s\", \"baud\": %u, \"rx_bytes\": %llu, \"tx_bytes\": %llu, "
+		"\"seconds\": %.3f, \"cpu_seconds\": %.3f, \"rx_spliced\": %s, \"tx_spliced\": %s }\n",
+		options.portName, options.settings.baudRate, (unsigned long long)stats.received,
+		(unsigned long long)stats.sent, seconds, (double)clock() / CLOCKS_PER_SEC,
+		stats.isReceiveSpliced ? "true" : "false", stats.isSendSpliced ? "true" : "false");
+}
+
+/*------------------------------------------------------------------------------------------------------------------
+-- FUNCTION:	main
+--
+-- DATE:		Oct 17, 2026
+--
+-- REVISIONS:	(N/A)
+--
+-- DESIGNER:	Henry Ho
+--
+-- PROGRAMMER:	Henry Ho
+--
+-- INTERFACE:	int main(int argc, char * argv[])
+--
+-- RETURNS:		int - 0 on success, 1 on bad arguments, 2 if the port cannot be set up, 3 if it fails while streaming
+----------------------------------------------------------------------------------------------------------------------*/
+int main(int argc, char * argv[]) {
+	StreamOptions options;
+	StreamStats stats;
+	int result;
+
+	if (!parseOptions(argc, argv, &options)) {
+		fprintf(stderr, "usage: PortStream [--baud N] [--data 5|6|7|8] [--parity none|odd|even] [--stop 1|2]\n"
+			"                  [--flow none|rtscts|xonxoff] [--idle MS] [--no-splice] [--stats] PORT\n"
+			"       PortStream --list\n");
+		return 1;
+	}
+	if (options.isListing) {
+		return listPorts();
+	}
+
+#ifdef _WIN32
+	std::unique_ptr<SerialTransport> port = createSerialTransport();
+#else
+	std::unique_ptr<PosixTransport> port(new PosixTransport());
+#endif
+	if ((result = port->open(options.portName)) != 0 || (result = port->configure(options.settings)) != 0) {
+		fprintf(stderr, "could not set up %s (error %d)\n", options.portName, result);
+		return 2;
+	}
+
+	Clock::time_point begin = Clock::now();
+#ifdef _WIN32
+	result = streamThreaded(port.get(), options, &stats);
+#else
+	result = streamPolled(port.get(), options, &stats);
+#endif
+	port->close();
+	if (options.isStatsShown) {
+		printStats(options, stats, std::chrono::duration<double>(Clock::now() - begin).count());
+	}
+	return result;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <windows.h>
+#include <string.h>
+#include "Utf8Decoder.h"
 
 /*------------------------------------------------------------------------------------------------------------------
 -- HEADER FILE:		utils.h -	A file that contains all the utility methods for this application
@@ -8,12 +10,12 @@
 -- PROGRAM:			DumbSerialPortEmulator
 --
 -- FUNCTIONS:
---					static LPCWSTR strToLPCWSTR(const char * content)
+--					static LPCWSTR strToLPCWSTR(const char * content, wchar_t * buffer, size_t capacity)
 --
 --
 -- DATE:			Sept 28, 2019
 --
--- REVISIONS:		(N/A)
+-- REVISIONS:		Oct 17, 2026 - String conversion no longer allocates
 --
 -- DESIGNER:		Henry Ho
 --
@@ -29,25 +31,43 @@ namespace utils {
 	--
 	-- DATE:		Sept 28, 2019
 	--
-	-- REVISIONS:	(N/A)
+	-- REVISIONS:	Oct 17, 2026 - Writes into a buffer the caller owns instead of leaking a new one; decodes UTF-8
 	--
 	-- DESIGNER:	Henry Ho
 	--
 	-- PROGRAMMER:	Henry Ho
 	--
-	-- INTERFACE:	LPCWSTR strToLPCWSTR(const char * content)
-	--					char * content:	string content to convert to LPCWSTR
+	-- INTERFACE:	LPCWSTR strToLPCWSTR(const char * content, wchar_t * buffer, size_t capacity)
+	--					char * content:		UTF-8 string content to convert to LPCWSTR
+	--					wchar_t * buffer:	where to write the wide string
+	--					size_t capacity:	size of buffer in characters, at least 1
 	--
-	-- RETURNS:		LPCWSTR
+	-- RETURNS:		LPCWSTR - buffer, always null terminated
 	--
 	-- NOTES:
-	-- Call this function to convert a string character to a wide byte character.
+	-- Call this function to convert a string character to a wide byte character. Text that does not fit is cut off.
+	-- Nothing is allocated, so a stack array is the usual buffer.
 	----------------------------------------------------------------------------------------------------------------------*/
-	static LPCWSTR strToLPCWSTR(const char * content) {
-		size_t outSize;
-		size_t size = strlen(content) + 1;
-		wchar_t* wtext = new wchar_t[size];
-		mbstowcs_s(&outSize, wtext, size, content, size - 1);
-		return (LPCWSTR)wtext;
+	static LPCWSTR strToLPCWSTR(const char * content, wchar_t * buffer, size_t capacity) {
+		static_assert(sizeof(wchar_t) == sizeof(char16_t), "Windows wide strings are UTF-16");
+		Utf8Decoder decoder;
+		size_t remaining = strlen(content);
+		size_t written = 0;
+
+		// Each slice leaves room for the unit a decode call may carry over, and for the terminator
+		while (remaining > 0 && written + 2 < capacity) {
+			size_t slice = capacity - written - 2;
+			if (slice > remaining) {
+				slice = remaining;
+			}
+			written += decoder.decode(content, slice, (char16_t *)buffer + written);
+			content += slice;
+			remaining -= slice;
+		}
+		if (written + 1 < capacity) {
+			written += decoder.flush((char16_t *)buffer + written);
+		}
+		buffer[written] = L'\0';
+		return (LPCWSTR)buffer;
 	}
 }